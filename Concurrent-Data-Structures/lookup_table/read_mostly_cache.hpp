@@ -0,0 +1,153 @@
+#ifndef CDS_READ_MOSTLY_CACHE_HPP
+#define CDS_READ_MOSTLY_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// read_mostly_cache: the shared_mutex dns_cache pattern
+// (concurrency/03_12) productized for read rates where even a
+// shared_lock acquisition shows up in profiles.
+//
+// Readers never take a lock. The whole map lives behind one
+// shared_ptr<const map>, and a read is a single atomic shared_ptr
+// load plus a lookup in an immutable map - concurrent readers touch
+// no shared mutable state apart from the reference count. A reader
+// holding a snapshot keeps that version alive; writers can never
+// invalidate it under them (the RCU idea, with shared_ptr as the
+// grace period).
+//
+// Writers pay for that: a publish copies the whole map. So the write
+// path batches. update_or_add/erase buffer mutations under the writer
+// mutex and publish a new version only when the buffer reaches
+// batch_size (or on an explicit flush) - one copy amortized over the
+// batch instead of one per write. The price is bounded staleness:
+// readers do not see a buffered write until it publishes. Callers that
+// need a write visible immediately follow it with flush().
+//
+// Use this for genuinely read-mostly data (config, DNS entries,
+// routing tables). At anything near write-heavy, the copies dominate
+// and threadsafe_lookup_table.cpp's sharded locking is the better fit.
+
+namespace cds
+{
+
+template<typename Key, typename Value>
+class read_mostly_cache
+{
+public:
+    using map_type = std::map<Key, Value>;
+
+private:
+    // Readers atomic-load this; writers atomic-store a fresh map.
+    // C++17 idiom: free-function atomics on shared_ptr.
+    std::shared_ptr<const map_type> current;
+
+    // Writer side only. Buffered mutations apply in order, so a later
+    // erase cancels an earlier update of the same key and vice versa.
+    std::mutex writer_mutex;
+    struct mutation
+    {
+        Key key;
+        Value value;
+        bool is_erase;
+    };
+    std::vector<mutation> pending;
+    std::size_t const batch_size;
+
+    // Copy-apply-publish. Caller holds writer_mutex.
+    void publish_locked()
+    {
+        auto next = std::make_shared<map_type>(*current);
+        for (auto& m : pending)
+        {
+            if (m.is_erase)
+            {
+                next->erase(m.key);
+            }
+            else
+            {
+                (*next)[m.key] = std::move(m.value);
+            }
+        }
+        pending.clear();
+        std::atomic_store(&current,
+                          std::shared_ptr<const map_type>(std::move(next)));
+    }
+
+public:
+    explicit read_mostly_cache(std::size_t batch_size_ = 16)
+        : current(std::make_shared<map_type>()), batch_size(batch_size_)
+    {}
+
+    read_mostly_cache(const read_mostly_cache&) = delete;
+    read_mostly_cache& operator=(const read_mostly_cache&) = delete;
+
+    // Read fast path: one atomic load, no lock. Returns default_value
+    // for a missing key, like dns_cache's find_entry.
+    Value find(const Key& key, Value default_value = Value()) const
+    {
+        std::shared_ptr<const map_type> const snap = std::atomic_load(&current);
+        auto const it = snap->find(key);
+        return it == snap->end() ? std::move(default_value) : it->second;
+    }
+
+    bool contains(const Key& key) const
+    {
+        std::shared_ptr<const map_type> const snap = std::atomic_load(&current);
+        return snap->find(key) != snap->end();
+    }
+
+    // A stable, immutable view; iterate without any locking. Holding it
+    // pins that version's memory, not the writers.
+    std::shared_ptr<const map_type> snapshot() const
+    {
+        return std::atomic_load(&current);
+    }
+
+    // Buffered write: visible to readers after at most batch_size-1
+    // further writes, or immediately after flush().
+    void update_or_add(Key key, Value value)
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        pending.push_back({std::move(key), std::move(value), false});
+        if (pending.size() >= batch_size)
+        {
+            publish_locked();
+        }
+    }
+
+    void erase(Key key)
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        pending.push_back({std::move(key), Value(), true});
+        if (pending.size() >= batch_size)
+        {
+            publish_locked();
+        }
+    }
+
+    // Publish everything buffered so far.
+    void flush()
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        if (!pending.empty())
+        {
+            publish_locked();
+        }
+    }
+
+    // Size of the published version; buffered writes don't count yet.
+    std::size_t size() const
+    {
+        return std::atomic_load(&current)->size();
+    }
+};
+
+} // namespace cds
+
+#endif // CDS_READ_MOSTLY_CACHE_HPP
@@ -0,0 +1,199 @@
+#include "read_mostly_cache.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Demo for cds::read_mostly_cache - the dns_cache from
+// concurrency/03_12 rebuilt so readers do one atomic shared_ptr load
+// instead of acquiring a shared_mutex, and writes batch into one
+// copy-and-publish per batch_size mutations.
+
+// The baseline we are replacing: shared_mutex around a map, readers
+// take a shared_lock per find.
+class shared_mutex_cache
+{
+private:
+    std::map<std::string, std::string> entries;
+    mutable std::shared_mutex entry_mutex;
+
+public:
+    std::string find(std::string const& key) const
+    {
+        std::shared_lock<std::shared_mutex> lk(entry_mutex);
+        auto const it = entries.find(key);
+        return it == entries.end() ? std::string() : it->second;
+    }
+
+    void update_or_add(std::string const& key, std::string const& value)
+    {
+        std::lock_guard<std::shared_mutex> lk(entry_mutex);
+        entries[key] = value;
+    }
+};
+
+int main()
+{
+    std::cout << "=== Read-Mostly Cache Demo ===" << std::endl;
+
+    // 1. Basic operations and batched visibility
+    std::cout << "\n1. Basic operations (batch_size=4):" << std::endl;
+    {
+        cds::read_mostly_cache<std::string, std::string> cache(4);
+        cache.update_or_add("example.com", "93.184.216.34");
+        cache.update_or_add("localhost", "127.0.0.1");
+        std::cout << "After 2 buffered writes, find(example.com): '"
+                  << cache.find("example.com") << "' (not published yet)"
+                  << std::endl;
+        cache.flush();
+        std::cout << "After flush, find(example.com): '"
+                  << cache.find("example.com") << "'" << std::endl;
+
+        cache.update_or_add("a.com", "1.1.1.1");
+        cache.update_or_add("b.com", "2.2.2.2");
+        cache.update_or_add("c.com", "3.3.3.3");
+        cache.update_or_add("d.com", "4.4.4.4");  // 4th write: auto-publish
+        std::cout << "4 writes hit batch_size, find(d.com): '"
+                  << cache.find("d.com") << "' (published automatically)"
+                  << std::endl;
+
+        cache.erase("a.com");
+        cache.flush();
+        std::cout << "After erase+flush, contains(a.com): "
+                  << (cache.contains("a.com") ? "yes" : "no")
+                  << ", size: " << cache.size() << std::endl;
+    }
+
+    // 2. Snapshot iteration while a writer keeps publishing
+    std::cout << "\n2. Stable snapshot under concurrent writes:" << std::endl;
+    {
+        cds::read_mostly_cache<int, int> cache(8);
+        for (int i = 0; i < 100; ++i)
+        {
+            cache.update_or_add(i, i * 10);
+        }
+        cache.flush();
+
+        auto const snap = cache.snapshot();
+        std::thread writer([&cache]
+        {
+            for (int i = 100; i < 200; ++i)
+            {
+                cache.update_or_add(i, i * 10);
+            }
+            cache.flush();
+        });
+
+        // Iterate the frozen view while the writer runs; its size and
+        // contents cannot change under us.
+        long long sum = 0;
+        for (auto const& kv : *snap)
+        {
+            sum += kv.second;
+        }
+        writer.join();
+        std::cout << "Snapshot saw " << snap->size() << " entries (sum " << sum
+                  << ") while cache grew to " << cache.size() << std::endl;
+    }
+
+    // 3. Read throughput: shared_lock per read vs one atomic load
+    std::cout << "\n3. Read throughput, 4 readers x 500000 finds, "
+              << "1 writer trickling updates:" << std::endl;
+    {
+        int const reads_per_thread = 500000;
+        unsigned const num_readers = 4;
+
+        // Pre-build the key strings so the loop measures lookups, not
+        // std::to_string.
+        std::vector<std::string> keys;
+        for (int i = 0; i < 1000; ++i)
+        {
+            keys.push_back("key" + std::to_string(i));
+        }
+
+        auto const bench = [&](auto& cache, const char* label)
+        {
+            for (auto const& key : keys)
+            {
+                cache.update_or_add(key, "value");
+            }
+            std::atomic<bool> stop(false);
+            std::atomic<long long> hits(0);
+
+            auto const start = std::chrono::steady_clock::now();
+            std::vector<std::thread> readers;
+            for (unsigned r = 0; r < num_readers; ++r)
+            {
+                readers.emplace_back([&]
+                {
+                    long long local_hits = 0;
+                    for (int i = 0; i < reads_per_thread; ++i)
+                    {
+                        if (!cache.find(keys[i % 1000]).empty())
+                        {
+                            ++local_hits;
+                        }
+                    }
+                    hits.fetch_add(local_hits);
+                });
+            }
+            std::thread writer([&]
+            {
+                int i = 0;
+                while (!stop.load())
+                {
+                    cache.update_or_add(keys[i % 1000], "updated");
+                    ++i;
+                    std::this_thread::yield();
+                }
+            });
+            for (auto& t : readers)
+            {
+                t.join();
+            }
+            stop.store(true);
+            writer.join();
+            double const seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+            long long const total =
+                static_cast<long long>(num_readers) * reads_per_thread;
+            std::cout << "  " << label << ": "
+                      << static_cast<long long>(total / seconds)
+                      << " reads/sec (" << hits.load() << "/" << total
+                      << " hits)" << std::endl;
+            return total / seconds;
+        };
+
+        shared_mutex_cache baseline;
+        // batch_size 8 divides the 1000 warm-up writes evenly, so both
+        // caches enter the measurement with all keys visible.
+        cds::read_mostly_cache<std::string, std::string> cache(8);
+        double const locked = bench(baseline, "shared_mutex    ");
+        double const lockfree = bench(cache, "read_mostly_cache");
+        std::cout << "  speedup: " << lockfree / locked << "x" << std::endl;
+        if (std::thread::hardware_concurrency() <= 1)
+        {
+            // On one hardware thread the readers never actually run in
+            // parallel, so a shared_lock is never contended - the
+            // baseline's best case. The snapshot path's advantage is
+            // exactly the cross-core case this box cannot show: readers
+            // on different cores ping-ponging the shared_mutex cache
+            // line vs. each loading an (unchanging) pointer.
+            std::cout << "  (single hardware thread: shared_lock is "
+                         "uncontended here, so expect ~1x)" << std::endl;
+        }
+    }
+
+    std::cout << "\nDemo completed. Key features:" << std::endl;
+    std::cout << "- Reads are one atomic shared_ptr load; no lock, no waiting" << std::endl;
+    std::cout << "- Snapshots stay valid and immutable while writers publish" << std::endl;
+    std::cout << "- Writes batch into one map copy per batch_size mutations" << std::endl;
+    std::cout << "- Staleness is bounded: flush() publishes buffered writes now" << std::endl;
+
+    return 0;
+}
@@ -1,6 +1,11 @@
+#include <algorithm>
 #include <iostream>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
 #include <vector>
-#include <list>
+#include <mutex>
 #include <shared_mutex>
 #include <memory>
 #include <functional>
@@ -11,7 +16,105 @@
 #include <random>
 
 // Complete implementation of thread-safe lookup table from the text
-// This is the full implementation from Listing 6.11 with modern C++ features
+// (Listing 6.11), extended with concurrent incremental resizing.
+//
+// The original design fixes the bucket count at construction, so a
+// long-running table degrades to long per-bucket list scans as it
+// grows. Here the table doubles its bucket array once the average
+// load passes a threshold, and rehashes INCREMENTALLY, Redis-style:
+//
+//   - a table-level shared_mutex guards the bucket ARRAYS. Every
+//     operation (including migration steps) holds it shared; the only
+//     unique acquisitions are the brief moments that install and
+//     promote a new array, so readers keep running throughout a
+//     rehash under per-bucket shared locks as before;
+//   - while a rehash is in flight, each writer first migrates a couple
+//     of old buckets (claimed by atomic index) into the new array, so
+//     the cost is spread across writers and no operation ever pays for
+//     the whole table;
+//   - a migrated bucket is marked 'moved' under its own lock; any
+//     operation that lands on a moved bucket simply retries against
+//     the new array. Entries therefore live in exactly one place at
+//     every moment.
+
+// Bucket storage: a tiny vector with inline capacity for the common
+// 0-2 entry case. With the load factor capped at 4, most buckets hold
+// a couple of entries, so a probe scans contiguous pairs in one or two
+// cache lines instead of chasing std::list nodes across the heap, and
+// the usual insert or remove touches the allocator not at all.
+template<typename T, std::size_t InlineCapacity>
+class small_vector {
+private:
+    alignas(T) unsigned char inline_storage[sizeof(T) * InlineCapacity];
+    T* data_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = InlineCapacity;
+
+    T* inline_data() {
+        return reinterpret_cast<T*>(inline_storage);
+    }
+
+    // Spill (or re-spill) to a doubled heap buffer.
+    void grow() {
+        std::size_t const new_capacity = capacity_ * 2;
+        T* const new_data =
+            static_cast<T*>(::operator new(sizeof(T) * new_capacity));
+        for (std::size_t i = 0; i < size_; ++i) {
+            new (new_data + i) T(std::move(data_[i]));
+            data_[i].~T();
+        }
+        if (data_ != inline_data()) {
+            ::operator delete(data_);
+        }
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+public:
+    small_vector() : data_(inline_data()) {}
+
+    small_vector(const small_vector&) = delete;
+    small_vector& operator=(const small_vector&) = delete;
+
+    ~small_vector() {
+        clear();
+        if (data_ != inline_data()) {
+            ::operator delete(data_);
+        }
+    }
+
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    std::size_t size() const { return size_; }
+
+    void push_back(T value) {
+        if (size_ == capacity_) {
+            grow();
+        }
+        new (data_ + size_) T(std::move(value));
+        ++size_;
+    }
+
+    // A bucket is an unordered set of pairs, so erase just moves the
+    // last entry into the hole - O(1), no shifting.
+    void unordered_erase(T* pos) {
+        if (pos != data_ + size_ - 1) {
+            *pos = std::move(data_[size_ - 1]);
+        }
+        data_[size_ - 1].~T();
+        --size_;
+    }
+
+    void clear() {
+        for (std::size_t i = 0; i < size_; ++i) {
+            data_[i].~T();
+        }
+        size_ = 0;
+    }
+};
+
 template<typename Key, typename Value, typename Hash = std::hash<Key>>
 class ThreadSafeLookupTable {
 private:
@@ -19,235 +122,694 @@ private:
     class BucketType {
     private:
         using BucketValue = std::pair<Key, Value>;
-        using BucketData = std::list<BucketValue>;
-        using BucketIterator = typename BucketData::iterator;
-        
+        using BucketData = small_vector<BucketValue, 2>;
+
         BucketData data;                        // Storage for this bucket
         mutable std::shared_mutex mutex;        // Protection for this bucket
-        
-        // Find entry in this bucket - returns iterator
-        BucketIterator find_entry_for(const Key& key) {
+        bool moved = false;                     // Entries migrated to a larger array
+
+        // Find entry in this bucket - a linear scan over contiguous
+        // pairs, which at our bucket sizes beats any cleverer layout
+        BucketValue* find_entry_for(const Key& key) {
             return std::find_if(data.begin(), data.end(),
                 [&](const BucketValue& item) {
                     return item.first == key;
                 });
         }
-        
+
         // Const version for read operations
-        typename BucketData::const_iterator find_entry_for(const Key& key) const {
+        const BucketValue* find_entry_for(const Key& key) const {
             return std::find_if(data.begin(), data.end(),
                 [&](const BucketValue& item) {
                     return item.first == key;
                 });
         }
-        
+
     public:
+        // The accessors return false if this bucket was already migrated;
+        // the caller then retries against the new bucket array.
+
         // Get value with default - read operation uses shared lock
-        Value value_for(const Key& key, const Value& default_value) const {
+        bool value_for(const Key& key, const Value& default_value,
+                       Value& out) const {
             std::shared_lock<std::shared_mutex> lock(mutex);
+            if (moved) {
+                return false;
+            }
             auto found_entry = find_entry_for(key);
-            return (found_entry == data.end()) ? default_value : found_entry->second;
+            out = (found_entry == data.end()) ? default_value
+                                              : found_entry->second;
+            return true;
         }
-        
+
         // Add or update mapping - write operation uses unique lock
-        void add_or_update_mapping(const Key& key, const Value& value) {
+        bool add_or_update_mapping(const Key& key, const Value& value,
+                                   bool& inserted) {
             std::unique_lock<std::shared_mutex> lock(mutex);
+            if (moved) {
+                return false;
+            }
             auto found_entry = find_entry_for(key);
             if (found_entry == data.end()) {
                 // Add new entry
                 data.push_back(BucketValue(key, value));
+                inserted = true;
             } else {
                 // Update existing entry
                 found_entry->second = value;
+                inserted = false;
             }
+            return true;
         }
-        
+
         // Remove mapping - write operation uses unique lock
-        void remove_mapping(const Key& key) {
+        bool remove_mapping(const Key& key, bool& removed) {
             std::unique_lock<std::shared_mutex> lock(mutex);
+            if (moved) {
+                return false;
+            }
             auto found_entry = find_entry_for(key);
-            if (found_entry != data.end()) {
-                data.erase(found_entry);
+            removed = (found_entry != data.end());
+            if (removed) {
+                data.unordered_erase(found_entry);
             }
+            return true;
         }
-        
-        // For snapshot operations - return copy of all data
-        std::list<BucketValue> get_all_data() const {
+
+        // Move every entry to its slot in 'dest' and mark this bucket
+        // migrated. Locks are always taken old bucket -> new bucket and
+        // never the other way round, so this cannot deadlock with the
+        // normal operations above.
+        void migrate_into(std::vector<std::unique_ptr<BucketType>>& dest,
+                          const Hash& hasher) {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            for (auto& item : data) {
+                BucketType& target =
+                    *dest[hasher(item.first) % dest.size()];
+                bool inserted = false;
+                target.add_or_update_mapping(item.first, item.second,
+                                             inserted);
+            }
+            data.clear();
+            moved = true;
+        }
+
+        // Batch accessor: invokes fn(key_index, entry-or-null) for a run
+        // of keys that all hash to this bucket, under ONE shared-lock
+        // acquisition - the per-call lock is what a batched lookup is
+        // amortizing. Returns false if the bucket has migrated; the
+        // caller then retries those keys against the new array.
+        template<typename Fn>
+        bool visit_keys(const std::vector<Key>& keys,
+                        const std::size_t* order, std::size_t count,
+                        Fn&& fn) const {
             std::shared_lock<std::shared_mutex> lock(mutex);
-            return data;
+            if (moved) {
+                return false;
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                std::size_t const key_index = order[i];
+                auto entry = find_entry_for(keys[key_index]);
+                fn(key_index, entry == data.end() ? nullptr : entry);
+            }
+            return true;
         }
-        
-        // Get exclusive lock for cross-bucket operations
-        std::unique_lock<std::shared_mutex> get_lock() {
-            return std::unique_lock<std::shared_mutex>(mutex);
+
+        // For snapshot operations - return copy of all data
+        std::vector<BucketValue> get_all_data() const {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return std::vector<BucketValue>(data.begin(), data.end());
         }
     };
-    
-    std::vector<std::unique_ptr<BucketType>> buckets;  // Bucket array
-    Hash hasher;                                       // Hash function
-    
-    // Get bucket for a given key
-    BucketType& get_bucket(const Key& key) const {
-        std::size_t bucket_index = hasher(key) % buckets.size();
-        return *buckets[bucket_index];
-    }
-    
+
+    std::vector<std::unique_ptr<BucketType>> buckets;       // Current array
+    std::vector<std::unique_ptr<BucketType>> next_buckets;  // Rehash target
+    Hash hasher;                                            // Hash function
+
+    // Shared for every operation, unique only to install or promote a
+    // bucket array - so a rehash never stops readers.
+    mutable std::shared_mutex table_mutex;
+    bool rehashing = false;                      // Guarded by table_mutex
+    std::atomic<std::size_t> rehash_index{0};    // Next old bucket to claim
+    std::atomic<std::size_t> rehash_done{0};     // Old buckets fully migrated
+    std::atomic<std::size_t> entries{0};         // Total mappings
+
+    // RCU-style snapshot support: every mutation bumps 'version'; the
+    // last snapshot built is published through an atomically-swapped
+    // shared_ptr tagged with the version it was built at. Readers of a
+    // snapshot hold it alive by refcount alone, so monitoring code can
+    // iterate a frozen view with no locks while mutations continue.
+    struct Snapshot {
+        std::uint64_t version;
+        std::map<Key, Value> data;
+    };
+    std::atomic<std::uint64_t> version{0};
+    mutable std::shared_ptr<const Snapshot> cached_snapshot;  // atomic_load/store only
+
+    // Grow once the average bucket holds this many entries; value_for
+    // then scans a short list no matter how large the table gets.
+    static constexpr std::size_t max_load_factor = 4;
+    // Old buckets each writer migrates per operation.
+    static constexpr unsigned migrate_step = 2;
+
+    static std::vector<std::unique_ptr<BucketType>> make_buckets(
+        std::size_t count) {
+        std::vector<std::unique_ptr<BucketType>> result(count);
+        for (auto& bucket : result) {
+            bucket = std::make_unique<BucketType>();
+        }
+        return result;
+    }
+
+    // Get bucket for a given key within one of the arrays
+    BucketType& bucket_in(
+        const std::vector<std::unique_ptr<BucketType>>& array,
+        const Key& key) const {
+        return *array[hasher(key) % array.size()];
+    }
+
+    // Writers chip in a couple of old buckets per call while a rehash
+    // is running, claimed by atomic index so no bucket moves twice.
+    // Requires table_mutex held shared.
+    void help_rehash() {
+        for (unsigned step = 0; step < migrate_step; ++step) {
+            std::size_t const i = rehash_index.fetch_add(1);
+            if (i >= buckets.size()) {
+                return;  // Every bucket claimed; stragglers still copying
+            }
+            buckets[i]->migrate_into(next_buckets, hasher);
+            rehash_done.fetch_add(1);
+        }
+    }
+
+    // Install a doubled target array if the load still warrants it.
+    void maybe_start_rehash() {
+        std::unique_lock<std::shared_mutex> lock(table_mutex);
+        if (!rehashing &&
+            entries.load() > max_load_factor * buckets.size()) {
+            next_buckets = make_buckets(buckets.size() * 2);
+            rehash_index.store(0);
+            rehash_done.store(0);
+            rehashing = true;
+        }
+    }
+
+    // Shared core of get_many/contains_many: sorts the key indices by
+    // owning bucket so each touched bucket becomes one contiguous run,
+    // then resolves every run under a single acquisition of that
+    // bucket's lock. Lock acquisitions per batch drop from N keys to
+    // the number of distinct buckets hit. Keys whose bucket migrated
+    // mid-rehash are re-resolved one by one against the new array -
+    // migration is transient and rare, so regrouping there buys nothing.
+    template<typename Fn>
+    void visit_many(const std::vector<Key>& keys, Fn&& fn) const {
+        std::shared_lock<std::shared_mutex> lock(table_mutex);
+
+        // (bucket index, key index), sorted: one run per bucket, and
+        // within a run keys keep a deterministic order.
+        std::vector<std::pair<std::size_t, std::size_t>> order;
+        order.reserve(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            order.emplace_back(hasher(keys[i]) % buckets.size(), i);
+        }
+        std::sort(order.begin(), order.end());
+
+        std::vector<std::size_t> run;
+        for (std::size_t i = 0; i < order.size();) {
+            std::size_t const b = order[i].first;
+            run.clear();
+            for (; i < order.size() && order[i].first == b; ++i) {
+                run.push_back(order[i].second);
+            }
+            if (!buckets[b]->visit_keys(keys, run.data(), run.size(), fn)) {
+                for (std::size_t const k : run) {
+                    bucket_in(next_buckets, keys[k])
+                        .visit_keys(keys, &k, 1, fn);
+                }
+            }
+        }
+    }
+
+    // Promote the new array once every old bucket has migrated. The
+    // unique lock waits out any migration step still holding the table
+    // lock shared.
+    void maybe_finish_rehash() {
+        std::unique_lock<std::shared_mutex> lock(table_mutex);
+        if (rehashing && rehash_done.load() == buckets.size()) {
+            buckets = std::move(next_buckets);
+            next_buckets.clear();
+            rehashing = false;
+        }
+    }
+
 public:
     // Type aliases for STL compatibility
     using key_type = Key;
     using mapped_type = Value;
     using hash_type = Hash;
-    
+
     // Constructor with configurable buckets and hash function
     explicit ThreadSafeLookupTable(
         unsigned num_buckets = 19,
         const Hash& hasher_func = Hash{})
-        : buckets(num_buckets), hasher(hasher_func) {
-        
-        // Initialize all buckets
-        for (unsigned i = 0; i < num_buckets; ++i) {
-            buckets[i] = std::make_unique<BucketType>();
-        }
-    }
-    
+        : buckets(make_buckets(num_buckets)), hasher(hasher_func) {}
+
     // Delete copy operations for thread safety
     ThreadSafeLookupTable(const ThreadSafeLookupTable&) = delete;
     ThreadSafeLookupTable& operator=(const ThreadSafeLookupTable&) = delete;
-    
-    // Main interface functions - delegate to appropriate bucket
+
+    // Main interface functions - route to the bucket in the current
+    // array, falling through to the new array if that bucket has
+    // already migrated.
     Value value_for(const Key& key, const Value& default_value = Value{}) const {
-        return get_bucket(key).value_for(key, default_value);
+        std::shared_lock<std::shared_mutex> lock(table_mutex);
+        // Seeded with the default, not default-constructed: both probes
+        // reporting "moved" cannot happen, but this keeps that path
+        // returning something defined - and keeps Value free of any
+        // default-constructibility requirement the original API never had.
+        Value out = default_value;
+        if (!bucket_in(buckets, key).value_for(key, default_value, out)) {
+            bucket_in(next_buckets, key).value_for(key, default_value, out);
+        }
+        return out;
+    }
+
+    // Batch lookup: resolves every key with one lock acquisition per
+    // distinct bucket touched instead of one per key. out[i] holds the
+    // value for keys[i], or default_value if absent. Per-bucket
+    // consistent (like snapshot()), not a point-in-time cut across keys.
+    void get_many(const std::vector<Key>& keys, std::vector<Value>& out,
+                  const Value& default_value = Value{}) const {
+        out.assign(keys.size(), default_value);
+        visit_many(keys, [&](std::size_t i, const auto* entry) {
+            if (entry) {
+                out[i] = entry->second;
+            }
+        });
     }
-    
+
+    // Batch membership, same locking shape; out[i] is nonzero when
+    // keys[i] is present (char, not bool - vector<bool> bit slots
+    // cannot be written from the visitor without proxy churn).
+    void contains_many(const std::vector<Key>& keys,
+                       std::vector<char>& out) const {
+        out.assign(keys.size(), 0);
+        visit_many(keys, [&](std::size_t i, const auto* entry) {
+            out[i] = entry != nullptr;
+        });
+    }
+
     void add_or_update_mapping(const Key& key, const Value& value) {
-        get_bucket(key).add_or_update_mapping(key, value);
+        bool grow = false;
+        bool finish = false;
+        {
+            std::shared_lock<std::shared_mutex> lock(table_mutex);
+            if (rehashing) {
+                help_rehash();
+            }
+            bool inserted = false;
+            if (!bucket_in(buckets, key).add_or_update_mapping(key, value,
+                                                               inserted)) {
+                bucket_in(next_buckets, key).add_or_update_mapping(
+                    key, value, inserted);
+            }
+            if (inserted) {
+                entries.fetch_add(1);
+            }
+            version.fetch_add(1);  // Updates change values too
+            finish = rehashing && rehash_done.load() == buckets.size();
+            grow = !rehashing &&
+                   entries.load() > max_load_factor * buckets.size();
+        }
+        // The unique-lock steps happen outside the shared lock.
+        if (finish) {
+            maybe_finish_rehash();
+        } else if (grow) {
+            maybe_start_rehash();
+        }
     }
-    
+
     void remove_mapping(const Key& key) {
-        get_bucket(key).remove_mapping(key);
+        bool finish = false;
+        {
+            std::shared_lock<std::shared_mutex> lock(table_mutex);
+            if (rehashing) {
+                help_rehash();
+            }
+            bool removed = false;
+            if (!bucket_in(buckets, key).remove_mapping(key, removed)) {
+                bucket_in(next_buckets, key).remove_mapping(key, removed);
+            }
+            if (removed) {
+                entries.fetch_sub(1);
+                version.fetch_add(1);
+            }
+            finish = rehashing && rehash_done.load() == buckets.size();
+        }
+        if (finish) {
+            maybe_finish_rehash();
+        }
     }
-    
-    // Snapshot function - implementation from Listing 6.12
-    // Locks all buckets in order to prevent deadlock
+
+    // Snapshot function - implementation from Listing 6.12, adapted:
+    // holding the table lock uniquely excludes every other operation
+    // (they all take it shared first), which also pauses migration, so
+    // the two arrays together form a consistent snapshot.
     std::map<Key, Value> get_map() const {
-        // Lock all buckets in order
-        std::vector<std::unique_lock<std::shared_mutex>> locks;
-        for (unsigned i = 0; i < buckets.size(); ++i) {
-            locks.push_back(buckets[i]->get_lock());
-        }
-        
-        // Collect all data from all buckets
+        std::unique_lock<std::shared_mutex> lock(table_mutex);
+
         std::map<Key, Value> result;
-        for (unsigned i = 0; i < buckets.size(); ++i) {
-            auto bucket_data = buckets[i]->get_all_data();
-            for (const auto& item : bucket_data) {
+        for (const auto& bucket : buckets) {
+            for (const auto& item : bucket->get_all_data()) {
+                result.insert(item);
+            }
+        }
+        for (const auto& bucket : next_buckets) {
+            for (const auto& item : bucket->get_all_data()) {
                 result.insert(item);
             }
         }
-        
         return result;
     }
-    
+
+    // A consistent frozen view, built at most once per table version:
+    // repeated calls on an unchanged table hand out the SAME map by
+    // refcount, and iterating it never takes a lock, so writers keep
+    // running while monitoring code walks the view. Unlike get_map,
+    // building it locks one bucket at a time (shared), so the copy is
+    // per-bucket consistent rather than a single point-in-time cut -
+    // use get_map when strict consistency across keys matters.
+    std::shared_ptr<const std::map<Key, Value>> snapshot() const {
+        std::shared_ptr<const Snapshot> cached =
+            std::atomic_load(&cached_snapshot);
+        // Read the version BEFORE copying: a mutation racing the copy
+        // then simply leaves the new snapshot already stale, and the
+        // next call rebuilds.
+        std::uint64_t const current = version.load();
+        if (cached && cached->version == current) {
+            return std::shared_ptr<const std::map<Key, Value>>(
+                cached, &cached->data);
+        }
+
+        auto fresh = std::make_shared<Snapshot>();
+        fresh->version = current;
+        {
+            std::shared_lock<std::shared_mutex> lock(table_mutex);
+            for (const auto& bucket : buckets) {
+                for (const auto& item : bucket->get_all_data()) {
+                    fresh->data.insert(item);
+                }
+            }
+            for (const auto& bucket : next_buckets) {
+                for (const auto& item : bucket->get_all_data()) {
+                    fresh->data.insert(item);
+                }
+            }
+        }
+        std::atomic_store(&cached_snapshot,
+                          std::shared_ptr<const Snapshot>(fresh));
+        return std::shared_ptr<const std::map<Key, Value>>(
+            std::shared_ptr<const Snapshot>(fresh), &fresh->data);
+    }
+
+    // Read through the snapshot instead of the bucket locks. In a
+    // read-mostly deployment (the scenario 03_12 motivates) the cached
+    // view is almost always current, so this is lock-free at the cost
+    // of observing a value at most one mutation behind.
+    Value cached_value_for(const Key& key,
+                           const Value& default_value = Value{}) const {
+        auto view = snapshot();
+        auto found = view->find(key);
+        return found == view->end() ? default_value : found->second;
+    }
+
     // Utility functions
     size_t bucket_count() const {
-        return buckets.size();
+        std::shared_lock<std::shared_mutex> lock(table_mutex);
+        return rehashing ? next_buckets.size() : buckets.size();
     }
-    
-    // Get approximate size (without locking all buckets)
-    size_t approximate_size() const {
-        size_t total = 0;
-        for (const auto& bucket : buckets) {
-            // This is approximate since we're not locking
-            total += bucket->get_all_data().size();
-        }
-        return total;
+
+    // Exact and O(1) now that insert/remove maintain a counter.
+    size_t size() const {
+        return entries.load();
     }
 };
 
 // Demonstration of concurrent usage
-void concurrent_writer(ThreadSafeLookupTable<std::string, int>& table, 
+void concurrent_writer(ThreadSafeLookupTable<std::string, int>& table,
                       int thread_id, int operations) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<> dis(1, 100);
-    
+
     for (int i = 0; i < operations; ++i) {
         std::string key = "key_" + std::to_string(thread_id) + "_" + std::to_string(i);
         int value = dis(gen);
         table.add_or_update_mapping(key, value);
-        
+
         // Occasional removal
         if (i % 5 == 0 && i > 0) {
             std::string old_key = "key_" + std::to_string(thread_id) + "_" + std::to_string(i-5);
             table.remove_mapping(old_key);
         }
-        
+
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 }
 
-void concurrent_reader(const ThreadSafeLookupTable<std::string, int>& table, 
+void concurrent_reader(const ThreadSafeLookupTable<std::string, int>& table,
                       int thread_id, int operations) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<> dis(0, 2);
-    
+
     for (int i = 0; i < operations; ++i) {
         // Read from different threads' keys
         int target_thread = dis(gen);
         std::string key = "key_" + std::to_string(target_thread) + "_" + std::to_string(i % 10);
         int value = table.value_for(key, -1);
-        
+
         if (value != -1) {
             std::cout << "Reader " << thread_id << " found " << key << " = " << value << std::endl;
         }
-        
+
         std::this_thread::sleep_for(std::chrono::milliseconds(15));
     }
 }
 
 int main() {
     std::cout << "=== Complete Thread-Safe Lookup Table Demo ===" << std::endl;
-    
+
     // Create lookup table with moderate number of buckets
     ThreadSafeLookupTable<std::string, int> lookup_table(13);
-    
+
     std::cout << "Created lookup table with " << lookup_table.bucket_count() << " buckets" << std::endl;
-    
+
     // Add some initial data
     std::cout << "\n--- Adding initial data ---" << std::endl;
     for (int i = 0; i < 10; ++i) {
         lookup_table.add_or_update_mapping("init_" + std::to_string(i), i * 10);
     }
-    
+
     std::cout << "\n--- Starting concurrent access test ---" << std::endl;
-    
+
     // Create concurrent threads
     std::vector<std::thread> threads;
-    
+
     // Start writer threads
     for (int i = 0; i < 3; ++i) {
         threads.emplace_back(concurrent_writer, std::ref(lookup_table), i, 20);
     }
-    
+
     // Start reader threads
     for (int i = 0; i < 2; ++i) {
         threads.emplace_back(concurrent_reader, std::cref(lookup_table), i + 10, 30);
     }
-    
+
     // Wait for all threads to complete
     for (auto& t : threads) {
         t.join();
     }
-    
+
     std::cout << "\n--- Final state snapshot ---" << std::endl;
     auto final_state = lookup_table.get_map();
-    
+
     std::cout << "Final table contains " << final_state.size() << " entries:" << std::endl;
     for (const auto& pair : final_state) {
         std::cout << "  " << pair.first << " -> " << pair.second << std::endl;
     }
-    
+
+    // Growth test: hammer a small table from several writers while
+    // readers keep verifying, then check that every key survived the
+    // rehashes and the bucket array actually grew.
+    std::cout << "\n--- Concurrent growth test ---" << std::endl;
+    ThreadSafeLookupTable<std::string, int> growing_table(8);
+    std::cout << "Starting buckets: " << growing_table.bucket_count() << std::endl;
+
+    int const writers = 4;
+    int const keys_per_writer = 5000;
+    std::atomic<bool> stop_readers(false);
+    std::atomic<long long> reads_done(0);
+
+    std::vector<std::thread> growth_threads;
+    for (int w = 0; w < writers; ++w) {
+        growth_threads.emplace_back([&growing_table, w] {
+            for (int i = 0; i < keys_per_writer; ++i) {
+                growing_table.add_or_update_mapping(
+                    "grow_" + std::to_string(w) + "_" + std::to_string(i),
+                    w * keys_per_writer + i);
+            }
+        });
+    }
+    for (int r = 0; r < 2; ++r) {
+        growth_threads.emplace_back([&, r] {
+            std::mt19937 gen(r + 1);
+            std::uniform_int_distribution<> writer_dis(0, writers - 1);
+            std::uniform_int_distribution<> key_dis(0, keys_per_writer - 1);
+            while (!stop_readers.load()) {
+                int const w = writer_dis(gen);
+                int const i = key_dis(gen);
+                int const value = growing_table.value_for(
+                    "grow_" + std::to_string(w) + "_" + std::to_string(i), -1);
+                // Not-yet-written keys report the default; anything else
+                // must be the exact value its writer stored.
+                if (value != -1 && value != w * keys_per_writer + i) {
+                    std::cout << "READ ERROR: wrong value " << value << std::endl;
+                }
+                reads_done.fetch_add(1);
+            }
+        });
+    }
+    for (int w = 0; w < writers; ++w) {
+        growth_threads[w].join();
+    }
+    stop_readers.store(true);
+    for (size_t t = writers; t < growth_threads.size(); ++t) {
+        growth_threads[t].join();
+    }
+
+    int missing = 0;
+    for (int w = 0; w < writers; ++w) {
+        for (int i = 0; i < keys_per_writer; ++i) {
+            if (growing_table.value_for(
+                    "grow_" + std::to_string(w) + "_" + std::to_string(i),
+                    -1) != w * keys_per_writer + i) {
+                ++missing;
+            }
+        }
+    }
+    std::cout << "Inserted " << writers * keys_per_writer << " keys, size() = "
+              << growing_table.size() << ", missing after growth: " << missing
+              << std::endl;
+    std::cout << "Final buckets: " << growing_table.bucket_count()
+              << " (reads during growth: " << reads_done.load() << ")"
+              << std::endl;
+
+    // Batch lookup test: get_many must agree with per-key value_for on
+    // a mixed present/absent batch, and the batched form should beat
+    // the per-key loop on lock traffic (one acquisition per distinct
+    // bucket instead of one per key).
+    std::cout << "\n--- Batch lookup test ---" << std::endl;
+    {
+        std::vector<std::string> batch;
+        for (int i = 0; i < 1000; ++i) {
+            // Even entries exist (writer 0 keys), odd ones do not.
+            batch.push_back(i % 2 == 0
+                                ? "grow_0_" + std::to_string(i)
+                                : "missing_" + std::to_string(i));
+        }
+
+        std::vector<int> values;
+        growing_table.get_many(batch, values, -1);
+        std::vector<char> present;
+        growing_table.contains_many(batch, present);
+
+        int mismatches = 0;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            int const single = growing_table.value_for(batch[i], -1);
+            if (values[i] != single ||
+                present[i] != (single != -1)) {
+                ++mismatches;
+            }
+        }
+        std::cout << "get_many/contains_many vs value_for on "
+                  << batch.size() << " keys: " << mismatches
+                  << " mismatches (expected 0)" << std::endl;
+
+        int const rounds = 2000;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            growing_table.get_many(batch, values, -1);
+        }
+        double const batched = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < batch.size(); ++i) {
+                values[i] = growing_table.value_for(batch[i], -1);
+            }
+        }
+        double const per_key = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "1000-key batch x " << rounds << ": batched "
+                  << batched << " s, per-key " << per_key << " s ("
+                  << per_key / batched << "x)" << std::endl;
+        if (std::thread::hardware_concurrency() <= 1) {
+            // An uncontended shared_lock is a couple of atomic ops, so
+            // with nobody else running the sort-and-group overhead can
+            // eat the saving; the batch pays off when bucket locks are
+            // actually contended by writers on other cores.
+            std::cout << "(single hardware thread: locks are uncontended, "
+                         "expect ~1x)" << std::endl;
+        }
+    }
+
+    // Snapshot test: a frozen view stays stable and iterable without
+    // locks while a writer keeps mutating, and an unchanged table hands
+    // out the same snapshot object again instead of re-copying.
+    std::cout << "\n--- Lock-free snapshot test ---" << std::endl;
+    ThreadSafeLookupTable<std::string, int> snap_table(8);
+    for (int i = 0; i < 100; ++i) {
+        snap_table.add_or_update_mapping("snap_" + std::to_string(i), i);
+    }
+
+    std::atomic<bool> writer_done(false);
+    std::thread snap_writer([&] {
+        for (int i = 100; i < 5000; ++i) {
+            snap_table.add_or_update_mapping("snap_" + std::to_string(i), i);
+        }
+        writer_done.store(true);
+    });
+
+    auto frozen = snap_table.snapshot();
+    size_t const frozen_size = frozen->size();
+    long long frozen_sum = 0;
+    while (!writer_done.load()) {
+        // Iterate the frozen view repeatedly while the writer runs; it
+        // must never change under us.
+        frozen_sum = 0;
+        for (const auto& pair : *frozen) {
+            frozen_sum += pair.second;
+        }
+        if (frozen->size() != frozen_size) {
+            std::cout << "SNAPSHOT ERROR: view changed during iteration"
+                      << std::endl;
+        }
+    }
+    snap_writer.join();
+
+    std::cout << "Frozen view held " << frozen_size
+              << " entries throughout (sum " << frozen_sum
+              << "); live table now has " << snap_table.size() << std::endl;
+
+    auto after1 = snap_table.snapshot();
+    auto after2 = snap_table.snapshot();
+    std::cout << "Snapshot after writes sees " << after1->size()
+              << " entries; repeat call reuses it: "
+              << (after1.get() == after2.get() ? "yes" : "NO") << std::endl;
+    std::cout << "cached_value_for(\"snap_4999\") = "
+              << snap_table.cached_value_for("snap_4999", -1) << std::endl;
+
     return 0;
 }
 
@@ -256,9 +818,12 @@ Complete Implementation Features:
 1. Fine-grained locking per bucket
 2. Shared mutex for reader/writer concurrency within buckets
 3. Hash-based bucket assignment
-4. Exception-safe operations
-5. Consistent snapshot functionality
-6. STL-compatible interface
+4. Incremental concurrent resizing (doubling) above a load factor
+5. Exception-safe operations
+6. Consistent snapshot functionality
+7. STL-compatible interface
+8. Batch lookup (get_many/contains_many): one lock acquisition per
+   distinct bucket touched instead of one per key
 
 Exception Safety Analysis:
 - value_for: No modifications, exception-safe
@@ -267,13 +832,22 @@ Exception Safety Analysis:
 
 Performance Characteristics:
 - O(1) average case for all operations (good hash function assumed)
-- N-fold concurrency improvement (N = bucket count)
-- Reader operations can proceed concurrently within same bucket
+- Load factor capped at 4, so per-bucket scans stay short at any size
+- Buckets store contiguous pairs with inline capacity for 2 entries:
+  probes stay within a cache line or two and the typical insert or
+  remove performs no allocation
+- Rehashing amortized over writers, ~2 old buckets per operation
+- Readers never blocked by a rehash, only by their own bucket's writer
 - Operations on different buckets are fully concurrent
 
 Threading Model:
+- Snapshots are immutable and shared by refcount: iteration is
+  lock-free and never blocks or observes mutations
 - Each bucket can have multiple readers OR one writer
 - Different buckets can be accessed simultaneously
-- Snapshot operation requires exclusive access to all buckets
-- Deadlock prevention through consistent bucket locking order
-*/
\ No newline at end of file
+- Table lock is shared for every operation; only array install/promote
+  takes it uniquely, and both are O(bucket count) pointer moves
+- Migration locks old bucket before new bucket, never the reverse,
+  so bucket locks cannot deadlock
+- Snapshot operation excludes everything via the unique table lock
+*/
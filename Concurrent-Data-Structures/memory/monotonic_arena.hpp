@@ -0,0 +1,177 @@
+#ifndef CDS_MONOTONIC_ARENA_HPP
+#define CDS_MONOTONIC_ARENA_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// monotonic_arena: bump allocation for short-lived same-lifetime objects.
+//
+// Several hot paths allocate thousands of small objects that all die at
+// the same moment: the tokens of one file, the scratch sets of one graph
+// traversal, the postings of one document. Paying malloc/free per object
+// there buys individual lifetimes nobody uses - and the frees alone can
+// dominate an allocation-bound phase. The arena model matches the actual
+// lifetime: allocation is a pointer bump into a large slab, nothing is
+// ever freed individually, and one reset() retires the whole batch.
+//
+// reset() rewinds but RETAINS the slabs, so a per-file / per-operation
+// arena reaches a steady state where entire batches allocate without a
+// single call into malloc. release() gives the memory back.
+//
+// Not thread-safe: one arena belongs to one thread (or one critical
+// section) at a time, which is exactly the per-worker scratch shape it
+// exists for. Nothing is destructed by reset() - only use it for
+// trivially destructible payloads, or via containers whose elements are
+// destroyed before the reset (the arena_allocator pattern below).
+
+namespace cds
+{
+
+class monotonic_arena
+{
+public:
+    // slab_bytes is the granularity of slab growth; a request larger
+    // than it simply gets a dedicated slab of its own size.
+    explicit monotonic_arena(std::size_t slab_bytes = 64 * 1024)
+        : slab_bytes_(slab_bytes)
+    {
+    }
+
+    monotonic_arena(const monotonic_arena&) = delete;
+    monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+    // Bump-allocates 'bytes' aligned to 'align' (at most
+    // alignof(max_align_t) - slabs come from new[], which guarantees no
+    // more). Walks into the next retained slab, or grows, when the
+    // current one is exhausted.
+    void* allocate(std::size_t bytes,
+                   std::size_t align = alignof(std::max_align_t))
+    {
+        while (current_ < slabs_.size())
+        {
+            std::size_t const aligned = (used_ + (align - 1)) & ~(align - 1);
+            if (aligned + bytes <= slabs_[current_].size)
+            {
+                used_ = aligned + bytes;
+                return slabs_[current_].data.get() + aligned;
+            }
+            ++current_;  // Slab exhausted; try the next retained one
+            used_ = 0;
+        }
+        std::size_t const size = bytes > slab_bytes_ ? bytes : slab_bytes_;
+        slabs_.push_back({std::make_unique<char[]>(size), size});
+        allocated_ += size;
+        used_ = bytes;
+        return slabs_.back().data.get();
+    }
+
+    // Copies 'bytes' into the arena and returns a view of the copy,
+    // stable until reset()/release() - the string-interning shape.
+    std::string_view copy(std::string_view bytes)
+    {
+        char* dest = static_cast<char*>(allocate(bytes.size(), 1));
+        std::memcpy(dest, bytes.data(), bytes.size());
+        return std::string_view(dest, bytes.size());
+    }
+
+    // Rewinds to empty, keeping every slab for reuse: the one "free" of
+    // the batch model. Everything previously allocated is dead.
+    void reset()
+    {
+        current_ = 0;
+        used_ = 0;
+    }
+
+    // Frees the slabs too, for clear()-style teardown paths.
+    void release()
+    {
+        slabs_.clear();
+        current_ = 0;
+        used_ = 0;
+        allocated_ = 0;
+    }
+
+    // Total bytes held in slabs (used or not), for memory accounting.
+    std::size_t allocated_bytes() const { return allocated_; }
+
+private:
+    struct slab
+    {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    std::vector<slab> slabs_;
+    std::size_t current_ = 0;  // Slab currently being bumped into
+    std::size_t used_ = 0;     // Bytes consumed of that slab
+    std::size_t slab_bytes_;
+    std::size_t allocated_ = 0;
+};
+
+// Minimal std-compatible adapter, so standard containers can do their
+// scratch work in an arena: vector, unordered_set and friends allocate
+// with a pointer bump and their deallocate becomes a no-op (the arena's
+// reset is the real free). The container must still be destroyed (or
+// cleared) before the arena is reset - reset does not run destructors.
+template<typename T>
+class arena_allocator
+{
+public:
+    using value_type = T;
+
+    // Moved-from and empty containers propagate their source's allocator
+    // instead of element-wise copying into the target's - required for
+    // arena-backed values inside ordinary (default-allocated) containers.
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    // An arena-less adapter: never allocates validly. Exists so an empty
+    // arena-backed container can be default-constructed (an empty map
+    // slot, a moved-from value); any real allocation must come from a
+    // container built with the arena-taking constructor.
+    arena_allocator() noexcept = default;
+
+    explicit arena_allocator(monotonic_arena& arena) noexcept
+        : arena_(&arena)
+    {
+    }
+
+    template<typename U>
+    arena_allocator(const arena_allocator<U>& other) noexcept
+        : arena_(other.arena_)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept {}  // reset() is the free
+
+    template<typename U>
+    bool operator==(const arena_allocator<U>& other) const noexcept
+    {
+        return arena_ == other.arena_;
+    }
+
+    template<typename U>
+    bool operator!=(const arena_allocator<U>& other) const noexcept
+    {
+        return arena_ != other.arena_;
+    }
+
+private:
+    template<typename U>
+    friend class arena_allocator;
+
+    monotonic_arena* arena_ = nullptr;
+};
+
+} // namespace cds
+
+#endif // CDS_MONOTONIC_ARENA_HPP
@@ -0,0 +1,242 @@
+#ifndef CDS_SMALL_VECTOR_HPP
+#define CDS_SMALL_VECTOR_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// small_vector<T, N>: a vector whose first N elements live inline.
+//
+// std::vector pays a heap allocation for its very first element, and on
+// hot paths that deal in SMALL collections - a task's dependency list,
+// the handful of tasks one completion unblocks, the tokens of one line -
+// that allocation (and the free behind it) is most of the cost. The
+// collections are small by construction: >90% of scheduled tasks carry
+// 0-4 dependencies, a line of text is a couple dozen tokens. Sizing N to
+// the common case makes those paths allocation-free entirely; the rare
+// large instance spills to the heap and behaves like a plain vector from
+// then on.
+//
+// Deliberately the vector subset the hot paths use: push/emplace/pop,
+// clear, reserve, indexing and contiguous iteration. No insert/erase in
+// the middle - nothing here needs it, and leaving it out keeps the
+// header honest about what has been exercised. Moving a spilled
+// small_vector steals the heap block (cheap); moving an inline one moves
+// the elements (still no allocation).
+
+namespace cds
+{
+
+template<typename T, std::size_t N>
+class small_vector
+{
+    static_assert(N > 0, "inline capacity must be at least one element");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    small_vector() = default;
+
+    small_vector(std::initializer_list<T> init)
+    {
+        reserve(init.size());
+        for (const T& v : init)
+        {
+            push_back(v);
+        }
+    }
+
+    small_vector(const small_vector& other)
+    {
+        reserve(other.size_);
+        for (std::size_t i = 0; i < other.size_; ++i)
+        {
+            push_back(other.data_[i]);
+        }
+    }
+
+    small_vector(small_vector&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value)
+    {
+        steal_or_move(std::move(other));
+    }
+
+    small_vector& operator=(const small_vector& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            reserve(other.size_);
+            for (std::size_t i = 0; i < other.size_; ++i)
+            {
+                push_back(other.data_[i]);
+            }
+        }
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value)
+    {
+        if (this != &other)
+        {
+            destroy_all();
+            steal_or_move(std::move(other));
+        }
+        return *this;
+    }
+
+    ~small_vector() { destroy_all(); }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (size_ == capacity_)
+        {
+            grow(capacity_ * 2);
+        }
+        T* slot = data_ + size_;
+        ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void pop_back()
+    {
+        --size_;
+        data_[size_].~T();
+    }
+
+    // Destroys the elements but keeps the current storage - inline or
+    // spilled - so a buffer reused per batch stops allocating once warm
+    // (the same contract std::vector::clear gives).
+    void clear()
+    {
+        for (std::size_t i = size_; i > 0; --i)
+        {
+            data_[i - 1].~T();
+        }
+        size_ = 0;
+    }
+
+    void reserve(std::size_t wanted)
+    {
+        if (wanted > capacity_)
+        {
+            grow(wanted);
+        }
+    }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    // True while the elements still sit in the inline buffer (exposed
+    // mostly so callers can assert their sizing assumption holds).
+    bool is_inline() const { return data_ == inline_data(); }
+
+    T& operator[](std::size_t i) { return data_[i]; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+    const_iterator cbegin() const { return data_; }
+    const_iterator cend() const { return data_ + size_; }
+
+private:
+    T* inline_data()
+    {
+        return reinterpret_cast<T*>(inline_storage_);
+    }
+    const T* inline_data() const
+    {
+        return reinterpret_cast<const T*>(inline_storage_);
+    }
+
+    void destroy_all()
+    {
+        clear();
+        if (!is_inline())
+        {
+            ::operator delete(data_, std::align_val_t(alignof(T)));
+        }
+        data_ = inline_data();
+        capacity_ = N;
+    }
+
+    // Move construction/assignment: adopt a spilled source's heap block
+    // wholesale, or move element-wise out of its inline buffer. Either
+    // way the source is left empty and inline.
+    void steal_or_move(small_vector&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value)
+    {
+        if (!other.is_inline())
+        {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            size_ = other.size_;
+        }
+        else
+        {
+            data_ = inline_data();
+            capacity_ = N;
+            size_ = other.size_;
+            for (std::size_t i = 0; i < size_; ++i)
+            {
+                ::new (static_cast<void*>(data_ + i))
+                    T(std::move(other.data_[i]));
+                other.data_[i].~T();
+            }
+        }
+        other.data_ = other.inline_data();
+        other.capacity_ = N;
+        other.size_ = 0;
+    }
+
+    // Spills (or re-spills) to a heap block of at least 'wanted'
+    // elements. Elements are moved, never copied - the one place this
+    // matters is move-only payloads like shared_ptr-of-task lists.
+    void grow(std::size_t wanted)
+    {
+        std::size_t const new_capacity = wanted > 2 * N ? wanted : 2 * N;
+        T* fresh = static_cast<T*>(
+            ::operator new(new_capacity * sizeof(T), std::align_val_t(alignof(T))));
+        for (std::size_t i = 0; i < size_; ++i)
+        {
+            ::new (static_cast<void*>(fresh + i)) T(std::move(data_[i]));
+            data_[i].~T();
+        }
+        if (!is_inline())
+        {
+            ::operator delete(data_, std::align_val_t(alignof(T)));
+        }
+        data_ = fresh;
+        capacity_ = new_capacity;
+    }
+
+    alignas(T) unsigned char inline_storage_[N * sizeof(T)];
+    T* data_ = inline_data();
+    std::size_t size_ = 0;
+    std::size_t capacity_ = N;
+};
+
+} // namespace cds
+
+#endif // CDS_SMALL_VECTOR_HPP
@@ -0,0 +1,150 @@
+#ifndef MPMC_BOUNDED_QUEUE_HPP
+#define MPMC_BOUNDED_QUEUE_HPP
+
+#include "../sync/padded.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Bounded multi-producer/multi-consumer FIFO ring (Dmitry Vyukov's design).
+//
+// Unlike the teaching queues in this directory, this header is meant to be
+// included by the other projects in this repository (the scheduler's ready
+// path and the indexer's pipeline queue both sit on it), so it lives in a
+// namespace and carries no demo code - see mpmc_bounded_queue_demo.cpp for
+// the walkthrough and the stress tests.
+//
+// How it works: every cell carries a sequence number that encodes, for the
+// current lap around the ring, whether the cell is free (sequence == its
+// position) or occupied (sequence == position + 1). A producer claims a
+// free cell by CAS on the enqueue counter, writes its data, then bumps the
+// cell's sequence to publish it; a consumer mirrors this on the dequeue
+// counter and releases the cell for the next lap. Both operations are one
+// CAS in the uncontended case - no locks, no node allocation, and failure
+// (full/empty) is detected from the sequence without touching the other
+// side's counter.
+//
+// Layout notes:
+//   - the enqueue and dequeue counters live on separate cache lines, so
+//     producers and consumers do not false-share;
+//   - each cell is padded to a cache line too: neighbouring cells are
+//     written by different threads within the same lap, and for small T
+//     several of them would otherwise share a line and ping-pong it.
+//
+// The capacity is fixed at construction (rounded up to a power of two).
+// try_push reports failure when the ring is full so callers can apply
+// backpressure or fall back to an overflow path.
+namespace cds {
+
+template<typename T>
+class mpmc_bounded_queue {
+private:
+    static constexpr std::size_t cache_line = kCacheLineSize;
+
+    struct alignas(cache_line) cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    std::size_t mask_;
+    std::unique_ptr<cell[]> cells_;
+
+    padded<std::atomic<std::size_t>> enqueue_pos_;
+    padded<std::atomic<std::size_t>> dequeue_pos_;
+
+public:
+    explicit mpmc_bounded_queue(std::size_t capacity = 65536)
+        : enqueue_pos_(0)
+        , dequeue_pos_(0)
+    {
+        std::size_t cap = 2;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        mask_ = cap - 1;
+        cells_ = std::make_unique<cell[]>(cap);
+        for (std::size_t i = 0; i < cap; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpmc_bounded_queue(const mpmc_bounded_queue&) = delete;
+    mpmc_bounded_queue& operator=(const mpmc_bounded_queue&) = delete;
+
+    // Returns false (leaving item untouched) if the ring is full.
+    bool try_push(T&& item) {
+        cell* c;
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            c = &cells_[pos & mask_];
+            std::size_t seq = c->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) -
+                                 static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                // Cell is free for this lap - try to claim it.
+                if (enqueue_pos_.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Full - the consumer hasn't freed this cell yet
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        c->data = std::move(item);
+        // Publish: consumers wait for sequence == pos + 1.
+        c->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Returns false if the ring is empty.
+    bool try_pop(T& item) {
+        cell* c;
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            c = &cells_[pos & mask_];
+            std::size_t seq = c->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) -
+                                 static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Empty - no producer has filled this cell
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        item = std::move(c->data);
+        // Free the cell for the producers' next lap.
+        c->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate - racy by nature, for monitoring only.
+    std::size_t size_approx() const {
+        std::size_t e = enqueue_pos_.load(std::memory_order_relaxed);
+        std::size_t d = dequeue_pos_.load(std::memory_order_relaxed);
+        return e > d ? e - d : 0;
+    }
+
+    std::size_t capacity() const {
+        return mask_ + 1;
+    }
+};
+
+} // namespace cds
+
+#endif // MPMC_BOUNDED_QUEUE_HPP
@@ -0,0 +1,630 @@
+#include "mpmc_bounded_queue.hpp"
+#include "../reclamation/hazard_pointer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Contended-throughput benchmark comparing the queue variants in this
+// directory, so deployment choices (and future queue changes) are
+// judged by numbers instead of folklore. For each variant it measures,
+// under configurable producer/consumer counts and payload sizes:
+//
+//   - throughput (operations per second, one push + one pop = 2 ops);
+//   - p99 latency of push and of successful pop (sampled every 32nd
+//     operation to keep the clock out of the hot path);
+//   - allocator traffic (global operator new count per item).
+//
+// Output is CSV on stdout ('#' lines are comments), one row per
+// (queue, payload, mix) combination:
+//
+//     queue,payload_bytes,producers,consumers,items,ops_per_sec,p99_push_ns,p99_pop_ns,allocs_per_item
+//
+// Usage: queue_benchmark [producers consumers [items_per_producer]]
+// With no arguments a default sweep of thread mixes is run.
+//
+// The demo files own the canonical, commented implementations; this
+// harness carries condensed copies of the locked designs (their
+// classes live in .cpp files with mains) and includes the shared
+// headers for the lock-free ones. Variants 1, 2 and 4 share one
+// design - std::queue under a single mutex with a condition variable -
+// and appear as the single 'coarse_mutex' entry. All consumers drain
+// via try_pop with yield, so the comparison isolates the queue itself
+// rather than mixing in different wait strategies.
+
+// ---------------------------------------------------------------------------
+// Allocation counting: every global new/delete in the process ticks a
+// counter, and each run reports the delta across its working phase.
+// ---------------------------------------------------------------------------
+
+std::atomic<long long> allocation_count(0);
+
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// ---------------------------------------------------------------------------
+// The contenders, behind one push / try_pop interface.
+// ---------------------------------------------------------------------------
+
+// Variants 1/2/4: std::queue under one mutex. push keeps the
+// notify_one those variants pay for their blocking consumers.
+template<typename T>
+class coarse_mutex_queue
+{
+    mutable std::mutex mut;
+    std::queue<T> data_queue;
+    std::condition_variable data_cond;
+
+public:
+    static const char* name() { return "coarse_mutex"; }
+
+    void push(T new_value)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        data_queue.push(std::move(new_value));
+        data_cond.notify_one();
+    }
+
+    bool try_pop(T& value)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        if (data_queue.empty())
+        {
+            return false;
+        }
+        value = std::move(data_queue.front());
+        data_queue.pop();
+        return true;
+    }
+};
+
+// Variant 3: dummy-node queue with separate head and tail mutexes.
+template<typename T>
+class fine_locked_queue
+{
+    struct node
+    {
+        std::shared_ptr<T> data;
+        std::unique_ptr<node> next;
+    };
+
+    std::mutex head_mutex;
+    std::unique_ptr<node> head;
+    std::mutex tail_mutex;
+    node* tail;
+
+    node* get_tail()
+    {
+        std::lock_guard<std::mutex> tail_lock(tail_mutex);
+        return tail;
+    }
+
+public:
+    static const char* name() { return "fine_locked"; }
+
+    fine_locked_queue() : head(new node), tail(head.get()) {}
+
+    void push(T new_value)
+    {
+        std::shared_ptr<T> new_data(std::make_shared<T>(std::move(new_value)));
+        std::unique_ptr<node> p(new node);
+        node* const new_tail = p.get();
+        std::lock_guard<std::mutex> tail_lock(tail_mutex);
+        tail->data = new_data;
+        tail->next = std::move(p);
+        tail = new_tail;
+    }
+
+    bool try_pop(T& value)
+    {
+        std::unique_ptr<node> old_head;
+        {
+            std::lock_guard<std::mutex> head_lock(head_mutex);
+            if (head.get() == get_tail())
+            {
+                return false;
+            }
+            old_head = std::move(head);
+            head = std::move(old_head->next);
+        }
+        value = std::move(*old_head->data);
+        return true;
+    }
+};
+
+// Variant 3 pooled: value lives in the node, retired nodes feed a
+// free list, so a warm queue allocates nothing.
+template<typename T>
+class pooled_fine_locked_queue
+{
+    struct node
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+        node* next = nullptr;
+
+        T* value() { return reinterpret_cast<T*>(storage); }
+    };
+
+    std::mutex head_mutex;
+    node* head;
+    std::mutex tail_mutex;
+    node* tail;
+    std::mutex pool_mutex;
+    node* free_list = nullptr;
+
+    node* get_tail()
+    {
+        std::lock_guard<std::mutex> tail_lock(tail_mutex);
+        return tail;
+    }
+
+    node* acquire_node()
+    {
+        {
+            std::lock_guard<std::mutex> pool_lock(pool_mutex);
+            if (free_list)
+            {
+                node* const n = free_list;
+                free_list = n->next;
+                n->next = nullptr;
+                return n;
+            }
+        }
+        return new node;
+    }
+
+public:
+    static const char* name() { return "pooled_fine_locked"; }
+
+    pooled_fine_locked_queue() : head(new node), tail(head) {}
+
+    ~pooled_fine_locked_queue()
+    {
+        while (head != tail)
+        {
+            node* const next = head->next;
+            head->value()->~T();
+            delete head;
+            head = next;
+        }
+        delete head;
+        while (free_list)
+        {
+            node* const next = free_list->next;
+            delete free_list;
+            free_list = next;
+        }
+    }
+
+    void push(T new_value)
+    {
+        node* const new_dummy = acquire_node();
+        std::lock_guard<std::mutex> tail_lock(tail_mutex);
+        new (tail->storage) T(std::move(new_value));
+        tail->next = new_dummy;
+        tail = new_dummy;
+    }
+
+    bool try_pop(T& value)
+    {
+        node* old_head;
+        {
+            std::lock_guard<std::mutex> head_lock(head_mutex);
+            if (head == get_tail())
+            {
+                return false;
+            }
+            old_head = head;
+            head = head->next;
+        }
+        value = std::move(*old_head->value());
+        old_head->value()->~T();
+        std::lock_guard<std::mutex> pool_lock(pool_mutex);
+        old_head->next = free_list;
+        free_list = old_head;
+        return true;
+    }
+};
+
+// Variant 5: Michael-Scott lock-free queue on the shared hazard-pointer
+// component.
+template<typename T>
+class lock_free_queue
+{
+    struct node
+    {
+        std::shared_ptr<T> data;
+        std::atomic<node*> next;
+
+        node() : next(nullptr) {}
+    };
+
+    std::atomic<node*> head;
+    std::atomic<node*> tail;
+
+public:
+    static const char* name() { return "lock_free_ms"; }
+
+    lock_free_queue()
+    {
+        node* const dummy = new node;
+        head.store(dummy);
+        tail.store(dummy);
+    }
+
+    ~lock_free_queue()
+    {
+        node* current = head.load();
+        while (current)
+        {
+            node* const next = current->next.load();
+            delete current;
+            current = next;
+        }
+        cds::scan_retired();
+    }
+
+    void push(T new_value)
+    {
+        std::shared_ptr<T> new_data(std::make_shared<T>(std::move(new_value)));
+        node* const new_node = new node;
+        new_node->data = new_data;
+        for (;;)
+        {
+            node* const old_tail = cds::protect(tail, 0);
+            node* next = old_tail->next.load();
+            if (old_tail != tail.load())
+            {
+                continue;
+            }
+            if (next)
+            {
+                node* expected_tail = old_tail;
+                tail.compare_exchange_strong(expected_tail, next);
+                continue;
+            }
+            node* expected = nullptr;
+            if (old_tail->next.compare_exchange_strong(expected, new_node))
+            {
+                node* expected_tail = old_tail;
+                tail.compare_exchange_strong(expected_tail, new_node);
+                cds::clear_hazard(0);
+                return;
+            }
+        }
+    }
+
+    bool try_pop(T& value)
+    {
+        for (;;)
+        {
+            node* const old_head = cds::protect(head, 0);
+            node* const next = cds::protect(old_head->next, 1);
+            if (old_head != head.load())
+            {
+                continue;
+            }
+            if (!next)
+            {
+                cds::clear_hazard(0);
+                cds::clear_hazard(1);
+                return false;
+            }
+            if (old_head == tail.load())
+            {
+                node* expected_tail = old_head;
+                tail.compare_exchange_strong(expected_tail, next);
+                continue;
+            }
+            std::shared_ptr<T> const res = next->data;
+            node* expected = old_head;
+            if (head.compare_exchange_strong(expected, next))
+            {
+                cds::clear_hazard(0);
+                cds::clear_hazard(1);
+                cds::retire(old_head);
+                value = std::move(*res);
+                return true;
+            }
+        }
+    }
+};
+
+// The Vyukov bounded MPMC ring from the shared header; push spins on a
+// full buffer, which is the backpressure pipelines want anyway.
+template<typename T>
+class bounded_mpmc_queue
+{
+    cds::mpmc_bounded_queue<T> ring;
+
+public:
+    static const char* name() { return "bounded_mpmc"; }
+
+    bounded_mpmc_queue() : ring(4096) {}
+
+    void push(T new_value)
+    {
+        while (!ring.try_push(std::move(new_value)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    bool try_pop(T& value)
+    {
+        return ring.try_pop(value);
+    }
+};
+
+// Variant 6: the single-producer/single-consumer ring. Only valid in
+// 1p x 1c runs, where it shows what giving up MPMC generality buys.
+template<typename T>
+class spsc_ring_queue
+{
+    static constexpr std::size_t kCapacity = 4096;  // Power of two
+    std::vector<T> buffer;
+
+    alignas(64) std::atomic<std::size_t> tail{0};
+    alignas(64) std::atomic<std::size_t> head{0};
+
+public:
+    static const char* name() { return "spsc_ring"; }
+
+    spsc_ring_queue() : buffer(kCapacity) {}
+
+    void push(T new_value)
+    {
+        std::size_t const t = tail.load(std::memory_order_relaxed);
+        while (t - head.load(std::memory_order_acquire) == kCapacity)
+        {
+            std::this_thread::yield();
+        }
+        buffer[t & (kCapacity - 1)] = std::move(new_value);
+        tail.store(t + 1, std::memory_order_release);
+    }
+
+    bool try_pop(T& value)
+    {
+        std::size_t const h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        value = std::move(buffer[h & (kCapacity - 1)]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// The harness.
+// ---------------------------------------------------------------------------
+
+// Payloads approximate message sizes: a sequence number plus padding.
+template<std::size_t Bytes>
+struct payload
+{
+    long long value = 0;
+    unsigned char pad[Bytes > sizeof(long long) ? Bytes - sizeof(long long) : 1] = {};
+};
+
+// Sample every 32nd operation so timing overhead stays off the hot path.
+constexpr unsigned kSampleEvery = 32;
+
+long long percentile_ns(std::vector<long long>& samples, double fraction)
+{
+    if (samples.empty())
+    {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    std::size_t const index = static_cast<std::size_t>(
+        fraction * static_cast<double>(samples.size() - 1));
+    return samples[index];
+}
+
+template<typename Queue, std::size_t Bytes>
+void run_benchmark(unsigned num_producers, unsigned num_consumers,
+                   int items_per_producer)
+{
+    using clock = std::chrono::steady_clock;
+    using P = payload<Bytes>;
+
+    Queue q;
+    long long const total_items =
+        static_cast<long long>(num_producers) * items_per_producer;
+
+    std::atomic<long long> popped_count(0);
+    std::atomic<long long> popped_sum(0);
+    std::atomic<unsigned> ready(0);
+    std::atomic<bool> go(false);
+
+    std::mutex samples_mutex;
+    std::vector<long long> push_samples;
+    std::vector<long long> pop_samples;
+
+    std::vector<std::thread> threads;
+    for (unsigned p = 0; p < num_producers; ++p)
+    {
+        threads.emplace_back([&]
+        {
+            std::vector<long long> local;
+            local.reserve(items_per_producer / kSampleEvery + 1);
+            ready.fetch_add(1);
+            while (!go.load())
+            {
+                std::this_thread::yield();
+            }
+            for (int i = 1; i <= items_per_producer; ++i)
+            {
+                P item;
+                item.value = i;
+                if (i % kSampleEvery == 0)
+                {
+                    auto const t0 = clock::now();
+                    q.push(std::move(item));
+                    local.push_back(
+                        std::chrono::nanoseconds(clock::now() - t0).count());
+                }
+                else
+                {
+                    q.push(std::move(item));
+                }
+            }
+            std::lock_guard<std::mutex> lock(samples_mutex);
+            push_samples.insert(push_samples.end(), local.begin(), local.end());
+        });
+    }
+    for (unsigned c = 0; c < num_consumers; ++c)
+    {
+        threads.emplace_back([&]
+        {
+            std::vector<long long> local;
+            long long sum = 0;
+            long long count = 0;
+            ready.fetch_add(1);
+            while (!go.load())
+            {
+                std::this_thread::yield();
+            }
+            P item;
+            while (popped_count.load() < total_items)
+            {
+                bool popped;
+                if (count % kSampleEvery == 0)
+                {
+                    auto const t0 = clock::now();
+                    popped = q.try_pop(item);
+                    if (popped)
+                    {
+                        local.push_back(
+                            std::chrono::nanoseconds(clock::now() - t0).count());
+                    }
+                }
+                else
+                {
+                    popped = q.try_pop(item);
+                }
+                if (popped)
+                {
+                    sum += item.value;
+                    ++count;
+                    popped_count.fetch_add(1);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+            popped_sum.fetch_add(sum);
+            std::lock_guard<std::mutex> lock(samples_mutex);
+            pop_samples.insert(pop_samples.end(), local.begin(), local.end());
+        });
+    }
+
+    while (ready.load() != num_producers + num_consumers)
+    {
+        std::this_thread::yield();
+    }
+    long long const allocations_before = allocation_count.load();
+    auto const start = clock::now();
+    go.store(true);
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    double const seconds =
+        std::chrono::duration<double>(clock::now() - start).count();
+    long long const allocations =
+        allocation_count.load() - allocations_before;
+
+    long long const expected = static_cast<long long>(num_producers) *
+        items_per_producer * (items_per_producer + 1LL) / 2;
+    if (popped_sum.load() != expected)
+    {
+        std::cout << "# CHECKSUM MISMATCH for " << Queue::name() << std::endl;
+    }
+
+    std::cout << Queue::name() << "," << Bytes << "," << num_producers << ","
+              << num_consumers << "," << total_items << ","
+              << static_cast<long long>(2.0 * static_cast<double>(total_items)
+                                        / seconds)
+              << "," << percentile_ns(push_samples, 0.99) << ","
+              << percentile_ns(pop_samples, 0.99) << ","
+              << static_cast<double>(allocations)
+                     / static_cast<double>(total_items)
+              << std::endl;
+}
+
+template<std::size_t Bytes>
+void run_all_queues(unsigned producers, unsigned consumers, int items)
+{
+    run_benchmark<coarse_mutex_queue<payload<Bytes>>, Bytes>(producers, consumers, items);
+    run_benchmark<fine_locked_queue<payload<Bytes>>, Bytes>(producers, consumers, items);
+    run_benchmark<pooled_fine_locked_queue<payload<Bytes>>, Bytes>(producers, consumers, items);
+    run_benchmark<lock_free_queue<payload<Bytes>>, Bytes>(producers, consumers, items);
+    run_benchmark<bounded_mpmc_queue<payload<Bytes>>, Bytes>(producers, consumers, items);
+    if (producers == 1 && consumers == 1)
+    {
+        run_benchmark<spsc_ring_queue<payload<Bytes>>, Bytes>(producers, consumers, items);
+    }
+}
+
+void run_mix(unsigned producers, unsigned consumers, int items)
+{
+    run_all_queues<8>(producers, consumers, items);
+    run_all_queues<64>(producers, consumers, items);
+    run_all_queues<512>(producers, consumers, items);
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << "# === Queue Benchmark Harness ===" << std::endl;
+    std::cout << "# ops = pushes + pops; latencies sampled every "
+              << kSampleEvery << " ops" << std::endl;
+    std::cout << "queue,payload_bytes,producers,consumers,items,"
+                 "ops_per_sec,p99_push_ns,p99_pop_ns,allocs_per_item"
+              << std::endl;
+
+    int const items = (argc > 3) ? std::atoi(argv[3]) : 20000;
+    if (argc > 2)
+    {
+        run_mix(static_cast<unsigned>(std::atoi(argv[1])),
+                static_cast<unsigned>(std::atoi(argv[2])), items);
+        return 0;
+    }
+
+    run_mix(1, 1, items);
+    run_mix(2, 2, items);
+    run_mix(4, 4, items);
+    run_mix(4, 1, items);
+
+    return 0;
+}
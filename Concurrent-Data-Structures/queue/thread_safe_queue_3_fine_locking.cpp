@@ -1,6 +1,8 @@
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <iostream>
+#include <new>
 #include <thread>
 #include <vector>
 
@@ -80,6 +82,125 @@ public:
     }
 };
 
+// Pooled variant: same dummy-node / two-mutex design, but the value
+// lives INSIDE the node (constructed on push, moved out and destroyed
+// on pop) and retired nodes go to a free list instead of the heap.
+// The original pays two allocations per message - a node and a
+// shared_ptr control block - which for small fixed-size message
+// structs costs more than the queue logic itself. Here a warm queue
+// allocates nothing: pop recycles exactly the node push will need
+// next. The pool mutex guards a two-pointer splice, far cheaper than
+// a malloc/free pair, and the pool never holds more nodes than the
+// queue's high-water mark.
+template<typename T>
+class pooled_threadsafe_queue
+{
+private:
+    struct node
+    {
+        // Raw storage: a pooled node holds no live T between pop and
+        // the push that reuses it.
+        alignas(T) unsigned char storage[sizeof(T)];
+        node* next = nullptr;
+
+        T* value() { return reinterpret_cast<T*>(storage); }
+    };
+
+    std::mutex head_mutex;
+    node* head;
+    std::mutex tail_mutex;
+    node* tail;
+
+    std::mutex pool_mutex;
+    node* free_list = nullptr;
+
+    node* get_tail()
+    {
+        std::lock_guard<std::mutex> tail_lock(tail_mutex);
+        return tail;
+    }
+
+    node* acquire_node()
+    {
+        {
+            std::lock_guard<std::mutex> pool_lock(pool_mutex);
+            if (free_list)
+            {
+                node* const n = free_list;
+                free_list = n->next;
+                n->next = nullptr;
+                return n;
+            }
+        }
+        return new node;  // Cold start or new high-water mark: grow
+    }
+
+    void release_node(node* n)
+    {
+        std::lock_guard<std::mutex> pool_lock(pool_mutex);
+        n->next = free_list;
+        free_list = n;
+    }
+
+public:
+    pooled_threadsafe_queue() : head(new node), tail(head) {}
+
+    pooled_threadsafe_queue(const pooled_threadsafe_queue&) = delete;
+    pooled_threadsafe_queue& operator=(const pooled_threadsafe_queue&) = delete;
+
+    ~pooled_threadsafe_queue()
+    {
+        // Single-threaded by contract. Every node except the trailing
+        // dummy holds a live value.
+        while (head != tail)
+        {
+            node* const next = head->next;
+            head->value()->~T();
+            delete head;
+            head = next;
+        }
+        delete head;
+        while (free_list)
+        {
+            node* const next = free_list->next;
+            delete free_list;
+            free_list = next;
+        }
+    }
+
+    void push(T new_value)
+    {
+        // Grab the next dummy from the pool outside the tail lock,
+        // mirroring the original's allocate-before-locking.
+        node* const new_dummy = acquire_node();
+        {
+            std::lock_guard<std::mutex> tail_lock(tail_mutex);
+            new (tail->storage) T(std::move(new_value));  // Dummy becomes real
+            tail->next = new_dummy;
+            tail = new_dummy;
+        }
+    }
+
+    // Moves the value out - no shared_ptr, no control block.
+    bool try_pop(T& value)
+    {
+        node* old_head;
+        {
+            std::lock_guard<std::mutex> head_lock(head_mutex);
+            if (head == get_tail())
+            {
+                return false;
+            }
+            old_head = head;
+            head = head->next;
+        }
+        value = std::move(*old_head->value());
+        old_head->value()->~T();
+        release_node(old_head);
+        return true;
+    }
+};
+
 // Test concurrent operations
 void producer(threadsafe_queue<int>& q, int start, int count)
 {
@@ -128,6 +249,90 @@ int main()
     std::cout << "- Multiple producers can allocate concurrently" << std::endl;
     std::cout << "- Push and pop can proceed concurrently" << std::endl;
     std::cout << "- Only brief locks during pointer updates" << std::endl;
-    
+
+    // Pooled variant: same interleaving behaviour, but pop moves the
+    // value out and a warm queue recycles nodes instead of allocating.
+    std::cout << "\n=== Pooled Variant ===" << std::endl;
+    pooled_threadsafe_queue<int> pq;
+    for (int i = 1; i <= 3; ++i)
+    {
+        pq.push(i);
+    }
+    int value;
+    while (pq.try_pop(value))
+    {
+        std::cout << "Pooled pop got: " << value << std::endl;
+    }
+
+    // Quick throughput comparison, one producer vs one consumer moving
+    // fixed-size messages. The pooled queue does zero allocations once
+    // warm; the original does two per message (node + control block).
+    // queue_benchmark.cpp has the full measurement across thread mixes.
+    struct message { long long sequence; char body[48]; };
+    int const messages = 200000;
+
+    auto const run_original = [messages]
+    {
+        threadsafe_queue<message> q2;
+        auto const start = std::chrono::steady_clock::now();
+        std::thread prod([&] {
+            for (int i = 1; i <= messages; ++i)
+            {
+                q2.push(message{i, {}});
+            }
+        });
+        std::thread cons([&] {
+            int remaining = messages;
+            while (remaining > 0)
+            {
+                if (q2.try_pop())
+                {
+                    --remaining;
+                }
+            }
+        });
+        prod.join();
+        cons.join();
+        return std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    };
+    auto const run_pooled = [messages]
+    {
+        pooled_threadsafe_queue<message> q2;
+        auto const start = std::chrono::steady_clock::now();
+        std::thread prod([&] {
+            for (int i = 1; i <= messages; ++i)
+            {
+                q2.push(message{i, {}});
+            }
+        });
+        std::thread cons([&] {
+            message m;
+            int remaining = messages;
+            while (remaining > 0)
+            {
+                if (q2.try_pop(m))
+                {
+                    --remaining;
+                }
+            }
+        });
+        prod.join();
+        cons.join();
+        return std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    };
+
+    double const original_s = run_original();
+    double const pooled_s = run_pooled();
+    std::cout << "\n" << messages << " x 56-byte messages, 1 producer x 1 consumer:"
+              << std::endl;
+    std::cout << "  original (2 allocs/msg): "
+              << static_cast<long long>(messages / original_s) << " msgs/sec"
+              << std::endl;
+    std::cout << "  pooled   (0 allocs warm): "
+              << static_cast<long long>(messages / pooled_s) << " msgs/sec ("
+              << original_s / pooled_s << "x)" << std::endl;
+
     return 0;
 }
\ No newline at end of file
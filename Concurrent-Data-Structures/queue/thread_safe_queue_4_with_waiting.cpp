@@ -7,6 +7,11 @@
 
 // Complete thread-safe queue with waiting capabilities
 // Adds condition variables for blocking operations
+//
+// NOTE: this file demonstrates the fine-locked construction. The
+// production variant - one coarse lock, but with bounding, close(),
+// try/blocking flavours and bulk ops - is cds::concurrent_queue in
+// concurrent_queue.hpp; new features and tuning belong there.
 template<typename T>
 class threadsafe_queue
 {
@@ -0,0 +1,328 @@
+#include "../reclamation/hazard_pointer.hpp"
+
+#include <atomic>
+#include <memory>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Lock-free queue (Michael & Scott algorithm) with hazard-pointer reclamation
+//
+// The fine-grained queue (thread_safe_queue_3_fine_locking.cpp) still takes
+// head_mutex or tail_mutex on every operation, so throughput stops scaling
+// around 4 threads: everyone queues up on two locks. Here head and tail are
+// plain atomics updated with compare_exchange, so any number of producers
+// and consumers make progress without ever blocking each other - a stalled
+// (even suspended) thread cannot hold anyone else up.
+//
+// The two classic problems this file demonstrates solutions for:
+//
+// 1. The lagging tail: a producer links its node with one CAS, then swings
+//    tail with a second. Between the two, other threads see tail pointing
+//    one node behind - so every operation that finds tail lagging helps by
+//    swinging it forward itself (the "helping" pattern).
+//
+// 2. Safe reclamation: a popper cannot just 'delete' the node it removed,
+//    because another thread may still be reading it (it loaded the same
+//    head pointer a moment earlier). The shared hazard-pointer component
+//    (../reclamation/hazard_pointer.hpp) solves this: cds::protect
+//    publishes the pointer before dereferencing it, and cds::retire hands
+//    removed nodes to a per-thread list that is scanned - and freed -
+//    only once it crosses a threshold, so pop pays no refcount traffic
+//    and no per-operation table walk.
+
+// ---------------------------------------------------------------------------
+// The queue itself.
+// ---------------------------------------------------------------------------
+
+template<typename T>
+class lock_free_queue
+{
+private:
+    struct node
+    {
+        std::shared_ptr<T> data;   // Empty in the dummy node
+        std::atomic<node*> next;
+
+        node() : next(nullptr) {}
+    };
+
+    // Like the locked versions, a dummy node separates producers from
+    // consumers: head always points at the dummy, the first real element
+    // is head->next. An empty queue is head == tail with next == nullptr.
+    std::atomic<node*> head;
+    std::atomic<node*> tail;
+
+public:
+    lock_free_queue()
+    {
+        node* const dummy = new node;
+        head.store(dummy);
+        tail.store(dummy);
+    }
+
+    lock_free_queue(const lock_free_queue& other) = delete;
+    lock_free_queue& operator=(const lock_free_queue& other) = delete;
+
+    ~lock_free_queue()
+    {
+        // Single-threaded by contract at this point.
+        node* current = head.load();
+        while (current)
+        {
+            node* const next = current->next.load();
+            delete current;
+            current = next;
+        }
+        cds::scan_retired();
+    }
+
+    void push(T new_value)
+    {
+        // The data lives in a shared_ptr (same as the locked queues) so
+        // try_pop can hand it out without a copy that might throw after
+        // the node is already unlinked.
+        std::shared_ptr<T> new_data(std::make_shared<T>(std::move(new_value)));
+        node* const new_node = new node;
+        new_node->data = new_data;
+
+        for (;;)
+        {
+            node* const old_tail = cds::protect(tail, 0);
+            node* next = old_tail->next.load();
+
+            if (old_tail != tail.load())
+            {
+                continue;  // Tail moved while we were publishing the hazard
+            }
+            if (next)
+            {
+                // Tail is lagging behind the real last node: help swing it
+                // forward and retry. We never wait for the other producer.
+                node* expected_tail = old_tail;
+                tail.compare_exchange_strong(expected_tail, next);
+                continue;
+            }
+            // Tail really is the last node: link ours after it...
+            node* expected = nullptr;
+            if (old_tail->next.compare_exchange_strong(expected, new_node))
+            {
+                // ...and swing tail. If this CAS fails, someone helped us
+                // (see above), which is fine.
+                node* expected_tail = old_tail;
+                tail.compare_exchange_strong(expected_tail, new_node);
+                cds::clear_hazard(0);
+                return;
+            }
+            // Another producer linked first; loop and try again.
+        }
+    }
+
+    // Non-blocking pop: nullptr if the queue is empty.
+    std::shared_ptr<T> try_pop()
+    {
+        std::shared_ptr<T> res;
+        for (;;)
+        {
+            node* const old_head = cds::protect(head, 0);
+            node* const next = cds::protect(old_head->next, 1);
+
+            if (old_head != head.load())
+            {
+                continue;  // Head moved; our hazard may protect a stale node
+            }
+            if (!next)
+            {
+                res.reset();  // Only the dummy: empty
+                break;
+            }
+            if (old_head == tail.load())
+            {
+                // Non-empty but tail still points at the dummy: a producer
+                // is mid-push. Help swing tail and retry.
+                node* expected_tail = old_head;
+                tail.compare_exchange_strong(expected_tail, next);
+                continue;
+            }
+            // Read the data *before* the CAS: afterwards another thread may
+            // pop 'next' and retire it.
+            res = next->data;
+            node* expected = old_head;
+            if (head.compare_exchange_strong(expected, next))
+            {
+                // We own old_head now, but other threads may still hold it
+                // in a hazard pointer - retire it instead of deleting. The
+                // component scans only when the retire list fills up, so
+                // the common pop does no hazard-table walk at all.
+                cds::clear_hazard(0);
+                cds::clear_hazard(1);
+                cds::retire(old_head);
+                return res;
+            }
+        }
+        cds::clear_hazard(0);
+        cds::clear_hazard(1);
+        return res;
+    }
+
+    bool try_pop(T& value)
+    {
+        std::shared_ptr<T> const res = try_pop();
+        if (!res)
+        {
+            return false;
+        }
+        value = std::move(*res);
+        return true;
+    }
+
+    // Blocking interface, to match threadsafe_queue's call sites. There is
+    // no condition variable to sleep on in a lock-free structure, so this
+    // spins with yield - appropriate when consumers rarely find the queue
+    // empty (the messaging-layer case these queues template for).
+    std::shared_ptr<T> wait_and_pop()
+    {
+        for (;;)
+        {
+            std::shared_ptr<T> res = try_pop();
+            if (res)
+            {
+                return res;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    void wait_and_pop(T& value)
+    {
+        while (!try_pop(value))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    bool empty()
+    {
+        // A snapshot, like threadsafe_queue::empty - stale by the time the
+        // caller looks at it, but safe to call concurrently.
+        node* const old_head = cds::protect(head, 0);
+        bool const result = (old_head->next.load() == nullptr);
+        cds::clear_hazard(0);
+        return result;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Demo
+// ---------------------------------------------------------------------------
+
+// MPMC stress: several producers each push a known series, several
+// consumers pop everything; the grand total must match exactly.
+void stress_test()
+{
+    lock_free_queue<int> q;
+    unsigned const num_producers = 4;
+    unsigned const num_consumers = 4;
+    int const items_per_producer = 25000;
+
+    std::atomic<long long> popped_sum(0);
+    std::atomic<int> popped_count(0);
+    int const total_items = num_producers * items_per_producer;
+
+    std::vector<std::thread> threads;
+    for (unsigned p = 0; p < num_producers; ++p)
+    {
+        threads.emplace_back([&q]
+        {
+            for (int i = 1; i <= items_per_producer; ++i)
+            {
+                q.push(i);
+            }
+        });
+    }
+    for (unsigned c = 0; c < num_consumers; ++c)
+    {
+        threads.emplace_back([&]
+        {
+            int value;
+            while (popped_count.load() < total_items)
+            {
+                if (q.try_pop(value))
+                {
+                    popped_sum.fetch_add(value);
+                    popped_count.fetch_add(1);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    long long const expected =
+        static_cast<long long>(num_producers) * items_per_producer *
+        (items_per_producer + 1) / 2;
+    std::cout << "Popped " << popped_count.load() << "/" << total_items
+              << " items, sum " << popped_sum.load()
+              << (popped_sum.load() == expected ? " (correct)" : " (WRONG!)")
+              << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Lock-Free Queue (Michael-Scott) Demo ===" << std::endl;
+
+    // 1. Basic single-threaded behaviour matches threadsafe_queue
+    std::cout << "\n1. Basic operations:" << std::endl;
+    lock_free_queue<int> q;
+    std::cout << "empty() on fresh queue: " << (q.empty() ? "true" : "false")
+              << std::endl;
+
+    auto missing = q.try_pop();
+    std::cout << "try_pop on empty queue: "
+              << (missing ? "got value" : "no value") << std::endl;
+
+    q.push(1);
+    q.push(2);
+    q.push(3);
+    std::cout << "Pushed: 1, 2, 3" << std::endl;
+
+    int value;
+    while (q.try_pop(value))
+    {
+        std::cout << "try_pop got: " << value << std::endl;
+    }
+
+    // 2. Blocking interface
+    std::cout << "\n2. wait_and_pop across threads:" << std::endl;
+    std::thread consumer([&q]
+    {
+        auto popped = q.wait_and_pop();
+        std::cout << "Consumer got: " << *popped << std::endl;
+    });
+    std::thread producer([&q]
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::cout << "Producer: pushing 42" << std::endl;
+        q.push(42);
+    });
+    consumer.join();
+    producer.join();
+
+    // 3. Many producers and consumers at once
+    std::cout << "\n3. MPMC stress (4 producers x 4 consumers):" << std::endl;
+    stress_test();
+
+    std::cout << "\nDemo completed. Key features:" << std::endl;
+    std::cout << "- push/try_pop never block: progress via CAS loops" << std::endl;
+    std::cout << "- Lagging tail fixed by helping, not waiting" << std::endl;
+    std::cout << "- Hazard pointers make node deletion safe, scans amortized" << std::endl;
+    std::cout << "- Same interface as threadsafe_queue, so it drops in" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,282 @@
+#include <atomic>
+#include <memory>
+#include <iostream>
+#include <thread>
+#include <new>
+#include <chrono>
+
+// Bounded single-producer/single-consumer ring buffer (wait-free)
+//
+// Every other queue in this suite is node-based and unbounded: each push
+// allocates a node, each pop frees one, and producers and consumers
+// coordinate through mutexes (queues 1-4) or CAS loops (queue 5). When
+// there is exactly ONE producer thread and ONE consumer thread - a common
+// shape for pipeline stages - none of that is needed. The classic Lamport
+// ring does it with two plain indices:
+//
+//   - a fixed power-of-two buffer allocated once, up front;
+//   - the producer owns 'tail' (only it writes it), the consumer owns
+//     'head' (only it writes it) - so neither index is ever contended;
+//   - one release-store/acquire-load pair per transfer publishes the
+//     element: no CAS, no retry loop, every operation finishes in a
+//     bounded number of steps (wait-free, not merely lock-free).
+//
+// Two micro-optimizations make this the fastest queue in the family:
+//
+//   1. Cache padding: head and tail live on separate cache lines, so the
+//      producer hammering tail never invalidates the consumer's line
+//      holding head (false sharing is THE classic SPSC pitfall).
+//
+//   2. Index caching: the producer remembers the last head it saw and
+//      only re-reads the shared atomic when the ring looks full (and the
+//      consumer mirrors this with tail). A burst of pushes then touches
+//      no shared data at all except the slots themselves.
+//
+// The price: exactly one producer and one consumer. Two producers racing
+// on tail would corrupt the ring - this is a contract, not a checked
+// condition.
+template<typename T>
+class spsc_ring_queue
+{
+private:
+    static constexpr size_t cache_line = 64;
+
+    size_t const capacity_;  // Power of two
+    size_t const mask_;      // capacity_ - 1: index & mask_ == index % capacity_
+
+    // Raw storage, constructed/destroyed per element with placement new,
+    // so T does not need to be default-constructible and empty slots hold
+    // no object.
+    std::unique_ptr<unsigned char[]> storage_;
+
+    // Producer's line: its own index plus its cached copy of head.
+    alignas(cache_line) std::atomic<size_t> tail_;
+    size_t cached_head_;
+
+    // Consumer's line: its own index plus its cached copy of tail.
+    alignas(cache_line) std::atomic<size_t> head_;
+    size_t cached_tail_;
+
+    T* slot(size_t index)
+    {
+        return reinterpret_cast<T*>(storage_.get() + (index & mask_) * sizeof(T));
+    }
+
+    static size_t round_up_to_power_of_two(size_t n)
+    {
+        size_t p = 1;
+        while (p < n)
+        {
+            p <<= 1;
+        }
+        return p;
+    }
+
+public:
+    explicit spsc_ring_queue(size_t capacity)
+        : capacity_(round_up_to_power_of_two(capacity)),
+          mask_(capacity_ - 1),
+          storage_(new unsigned char[capacity_ * sizeof(T)]),
+          tail_(0), cached_head_(0),
+          head_(0), cached_tail_(0)
+    {
+    }
+
+    spsc_ring_queue(const spsc_ring_queue& other) = delete;
+    spsc_ring_queue& operator=(const spsc_ring_queue& other) = delete;
+
+    ~spsc_ring_queue()
+    {
+        // Single-threaded by contract at this point.
+        T value;
+        while (try_pop(value))
+        {
+        }
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    // Producer side. Returns false if the ring is full (bounded queues
+    // must be able to say no - that is what gives the pipeline
+    // backpressure).
+    bool try_push(T value)
+    {
+        size_t const tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == capacity_)
+        {
+            // Looks full - but our head copy may be stale. Re-read the
+            // real one (this is the only time the producer touches it).
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == capacity_)
+            {
+                return false;  // Genuinely full
+            }
+        }
+        new (slot(tail)) T(std::move(value));
+        // The release makes the slot's contents visible to the consumer's
+        // acquire load of tail_ - this pair is the entire handoff.
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: mirror image of try_push.
+    bool try_pop(T& value)
+    {
+        size_t const head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_)
+            {
+                return false;  // Genuinely empty
+            }
+        }
+        T* const p = slot(head);
+        value = std::move(*p);
+        p->~T();
+        // Release publishes the freed slot back to the producer.
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Blocking wrappers, matching the wait-style interface of the other
+    // queues. No lock exists to sleep on, so they spin with yield - cheap
+    // when the ring is sized so full/empty are the exception.
+    void push(T value)
+    {
+        while (!try_push(std::move(value)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void wait_and_pop(T& value)
+    {
+        while (!try_pop(value))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // Snapshots, callable from either side.
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) ==
+               tail_.load(std::memory_order_acquire);
+    }
+
+    size_t size() const
+    {
+        return tail_.load(std::memory_order_acquire) -
+               head_.load(std::memory_order_acquire);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Demo
+// ---------------------------------------------------------------------------
+
+// One producer streams a known series through a small ring to one
+// consumer; the sum must match and the ring's bound must hold throughout.
+void throughput_test()
+{
+    spsc_ring_queue<int> q(1024);
+    int const items = 2000000;
+
+    auto const start = std::chrono::steady_clock::now();
+
+    std::thread producer([&q]
+    {
+        for (int i = 1; i <= items; ++i)
+        {
+            q.push(i);  // Blocks (spins) when the consumer falls behind
+        }
+    });
+
+    long long sum = 0;
+    std::thread consumer([&q, &sum]
+    {
+        int value;
+        for (int i = 0; i < items; ++i)
+        {
+            q.wait_and_pop(value);
+            sum += value;
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    long long const expected = static_cast<long long>(items) * (items + 1) / 2;
+    std::cout << "Transferred " << items << " items in " << elapsed.count()
+              << " ms, sum " << sum
+              << (sum == expected ? " (correct)" : " (WRONG!)") << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== SPSC Ring Buffer Queue Demo ===" << std::endl;
+
+    // 1. Basic bounded behaviour
+    std::cout << "\n1. Bounded basics (capacity 4):" << std::endl;
+    spsc_ring_queue<int> q(4);
+    std::cout << "empty() on fresh queue: " << (q.empty() ? "true" : "false")
+              << std::endl;
+
+    for (int i = 1; i <= 4; ++i)
+    {
+        std::cout << "try_push(" << i << "): "
+                  << (q.try_push(i) ? "ok" : "full") << std::endl;
+    }
+    std::cout << "try_push(5): " << (q.try_push(5) ? "ok" : "full (as expected)")
+              << std::endl;
+
+    int value;
+    while (q.try_pop(value))
+    {
+        std::cout << "try_pop got: " << value << std::endl;
+    }
+    std::cout << "try_pop on empty: " << (q.try_pop(value) ? "got value" : "no value")
+              << std::endl;
+
+    // 2. Capacity is rounded up to a power of two (for the index mask)
+    spsc_ring_queue<int> q6(6);
+    std::cout << "\n2. Requested capacity 6, actual: " << q6.capacity()
+              << std::endl;
+
+    // 3. Blocking wrapper across the two threads
+    std::cout << "\n3. Blocking wrapper:" << std::endl;
+    std::thread consumer([&q]
+    {
+        int v;
+        q.wait_and_pop(v);
+        std::cout << "Consumer got: " << v << std::endl;
+    });
+    std::thread producer([&q]
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::cout << "Producer: pushing 42" << std::endl;
+        q.push(42);
+    });
+    consumer.join();
+    producer.join();
+
+    // 4. Sustained one-producer/one-consumer stream
+    std::cout << "\n4. Throughput (1 producer, 1 consumer, ring of 1024):"
+              << std::endl;
+    throughput_test();
+
+    std::cout << "\nDemo completed. Key features:" << std::endl;
+    std::cout << "- Fixed buffer, no allocation after construction" << std::endl;
+    std::cout << "- Wait-free: one release/acquire pair per transfer, no CAS" << std::endl;
+    std::cout << "- head and tail cache-padded against false sharing" << std::endl;
+    std::cout << "- Exactly one producer and one consumer, by contract" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,248 @@
+#ifndef HAZARD_POINTER_HPP
+#define HAZARD_POINTER_HPP
+
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Hazard-pointer reclamation for lock-free data structures.
+//
+// The deletion problem: a thread that unlinks a node from a lock-free
+// structure cannot simply delete it, because another thread may have
+// loaded the same pointer a moment earlier and still be dereferencing
+// it. The teaching examples in this directory sidestep this with
+// shared_ptr (atomic refcount traffic on every operation) or by
+// leaking. Hazard pointers solve it without per-node refcounts:
+//
+//   - before dereferencing a shared pointer, a thread PUBLISHES it in
+//     one of a small fixed table of hazard slots, then re-reads the
+//     source to make sure it published the current value;
+//   - a thread that unlinks a node RETIREs it to a thread-local list
+//     instead of deleting it;
+//   - when the local list grows past a threshold, the thread SCANs the
+//     hazard table once and frees every retired node no slot protects,
+//     keeping the rest for the next scan.
+//
+// Because the scan threshold is a multiple of the table size, each scan
+// frees at least half the list, so the amortized cost per retired node
+// is O(1) and the memory held back is bounded by
+// threshold x thread count.
+//
+// Usage (see hazard_pointer_demo.cpp and the lock-free queue):
+//
+//     node* n = cds::protect(head, 0);   // slot 0 now guards n
+//     ... use n ...
+//     cds::clear_hazard(0);
+//
+//     cds::retire(unlinked_node);        // instead of delete
+//
+// Each thread may hold up to max_hazards_per_thread simultaneous
+// hazards (index 'which'). Slots are claimed on a thread's first use
+// and released when it exits; retired nodes a thread leaves behind are
+// handed to a global list that other threads' scans adopt.
+namespace cds {
+
+constexpr unsigned max_hazard_threads = 64;
+constexpr unsigned max_hazards_per_thread = 4;
+constexpr unsigned max_hazard_pointers =
+    max_hazard_threads * max_hazards_per_thread;
+
+// One published pointer. The owner id marks the whole block of
+// max_hazards_per_thread slots as claimed.
+struct hazard_slot {
+    std::atomic<std::thread::id> id;
+    std::atomic<void*> pointer;
+};
+
+inline hazard_slot hazard_table[max_hazard_pointers];
+
+namespace detail {
+
+    // A retired node still waiting for no hazard to reference it. The
+    // deleter is captured as a plain function pointer per type, so
+    // retire() costs one small allocation and no std::function.
+    struct retired_node {
+        void* data;
+        void (*deleter)(void*);
+        retired_node* next;
+    };
+
+    template<typename T>
+    void delete_as(void* p) {
+        delete static_cast<T*>(p);
+    }
+
+    // Orphaned retirements from exited threads; adopted by the next scan.
+    inline std::atomic<retired_node*> global_retired{nullptr};
+
+    inline void push_global(retired_node* first, retired_node* last) {
+        last->next = global_retired.load();
+        while (!global_retired.compare_exchange_weak(last->next, first)) {
+        }
+    }
+
+    // RAII owner of one thread's block of hazard slots.
+    class hazard_owner {
+        hazard_slot* block_ = nullptr;
+
+    public:
+        hazard_owner(const hazard_owner&) = delete;
+        hazard_owner& operator=(const hazard_owner&) = delete;
+
+        hazard_owner() {
+            for (unsigned i = 0; i < max_hazard_threads; ++i) {
+                hazard_slot* candidate =
+                    &hazard_table[i * max_hazards_per_thread];
+                std::thread::id old_id;
+                if (candidate->id.compare_exchange_strong(
+                        old_id, std::this_thread::get_id())) {
+                    block_ = candidate;
+                    return;
+                }
+            }
+            throw std::runtime_error("No hazard-pointer slots available");
+        }
+
+        ~hazard_owner() {
+            for (unsigned i = 0; i < max_hazards_per_thread; ++i) {
+                block_[i].pointer.store(nullptr);
+            }
+            block_[0].id.store(std::thread::id());
+        }
+
+        std::atomic<void*>& slot(unsigned which) {
+            return block_[which].pointer;
+        }
+    };
+
+    inline hazard_owner& owner_for_current_thread() {
+        thread_local static hazard_owner owner;
+        return owner;
+    }
+
+    // The thread-local retired list. Destruction (thread exit) does a
+    // last scan and hands anything still protected to the global list.
+    class retire_list {
+        retired_node* head_ = nullptr;
+        std::size_t count_ = 0;
+
+    public:
+        // Scan when the list could more than fill the hazard table: at
+        // least half of it is then guaranteed unprotected, making the
+        // amortized cost per retirement O(1).
+        static constexpr std::size_t scan_threshold = 2 * max_hazard_pointers;
+
+        ~retire_list() {
+            scan();
+            if (head_) {
+                retired_node* last = head_;
+                while (last->next) {
+                    last = last->next;
+                }
+                push_global(head_, last);
+            }
+        }
+
+        void add(retired_node* node) {
+            node->next = head_;
+            head_ = node;
+            if (++count_ >= scan_threshold) {
+                scan();
+            }
+        }
+
+        void scan() {
+            // Adopt orphans first so an exited thread's nodes get freed.
+            retired_node* adopted = global_retired.exchange(nullptr);
+            while (adopted) {
+                retired_node* const next = adopted->next;
+                adopted->next = head_;
+                head_ = adopted;
+                ++count_;
+                adopted = next;
+            }
+
+            // Snapshot every live hazard once; sorted so each retired
+            // node costs one binary search instead of a table walk.
+            std::vector<void*> hazards;
+            hazards.reserve(max_hazard_pointers);
+            for (unsigned i = 0; i < max_hazard_pointers; ++i) {
+                void* const p = hazard_table[i].pointer.load();
+                if (p) {
+                    hazards.push_back(p);
+                }
+            }
+            std::sort(hazards.begin(), hazards.end());
+
+            retired_node* current = head_;
+            head_ = nullptr;
+            count_ = 0;
+            while (current) {
+                retired_node* const next = current->next;
+                if (std::binary_search(hazards.begin(), hazards.end(),
+                                       current->data)) {
+                    current->next = head_;  // Still protected: keep
+                    head_ = current;
+                    ++count_;
+                } else {
+                    current->deleter(current->data);
+                    delete current;
+                }
+                current = next;
+            }
+        }
+    };
+
+    inline retire_list& retire_list_for_current_thread() {
+        thread_local static retire_list list;
+        return list;
+    }
+
+} // namespace detail
+
+// The calling thread's hazard slot 'which' (0..max_hazards_per_thread-1).
+inline std::atomic<void*>& hazard_pointer(unsigned which) {
+    return detail::owner_for_current_thread().slot(which);
+}
+
+// Publishes the pointer read from 'src' in slot 'which' and re-reads
+// until the published value is the current one - only then is it safe
+// to dereference. The slot keeps guarding the result until overwritten
+// or cleared.
+template<typename T>
+T* protect(std::atomic<T*>& src, unsigned which) {
+    std::atomic<void*>& slot = hazard_pointer(which);
+    T* p = src.load();
+    T* seen;
+    do {
+        seen = p;
+        slot.store(p);
+        p = src.load();
+    } while (p != seen);
+    return p;
+}
+
+inline void clear_hazard(unsigned which) {
+    hazard_pointer(which).store(nullptr);
+}
+
+// Hands an unlinked node to the calling thread's retired list; it is
+// deleted by a later scan once no hazard slot references it.
+template<typename T>
+void retire(T* p) {
+    detail::retire_list_for_current_thread().add(
+        new detail::retired_node{p, &detail::delete_as<T>, nullptr});
+}
+
+// Forces a scan now (tests, quiescent points). Normal code never needs
+// this - retire() scans automatically at the threshold.
+inline void scan_retired() {
+    detail::retire_list_for_current_thread().scan();
+}
+
+} // namespace cds
+
+#endif // HAZARD_POINTER_HPP
@@ -41,6 +41,17 @@ void threadsafe_stack<T>::pop(T& value) {
     data.pop();
 }
 
+template<typename T>
+std::optional<T> threadsafe_stack<T>::try_pop() {
+    std::lock_guard<std::mutex> lock(m);
+
+    if(data.empty()) return std::nullopt;
+
+    std::optional<T> res(std::move(data.top()));
+    data.pop();
+    return res;
+}
+
 template<typename T>
 bool threadsafe_stack<T>::empty() const {
     std::lock_guard<std::mutex> lock(m);
@@ -97,4 +108,14 @@ int ThrowingType::get_value() const { return value; }
 // This ensures the compiler generates the code for these types,
 // which will be used in stack_demos.cpp.
 template class threadsafe_stack<int>;
-template class threadsafe_stack<ThrowingType>;
\ No newline at end of file
+template class threadsafe_stack<ThrowingType>;
+
+// A move-only payload can't use explicit CLASS instantiation: that would
+// instantiate every member, including the copy constructor (which copies
+// the underlying std::stack and so requires a copyable T). Instantiate
+// only the members a move-only type can actually use.
+template threadsafe_stack<std::unique_ptr<int>>::threadsafe_stack();
+template void threadsafe_stack<std::unique_ptr<int>>::push(std::unique_ptr<int>);
+template std::optional<std::unique_ptr<int>> threadsafe_stack<std::unique_ptr<int>>::try_pop();
+template bool threadsafe_stack<std::unique_ptr<int>>::empty() const;
+template size_t threadsafe_stack<std::unique_ptr<int>>::size() const;
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <stack>
 #include <mutex>
 #include <memory>
+#include <optional>
+#include <utility>
 #include <exception>
 #include <iostream> // Primarily for exception, but generally useful for types like std::string if used in classes.
 
@@ -45,6 +47,24 @@ public:
     void push(T new_value);
     std::shared_ptr<T> pop();
     void pop(T& value);
+
+    // Constructs the element in place under the lock - no temporary T
+    // on the caller's side. A member template cannot be covered by the
+    // explicit instantiations in improved_stack.cpp, so it is defined
+    // here in the header.
+    template<class... Args>
+    void emplace(Args&&... args) {
+        std::lock_guard<std::mutex> lock(m);
+        data.emplace(std::forward<Args>(args)...);
+    }
+
+    // Move-out pop: empty() maps to nullopt instead of an exception,
+    // and the value is MOVED into the optional - no shared_ptr control
+    // block, no copy. The interface of choice for move-only payloads
+    // (the Listing 3.5 shared_ptr pop cannot even name them without an
+    // allocation the structure doesn't need).
+    std::optional<T> try_pop();
+
     bool empty() const;
     size_t size() const;
 };
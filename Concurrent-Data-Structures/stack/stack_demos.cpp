@@ -11,6 +11,7 @@
 void demonstrate_race_condition();
 void demonstrate_safe_operations();
 void demonstrate_exception_safety();
+void demonstrate_move_out_operations();
 void performance_comparison();
 
 // --- Demonstration of the Race Condition Problem ---
@@ -146,6 +147,33 @@ void demonstrate_exception_safety() {
     std::cout << std::endl;
 }
 
+// --- Demonstration of emplace and the move-out try_pop ---
+void demonstrate_move_out_operations() {
+    std::cout << "\n=== DEMONSTRATING EMPLACE AND MOVE-OUT POP ===" << std::endl;
+
+    // try_pop on an int stack: empty maps to nullopt, no exception to catch.
+    threadsafe_stack<int> ints;
+    ints.push(1);
+    ints.push(2);
+    while (auto value = ints.try_pop()) {
+        std::cout << "try_pop got: " << *value << std::endl;
+    }
+    std::cout << "try_pop on empty stack returned nullopt: "
+              << (ints.try_pop() ? "NO" : "yes") << std::endl;
+
+    // A move-only payload: the shared_ptr pop can't hold one without an
+    // allocation per element; emplace + try_pop move it through the
+    // stack with none beyond the payload itself.
+    threadsafe_stack<std::unique_ptr<int>> owners;
+    owners.emplace(new int(42));           // unique_ptr built in place
+    owners.push(std::make_unique<int>(7)); // or moved in
+    std::cout << "Move-only stack size: " << owners.size() << std::endl;
+    while (auto owned = owners.try_pop()) {
+        std::cout << "Moved out unique_ptr to: " << **owned << std::endl;
+    }
+    std::cout << std::endl;
+}
+
 // --- Performance Comparison ---
 void performance_comparison() {
     std::cout << "\n=== PERFORMANCE COMPARISON ===" << std::endl;
@@ -208,6 +236,7 @@ int main() {
     demonstrate_race_condition();
     demonstrate_safe_operations();
     demonstrate_exception_safety();
+    demonstrate_move_out_operations();
     performance_comparison();
     
     return 0;
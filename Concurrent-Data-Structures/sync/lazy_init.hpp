@@ -0,0 +1,118 @@
+#ifndef CDS_LAZY_INIT_HPP
+#define CDS_LAZY_INIT_HPP
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <utility>
+
+// lazy_init<T>: once-initialization as a component.
+//
+// The chapter-3 material (concurrency/03_11) shows the menagerie -
+// double-checked locking done wrong, mutex-guarded checks, call_once -
+// and every production use ends up re-deriving the same correct
+// combination. This is that combination, packaged:
+//
+//   - fast path: one acquire load of a pointer. After initialization
+//     a reader pays a load and a predictable branch, nothing else -
+//     no lock, no once_flag fence, no function-local-static guard
+//     check in someone else's TU.
+//   - slow path: std::call_once, so exactly one thread constructs,
+//     concurrent callers block until it finishes, and a constructor
+//     that THROWS leaves the flag unset for the next caller to retry
+//     (the property hand-rolled double-checked schemes usually lose).
+//
+// The value lives in aligned storage inside the lazy_init itself and
+// is constructed there by placement new: no heap allocation, and a
+// lazy_init placed in an arena (or an mmap'd region via placement
+// new) keeps its T in that same memory. Destruction runs in
+// ~lazy_init if construction ever happened.
+//
+// Unlike a function-local static, the slow path takes the constructor
+// arguments at the call site, and peek() lets shutdown paths ask
+// "did this ever get built?" without building it.
+
+namespace cds
+{
+
+template<typename T>
+class lazy_init
+{
+public:
+    lazy_init() = default;
+
+    lazy_init(const lazy_init&) = delete;
+    lazy_init& operator=(const lazy_init&) = delete;
+
+    ~lazy_init()
+    {
+        T* const p = ptr_.load(std::memory_order_acquire);
+        if (p)
+        {
+            p->~T();
+        }
+    }
+
+    // Returns the value, constructing it from args on first call.
+    // Arguments passed by losing racers are evaluated but unused -
+    // keep them cheap or use get_with().
+    template<typename... Args>
+    T& get(Args&&... args)
+    {
+        T* p = ptr_.load(std::memory_order_acquire);
+        if (p)
+        {
+            return *p;  // Fast path: one load, one branch
+        }
+        std::call_once(flag_, [&]
+        {
+            T* const built = ::new (storage_) T(std::forward<Args>(args)...);
+            ptr_.store(built, std::memory_order_release);
+        });
+        return *ptr_.load(std::memory_order_acquire);
+    }
+
+    // Same, but the factory runs only if this call constructs - for
+    // expensive setup (reading the stop-word file, mapping the index
+    // snapshot) that must not happen on every lookup.
+    template<typename Factory>
+    T& get_with(Factory&& factory)
+    {
+        T* p = ptr_.load(std::memory_order_acquire);
+        if (p)
+        {
+            return *p;
+        }
+        std::call_once(flag_, [&]
+        {
+            T* const built = ::new (storage_) T(factory());
+            ptr_.store(built, std::memory_order_release);
+        });
+        return *ptr_.load(std::memory_order_acquire);
+    }
+
+    // The value if initialized, nullptr otherwise; never constructs.
+    T* peek()
+    {
+        return ptr_.load(std::memory_order_acquire);
+    }
+
+    const T* peek() const
+    {
+        return ptr_.load(std::memory_order_acquire);
+    }
+
+    bool is_initialized() const
+    {
+        return ptr_.load(std::memory_order_acquire) != nullptr;
+    }
+
+private:
+    alignas(T) unsigned char storage_[sizeof(T)];
+    std::once_flag flag_;
+    std::atomic<T*> ptr_{nullptr};
+};
+
+} // namespace cds
+
+#endif // CDS_LAZY_INIT_HPP
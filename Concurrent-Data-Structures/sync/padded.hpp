@@ -0,0 +1,81 @@
+#ifndef CDS_PADDED_HPP
+#define CDS_PADDED_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// padded<T>: T alone on its cache line.
+//
+// False sharing is the silent tax on shared structures: two logically
+// independent atomics that happen to sit in the same cache line turn
+// every write into an invalidation of the OTHER variable's cached copy,
+// and two threads that never touch the same data still ping-pong a line
+// between their cores. It shows up wherever hot counters are packed
+// adjacently - a ring's head and tail indices, per-worker stat slots,
+// counters stored next to each other in a map node - and it is invisible
+// in the source: the code is correct, just slow.
+//
+// padded<T> fixes the layout, not the code: it is a T aligned to (and
+// therefore sized to a multiple of) the destructive interference size,
+// so two padded objects can never share a line. The alignment constant
+// comes from std::hardware_destructive_interference_size where the
+// library provides it, else the 64 bytes that x86 and mainstream ARM
+// actually have.
+//
+// For class types (every std::atomic) padded<T> inherits from T, so the
+// wrapped object keeps its full interface - a padded<std::atomic<int>>
+// is loaded, stored and CAS'd exactly like the bare atomic, and
+// adopting the wrapper changes a declaration, not the call sites. For
+// scalars, which cannot be bases, the value lives in a .value member.
+//
+// Pad what is written by different threads; padding read-mostly data
+// just wastes cache. A line that several threads only read is happily
+// shared.
+
+namespace cds
+{
+
+#if defined(__cpp_lib_hardware_interference_size)
+// GCC warns that the value can vary with -mtune; that is fine here - it
+// is a layout hint, not ABI - so take the library's number quietly.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+inline constexpr std::size_t kCacheLineSize =
+    std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+inline constexpr std::size_t kCacheLineSize = 64;
+#endif
+
+template<typename T, bool = std::is_class<T>::value>
+struct alignas(kCacheLineSize) padded;
+
+// Class types: inherit, so the full interface stays available on the
+// wrapper itself.
+template<typename T>
+struct alignas(kCacheLineSize) padded<T, true> : T
+{
+    using T::T;
+    padded() = default;
+};
+
+// Scalars and other non-class types: a .value member.
+template<typename T>
+struct alignas(kCacheLineSize) padded<T, false>
+{
+    padded() = default;
+
+    explicit padded(T initial) : value(std::move(initial)) {}
+
+    T value{};
+};
+
+} // namespace cds
+
+#endif // CDS_PADDED_HPP
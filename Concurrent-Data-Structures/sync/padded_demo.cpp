@@ -0,0 +1,109 @@
+#include "padded.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Demo for cds::padded - curing false sharing by layout.
+
+int main()
+{
+    std::cout << "=== Padded Wrapper Demo ===" << std::endl;
+
+    // 1. What the wrapper actually does: size and alignment
+    std::cout << "\n1. Layout:" << std::endl;
+    {
+        std::cout << "Interference size in use: " << cds::kCacheLineSize
+                  << " bytes" << std::endl;
+        std::cout << "sizeof(std::atomic<int>)              = "
+                  << sizeof(std::atomic<int>) << std::endl;
+        std::cout << "sizeof(cds::padded<std::atomic<int>>) = "
+                  << sizeof(cds::padded<std::atomic<int>>) << std::endl;
+
+        cds::padded<std::atomic<int>> a[2];
+        std::cout << "Adjacent padded atomics are "
+                  << reinterpret_cast<char*>(&a[1]) -
+                         reinterpret_cast<char*>(&a[0])
+                  << " bytes apart: never one line" << std::endl;
+    }
+
+    // 2. The wrapped interface survives: padded<atomic> IS an atomic
+    std::cout << "\n2. Drop-in adoption (class types inherit):" << std::endl;
+    {
+        cds::padded<std::atomic<std::uint64_t>> counter{0};
+        counter.fetch_add(41, std::memory_order_relaxed);
+        ++counter;
+        std::cout << "load() through the wrapper: " << counter.load()
+                  << " (no .value at atomic call sites)" << std::endl;
+
+        cds::padded<long> scalar{7};
+        std::cout << "Scalars use .value: " << scalar.value << std::endl;
+    }
+
+    // 3. The bug it fixes: two threads, two counters, one line vs two
+    std::cout << "\n3. Independent counters, 2 threads x 20M increments:"
+              << std::endl;
+    {
+        std::uint64_t const iterations = 20000000;
+
+        auto const run = [&](std::atomic<std::uint64_t>& c0,
+                             std::atomic<std::uint64_t>& c1)
+        {
+            auto const start = std::chrono::steady_clock::now();
+            std::thread t0([&]
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    c0.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+            std::thread t1([&]
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    c1.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+            t0.join();
+            t1.join();
+            return std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        };
+
+        // Packed: both counters in one cache line.
+        struct
+        {
+            std::atomic<std::uint64_t> a{0};
+            std::atomic<std::uint64_t> b{0};
+        } packed;
+        double const packed_time = run(packed.a, packed.b);
+
+        // Padded: one line each.
+        cds::padded<std::atomic<std::uint64_t>> pa{0};
+        cds::padded<std::atomic<std::uint64_t>> pb{0};
+        double const padded_time = run(pa, pb);
+
+        std::cout << "  packed: " << packed_time << " s" << std::endl;
+        std::cout << "  padded: " << padded_time << " s ("
+                  << packed_time / padded_time << "x)" << std::endl;
+        if (std::thread::hardware_concurrency() <= 1)
+        {
+            // False sharing is two CORES invalidating each other's copy
+            // of a line; one hardware thread has one cache, so there is
+            // nothing to invalidate and both layouts run alike.
+            std::cout << "  (single hardware thread: no cross-core "
+                         "invalidation, expect ~1x)" << std::endl;
+        }
+    }
+
+    std::cout << "\nDemo completed. Key features:" << std::endl;
+    std::cout << "- alignas(interference size): two padded objects never share a line" << std::endl;
+    std::cout << "- Class types inherit: adopting changes declarations, not call sites" << std::endl;
+    std::cout << "- Uses std::hardware_destructive_interference_size when available" << std::endl;
+    std::cout << "- Pad write-shared data only; read-mostly lines share fine" << std::endl;
+
+    return 0;
+}
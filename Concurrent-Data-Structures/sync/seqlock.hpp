@@ -0,0 +1,161 @@
+#ifndef CDS_SEQLOCK_HPP
+#define CDS_SEQLOCK_HPP
+
+#include "spinlock.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+// seqlock<T>: optimistic multi-word publication.
+//
+// The stats problem in one line: a worker writes a block of counters,
+// a monitor reads that block at high frequency, and a mutex per read
+// makes the MONITOR perturb the WORKER. A seqlock inverts the usual
+// reader/writer priority:
+//
+//   - the writer bumps a sequence counter to odd, writes the words,
+//     bumps it back to even. It never waits for readers and cannot
+//     even tell they exist - writes are wait-free with respect to
+//     reads.
+//   - a reader loads the sequence, copies the words, loads the
+//     sequence again. Same even value both times means the copy is a
+//     consistent snapshot; otherwise a write overlapped and the
+//     reader retries.
+//
+// The trade against a shared_mutex is that readers can starve under a
+// write storm - the right shape when writes are periodic (stats
+// ticks) and reads must be invisible. Distinct writers serialize on
+// an internal spinlock (cds::spinlock), so multi-writer use is safe;
+// the common case is one writer, which never contends it.
+//
+// T must be trivially copyable and should be small - a cache line or
+// two of counters. The words are stored as relaxed-ish atomics with
+// the Boehm acquire/release recipe rather than raw memory plus
+// fences, so the race the algorithm relies on is one the memory
+// model (and TSan) actually sanctions: a torn copy can be OBSERVED,
+// but it is always DETECTED and discarded.
+
+namespace cds
+{
+
+template<typename T>
+class seqlock
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "seqlock<T> copies T word-by-word; T must be trivially "
+                  "copyable");
+
+public:
+    seqlock()
+    {
+        T initial{};
+        store_words(initial);
+    }
+
+    explicit seqlock(const T& initial)
+    {
+        store_words(initial);
+    }
+
+    seqlock(const seqlock&) = delete;
+    seqlock& operator=(const seqlock&) = delete;
+
+    // Consistent copy of the value; retries while a write overlaps.
+    T load() const
+    {
+        T value;
+        backoff b;
+        for (;;)
+        {
+            std::uint64_t const s1 = seq_.load(std::memory_order_acquire);
+            if ((s1 & 1) == 0)
+            {
+                load_words(value);
+                // The acquire loads in load_words order this re-read
+                // after the copy; equal means no write overlapped.
+                if (seq_.load(std::memory_order_relaxed) == s1)
+                {
+                    return value;
+                }
+            }
+            b.pause();
+        }
+    }
+
+    // Publishes a new value. Wait-free with respect to readers; other
+    // writers serialize on the internal lock.
+    void store(const T& value)
+    {
+        std::lock_guard<spinlock> guard(writer_lock_);
+        std::uint64_t const s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);  // Odd: write open
+        store_words(value);  // Release stores keep the odd marker ahead
+        seq_.store(s + 2, std::memory_order_release);  // Even: write done
+    }
+
+    // Read-modify-write under the writer lock: fn gets the current
+    // value by reference. For counter blocks, this is the increment
+    // path.
+    template<typename Fn>
+    void update(Fn&& fn)
+    {
+        std::lock_guard<spinlock> guard(writer_lock_);
+        T value;
+        load_words_plain(value);
+        fn(value);
+        std::uint64_t const s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        store_words(value);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(T) + 7) / 8;
+
+    // Writer side. The release ordering on each word store keeps the
+    // odd sequence store visible before any new word is.
+    void store_words(const T& value)
+    {
+        std::uint64_t buffer[kWords] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+        for (std::size_t i = 0; i < kWords; ++i)
+        {
+            words_[i].store(buffer[i], std::memory_order_release);
+        }
+    }
+
+    // Reader side. Acquire loads order the sequence re-read after the
+    // copy (and synchronize with the writer's release stores).
+    void load_words(T& out) const
+    {
+        std::uint64_t buffer[kWords];
+        for (std::size_t i = 0; i < kWords; ++i)
+        {
+            buffer[i] = words_[i].load(std::memory_order_acquire);
+        }
+        std::memcpy(&out, buffer, sizeof(T));
+    }
+
+    // Under the writer lock no load can tear; relaxed is enough.
+    void load_words_plain(T& out) const
+    {
+        std::uint64_t buffer[kWords];
+        for (std::size_t i = 0; i < kWords; ++i)
+        {
+            buffer[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::memcpy(&out, buffer, sizeof(T));
+    }
+
+    std::atomic<std::uint64_t> seq_{0};
+    std::atomic<std::uint64_t> words_[kWords];
+    spinlock writer_lock_;
+};
+
+} // namespace cds
+
+#endif // CDS_SEQLOCK_HPP
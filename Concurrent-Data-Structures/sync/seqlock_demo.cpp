@@ -0,0 +1,179 @@
+#include "seqlock.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Demo for cds::seqlock - consistent multi-word snapshots where the
+// readers must not perturb the writer (the stats-monitoring shape).
+
+// A stats block like the scheduler's and indexer's: several related
+// counters that only make sense together.
+struct stats_block
+{
+    std::uint64_t tasks = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t waits = 0;
+    // Invariant maintained by the writer: checksum = tasks+bytes+waits.
+    // A torn read surfaces as a checksum mismatch.
+    std::uint64_t checksum = 0;
+
+    bool consistent() const
+    {
+        return checksum == tasks + bytes + waits;
+    }
+};
+
+int main()
+{
+    std::cout << "=== Seqlock Demo ===" << std::endl;
+
+    // 1. Basic store/load/update
+    std::cout << "\n1. Basic operations:" << std::endl;
+    {
+        cds::seqlock<stats_block> stats;
+        stats.store({10, 2000, 3, 2013});
+        stats_block const s = stats.load();
+        std::cout << "Stored and loaded: tasks=" << s.tasks << " bytes="
+                  << s.bytes << " consistent=" << (s.consistent() ? "yes" : "NO!")
+                  << std::endl;
+        stats.update([](stats_block& b)
+        {
+            b.tasks += 1;
+            b.bytes += 100;
+            b.checksum = b.tasks + b.bytes + b.waits;
+        });
+        std::cout << "After update: tasks=" << stats.load().tasks
+                  << " bytes=" << stats.load().bytes << std::endl;
+    }
+
+    // 2. No torn reads under a hammering writer
+    std::cout << "\n2. Consistency, 1 writer x 3 readers, 2 seconds:" << std::endl;
+    {
+        cds::seqlock<stats_block> stats;
+        std::atomic<bool> stop(false);
+        std::atomic<long long> reads(0);
+        std::atomic<long long> torn(0);
+
+        std::thread writer([&]
+        {
+            stats_block b;
+            while (!stop.load())
+            {
+                b.tasks += 1;
+                b.bytes += 512;
+                b.waits += (b.tasks % 7 == 0);
+                b.checksum = b.tasks + b.bytes + b.waits;
+                stats.store(b);
+            }
+        });
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r)
+        {
+            readers.emplace_back([&]
+            {
+                long long local_reads = 0;
+                long long local_torn = 0;
+                while (!stop.load())
+                {
+                    stats_block const s = stats.load();
+                    ++local_reads;
+                    if (!s.consistent())
+                    {
+                        ++local_torn;
+                    }
+                }
+                reads.fetch_add(local_reads);
+                torn.fetch_add(local_torn);
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+        stop.store(true);
+        writer.join();
+        for (auto& t : readers)
+        {
+            t.join();
+        }
+        std::cout << reads.load() << " snapshot reads, " << torn.load()
+                  << " torn (expected 0); writer reached "
+                  << stats.load().tasks << " tasks" << std::endl;
+    }
+
+    // 3. Writer throughput: how much do the readers cost the writer?
+    //    Under a mutex every read can stall the writer; under the
+    //    seqlock the writer never even sees them.
+    std::cout << "\n3. Writer throughput with 3 polling readers:" << std::endl;
+    {
+        int const writes = 200000;
+
+        auto const run = [&](auto&& do_write, auto&& do_read)
+        {
+            std::atomic<bool> stop(false);
+            std::vector<std::thread> readers;
+            for (int r = 0; r < 3; ++r)
+            {
+                readers.emplace_back([&]
+                {
+                    while (!stop.load())
+                    {
+                        do_read();
+                    }
+                });
+            }
+            auto const start = std::chrono::steady_clock::now();
+            for (int i = 0; i < writes; ++i)
+            {
+                do_write();
+            }
+            double const seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+            stop.store(true);
+            for (auto& t : readers)
+            {
+                t.join();
+            }
+            return writes / seconds;
+        };
+
+        std::mutex m;
+        stats_block locked_block;
+        double const mutex_rate = run(
+            [&] { std::lock_guard<std::mutex> g(m); locked_block.tasks += 1; },
+            [&] { std::lock_guard<std::mutex> g(m); (void)locked_block.tasks; });
+
+        cds::seqlock<stats_block> seq_block;
+        stats_block shadow;
+        double const seq_rate = run(
+            [&] { shadow.tasks += 1; seq_block.store(shadow); },
+            [&] { (void)seq_block.load(); });
+
+        std::cout << "  mutex  : " << static_cast<long long>(mutex_rate)
+                  << " writes/sec" << std::endl;
+        std::cout << "  seqlock: " << static_cast<long long>(seq_rate)
+                  << " writes/sec (" << seq_rate / mutex_rate << "x)"
+                  << std::endl;
+        if (std::thread::hardware_concurrency() <= 1)
+        {
+            // With one hardware thread the readers never actually hold
+            // the mutex while the writer wants it, so the mutex runs at
+            // its uncontended best while the seqlock still pays its
+            // per-store word fencing. The case the seqlock exists for -
+            // reader cores stalling the writer's lock acquisition -
+            // needs real parallelism to appear.
+            std::cout << "  (single hardware thread: the mutex is never "
+                         "contended here, so expect <1x)" << std::endl;
+        }
+    }
+
+    std::cout << "\nDemo completed. Key features:" << std::endl;
+    std::cout << "- Writers never wait for readers: stores are uncontended" << std::endl;
+    std::cout << "- Readers detect and discard torn copies via the sequence" << std::endl;
+    std::cout << "- Multi-writer safe: distinct writers serialize internally" << std::endl;
+    std::cout << "- update() gives read-modify-write for counter blocks" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "spinlock.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Demo for cds::spinlock and cds::backoff - the TTAS + exponential
+// backoff upgrade of the naive atomic_flag spinlock from
+// concurrency/05_04_atomic_flag.cpp.
+
+// The textbook version, kept here as the baseline: spins on
+// test_and_set, hammering the cache line with RMWs.
+class naive_spinlock
+{
+    std::atomic_flag flag = ATOMIC_FLAG_INIT;
+public:
+    void lock()
+    {
+        while (flag.test_and_set(std::memory_order_acquire))
+        {
+        }
+    }
+    void unlock()
+    {
+        flag.clear(std::memory_order_release);
+    }
+};
+
+// Contention benchmark: num_threads threads each do a short critical
+// section (one counter increment - the per-shard/per-bucket case the
+// lock is sized for) iters times.
+template<typename Lock>
+double contend(unsigned num_threads, int iters, long long& counter_out)
+{
+    Lock lock;
+    long long counter = 0;
+    std::atomic<bool> go(false);
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&]
+        {
+            while (!go.load())
+            {
+                cds::backoff::cpu_relax();
+            }
+            for (int i = 0; i < iters; ++i)
+            {
+                std::lock_guard<Lock> guard(lock);
+                ++counter;
+            }
+        });
+    }
+    auto const start = std::chrono::steady_clock::now();
+    go.store(true);
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    double const seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    counter_out = counter;
+    return seconds;
+}
+
+int main()
+{
+    std::cout << "=== TTAS Spinlock Demo ===" << std::endl;
+
+    // 1. Basic Lockable behaviour
+    std::cout << "\n1. Basic operations:" << std::endl;
+    {
+        cds::spinlock lock;
+        {
+            std::lock_guard<cds::spinlock> guard(lock);
+            std::cout << "lock_guard holds the spinlock" << std::endl;
+            std::cout << "try_lock while held: "
+                      << (lock.try_lock() ? "acquired (BUG!)" : "refused")
+                      << std::endl;
+        }
+        std::cout << "try_lock after release: "
+                  << (lock.try_lock() ? "acquired" : "refused (BUG!)")
+                  << std::endl;
+        lock.unlock();
+    }
+
+    // 2. backoff as a standalone spin-wait helper
+    std::cout << "\n2. backoff helper on a flag wait:" << std::endl;
+    {
+        std::atomic<bool> ready(false);
+        std::thread setter([&]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            ready.store(true);
+        });
+        cds::backoff b;
+        long long rounds = 0;
+        while (!ready.load())
+        {
+            b.pause();  // Doubling pauses, then yields
+            ++rounds;
+        }
+        setter.join();
+        std::cout << "Waited out ~5ms in " << rounds
+                  << " backoff rounds (pure spin would be millions)"
+                  << std::endl;
+    }
+
+    // 3. Contention: naive TAS vs TTAS+backoff vs std::mutex
+    //    Short critical section, 4 threads. On a single hardware
+    //    thread any spinner burns its remaining timeslice before the
+    //    owner can run, so backoff's yield escalation is what keeps
+    //    the spinlocks competitive there; the TTAS load-spin advantage
+    //    shows up with real cores sharing the line.
+    std::cout << "\n3. Contention, 4 threads x 100000 increments:" << std::endl;
+    {
+        unsigned const num_threads = 4;
+        int const iters = 100000;
+        long long const expected =
+            static_cast<long long>(num_threads) * iters;
+        long long counter = 0;
+
+        double const naive_s =
+            contend<naive_spinlock>(num_threads, iters, counter);
+        std::cout << "  naive TAS spin : " << naive_s << "s, counter "
+                  << counter << (counter == expected ? "" : " (WRONG!)")
+                  << std::endl;
+        double const ttas_s =
+            contend<cds::spinlock>(num_threads, iters, counter);
+        std::cout << "  TTAS + backoff : " << ttas_s << "s, counter "
+                  << counter << (counter == expected ? "" : " (WRONG!)")
+                  << std::endl;
+        double const mutex_s =
+            contend<std::mutex>(num_threads, iters, counter);
+        std::cout << "  std::mutex     : " << mutex_s << "s, counter "
+                  << counter << (counter == expected ? "" : " (WRONG!)")
+                  << std::endl;
+        std::cout << "  TTAS vs naive: " << naive_s / ttas_s << "x" << std::endl;
+    }
+
+    std::cout << "\nDemo completed. Key features:" << std::endl;
+    std::cout << "- Waiters spin on loads, not RMWs: the line stays cached" << std::endl;
+    std::cout << "- Exponential backoff spreads waiters off the freed line" << std::endl;
+    std::cout << "- Yield past the cap copes with preempted/absent owners" << std::endl;
+    std::cout << "- backoff is reusable for any spin-wait retry loop" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#ifndef CDS_STRIPED_COUNTER_HPP
+#define CDS_STRIPED_COUNTER_HPP
+
+#include "padded.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// striped_counter: a cross-thread counter that trades read cost for
+// write cost.
+//
+// A single shared std::atomic counter is correct but slow under load:
+// every increment is an RMW on the same cache line, so the line
+// ping-pongs between every core that touches it, and a counter bumped
+// on a hot path (per push, per token, per edge) becomes a serialization
+// point all by itself. The striped version splits the count across a
+// small array of cache-line-padded slots; each thread always hits its
+// own slot, so increments are uncontended relaxed adds on a line no
+// other core writes. Reading sums the slots - more expensive, and only
+// eventually consistent (a sum taken while writers run may miss
+// in-flight updates), but size()/depth() queries are monitoring reads
+// that tolerate exactly that.
+//
+// Deltas are signed: a thread may decrement a count another thread
+// incremented (consumer popping a producer's push), which can drive an
+// individual slot negative. Only the sum is meaningful.
+//
+// Use it when writes vastly outnumber reads and the read may be a
+// moment stale. For an exact, linearizable count, keep the lock.
+
+namespace cds
+{
+
+class striped_counter
+{
+public:
+    striped_counter() = default;
+    striped_counter(const striped_counter&) = delete;
+    striped_counter& operator=(const striped_counter&) = delete;
+
+    // Uncontended in the common case: each thread owns one stripe.
+    void add(std::int64_t delta)
+    {
+        slots_[my_stripe()].fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    void increment() { add(1); }
+    void decrement() { add(-1); }
+
+    // Sum of all stripes. Eventually consistent: updates racing the sum
+    // may or may not be included, but no update is ever lost.
+    std::int64_t load() const
+    {
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i < kStripes; ++i)
+        {
+            total += slots_[i].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // load() clamped at zero and sized - the shape size() queries want.
+    // A transiently negative sum (a decrement observed before the
+    // increment it pairs with) reads as empty, not as huge.
+    std::size_t load_size() const
+    {
+        std::int64_t const total = load();
+        return total > 0 ? static_cast<std::size_t>(total) : 0;
+    }
+
+    // Zeroes every stripe. Not safe against concurrent writers; meant
+    // for clear()-style paths that already exclude them.
+    void reset()
+    {
+        for (std::size_t i = 0; i < kStripes; ++i)
+        {
+            slots_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    // Power of two so stripe selection is a mask. More stripes than
+    // this and the read-side sum starts to cost real cache misses for
+    // little extra write-side spread.
+    static constexpr std::size_t kStripes = 16;
+
+    // padded<> keeps each stripe alone on its line - the whole point.
+    using slot = padded<std::atomic<std::int64_t>>;
+
+    // Each thread gets a stripe on first use, handed out round-robin so
+    // up to kStripes concurrent threads never collide. Hashing the
+    // thread id would also work but can clump; round-robin cannot.
+    static std::size_t my_stripe()
+    {
+        static std::atomic<std::size_t> next{0};
+        thread_local std::size_t const stripe =
+            next.fetch_add(1, std::memory_order_relaxed) & (kStripes - 1);
+        return stripe;
+    }
+
+    slot slots_[kStripes] = {};  // Value-init: every stripe starts at 0
+};
+
+} // namespace cds
+
+#endif // CDS_STRIPED_COUNTER_HPP
@@ -0,0 +1,126 @@
+#include "striped_counter.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Demo for cds::striped_counter - cross-thread counting without a
+// shared cache line (the queue-depth / index-size shape).
+
+int main()
+{
+    std::cout << "=== Striped Counter Demo ===" << std::endl;
+
+    // 1. Correctness: concurrent increments and decrements sum exactly
+    std::cout << "\n1. Correctness, 4 threads x 100000 mixed ops:" << std::endl;
+    {
+        cds::striped_counter counter;
+        int const per_thread = 100000;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&counter, per_thread]
+            {
+                // Two increments per decrement: net +1 per iteration.
+                for (int i = 0; i < per_thread; ++i)
+                {
+                    counter.increment();
+                    counter.increment();
+                    counter.decrement();
+                }
+            });
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        std::cout << "Final count: " << counter.load()
+                  << " (expected " << 4 * per_thread << ")" << std::endl;
+    }
+
+    // 2. Cross-thread decrements: a consumer popping a producer's push
+    //    can drive one stripe negative; the sum stays right.
+    std::cout << "\n2. Producer/consumer pairing:" << std::endl;
+    {
+        cds::striped_counter depth;
+        int const items = 50000;
+        std::thread producer([&]
+        {
+            for (int i = 0; i < items; ++i)
+            {
+                depth.increment();
+            }
+        });
+        std::thread consumer([&]
+        {
+            for (int i = 0; i < items - 7; ++i)
+            {
+                depth.decrement();
+            }
+        });
+        producer.join();
+        consumer.join();
+        std::cout << "Depth after " << items << " pushes, " << (items - 7)
+                  << " pops: " << depth.load() << " (expected 7); load_size()="
+                  << depth.load_size() << std::endl;
+    }
+
+    // 3. Throughput: striped vs one shared atomic, 4 incrementing threads
+    std::cout << "\n3. Increment throughput, 4 threads:" << std::endl;
+    {
+        int const per_thread = 2000000;
+
+        auto const run = [&](auto&& bump)
+        {
+            std::vector<std::thread> threads;
+            auto const start = std::chrono::steady_clock::now();
+            for (int t = 0; t < 4; ++t)
+            {
+                threads.emplace_back([&bump, per_thread]
+                {
+                    for (int i = 0; i < per_thread; ++i)
+                    {
+                        bump();
+                    }
+                });
+            }
+            for (auto& t : threads)
+            {
+                t.join();
+            }
+            double const seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+            return (4.0 * per_thread) / seconds / 1e6;
+        };
+
+        std::atomic<std::int64_t> shared(0);
+        double const shared_rate = run(
+            [&] { shared.fetch_add(1, std::memory_order_relaxed); });
+
+        cds::striped_counter striped;
+        double const striped_rate = run([&] { striped.increment(); });
+
+        std::cout << "  shared atomic : " << shared_rate << " M ops/sec"
+                  << std::endl;
+        std::cout << "  striped       : " << striped_rate << " M ops/sec ("
+                  << striped_rate / shared_rate << "x)" << std::endl;
+        if (std::thread::hardware_concurrency() <= 1)
+        {
+            // The win is avoiding cache-line ping-pong between cores;
+            // with one hardware thread there is no other core to
+            // ping-pong with, so both run at the uncontended rate.
+            std::cout << "  (single hardware thread: no line bouncing to "
+                         "avoid, expect ~1x)" << std::endl;
+        }
+    }
+
+    std::cout << "\nDemo completed. Key features:" << std::endl;
+    std::cout << "- Writers hit a private cache-line-padded stripe: no ping-pong" << std::endl;
+    std::cout << "- Readers sum the stripes: eventually consistent, never lossy" << std::endl;
+    std::cout << "- Signed deltas: consumers may decrement a producer's stripe" << std::endl;
+    std::cout << "- load_size() clamps transiently negative sums to zero" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file IndexBench.cpp
+ * @brief Indexing throughput benchmark over a synthetic corpus.
+ *
+ * Generates a corpus with configurable file count, size distribution and
+ * vocabulary skew, then runs the full scan -> read -> tokenize -> index
+ * pipeline at several thread configurations and reports MiB/s and
+ * tokens/s for each. Word frequencies follow a Zipf distribution so the
+ * dictionary and posting lists stress the same skew real text does.
+ *
+ * Usage: IndexBench [files] [avg_kib] [vocabulary] [zipf_s]
+ * Defaults: 500 files, 32 KiB average, 20000 words, s = 1.0.
+ */
+#include "ConcurrentQueue.hpp"
+#include "FileScanner.hpp"
+#include "IndexerWorker.hpp"
+#include "IndexingStats.hpp"
+#include "InvertedIndex.hpp"
+#include "ReaderWorker.hpp"
+
+#include <algorithm> // For std::lower_bound
+#include <chrono>
+#include <cmath>     // For std::pow (Zipf weights)
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    /** @brief Knobs for the synthetic corpus. */
+    struct CorpusConfig {
+        size_t file_count = 500;
+        size_t avg_file_kib = 32;
+        size_t vocabulary = 20000;
+        double zipf_s = 1.0; ///< Zipf exponent; higher = more skew.
+    };
+
+    /** @brief The thread configurations benchmarked, (readers, indexers). */
+    const std::vector<std::pair<int, int>> kThreadConfigs = {
+        {1, 1}, {1, 2}, {2, 2}, {2, 4}};
+
+    /**
+     * @brief Builds the word list: varied lengths so tokenization and
+     * interning see realistic key sizes.
+     */
+    std::vector<std::string> build_vocabulary(size_t n, std::mt19937& rng) {
+        static const char* kSyllables[] = {"ba", "co", "dun", "el", "fi", "gor",
+                                           "ha", "in", "ju", "ka", "lo", "mer",
+                                           "na", "os", "pre", "qua", "ri", "sol",
+                                           "ta", "ur", "vex", "wi", "xy", "zen"};
+        std::uniform_int_distribution<size_t> syllable(0, std::size(kSyllables) - 1);
+        std::uniform_int_distribution<int> length(2, 5);
+        std::vector<std::string> words;
+        words.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            std::string word;
+            const int parts = length(rng);
+            for (int p = 0; p < parts; ++p) {
+                word += kSyllables[syllable(rng)];
+            }
+            word += std::to_string(i); // Guarantee uniqueness.
+            words.push_back(std::move(word));
+        }
+        return words;
+    }
+
+    /**
+     * @brief Cumulative Zipf weights over ranks 1..n, for inverse-CDF
+     * sampling: a handful of head words dominate, exactly like a query or
+     * text log.
+     */
+    std::vector<double> zipf_cdf(size_t n, double s) {
+        std::vector<double> cdf(n);
+        double total = 0.0;
+        for (size_t rank = 1; rank <= n; ++rank) {
+            total += 1.0 / std::pow(static_cast<double>(rank), s);
+            cdf[rank - 1] = total;
+        }
+        for (double& c : cdf) {
+            c /= total;
+        }
+        return cdf;
+    }
+
+    /**
+     * @brief Writes the corpus under 'dir' and returns its total bytes.
+     *
+     * Sizes are bimodal - most files small, one in ten several times the
+     * average - so the run exercises both the pooled-buffer and the
+     * mmap/chunked paths.
+     */
+    uint64_t generate_corpus(const std::filesystem::path& dir,
+                             const CorpusConfig& config, std::mt19937& rng) {
+        const std::vector<std::string> words =
+            build_vocabulary(config.vocabulary, rng);
+        const std::vector<double> cdf = zipf_cdf(config.vocabulary, config.zipf_s);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        uint64_t total_bytes = 0;
+        for (size_t f = 0; f < config.file_count; ++f) {
+            // 90% of files land well under the average, the rest well over.
+            const size_t target = f % 10 == 9 ? config.avg_file_kib * 1024 * 6
+                                              : config.avg_file_kib * 1024 / 2;
+            std::ofstream out(dir / ("doc" + std::to_string(f) + ".txt"));
+            size_t written = 0;
+            size_t line_words = 0;
+            while (written < target) {
+                const auto it = std::lower_bound(cdf.begin(), cdf.end(),
+                                                 uniform(rng));
+                const std::string& word =
+                    words[static_cast<size_t>(it - cdf.begin())];
+                out << word;
+                written += word.size() + 1;
+                if (++line_words == 12) {
+                    out << '\n';
+                    line_words = 0;
+                } else {
+                    out << ' ';
+                }
+            }
+            out << '\n';
+            total_bytes += written + 1;
+        }
+        return total_bytes;
+    }
+
+    /** @brief One pipeline run's measurements. */
+    struct RunResult {
+        double seconds = 0.0;
+        uint64_t tokens = 0;
+        size_t unique_words = 0;
+    };
+
+    /**
+     * @brief Runs the full pipeline over 'dir' once, mirroring main()'s
+     * full-scan setup, and returns wall time and token throughput inputs.
+     */
+    RunResult run_pipeline(const std::string& dir, int reader_count,
+                           int indexer_count) {
+        ConcurrentQueue<FileInfo> file_queue(4096);
+        ConcurrentQueue<FileContent> content_queue(
+            static_cast<size_t>(indexer_count) * 16);
+        BufferPool buffer_pool(static_cast<size_t>(indexer_count) * 16);
+        InvertedIndex index;
+        IndexingStats stats(static_cast<size_t>(reader_count),
+                            static_cast<size_t>(indexer_count));
+        FileScanner scanner(dir, file_queue);
+
+        const auto start = std::chrono::steady_clock::now();
+        std::thread scanner_thread([&scanner] { scanner.start_scanning(); });
+
+        std::vector<std::unique_ptr<ReaderWorker>> readers;
+        std::vector<std::thread> reader_threads;
+        for (int i = 0; i < reader_count; ++i) {
+            readers.push_back(std::make_unique<ReaderWorker>(
+                file_queue, content_queue, buffer_pool,
+                stats.reader(static_cast<size_t>(i))));
+            reader_threads.emplace_back(
+                [worker = readers.back().get()] { (*worker)(); });
+        }
+        std::vector<std::unique_ptr<IndexerWorker>> indexers;
+        std::vector<std::thread> indexer_threads;
+        for (int i = 0; i < indexer_count; ++i) {
+            indexers.push_back(std::make_unique<IndexerWorker>(
+                content_queue, index, buffer_pool,
+                stats.indexer(static_cast<size_t>(i))));
+            indexer_threads.emplace_back(
+                [worker = indexers.back().get()] { (*worker)(); });
+        }
+
+        scanner_thread.join();
+        for (std::thread& t : reader_threads) {
+            t.join();
+        }
+        content_queue.close();
+        for (std::thread& t : indexer_threads) {
+            t.join();
+        }
+
+        RunResult result;
+        result.seconds = std::chrono::duration_cast<std::chrono::duration<double>>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+        result.tokens = stats.indexer_totals().tokens;
+        result.unique_words = index.size();
+        return result;
+    }
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    CorpusConfig config;
+    if (argc >= 2) config.file_count = std::stoul(argv[1]);
+    if (argc >= 3) config.avg_file_kib = std::stoul(argv[2]);
+    if (argc >= 4) config.vocabulary = std::stoul(argv[3]);
+    if (argc >= 5) config.zipf_s = std::stod(argv[4]);
+
+    // Timestamp-suffixed so concurrent benchmark runs don't collide.
+    const std::filesystem::path corpus_dir =
+        std::filesystem::temp_directory_path() /
+        ("parallel_index_bench_" +
+         std::to_string(
+             std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(corpus_dir);
+
+    std::cout << "Generating corpus: " << config.file_count << " files, ~"
+              << config.avg_file_kib << " KiB average, "
+              << config.vocabulary << " word vocabulary, Zipf s = "
+              << config.zipf_s << "..." << std::endl;
+    std::mt19937 rng(42); // Fixed seed: identical corpus run to run.
+    const uint64_t total_bytes = generate_corpus(corpus_dir, config, rng);
+    const double total_mib = static_cast<double>(total_bytes) / (1024.0 * 1024.0);
+    std::cout << "Corpus ready: " << std::fixed << std::setprecision(1)
+              << total_mib << " MiB in " << corpus_dir << "\n" << std::endl;
+
+    std::cout << std::setw(8) << "readers" << std::setw(9) << "workers"
+              << std::setw(10) << "time_ms" << std::setw(10) << "MiB/s"
+              << std::setw(12) << "Mtokens/s" << std::setw(10) << "words"
+              << std::endl;
+    for (const auto& [reader_count, indexer_count] : kThreadConfigs) {
+        // The pipeline logs per-thread start/exit lines; silence them so
+        // the report stays a table.
+        std::ostream null_stream(nullptr);
+        std::streambuf* saved_out = std::cout.rdbuf(null_stream.rdbuf());
+        const RunResult run =
+            run_pipeline(corpus_dir.string(), reader_count, indexer_count);
+        std::cout.rdbuf(saved_out);
+
+        std::cout << std::setw(8) << reader_count << std::setw(9)
+                  << indexer_count << std::setw(10)
+                  << static_cast<uint64_t>(run.seconds * 1000.0)
+                  << std::setw(10) << std::setprecision(1)
+                  << total_mib / run.seconds << std::setw(12)
+                  << std::setprecision(2)
+                  << static_cast<double>(run.tokens) / run.seconds / 1e6
+                  << std::setw(10) << run.unique_words << std::endl;
+    }
+
+    std::filesystem::remove_all(corpus_dir);
+    return 0;
+}
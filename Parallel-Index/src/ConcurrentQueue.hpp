@@ -4,6 +4,36 @@
 #include <mutex>              // For std::mutex
 #include <condition_variable> // For std::condition_variable
 #include <optional>           // C++17: For std::optional
+#include <vector>             // For the bulk operations
+#include <chrono>             // For the enqueue timestamps (wait recording)
+#include <cstdint>            // For uint64_t
+#include <stop_token>         // For the stop-aware pops (cancellation)
+#include <type_traits>        // For std::conditional_t
+
+#include "../../Concurrent-Data-Structures/queue/concurrent_queue.hpp"
+#include "../../Concurrent-Data-Structures/sync/latency_histogram.hpp"
+
+#ifdef PARALLEL_INDEX_RING_QUEUE
+#include <atomic>
+#include "../../Concurrent-Data-Structures/queue/mpmc_bounded_queue.hpp"
+#endif
+
+/**
+ * @brief The wait-recording policy the pipeline queues are built with.
+ *
+ * Off by default: every item would otherwise carry a timestamp and every
+ * pop a clock read. The PARALLEL_INDEX_QUEUE_WAITS build option turns it
+ * on for a profiling build; the final per-stage breakdown then prints
+ * queue-residency percentiles (how long items sat in each queue), which
+ * is the direct signal for whether a deployment needs more reader or
+ * more indexer threads. All ConcurrentQueue instantiations in the
+ * pipeline share this alias, so the worker signatures never change.
+ */
+#ifdef PARALLEL_INDEX_QUEUE_WAITS
+using QueueWaitProfile = cds::record_queue_waits;
+#else
+using QueueWaitProfile = cds::no_queue_waits;
+#endif
 
 /**
  * @brief A thread-safe queue implementation for producer-consumer patterns.
@@ -12,122 +42,697 @@
  * It provides blocking and non-blocking pop operations, and a mechanism to signal
  * that no more items will be pushed (closing the queue), allowing consumers to gracefully exit.
  *
+ * The queue can optionally be bounded: constructed with a capacity, push()
+ * blocks while the queue is full, throttling producers to consumer speed
+ * (backpressure) and capping the queue's memory instead of letting a fast
+ * producer accumulate millions of items. A second condition variable
+ * signals "room available" so producers and consumers never wake each
+ * other spuriously.
+ *
+ * There are two interchangeable implementations behind this interface:
+ * the default, the shared cds::concurrent_queue (the consolidated
+ * mutex/condition-variable queue in Concurrent-Data-Structures), and -
+ * opt-in via the PARALLEL_INDEX_RING_QUEUE build option - a backend on
+ * the shared lock-free Vyukov ring, where push and pop are a single CAS
+ * and the mutex is only touched to park a thread that found the queue
+ * full or empty.
+ *
+ * Both backends also offer stop-aware push/wait_and_pop/wait_and_pop_bulk
+ * overloads taking a std::stop_token: a consumer parked on an empty
+ * queue (or a producer blocked on a full one) wakes when the token is
+ * signalled and backs out (false return) without transferring anything,
+ * which is what lets an indexing run be cancelled while its workers are
+ * blocked, not just between items - and keeps a cancelled producer from
+ * deadlocking against consumers that already left.
+ *
+ * Either backend can additionally record queue residency (see
+ * WaitProfile below): with cds::record_queue_waits each item is stamped
+ * on push and a log-bucketed histogram of push-to-pop times is kept;
+ * with the default cds::no_queue_waits the stamp, the clock reads and
+ * the histogram all compile out and items are stored bare.
+ *
  * @tparam T The type of elements to be stored in the queue.
+ * @tparam WaitProfile cds::record_queue_waits or cds::no_queue_waits.
  */
 
-template<typename T>
+#ifdef PARALLEL_INDEX_RING_QUEUE
+
+template<typename T, class WaitProfile = QueueWaitProfile>
 class ConcurrentQueue {
 
 private:
-    std::queue<T> queue_;            // The underlying standard queue
-    mutable std::mutex mutex_;       // Mutex to protect access to queue_ and closed_
-    std::condition_variable cond_var_; // Condition variable for signaling and waiting
-    bool closed_ = false;            // Flag to indicate if the queue is closed for pushing
+    // "Unbounded" mode still needs a ring size; this is deep enough that
+    // a pipeline hitting it has a stuck consumer anyway (producers then
+    // block exactly as the bounded mutex queue would).
+    static constexpr size_t kDefaultCapacity = 65536;
+
+    // With wait recording each slot carries its push() time; without it
+    // the ring stores T bare and none of the stamping code is emitted.
+    struct Stamped {
+        T value;
+        uint64_t enqueue_ns;
+    };
+    using Item = std::conditional_t<WaitProfile::enabled, Stamped, T>;
+
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // @brief Stamps a value on its way in (a no-op move when disabled).
+    static Item make_item(T&& value) {
+        if constexpr (WaitProfile::enabled) {
+            return Item{std::move(value), now_ns()};
+        } else {
+            return std::move(value);
+        }
+    }
+
+    // @brief Unwraps a popped item, recording its residency.
+    T take(Item&& item) {
+        if constexpr (WaitProfile::enabled) {
+            wait_hist_.record(now_ns() - item.enqueue_ns);
+            return std::move(item.value);
+        } else {
+            return std::move(item);
+        }
+    }
+
+    cds::mpmc_bounded_queue<Item> ring_;   // Holds the items; lock-free.
+    std::atomic<bool> closed_{false};
+    typename WaitProfile::histogram wait_hist_; // Empty type when disabled.
+
+    // Sleep machinery only - never touched while the ring has work and
+    // nobody is parked. The waiting counters are incremented under the
+    // mutex before the ring is re-checked, and the waking side reads them
+    // after its ring operation (both seq_cst), so a wakeup cannot fall
+    // between a waiter's last check and its wait.
+    mutable std::mutex mutex_;
+    std::condition_variable cond_var_; // Signals consumers: item available (or closed)
+    std::condition_variable room_var_; // Signals producers: capacity available (or closed)
+    std::atomic<int> waiting_consumers_{0};
+    std::atomic<int> waiting_producers_{0};
+
+    // @brief Wakes one parked consumer, if any. Taking the mutex before
+    // notifying is what makes the handoff race-free: a consumer holds it
+    // from its counter increment until its wait begins.
+    void wake_consumer() {
+        if (waiting_consumers_.load() > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cond_var_.notify_one();
+        }
+    }
+
+    // @brief Wakes one parked producer, if any (a slot was just freed).
+    void wake_producer() {
+        if (waiting_producers_.load() > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            room_var_.notify_one();
+        }
+    }
 
 public:
+    // @brief Constructs an "unbounded" queue (see kDefaultCapacity).
+    ConcurrentQueue() : ring_(kDefaultCapacity) {}
+
+    /**
+     * @brief Constructs a bounded queue.
+     * @param capacity The most items the queue will hold (rounded up to a
+     * power of two by the ring); push() blocks and try_push fails while
+     * the queue is at capacity.
+     */
+    explicit ConcurrentQueue(size_t capacity)
+        : ring_(capacity == 0 ? kDefaultCapacity : capacity) {}
+
     // @brief Pushes @param value value onto the back of the queue.
+    // Lock-free while the ring has room; parks on the mutex when full.
+    // A push racing with close() is dropped, as in the default backend.
+    // The residency stamp is taken here, so time spent blocked on a full
+    // queue counts toward the item's wait - backpressure is wait too.
     void push(T value) {
-        { // Scope for unique_lock
+        Item item = make_item(std::move(value));
+        for (;;) {
+            if (closed_.load()) {
+                return;
+            }
+            if (ring_.try_push(std::move(item))) {
+                wake_consumer();
+                return;
+            }
             std::unique_lock<std::mutex> lock(mutex_);
-            queue_.push(std::move(value)); // Use std::move for efficiency if 'value' is an rvalue
+            waiting_producers_.fetch_add(1);
+            // Re-check under the counter: a consumer finishing right now
+            // reads the counter after its pop and will notify us.
+            if (ring_.try_push(std::move(item))) {
+                waiting_producers_.fetch_sub(1);
+                lock.unlock();
+                wake_consumer();
+                return;
+            }
+            if (closed_.load()) {
+                waiting_producers_.fetch_sub(1);
+                return;
+            }
+            room_var_.wait(lock);
+            waiting_producers_.fetch_sub(1);
         }
-        cond_var_.notify_one(); // Notify one waiting consumer that a new item is available
     }
 
+    /**
+     * @brief Stop-aware push: blocks like push(), but backs out when the
+     * token is signalled. Returns false - value left untouched, so the
+     * caller can dispose of it properly - when cancelled or closed.
+     */
+    bool push(T& value, std::stop_token stop) {
+        std::stop_callback wake(stop, [this] {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+            room_var_.notify_all();
+        });
+        Item item = make_item(std::move(value));
+        for (;;) {
+            if (closed_.load() || stop.stop_requested()) {
+                break;
+            }
+            if (ring_.try_push(std::move(item))) {
+                wake_consumer();
+                return true;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            waiting_producers_.fetch_add(1);
+            // Re-check under the counter (see push()).
+            if (ring_.try_push(std::move(item))) {
+                waiting_producers_.fetch_sub(1);
+                lock.unlock();
+                wake_consumer();
+                return true;
+            }
+            if (closed_.load() || stop.stop_requested()) {
+                waiting_producers_.fetch_sub(1);
+                break;
+            }
+            room_var_.wait(lock);
+            waiting_producers_.fetch_sub(1);
+        }
+        if constexpr (WaitProfile::enabled) {
+            value = std::move(item.value);
+        } else {
+            value = std::move(item);
+        }
+        return false;
+    }
 
     /**
-     * @brief Attempts to pop a value from the front of the queue without blocking.
-     * This operation is thread-safe.
-     *
-     * @return An std::optional<T> containing the popped value if successful,
-     * or std::nullopt if the queue is empty or closed.
+     * @brief Attempts to push without blocking.
+     * @return True if the value was enqueued, false if the queue was full
+     * or closed (the value is left untouched in that case).
      */
-    std::optional<T> pop() {
-        std::unique_lock<std::mutex> lock(mutex_); // Acquire lock
-        if (queue_.empty() && closed_) {
-            // If queue is empty AND closed, no more items will ever arrive.
-            return std::nullopt; // Signal that queue is exhausted
+    bool try_push(T& value) {
+        if (closed_.load()) {
+            return false;
         }
-        if (queue_.empty()) {
-            // If queue is empty but not closed, a non-blocking pop just returns empty.
-            return std::nullopt;
+        if constexpr (WaitProfile::enabled) {
+            Item item = make_item(std::move(value));
+            if (!ring_.try_push(std::move(item))) {
+                value = std::move(item.value);
+                return false;
+            }
+        } else {
+            if (!ring_.try_push(std::move(value))) {
+                return false;
+            }
         }
+        wake_consumer();
+        return true;
+    }
 
-        T value = std::move(queue_.front()); 
-        // Since we're about to queue_.pop() and discard the original, moving avoids an unnecessary copy.
-        queue_.pop(); // Remove from queue
-        return value; // Return as optional
+    /**
+     * @brief Pushes every element of @param values onto the queue. The
+     * batch advantage of the mutex backend (one lock per batch) does not
+     * apply here - each push is already lock-free - so this is a simple
+     * loop. The vector is left empty.
+     */
+    void push_bulk(std::vector<T>&& values) {
+        for (T& value : values) {
+            push(std::move(value));
+        }
+        values.clear();
     }
 
+    /**
+     * @brief Attempts to pop a value without blocking.
+     * @return The popped value, or std::nullopt if the queue is empty.
+     */
+    std::optional<T> pop() {
+        Item item;
+        if (!ring_.try_pop(item)) {
+            return std::nullopt;
+        }
+        wake_producer();
+        return take(std::move(item));
+    }
 
     /**
-     * @brief Blocks until a value is available in the queue and then pops it.
-     * This operation is thread-safe. If the queue is closed and empty, it will return false.
-     *
-     * @param value A reference where the popped value will be moved into.
-     * @return True if a value was popped, false if the queue was closed and empty.
+     * @brief Blocks until a value is available and pops it.
+     * @return True if a value was popped, false if the queue was closed
+     * and empty.
      */
     bool wait_and_pop(T& value) {
-        std::unique_lock<std::mutex> lock(mutex_); // Acquire lock
-        // Wait until queue is not empty OR queue is closed
-        cond_var_.wait(lock, [this] { return !queue_.empty() || closed_; });
+        Item item;
+        if (!wait_and_pop_item(item)) {
+            return false;
+        }
+        value = take(std::move(item));
+        return true;
+    }
 
-        if (queue_.empty() && closed_) {
-            // If we woke up because the queue is closed and it's empty, no more items.
+    /**
+     * @brief Blocks until at least one value is available (or the queue
+     * is closed), then pops up to @param max_n values.
+     * @return True if at least one value was popped, false if the queue
+     * was closed and empty.
+     */
+    bool wait_and_pop_bulk(std::vector<T>& values, size_t max_n) {
+        values.clear();
+        Item item;
+        if (!wait_and_pop_item(item)) {
             return false;
         }
+        values.push_back(take(std::move(item)));
+        while (values.size() < max_n && ring_.try_pop(item)) {
+            values.push_back(take(std::move(item)));
+        }
+        wake_producer();
+        return true;
+    }
 
-        // We know queue is not empty here (otherwise, it must be closed and empty, which we handled)
-        value = std::move(queue_.front()); // Move the element
-        queue_.pop();
+    /**
+     * @brief Stop-aware wait_and_pop: returns false as soon as the token
+     * is signalled, even with items still queued - a cancelled consumer
+     * takes no more work; the leftovers are the sweeper's.
+     */
+    bool wait_and_pop(T& value, std::stop_token stop) {
+        Item item;
+        if (!wait_and_pop_item(item, stop)) {
+            return false;
+        }
+        value = take(std::move(item));
         return true;
     }
 
+    /**
+     * @brief Stop-aware bulk pop; same cancellation contract as the
+     * stop-aware wait_and_pop.
+     */
+    bool wait_and_pop_bulk(std::vector<T>& values, size_t max_n,
+                           std::stop_token stop) {
+        values.clear();
+        Item item;
+        if (!wait_and_pop_item(item, stop)) {
+            return false;
+        }
+        values.push_back(take(std::move(item)));
+        while (values.size() < max_n && ring_.try_pop(item)) {
+            values.push_back(take(std::move(item)));
+        }
+        wake_producer();
+        return true;
+    }
 
     /**
-     * @brief Closes the queue, signaling that no more items will be pushed.
-     * Consumers waiting on `wait_and_pop` will be notified and can gracefully exit
-     * once the queue becomes empty.
-     * This operation is thread-safe.
+     * @brief Closes the queue; consumers drain what is left and exit.
      */
     void close() {
-        { // Scope for unique_lock
-            std::unique_lock<std::mutex> lock(mutex_); // Acquire lock
-            closed_ = true; // Set the flag
-        } // Lock is released here
-        cond_var_.notify_all(); // Notify all waiting consumers to check the `closed_` flag
+        closed_.store(true);
+        { // Serialize with any waiter between its counter bump and wait.
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        cond_var_.notify_all();
+        room_var_.notify_all();
+    }
+
+    // @brief Approximate, like the ring counters it reads.
+    bool is_empty() const {
+        return ring_.size_approx() == 0;
+    }
+
+    bool is_closed() const {
+        return closed_.load();
+    }
+
+    // @brief Approximate, for monitoring (both backends read lock-free).
+    size_t size() const {
+        return ring_.size_approx();
     }
 
     /**
-     * @brief Checks if the queue is currently empty.
-     * This operation is thread-safe.
-     *
-     * @return True if the queue is empty, false otherwise.
+     * @brief The queue-residency distribution recorded so far. All-zero
+     * unless the queue was instantiated with cds::record_queue_waits.
      */
-    bool is_empty() const {
-        std::unique_lock<std::mutex> lock(mutex_); // Acquire lock
-        return queue_.empty();
+    cds::latency_histogram::snapshot_data wait_snapshot() const {
+        return wait_hist_.snapshot();
+    }
+
+private:
+    // @brief wait_and_pop on the stored item type; shared by the single
+    // and bulk pops so the stamp handling lives in one place.
+    bool wait_and_pop_item(Item& item) {
+        for (;;) {
+            if (ring_.try_pop(item)) {
+                wake_producer();
+                return true;
+            }
+            if (closed_.load()) {
+                // One final look: the last push may have landed between
+                // our pop attempt and the close check.
+                if (!ring_.try_pop(item)) {
+                    return false;
+                }
+                wake_producer();
+                return true;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            waiting_consumers_.fetch_add(1);
+            // Re-check under the counter (see the member comment).
+            if (ring_.try_pop(item)) {
+                waiting_consumers_.fetch_sub(1);
+                lock.unlock();
+                wake_producer();
+                return true;
+            }
+            if (closed_.load()) {
+                waiting_consumers_.fetch_sub(1);
+                return false;
+            }
+            cond_var_.wait(lock);
+            waiting_consumers_.fetch_sub(1);
+        }
+    }
+
+    // @brief The stop-aware variant of the park loop. The callback
+    // mirrors close(): take-and-drop the mutex before notifying, so the
+    // wakeup cannot fall between a waiter's last check and its wait.
+    bool wait_and_pop_item(Item& item, const std::stop_token& stop) {
+        std::stop_callback wake(stop, [this] {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+            cond_var_.notify_all();
+        });
+        for (;;) {
+            if (stop.stop_requested()) {
+                return false;
+            }
+            if (ring_.try_pop(item)) {
+                wake_producer();
+                return true;
+            }
+            if (closed_.load()) {
+                // One final look: the last push may have landed between
+                // our pop attempt and the close check.
+                if (!ring_.try_pop(item)) {
+                    return false;
+                }
+                wake_producer();
+                return true;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            waiting_consumers_.fetch_add(1);
+            // Re-check under the counter (see the member comment).
+            if (ring_.try_pop(item)) {
+                waiting_consumers_.fetch_sub(1);
+                lock.unlock();
+                wake_producer();
+                return true;
+            }
+            if (closed_.load() || stop.stop_requested()) {
+                waiting_consumers_.fetch_sub(1);
+                continue; // The top of the loop resolves which it was.
+            }
+            cond_var_.wait(lock);
+            waiting_consumers_.fetch_sub(1);
+        }
+    }
+};
+
+#else // !PARALLEL_INDEX_RING_QUEUE
+
+template<typename T, class WaitProfile = QueueWaitProfile>
+class ConcurrentQueue {
+
+private:
+    // With wait recording each item carries its push() time; without it
+    // the backend stores T bare and the stamping code is not emitted.
+    struct Stamped {
+        T value;
+        uint64_t enqueue_ns;
+    };
+    using Item = std::conditional_t<WaitProfile::enabled, Stamped, T>;
+
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // @brief Stamps a value on its way in (a no-op move when disabled).
+    static Item make_item(T&& value) {
+        if constexpr (WaitProfile::enabled) {
+            return Item{std::move(value), now_ns()};
+        } else {
+            return std::move(value);
+        }
+    }
+
+    // @brief Unwraps a popped item, recording its residency.
+    T take(Item&& item) {
+        if constexpr (WaitProfile::enabled) {
+            wait_hist_.record(now_ns() - item.enqueue_ns);
+            return std::move(item.value);
+        } else {
+            return std::move(item);
+        }
+    }
+
+    // The shared mutex/condvar queue from Concurrent-Data-Structures;
+    // bounding, closing, bulk ops and the two-condvar wakeup scheme all
+    // live there now, so improvements land once for every project.
+    cds::concurrent_queue<Item> impl_;
+    typename WaitProfile::histogram wait_hist_; // Empty type when disabled.
+
+public:
+    // @brief Constructs an unbounded queue.
+    ConcurrentQueue() = default;
+
+    /**
+     * @brief Constructs a bounded queue.
+     * @param capacity The most items the queue will hold; push() blocks
+     * (and try_push fails) while the queue is at capacity.
+     */
+    explicit ConcurrentQueue(size_t capacity) : impl_(capacity) {}
+
+    // @brief Pushes @param value value onto the back of the queue.
+    // On a bounded queue this blocks while the queue is full; a push racing
+    // with close() is dropped (consumers have already been told no more
+    // items are coming). The residency stamp is taken before any blocking,
+    // so backpressure time counts toward the item's wait.
+    void push(T value) {
+        impl_.push(make_item(std::move(value)));
     }
 
     /**
-     * @brief Checks if the queue has been closed.
-     * This operation is thread-safe.
-     *
-     * @return True if the queue has been closed, false otherwise.
+     * @brief Stop-aware push: blocks like push(), but backs out when the
+     * token is signalled. Returns false - value left untouched, so the
+     * caller can dispose of it properly - when cancelled or closed.
      */
-    bool is_closed() const {
-        std::unique_lock<std::mutex> lock(mutex_); // Acquire lock
-        return closed_;
+    bool push(T& value, std::stop_token stop) {
+        if constexpr (WaitProfile::enabled) {
+            Item item = make_item(std::move(value));
+            if (impl_.push(item, std::move(stop))) {
+                return true;
+            }
+            value = std::move(item.value);
+            return false;
+        } else {
+            return impl_.push(value, std::move(stop));
+        }
+    }
+
+    /**
+     * @brief Attempts to push without blocking.
+     * @return True if the value was enqueued, false if the queue was full
+     * or closed (the value is left untouched in that case).
+     */
+    bool try_push(T& value) {
+        if constexpr (WaitProfile::enabled) {
+            Item item = make_item(std::move(value));
+            if (impl_.try_push(item)) {
+                return true;
+            }
+            value = std::move(item.value);
+            return false;
+        } else {
+            return impl_.try_push(value);
+        }
+    }
+
+    /**
+     * @brief Pushes every element of @param values onto the queue under a
+     * single lock acquisition, then notifies once.
+     * Amortizes the mutex and condition-variable cost from per-item to
+     * per-batch; a producer with a directory's worth of work should prefer
+     * this over a push() loop. The vector is left empty.
+     */
+    void push_bulk(std::vector<T>&& values) {
+        if constexpr (WaitProfile::enabled) {
+            std::vector<Item> items;
+            items.reserve(values.size());
+            for (T& value : values) {
+                items.push_back(make_item(std::move(value)));
+            }
+            values.clear();
+            impl_.push_bulk(std::move(items));
+        } else {
+            impl_.push_bulk(std::move(values));
+        }
+    }
+
+    /**
+     * @brief Attempts to pop a value from the front of the queue without blocking.
+     * @return An std::optional<T> containing the popped value if successful,
+     * or std::nullopt if the queue is empty or closed.
+     */
+    std::optional<T> pop() {
+        if constexpr (WaitProfile::enabled) {
+            std::optional<Item> item = impl_.try_pop();
+            if (!item) {
+                return std::nullopt;
+            }
+            return take(std::move(*item));
+        } else {
+            return impl_.try_pop();
+        }
+    }
+
+    /**
+     * @brief Blocks until a value is available in the queue and then pops it.
+     * @param value A reference where the popped value will be moved into.
+     * @return True if a value was popped, false if the queue was closed and empty.
+     */
+    bool wait_and_pop(T& value) {
+        if constexpr (WaitProfile::enabled) {
+            Item item;
+            if (!impl_.wait_and_pop(item)) {
+                return false;
+            }
+            value = take(std::move(item));
+            return true;
+        } else {
+            return impl_.wait_and_pop(value);
+        }
+    }
+
+    /**
+     * @brief Blocks until at least one value is available (or the queue is
+     * closed), then pops up to @param max_n values in one lock acquisition.
+     * @param values Cleared, then filled with the popped values in order.
+     * @param max_n The most values to take in this call (at least 1).
+     * @return True if at least one value was popped, false if the queue was
+     * closed and empty.
+     */
+    bool wait_and_pop_bulk(std::vector<T>& values, size_t max_n) {
+        if constexpr (WaitProfile::enabled) {
+            std::vector<Item> items;
+            items.reserve(max_n);
+            if (!impl_.wait_and_pop_bulk(items, max_n)) {
+                return false;
+            }
+            values.clear();
+            values.reserve(items.size());
+            for (Item& item : items) {
+                values.push_back(take(std::move(item)));
+            }
+            return true;
+        } else {
+            return impl_.wait_and_pop_bulk(values, max_n);
+        }
+    }
+
+    /**
+     * @brief Stop-aware wait_and_pop: returns false as soon as the token
+     * is signalled, even with items still queued - a cancelled consumer
+     * takes no more work; the leftovers are the sweeper's.
+     */
+    bool wait_and_pop(T& value, std::stop_token stop) {
+        if constexpr (WaitProfile::enabled) {
+            Item item;
+            if (!impl_.wait_and_pop(item, std::move(stop))) {
+                return false;
+            }
+            value = take(std::move(item));
+            return true;
+        } else {
+            return impl_.wait_and_pop(value, std::move(stop));
+        }
+    }
+
+    /**
+     * @brief Stop-aware bulk pop; same cancellation contract as the
+     * stop-aware wait_and_pop.
+     */
+    bool wait_and_pop_bulk(std::vector<T>& values, size_t max_n,
+                           std::stop_token stop) {
+        if constexpr (WaitProfile::enabled) {
+            std::vector<Item> items;
+            items.reserve(max_n);
+            if (!impl_.wait_and_pop_bulk(items, max_n, std::move(stop))) {
+                return false;
+            }
+            values.clear();
+            values.reserve(items.size());
+            for (Item& item : items) {
+                values.push_back(take(std::move(item)));
+            }
+            return true;
+        } else {
+            return impl_.wait_and_pop_bulk(values, max_n, std::move(stop));
+        }
     }
 
     /**
-     * @brief Returns the current size of the queue.
-     * This operation is thread-safe.
-     *
-     * @return The number of elements currently in the queue.
+     * @brief Closes the queue, signaling that no more items will be pushed.
+     * Consumers waiting on `wait_and_pop` will be notified and can gracefully
+     * exit once the queue becomes empty.
      */
+    void close() {
+        impl_.close();
+    }
+
+    // @brief Checks if the queue is currently empty.
+    bool is_empty() const {
+        return impl_.is_empty();
+    }
+
+    // @brief Checks if the queue has been closed.
+    bool is_closed() const {
+        return impl_.is_closed();
+    }
+
+    // @brief Approximate depth, for monitoring; reads a striped counter
+    // instead of taking the queue mutex.
     size_t size() const {
-        std::unique_lock<std::mutex> lock(mutex_);
-        return queue_.size();
+        return impl_.size();
     }
-};
\ No newline at end of file
+
+    /**
+     * @brief The queue-residency distribution recorded so far. All-zero
+     * unless the queue was instantiated with cds::record_queue_waits.
+     */
+    cds::latency_histogram::snapshot_data wait_snapshot() const {
+        return wait_hist_.snapshot();
+    }
+};
+
+#endif // PARALLEL_INDEX_RING_QUEUE
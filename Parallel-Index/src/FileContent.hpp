@@ -0,0 +1,137 @@
+#pragma once
+
+#include "FileInfo.hpp"
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A file's loaded bytes travelling between the reader and indexer
+ * pipeline stages.
+ *
+ * Carries either a pooled buffer (small files, read into recycled
+ * std::strings) or an mmap'd region (large files, zero-copy). The indexer
+ * views the bytes in place and hands the payload back - buffer to the
+ * pool, mapping to munmap - when done.
+ */
+struct FileContent {
+    FileInfo info;
+    std::string buffer;       ///< Pooled storage; empty when mapped.
+    char* mapped = nullptr;   ///< mmap base when memory-mapped (private
+                              ///< copy-on-write, so in-place case folding
+                              ///< is allowed).
+    size_t mapped_length = 0; ///< Full mapping length (for munmap).
+    size_t mapped_skip = 0;   ///< Alignment bytes before the payload.
+
+    /** @brief The payload bytes, wherever they live. */
+    std::string_view view() const {
+        return mapped != nullptr
+                   ? std::string_view(mapped + mapped_skip,
+                                      mapped_length - mapped_skip)
+                   : std::string_view(buffer);
+    }
+
+    /** @brief Mutable access to the same payload bytes. */
+    char* mutable_data() {
+        return mapped != nullptr ? mapped + mapped_skip : buffer.data();
+    }
+};
+
+/**
+ * @brief A bounded, size-classed pool of recycled read buffers.
+ *
+ * Readers acquire a buffer per small file and indexers release it after
+ * tokenizing; recycling keeps each buffer's capacity warm instead of
+ * re-growing a fresh allocation per file - over a million-file corpus
+ * that is a million large transient allocations (RSS spikes, page-fault
+ * churn) turned into a steady working set.
+ *
+ * Buffers are binned by power-of-two capacity class, so a request is
+ * served by the smallest idle buffer that fits instead of whichever came
+ * back last - a 4 KiB source file no longer checks out (and dirties) a
+ * 1 MiB buffer some earlier large file grew. The cap is in BYTES of
+ * retained capacity, which makes it double as the read side's memory
+ * budget: idle buffers beyond it are simply freed.
+ *
+ * The pool never blocks: an empty class just hands out a fresh buffer,
+ * and the budget bounds what idles in the pool, not what is in flight
+ * (the bounded content queue already throttles that).
+ */
+class BufferPool {
+public:
+    /** @param max_idle_bytes The most retained (idle) capacity, in bytes. */
+    explicit BufferPool(size_t max_idle_bytes)
+        : max_idle_bytes_(max_idle_bytes) {}
+
+    /**
+     * @brief A recycled buffer with capacity for 'expected_bytes' if one
+     * is idle, otherwise the closest larger one, otherwise a fresh one.
+     */
+    std::string acquire(size_t expected_bytes = 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t c = class_for(expected_bytes); c < kClasses; ++c) {
+            if (!classes_[c].empty()) {
+                std::string buffer = std::move(classes_[c].back());
+                classes_[c].pop_back();
+                idle_bytes_ -= buffer.capacity();
+                return buffer;
+            }
+        }
+        return std::string();
+    }
+
+    /** @brief Returns a buffer to the pool (cleared, capacity kept),
+     *  unless retaining it would exceed the byte budget. */
+    void release(std::string&& buffer) {
+        buffer.clear();
+        const size_t capacity = buffer.capacity();
+        if (capacity < kMinClassBytes) {
+            return; // Too small to be worth recycling; dies here.
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (idle_bytes_ + capacity > max_idle_bytes_) {
+            return; // Over budget: the buffer dies, returning its memory.
+        }
+        // Binned by the largest class the capacity fully covers, so a
+        // buffer drawn from class c always fits a class-c request.
+        classes_[floor_class(capacity)].push_back(std::move(buffer));
+        idle_bytes_ += capacity;
+    }
+
+    /** @brief Bytes of capacity currently idle in the pool. */
+    size_t idle_bytes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idle_bytes_;
+    }
+
+private:
+    static constexpr size_t kMinClassBytes = 4096; ///< Class 0: <= 4 KiB.
+    static constexpr size_t kClasses = 16;         ///< Up to 128 MiB.
+
+    /** @brief Smallest class whose buffers hold 'bytes' (for acquire). */
+    static size_t class_for(size_t bytes) {
+        size_t c = 0;
+        size_t class_bytes = kMinClassBytes;
+        while (c + 1 < kClasses && class_bytes < bytes) {
+            class_bytes <<= 1;
+            ++c;
+        }
+        return c;
+    }
+
+    /** @brief Largest class fully covered by 'capacity' (for release). */
+    static size_t floor_class(size_t capacity) {
+        size_t c = 0;
+        while (c + 1 < kClasses && (kMinClassBytes << (c + 1)) <= capacity) {
+            ++c;
+        }
+        return c;
+    }
+
+    std::vector<std::string> classes_[kClasses];
+    mutable std::mutex mutex_;
+    size_t idle_bytes_ = 0;
+    const size_t max_idle_bytes_;
+};
@@ -1,14 +1,58 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 
-//  Represents metadata for a file to be indexed.
+//  Represents metadata for a file (or one chunk of a large file) to be
+//  indexed. The scanner splits oversized files into several FileInfo
+//  entries sharing one id, each covering a disjoint [offset, offset+length)
+//  slice, so multiple workers can tokenize one file in parallel.
+
+/**
+ * @brief How a file's bytes should be turned into terms, decided per
+ * extension at scan time. kText runs the prose tokenizer; kSource runs
+ * the identifier-splitting one, so camelCase and snake_case names index
+ * as their parts instead of as one-off glued terms that bloat the
+ * dictionary.
+ */
+enum class Extraction : uint8_t {
+    kText,
+    kSource,
+};
 
 struct FileInfo {
     size_t id;         ///< A unique identifier for the file within the index.
     std::string path;  ///< The full absolute path to the file.
+    uint64_t size;     ///< File size in bytes at scan time.
+    int64_t mtime_ns;  ///< Last-write time (filesystem clock ticks) at scan time.
+    uint64_t offset;   ///< Byte where this entry's slice of the file starts.
+    uint64_t length;   ///< Bytes in the slice; 0 means "through end of file".
+    Extraction extraction; ///< Tokenizer policy for this file (per extension).
 
     // Default constructor for convenience
-    FileInfo() : id(0), path("") {}
-    FileInfo(size_t id, std::string path) : id(id), path(std::move(path)) {}
-};
\ No newline at end of file
+    FileInfo() : id(0), path(""), size(0), mtime_ns(0), offset(0), length(0),
+                 extraction(Extraction::kText) {}
+    FileInfo(size_t id, std::string path, uint64_t size = 0, int64_t mtime_ns = 0,
+             uint64_t offset = 0, uint64_t length = 0,
+             Extraction extraction = Extraction::kText)
+        : id(id), path(std::move(path)), size(size), mtime_ns(mtime_ns),
+          offset(offset), length(length), extraction(extraction) {}
+};
+
+/**
+ * @brief Manifest record for one indexed file: enough to decide on the next
+ * run whether the file changed without reading a byte of it.
+ */
+struct ManifestEntry {
+    size_t id;         ///< The file's ID in the index/snapshot.
+    uint64_t size;     ///< Size in bytes when it was indexed.
+    int64_t mtime_ns;  ///< Last-write time when it was indexed.
+};
+
+/**
+ * @brief Path -> manifest record for every indexed file. Persisted in the
+ * snapshot's file table and compared against a fresh scan to drive
+ * incremental re-indexing.
+ */
+using FileManifest = std::unordered_map<std::string, ManifestEntry>;
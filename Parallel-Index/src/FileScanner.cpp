@@ -1,14 +1,48 @@
 #include "FileScanner.hpp"
+#include <cctype>   // For std::isspace (chunk boundary snapping)
+#include <fstream>  // For peeking at chunk boundaries
 #include <iostream> // For logging errors/info
-#include <set>      // For indexable extensions
+#include <map>      // For the extension -> extraction policy table
+#include <thread>   // For the scanner thread pool
+#include <vector>
 #include <algorithm>
 
-// Define a set of indexable file extensions
-static const std::set<std::string> indexable_extensions = {
-    ".txt", ".md", ".cpp", ".hpp", ".c", ".h", ".json", ".xml", ".log"
+// Indexable extensions, each mapped to its extraction policy: prose-like
+// formats run the plain tokenizer, source code runs the identifier-
+// splitting one (see Extraction in FileInfo.hpp).
+static const std::map<std::string, Extraction> indexable_extensions = {
+    {".txt", Extraction::kText},    {".md", Extraction::kText},
+    {".json", Extraction::kText},   {".xml", Extraction::kText},
+    {".log", Extraction::kText},
+    {".cpp", Extraction::kSource},  {".hpp", Extraction::kSource},
+    {".c", Extraction::kSource},    {".h", Extraction::kSource}
     // Add more as needed
 };
 
+// @brief The extraction policy for a path, by lowercased extension.
+// Only called for paths that passed is_indexable_file.
+static Extraction extraction_for(const std::filesystem::path& path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c){ return std::tolower(c); });
+    const auto it = indexable_extensions.find(extension);
+    return it == indexable_extensions.end() ? Extraction::kText : it->second;
+}
+
+// How many threads service the directory work queue. Traversal is
+// stat-bound, not CPU-bound, so a handful is plenty even on large trees.
+static const unsigned int kScannerThreads =
+    std::max(1u, std::min(4u, std::thread::hardware_concurrency()));
+
+// Files larger than this are split into roughly kChunkBytes-sized chunks so
+// several workers tokenize them in parallel - otherwise indexing tail
+// latency is set by the single largest file.
+static constexpr uint64_t kChunkBytes = 4 * 1024 * 1024;
+
+// How far past a tentative chunk boundary to look for whitespace to snap
+// to. A run of non-whitespace longer than this is split mid-token.
+static constexpr size_t kSnapWindowBytes = 4096;
+
 /**
  * @brief Constructs a FileScanner.
  * @param root_dir The starting directory to scan.
@@ -30,44 +64,238 @@ FileScanner::FileScanner(const std::string& root_dir, ConcurrentQueue<FileInfo>&
     }
 }
 
+/**
+ * @brief Constructs an incremental FileScanner.
+ * @param root_dir The starting directory to scan.
+ * @param file_queue A reference to the ConcurrentQueue to push FileInfo objects into.
+ * @param baseline The manifest from the previous run; files matching it by
+ *        size and mtime are skipped instead of enqueued.
+ */
+FileScanner::FileScanner(const std::string& root_dir, ConcurrentQueue<FileInfo>& file_queue,
+                         FileManifest baseline)
+    : FileScanner(root_dir, file_queue) {
+    baseline_ = std::move(baseline);
+    incremental_ = true;
+    // New/changed files get IDs above every ID the snapshot already uses.
+    size_t max_id = 0;
+    for (const auto& [path, entry] : baseline_) {
+        max_id = std::max(max_id, entry.id + 1);
+    }
+    next_file_id_.store(max_id);
+}
+
 /**
  * @brief Starts the file scanning process.
- * This method is designed to be run in its own thread.
- * It will traverse the directory and close the queue when finished.
+ * This method is designed to be run in its own thread. It spawns the
+ * scanner thread pool, blocks until the whole tree is traversed, and
+ * closes the queue when finished.
  */
-void FileScanner::start_scanning() {
-    try {
-        std::cout << "[Scanner] Starting scan of: " << root_directory_ << std::endl;
-        scan_directory(root_directory_);
-        std::cout << "[Scanner] Scan complete. Total files enqueued: " << next_file_id_ << std::endl;
-    } catch (const std::filesystem::filesystem_error& e) {
-        std::cerr << "[Scanner Error] Filesystem error during scan: " << e.what() << std::endl;
-    } catch (const std::exception& e) {
-        std::cerr << "[Scanner Error] An unexpected error occurred during scan: " << e.what() << std::endl;
+void FileScanner::start_scanning(std::stop_token stop) {
+    stop_ = std::move(stop);
+    std::cout << "[Scanner] Starting scan of: " << root_directory_
+              << " with " << kScannerThreads << " scanner threads." << std::endl;
+
+    // Seed the directory queue with the root; the pool takes it from there.
+    {
+        std::lock_guard<std::mutex> lock(dir_mutex_);
+        dir_queue_.push_back(root_directory_);
+        pending_dirs_ = 1;
+    }
+
+    std::vector<std::thread> scanners;
+    scanners.reserve(kScannerThreads);
+    for (unsigned int i = 0; i < kScannerThreads; ++i) {
+        scanners.emplace_back(&FileScanner::scan_worker, this);
+    }
+    for (std::thread& scanner : scanners) {
+        scanner.join();
+    }
+
+    if (stop_.stop_requested()) {
+        std::cout << "[Scanner] Stop requested: discovery halted with "
+                  << skipped_dirs_ << " queued directories unvisited. Files "
+                  << "enqueued so far: " << enqueued_count_ << "." << std::endl;
+    } else {
+        std::cout << "[Scanner] Scan complete. Files enqueued: " << enqueued_count_
+                  << ", unchanged: " << kept_file_ids_.size() << std::endl;
     }
     file_queue_.close(); // Signal to consumers that no more files will be added
     std::cout << "[Scanner] File queue closed." << std::endl;
 }
 
 /**
- * @brief Recursively scans a directory and its subdirectories.
- * @param current_path The current path being scanned.
+ * @brief One scanner thread: pops directories, lists their entries, queues
+ * subdirectories back, and enqueues indexable files.
+ *
+ * Termination: a directory stays counted in pending_dirs_ while its entries
+ * are being listed, so an empty queue with a nonzero count means more
+ * subdirectories may still appear. Every thread exits once both hit zero.
  */
-void FileScanner::scan_directory(const std::filesystem::path& current_path) {
-    // std::filesystem::recursive_directory_iterator handles recursion automatically
-    for (const auto& entry : std::filesystem::recursive_directory_iterator(current_path, std::filesystem::directory_options::skip_permission_denied)) {
+void FileScanner::scan_worker() {
+    while (true) {
+        std::filesystem::path dir;
+        {
+            std::unique_lock<std::mutex> lock(dir_mutex_);
+            dir_cv_.wait(lock, [this] {
+                return !dir_queue_.empty() || pending_dirs_ == 0;
+            });
+            if (dir_queue_.empty()) {
+                return; // pending_dirs_ == 0: traversal finished.
+            }
+            dir = std::move(dir_queue_.front());
+            dir_queue_.pop_front();
+            // A stop discards queued directories unlisted: no stat, no
+            // listing, no new files. Whatever was already enqueued stays
+            // in flight, so the manifest only ever covers discovered
+            // files and the partial index stays consistent.
+            if (stop_.stop_requested()) {
+                ++skipped_dirs_;
+                if (--pending_dirs_ == 0) {
+                    dir_cv_.notify_all(); // Wake everyone up to exit.
+                }
+                continue;
+            }
+        }
+
+        // Collect the directory's files and publish them as one batch: a
+        // single queue lock and notification per directory listed.
+        std::vector<FileInfo> batch;
         try {
-            if (entry.is_regular_file()) {
-                if (is_indexable_file(entry.path())) {
-                    size_t file_id = next_file_id_.fetch_add(1); // Atomically get and increment
-                    file_queue_.push(FileInfo(file_id, entry.path().string()));
-                    // std::cout << "[Scanner] Enqueued file: " << entry.path().filename() << " (ID: " << file_id << ")" << std::endl;
+            for (const auto& entry : std::filesystem::directory_iterator(
+                     dir, std::filesystem::directory_options::skip_permission_denied)) {
+                try {
+                    if (entry.is_directory() && !entry.is_symlink()) {
+                        std::lock_guard<std::mutex> lock(dir_mutex_);
+                        dir_queue_.push_back(entry.path());
+                        ++pending_dirs_;
+                        dir_cv_.notify_one();
+                    } else if (entry.is_regular_file() &&
+                               is_indexable_file(entry.path())) {
+                        process_file_entry(entry, batch);
+                    }
+                } catch (const std::filesystem::filesystem_error& e) {
+                    std::cerr << "[Scanner Warning] Skipping " << entry.path()
+                              << " due to: " << e.what() << std::endl;
                 }
             }
         } catch (const std::filesystem::filesystem_error& e) {
-            std::cerr << "[Scanner Warning] Skipping " << entry.path() << " due to: " << e.what() << std::endl;
+            std::cerr << "[Scanner Warning] Skipping directory " << dir
+                      << " due to: " << e.what() << std::endl;
+        }
+        file_queue_.push_bulk(std::move(batch));
+
+        {
+            std::lock_guard<std::mutex> lock(dir_mutex_);
+            if (--pending_dirs_ == 0) {
+                dir_cv_.notify_all(); // Wake everyone up to exit.
+            }
+        }
+    }
+}
+
+/**
+ * @brief Stats one regular file and either keeps it (incremental,
+ * unchanged) or assigns it an ID and adds it to the caller's batch, which
+ * is pushed to the indexing queue in bulk once the directory is listed.
+ * @param entry The directory entry to process.
+ * @param batch The current directory's outgoing FileInfo batch.
+ */
+void FileScanner::process_file_entry(const std::filesystem::directory_entry& entry,
+                                     std::vector<FileInfo>& batch) {
+    const std::string path_str = entry.path().string();
+    const uint64_t file_size = entry.file_size();
+    const int64_t mtime_ns = entry.last_write_time().time_since_epoch().count();
+
+    if (incremental_) {
+        auto it = baseline_.find(path_str);
+        if (it != baseline_.end() &&
+            it->second.size == file_size &&
+            it->second.mtime_ns == mtime_ns) {
+            // Unchanged since the snapshot: keep its ID (and thus its
+            // postings) without touching its bytes.
+            std::lock_guard<std::mutex> lock(tables_mutex_);
+            kept_file_ids_.insert(it->second.id);
+            file_table_.add(it->second.id, path_str);
+            manifest_.emplace(path_str, it->second);
+            return;
+        }
+    }
+
+    size_t file_id = next_file_id_.fetch_add(1); // Atomically get and increment
+    {
+        std::lock_guard<std::mutex> lock(tables_mutex_);
+        file_table_.add(file_id, path_str);
+        manifest_.emplace(path_str,
+                          ManifestEntry{file_id, file_size, mtime_ns});
+        ++enqueued_count_;
+    }
+
+    const Extraction extraction = extraction_for(entry.path());
+
+    if (file_size <= kChunkBytes) {
+        batch.push_back(FileInfo(file_id, path_str, file_size, mtime_ns,
+                                 0, 0, extraction));
+        return;
+    }
+
+    // Oversized file: enqueue one FileInfo per chunk, all sharing the same
+    // ID, so its tokenization spreads across the worker pool instead of
+    // serializing on whichever worker drew it.
+    const std::vector<uint64_t> boundaries = chunk_boundaries(path_str, file_size);
+    for (size_t i = 0; i < boundaries.size(); ++i) {
+        const uint64_t offset = boundaries[i];
+        const uint64_t end =
+            i + 1 < boundaries.size() ? boundaries[i + 1] : file_size;
+        batch.push_back(FileInfo(file_id, path_str, file_size, mtime_ns,
+                                 offset, end - offset, extraction));
+    }
+}
+
+/**
+ * @brief Computes the chunk start offsets for an oversized file.
+ *
+ * Tentative boundaries fall every kChunkBytes; each is snapped forward to
+ * just past the first whitespace byte within the snap window, so tokens
+ * never straddle chunks and every byte lands in exactly one chunk. If the
+ * file cannot be read, it is left as a single chunk and the reader stage
+ * will report the error.
+ *
+ * @param path The file to split.
+ * @param file_size Its size at scan time.
+ * @return Ascending chunk start offsets, beginning with 0.
+ */
+std::vector<uint64_t> FileScanner::chunk_boundaries(const std::string& path,
+                                                    uint64_t file_size) {
+    std::vector<uint64_t> boundaries = {0};
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return boundaries;
+    }
+
+    char window[kSnapWindowBytes];
+    for (uint64_t target = kChunkBytes; target < file_size; target += kChunkBytes) {
+        file.seekg(static_cast<std::streamoff>(target));
+        file.read(window, static_cast<std::streamsize>(
+                              std::min<uint64_t>(kSnapWindowBytes, file_size - target)));
+        const size_t got = static_cast<size_t>(file.gcount());
+        if (!file && got == 0) {
+            break; // Unreadable past this point; last chunk runs to EOF.
+        }
+        file.clear();
+
+        uint64_t boundary = target; // Fallback: hard split mid-token.
+        for (size_t i = 0; i < got; ++i) {
+            if (std::isspace(static_cast<unsigned char>(window[i]))) {
+                boundary = target + i + 1; // Chunk starts after the space.
+                break;
+            }
+        }
+        if (boundary >= file_size) {
+            break;
         }
+        boundaries.push_back(boundary);
     }
+    return boundaries;
 }
 
 /**
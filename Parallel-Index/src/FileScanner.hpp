@@ -2,9 +2,17 @@
 
 #include "ConcurrentQueue.hpp"
 #include "FileInfo.hpp"
+#include "FileTable.hpp"
 #include <filesystem>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stop_token>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 /**
  * @brief Scans a specified root directory and enqueues files for indexing.
@@ -12,16 +20,37 @@
  * This class traverses the file system using std::filesystem and pushes
  * eligible files (e.g., text files) into a ConcurrentQueue for processing
  * by indexer worker threads.
+ *
+ * The traversal itself is parallel: directories form a shared work queue
+ * serviced by several scanner threads, so stat latency (the bottleneck on
+ * network filesystems) is overlapped across directories instead of paid
+ * serially. Files reach the indexing queue as they are discovered; the
+ * queue is closed only once every scanner thread has drained.
+ *
+ * Given a baseline manifest from a previous run, the scanner works
+ * incrementally: files whose size and mtime are unchanged are skipped (their
+ * IDs are reported via kept_file_ids() so their postings can be reused from
+ * the snapshot), and only new or modified files are enqueued.
  */
 class FileScanner {
 public:
     /**
-     * @brief Constructs a FileScanner.
+     * @brief Constructs a FileScanner that enqueues every indexable file.
      * @param root_dir The starting directory to scan.
      * @param file_queue A reference to the ConcurrentQueue to push FileInfo objects into.
      */
     FileScanner(const std::string& root_dir, ConcurrentQueue<FileInfo>& file_queue);
 
+    /**
+     * @brief Constructs an incremental FileScanner.
+     * @param root_dir The starting directory to scan.
+     * @param file_queue A reference to the ConcurrentQueue to push FileInfo objects into.
+     * @param baseline The manifest from the previous run; files matching it
+     *        by size and mtime are skipped instead of enqueued.
+     */
+    FileScanner(const std::string& root_dir, ConcurrentQueue<FileInfo>& file_queue,
+                FileManifest baseline);
+
     // No copying or moving
     FileScanner(const FileScanner&) = delete;
     FileScanner& operator=(const FileScanner&) = delete;
@@ -30,21 +59,93 @@ public:
 
     /**
      * @brief Starts the file scanning process.
-     * This method is designed to be run in its own thread.
-     * It will traverse the directory and close the queue when finished.
+     * This method is designed to be run in its own thread. It spawns the
+     * scanner thread pool, blocks until the whole tree is traversed, and
+     * closes the queue when finished.
+     * @param stop Optional cancellation token. Once signalled, queued
+     *        directories are discarded without being listed, so discovery
+     *        winds down in at most one in-flight listing per scanner
+     *        thread; files already enqueued stay enqueued, and the queue
+     *        is still closed on the way out so the pipeline drains.
      */
-    void start_scanning();
+    void start_scanning(std::stop_token stop = {});
+
+    /**
+     * @brief The ID-to-path table of every current file (kept and enqueued).
+     * Only valid to read after the scanning thread has been joined; used to
+     * resolve search results and to persist the snapshot's file table.
+     */
+    const FileTable& file_table() const { return file_table_; }
+
+    /**
+     * @brief The manifest of every current file, for the next snapshot.
+     * Only valid after the scan finishes.
+     */
+    const FileManifest& manifest() const { return manifest_; }
+
+    /**
+     * @brief IDs of files skipped as unchanged (incremental mode only);
+     * their postings can be carried over from the previous snapshot.
+     * Baseline IDs absent from this set belong to removed or modified files
+     * and must be tombstoned. Only valid after the scan finishes.
+     */
+    const std::unordered_set<size_t>& kept_file_ids() const {
+        return kept_file_ids_;
+    }
+
+    /** @brief Number of files actually enqueued. Valid after the scan. */
+    size_t enqueued_count() const { return enqueued_count_; }
 
 private:
     std::filesystem::path root_directory_; ///< The path to the root directory to scan.
     ConcurrentQueue<FileInfo>& file_queue_; ///< Reference to the queue for discovered files.
     std::atomic<size_t> next_file_id_ = 0; ///< Atomically increments for unique file IDs.
+    FileTable file_table_; ///< ID -> path for every current file.
+
+    FileManifest baseline_;  ///< Previous run's manifest (empty for full scans).
+    bool incremental_ = false; ///< Whether baseline_ should be consulted.
+    FileManifest manifest_;  ///< Manifest of the current scan, for the next snapshot.
+    std::unordered_set<size_t> kept_file_ids_; ///< IDs skipped as unchanged.
+    size_t enqueued_count_ = 0; ///< Files actually pushed to the queue.
+
+    // The directory work queue shared by the scanner threads. A directory
+    // counts as pending from the moment it is queued until its entries have
+    // all been visited; the scan is done when pending_dirs_ drops to zero.
+    std::deque<std::filesystem::path> dir_queue_;
+    std::mutex dir_mutex_;
+    std::condition_variable dir_cv_;
+    size_t pending_dirs_ = 0;
+    size_t skipped_dirs_ = 0;  ///< Directories discarded by a stop request.
+
+    std::stop_token stop_;     ///< Cancellation token for this scan.
+
+    std::mutex tables_mutex_; ///< Guards the file/manifest/kept tables.
+
+    /**
+     * @brief One scanner thread: pops directories, lists their entries,
+     * queues subdirectories back, and enqueues indexable files.
+     */
+    void scan_worker();
+
+    /**
+     * @brief Stats one regular file and either keeps it (incremental,
+     * unchanged) or assigns it an ID and adds it to the caller's batch,
+     * which is pushed to the indexing queue in bulk per directory.
+     * @param entry The directory entry to process.
+     * @param batch The current directory's outgoing FileInfo batch.
+     */
+    void process_file_entry(const std::filesystem::directory_entry& entry,
+                            std::vector<FileInfo>& batch);
 
     /**
-     * @brief Recursively scans a directory and its subdirectories.
-     * @param current_path The current path being scanned.
+     * @brief Chunk start offsets for an oversized file, each snapped
+     * forward to just past the nearest whitespace so no token straddles
+     * two chunks. The first boundary is always 0.
+     * @param path The file to split.
+     * @param file_size Its size at scan time.
      */
-    void scan_directory(const std::filesystem::path& current_path);
+    static std::vector<uint64_t> chunk_boundaries(const std::string& path,
+                                                  uint64_t file_size);
 
     /**
      * @brief Checks if a file should be indexed (e.g., based on extension).
@@ -52,4 +153,4 @@ private:
      * @return True if the file should be indexed, false otherwise.
      */
     bool is_indexable_file(const std::filesystem::path& path) const;
-};
\ No newline at end of file
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A dense file-ID -> path table backed by a string arena.
+ *
+ * FileScanner assigns sequential IDs from one atomic counter, so the
+ * natural table is a vector indexed by ID - O(1) array indexing per
+ * displayed search result instead of a hash probe - with all path bytes
+ * packed into a single arena string instead of thousands of separate
+ * std::string allocations. IDs that were never added (removed files leave
+ * holes in incremental runs) resolve to an empty view.
+ *
+ * The table itself is unsynchronized; the scanner populates it under its
+ * own tables lock, and readers only touch it after the scan has finished
+ * (same contract as the manifest).
+ */
+class FileTable {
+public:
+    /** @brief Records the path for 'file_id', growing the table as needed. */
+    void add(size_t file_id, std::string_view path) {
+        if (file_id >= spans_.size()) {
+            spans_.resize(file_id + 1, Span{0, 0});
+        }
+        spans_[file_id] = Span{arena_.size(), path.size()};
+        arena_.append(path);
+        ++count_;
+    }
+
+    /**
+     * @brief The path recorded for 'file_id'; empty for unknown IDs. The
+     * view aliases the arena and stays valid until the table is destroyed
+     * or assigned over.
+     */
+    std::string_view path_of(size_t file_id) const {
+        if (file_id >= spans_.size() || spans_[file_id].length == 0) {
+            return {};
+        }
+        return std::string_view(arena_).substr(spans_[file_id].offset,
+                                               spans_[file_id].length);
+    }
+
+    /** @brief The number of paths recorded. */
+    size_t size() const { return count_; }
+
+private:
+    /** @brief One entry's slice of the arena. */
+    struct Span {
+        size_t offset;
+        size_t length;
+    };
+
+    std::vector<Span> spans_; ///< Indexed directly by file ID.
+    std::string arena_;       ///< Every path's bytes, packed back to back.
+    size_t count_ = 0;        ///< Set entries (the spans vector has holes).
+};
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief An open-addressing hash map with Robin Hood probing, specialized
+ * for small trivially-copied keys (interned string_views, integer IDs).
+ *
+ * std::unordered_map is node-based: every probe step is a pointer chase
+ * into a separately allocated node, which makes dictionary lookups the
+ * hottest data-dependent loads in the search profile. Here entries live
+ * in one flat array probed linearly, so a lookup touches consecutive
+ * cache lines and a hit usually costs a single one. Robin Hood insertion
+ * (the carried entry swaps with any slot that is closer to home than it
+ * is) keeps probe sequences short and lets lookups stop as soon as a
+ * slot's distance drops below their own; deletion backward-shifts, so no
+ * tombstones accumulate.
+ *
+ * The API mirrors the unordered_map subset the index uses - find /
+ * emplace / erase / operator[] / clear / size / iteration - so it drops
+ * in where that was used; find and emplace additionally take an optional
+ * precomputed hash for callers that already paid for one upstream.
+ * Differences to know about: rehashing moves
+ * entries, so references and iterators are invalidated by any insertion,
+ * and iteration order is meaningless. Capacity is a power of two, grown
+ * at 3/4 load; erase never shrinks.
+ *
+ * Not thread-safe; callers lock exactly as they would around an
+ * unordered_map.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatMap {
+    static constexpr size_t kMinCapacity = 16;
+    static constexpr size_t kNpos = static_cast<size_t>(-1);
+
+public:
+    using value_type = std::pair<Key, Value>;
+
+    /** @brief Forward iterator over occupied slots, in table order. */
+    template <bool Const>
+    class basic_iterator {
+        using map_pointer = std::conditional_t<Const, const FlatMap*, FlatMap*>;
+        using reference =
+            std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+    public:
+        basic_iterator() = default;
+        basic_iterator(map_pointer map, size_t index)
+            : map_(map), index_(index) {}
+
+        reference operator*() const { return map_->entries_[index_]; }
+        pointer operator->() const { return &map_->entries_[index_]; }
+
+        basic_iterator& operator++() {
+            ++index_;
+            skip_empty();
+            return *this;
+        }
+
+        bool operator==(const basic_iterator& other) const {
+            return index_ == other.index_;
+        }
+        bool operator!=(const basic_iterator& other) const {
+            return index_ != other.index_;
+        }
+
+    private:
+        friend class FlatMap;
+        void skip_empty() {
+            while (index_ < map_->probes_.size() && map_->probes_[index_] == 0) {
+                ++index_;
+            }
+        }
+        map_pointer map_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    iterator begin() {
+        iterator it(this, 0);
+        it.skip_empty();
+        return it;
+    }
+    iterator end() { return iterator(this, probes_.size()); }
+    const_iterator begin() const {
+        const_iterator it(this, 0);
+        it.skip_empty();
+        return it;
+    }
+    const_iterator end() const { return const_iterator(this, probes_.size()); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /** @brief Current slot count (unordered_map vocabulary, for accounting). */
+    size_t bucket_count() const { return probes_.size(); }
+
+    /** @brief Heap bytes held by the table, for memory accounting. */
+    size_t allocated_bytes() const {
+        return entries_.capacity() * sizeof(value_type) +
+               probes_.capacity() * sizeof(uint32_t);
+    }
+
+    /** @brief Finds 'key'; end() if absent. Stops early via the Robin Hood
+     *  invariant: no match can sit in a slot closer to home than we are. */
+    iterator find(const Key& key) {
+        return iterator(this, find_index(key, Hash{}(key)));
+    }
+    const_iterator find(const Key& key) const {
+        return const_iterator(this, find_index(key, Hash{}(key)));
+    }
+
+    /**
+     * @brief find() with the key's hash supplied by the caller - for hot
+     * paths where it was already computed upstream (the tokenizer hashes
+     * each token as it scans it). 'hash' must equal Hash{}(key); the table
+     * itself still rehashes with Hash on growth, so the two must agree.
+     */
+    iterator find(const Key& key, size_t hash) {
+        return iterator(this, find_index(key, hash));
+    }
+    const_iterator find(const Key& key, size_t hash) const {
+        return const_iterator(this, find_index(key, hash));
+    }
+
+    /**
+     * @brief Inserts (key, value) if the key is absent.
+     * @return The entry's iterator and whether an insertion happened.
+     */
+    std::pair<iterator, bool> emplace(Key key, Value value) {
+        const size_t hash = Hash{}(key);
+        return emplace(std::move(key), hash, std::move(value));
+    }
+
+    /**
+     * @brief emplace() with a caller-supplied hash; same contract as the
+     * hashed find - 'hash' must equal Hash{}(key).
+     */
+    std::pair<iterator, bool> emplace(Key key, size_t hash, Value value) {
+        if (probes_.empty() || (size_ + 1) * 4 > probes_.size() * 3) {
+            grow();
+        }
+        size_t index = hash & mask();
+        uint32_t probe = 1;
+        value_type carried{std::move(key), std::move(value)};
+        size_t rest_index = kNpos; // Where the new entry came to rest.
+        bool displaced = false;    // True once 'carried' is someone else's.
+        while (true) {
+            if (probes_[index] == 0) {
+                entries_[index] = std::move(carried);
+                probes_[index] = probe;
+                ++size_;
+                if (rest_index == kNpos) {
+                    rest_index = index;
+                }
+                return {iterator(this, rest_index), true};
+            }
+            if (!displaced && entries_[index].first == carried.first) {
+                return {iterator(this, index), false};
+            }
+            if (probes_[index] < probe) {
+                // This slot's occupant is closer to home than we are:
+                // deposit the carried entry and keep shifting the occupant.
+                std::swap(carried, entries_[index]);
+                std::swap(probe, probes_[index]);
+                if (rest_index == kNpos) {
+                    rest_index = index;
+                }
+                displaced = true;
+            }
+            index = (index + 1) & mask();
+            ++probe;
+        }
+    }
+
+    /** @brief The value for 'key', default-constructed on first access. */
+    Value& operator[](const Key& key) {
+        auto it = find(key);
+        if (it != end()) {
+            return it->second;
+        }
+        return emplace(key, Value{}).first->second;
+    }
+
+    /**
+     * @brief Removes the entry at 'it' by backward shift: every following
+     * slot that is displaced from home moves one step closer, so probe
+     * sequences stay tight and no tombstone is left behind.
+     */
+    void erase(iterator it) {
+        size_t index = it.index_;
+        size_t next = (index + 1) & mask();
+        while (probes_[next] > 1) {
+            entries_[index] = std::move(entries_[next]);
+            probes_[index] = probes_[next] - 1;
+            index = next;
+            next = (next + 1) & mask();
+        }
+        entries_[index] = value_type{};
+        probes_[index] = 0;
+        --size_;
+    }
+
+    /** @brief Drops every entry; keeps the table's capacity. */
+    void clear() {
+        for (size_t i = 0; i < probes_.size(); ++i) {
+            if (probes_[i] != 0) {
+                entries_[i] = value_type{};
+                probes_[i] = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+private:
+    size_t mask() const { return probes_.size() - 1; }
+
+    size_t find_index(const Key& key, size_t hash) const {
+        if (probes_.empty()) {
+            return 0; // == probes_.size(): the end() sentinel.
+        }
+        size_t index = hash & mask();
+        uint32_t probe = 1;
+        while (probes_[index] >= probe) {
+            if (entries_[index].first == key) {
+                return index;
+            }
+            index = (index + 1) & mask();
+            ++probe;
+        }
+        return probes_.size();
+    }
+
+    /** @brief Doubles the table and re-places every entry. */
+    void grow() {
+        const size_t capacity =
+            probes_.empty() ? kMinCapacity : probes_.size() * 2;
+        std::vector<value_type> old_entries = std::move(entries_);
+        std::vector<uint32_t> old_probes = std::move(probes_);
+        entries_.assign(capacity, value_type{});
+        probes_.assign(capacity, 0);
+        size_ = 0;
+        for (size_t i = 0; i < old_probes.size(); ++i) {
+            if (old_probes[i] != 0) {
+                emplace(std::move(old_entries[i].first),
+                        std::move(old_entries[i].second));
+            }
+        }
+    }
+
+    std::vector<value_type> entries_; ///< Slot payloads (empty slots value-initialized).
+    std::vector<uint32_t> probes_;    ///< Probe distance + 1 per slot; 0 = empty.
+    size_t size_ = 0;
+};
@@ -0,0 +1,318 @@
+#include "IndexDeltaLog.hpp"
+#include <scheduler/profile.hpp> // PROFILE_SCOPE (Task-Scheduler)
+
+#include <cstdio>     // For std::remove
+#include <cstring>    // For std::memcpy
+#include <filesystem> // For resize_file (torn-tail trimming)
+#include <fstream>    // For the appender / reader
+#include <iostream>   // For error logging
+
+namespace IndexDeltaLog {
+
+namespace {
+
+    constexpr char kMagic[8] = {'P', 'I', 'D', 'X', 'D', 'L', 'T', '1'};
+
+    // Compaction threshold: once the log carries more than a quarter of
+    // the base snapshot's bytes, replay and dead-posting overhead start
+    // rivalling the full rewrite the log exists to avoid.
+    constexpr size_t kCompactNumerator = 1;
+    constexpr size_t kCompactDenominator = 4;
+
+    /** @brief Segment frame preceding each payload. A torn append leaves
+     *  a frame whose length or checksum cannot hold up, which is how a
+     *  crash mid-write is detected and the tail ignored. */
+    struct SegmentHeader {
+        char magic[8];
+        uint64_t payload_bytes;
+        uint64_t payload_sum;
+    };
+    static_assert(sizeof(SegmentHeader) == 24, "segment header drifted");
+
+    /** @brief FNV-1a over a byte range (same flavour as the snapshot's). */
+    uint64_t fnv1a(const void* data, size_t len) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < len; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    void put_u64(std::vector<uint8_t>& out, uint64_t value) {
+        for (int shift = 0; shift < 64; shift += 8) {
+            out.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    void put_bytes(std::vector<uint8_t>& out, const void* data, size_t len) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), bytes, bytes + len);
+    }
+
+    /** @brief Bounds-checked payload cursor; read failures poison it so
+     *  one flag check at the end validates the whole decode. */
+    struct Reader {
+        const uint8_t* p;
+        size_t remaining;
+        bool ok = true;
+
+        uint64_t u64() {
+            if (remaining < 8) {
+                ok = false;
+                return 0;
+            }
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 8) {
+                value |= static_cast<uint64_t>(*p++) << shift;
+            }
+            remaining -= 8;
+            return value;
+        }
+
+        const uint8_t* bytes(size_t len) {
+            if (remaining < len) {
+                ok = false;
+                return nullptr;
+            }
+            const uint8_t* start = p;
+            p += len;
+            remaining -= len;
+            return start;
+        }
+    };
+
+} // namespace
+
+bool append(const std::string& path, const InvertedIndex& index,
+            const std::unordered_set<size_t>& changed_ids,
+            const std::vector<size_t>& removed_ids,
+            const FileManifest& manifest) {
+    PROFILE_SCOPE("DeltaLog::append");
+
+    std::vector<uint8_t> payload;
+
+    put_u64(payload, removed_ids.size());
+    for (size_t id : removed_ids) {
+        put_u64(payload, id);
+    }
+
+    // Manifest records of the files this run (re)indexed.
+    size_t changed_entries = 0;
+    for (const auto& [file_path, entry] : manifest) {
+        if (changed_ids.count(entry.id) != 0) {
+            ++changed_entries;
+        }
+    }
+    put_u64(payload, changed_entries);
+    for (const auto& [file_path, entry] : manifest) {
+        if (changed_ids.count(entry.id) == 0) {
+            continue;
+        }
+        put_u64(payload, entry.id);
+        put_u64(payload, entry.size);
+        put_u64(payload, static_cast<uint64_t>(entry.mtime_ns));
+        put_u64(payload, file_path.size());
+        put_bytes(payload, file_path.data(), file_path.size());
+    }
+
+    // Touched words: one dictionary walk, but only occurrences of the
+    // changed ids are written - the write scales with the change.
+    const size_t word_count_slot = payload.size();
+    put_u64(payload, 0); // Patched below.
+    size_t word_count = 0;
+    index.visit_all([&](std::string_view word,
+                        const std::vector<PostingCodec::PackedOccurrence>&
+                            occurrences) {
+        size_t touched = 0;
+        for (const auto& occ : occurrences) {
+            if (changed_ids.count(occ.file_id) != 0) {
+                ++touched;
+            }
+        }
+        if (touched == 0) {
+            return;
+        }
+        ++word_count;
+        put_u64(payload, word.size());
+        put_bytes(payload, word.data(), word.size());
+        put_u64(payload, touched);
+        for (const auto& occ : occurrences) {
+            if (changed_ids.count(occ.file_id) == 0) {
+                continue;
+            }
+            put_u64(payload, occ.file_id);
+            put_u64(payload, occ.position_count);
+            put_u64(payload, occ.last_position);
+            put_u64(payload, occ.packed_positions.size());
+            put_bytes(payload, occ.packed_positions.data(),
+                      occ.packed_positions.size());
+        }
+    });
+    // Patch the word count now that the walk is done.
+    {
+        std::vector<uint8_t> patched;
+        put_u64(patched, word_count);
+        std::memcpy(payload.data() + word_count_slot, patched.data(), 8);
+    }
+
+    SegmentHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.payload_bytes = payload.size();
+    header.payload_sum = fnv1a(payload.data(), payload.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    if (!out) {
+        std::cerr << "Delta log: cannot open " << path << " for append."
+                  << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(payload.data()),
+              static_cast<std::streamsize>(payload.size()));
+    out.flush();
+    if (!out.good()) {
+        std::cerr << "Delta log: append to " << path << " failed."
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+Delta load(const std::string& path) {
+    PROFILE_SCOPE("DeltaLog::load");
+    Delta delta;
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return delta; // No log: nothing to overlay.
+    }
+    const auto file_size = static_cast<size_t>(in.tellg());
+    std::vector<uint8_t> bytes(file_size);
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(bytes.data()),
+            static_cast<std::streamsize>(file_size));
+    if (!in.good()) {
+        std::cerr << "Delta log: failed to read " << path
+                  << "; ignoring it." << std::endl;
+        return delta;
+    }
+
+    size_t offset = 0;
+    bool halted = false;
+    while (offset + sizeof(SegmentHeader) <= bytes.size()) {
+        SegmentHeader header;
+        std::memcpy(&header, bytes.data() + offset, sizeof(header));
+        const size_t payload_off = offset + sizeof(header);
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+            payload_off + header.payload_bytes > bytes.size() ||
+            fnv1a(bytes.data() + payload_off, header.payload_bytes) !=
+                header.payload_sum) {
+            std::cerr << "Delta log: segment " << delta.segments
+                      << " is torn or corrupt; replaying only the "
+                      << delta.segments << " before it." << std::endl;
+            halted = true;
+            break;
+        }
+
+        Reader reader{bytes.data() + payload_off, header.payload_bytes};
+
+        const uint64_t removed_count = reader.u64();
+        for (uint64_t i = 0; reader.ok && i < removed_count; ++i) {
+            delta.removed_files.insert(reader.u64());
+        }
+
+        const uint64_t manifest_count = reader.u64();
+        for (uint64_t i = 0; reader.ok && i < manifest_count; ++i) {
+            ManifestEntry entry;
+            entry.id = reader.u64();
+            entry.size = reader.u64();
+            entry.mtime_ns = static_cast<int64_t>(reader.u64());
+            const uint64_t path_len = reader.u64();
+            const uint8_t* path_bytes = reader.bytes(path_len);
+            if (reader.ok) {
+                delta.manifest_updates[std::string(
+                    reinterpret_cast<const char*>(path_bytes), path_len)] =
+                    entry;
+            }
+        }
+
+        const uint64_t word_count = reader.u64();
+        for (uint64_t w = 0; reader.ok && w < word_count; ++w) {
+            const uint64_t word_len = reader.u64();
+            const uint8_t* word_bytes = reader.bytes(word_len);
+            if (!reader.ok) {
+                break;
+            }
+            std::string word(reinterpret_cast<const char*>(word_bytes),
+                             word_len);
+            auto& occurrences = delta.postings[word];
+            const uint64_t occ_count = reader.u64();
+            for (uint64_t i = 0; reader.ok && i < occ_count; ++i) {
+                PostingCodec::PackedOccurrence occ;
+                occ.file_id = reader.u64();
+                occ.position_count = reader.u64();
+                occ.last_position = reader.u64();
+                const uint64_t blob_len = reader.u64();
+                const uint8_t* blob = reader.bytes(blob_len);
+                if (reader.ok) {
+                    occ.packed_positions.assign(blob, blob + blob_len);
+                    occurrences.push_back(std::move(occ));
+                }
+            }
+        }
+
+        if (!reader.ok) {
+            std::cerr << "Delta log: segment " << delta.segments
+                      << " truncated mid-payload; replaying only the "
+                      << delta.segments << " before it." << std::endl;
+            halted = true;
+            break;
+        }
+
+        ++delta.segments;
+        offset = payload_off + header.payload_bytes;
+        delta.total_bytes = offset;
+    }
+
+    // Trim anything past the last valid segment (a torn tail, or a
+    // partial header too short to frame), so this run's own append lands
+    // after valid data and is not shadowed by the tear on the next load.
+    if (halted || delta.total_bytes < bytes.size()) {
+        in.close();
+        std::error_code ec;
+        std::filesystem::resize_file(path, delta.total_bytes, ec);
+        if (ec) {
+            std::cerr << "Delta log: could not trim the torn tail of "
+                      << path << ": " << ec.message() << std::endl;
+        }
+    }
+
+    return delta;
+}
+
+bool should_compact(size_t delta_bytes, size_t base_bytes) {
+    return delta_bytes * kCompactDenominator >
+           base_bytes * kCompactNumerator;
+}
+
+void discard(const std::string& path) {
+    std::remove(path.c_str());
+}
+
+FileManifest overlay_manifest(const FileManifest& base, const Delta& delta) {
+    FileManifest overlaid;
+    overlaid.reserve(base.size() + delta.manifest_updates.size());
+    for (const auto& [path, entry] : base) {
+        if (delta.removed_files.count(entry.id) == 0) {
+            overlaid.emplace(path, entry);
+        }
+    }
+    for (const auto& [path, entry] : delta.manifest_updates) {
+        overlaid[path] = entry; // Re-modified paths keep the latest record.
+    }
+    return overlaid;
+}
+
+} // namespace IndexDeltaLog
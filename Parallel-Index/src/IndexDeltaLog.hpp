@@ -0,0 +1,100 @@
+#pragma once
+
+#include "FileInfo.hpp"
+#include "InvertedIndex.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Append-only delta log beside the base snapshot, so an
+ * incremental re-index persists only what changed.
+ *
+ * A full IndexSnapshot::save rewrites the entire corpus even when an
+ * incremental run re-tokenized 1% of it. The delta log makes persistence
+ * proportional to the change instead: each incremental run appends one
+ * self-contained segment - the ids whose base postings are now dead
+ * (removed or modified files), the manifest records of the (re)indexed
+ * files, and for every touched word its occurrences restricted to those
+ * files' fresh ids. The next startup replays the log over the mapped
+ * base: carried postings skip the dead ids, segment postings fold in via
+ * restore_merge (delta ids always postdate base ids, so lists stay
+ * sorted), and the manifest overlay drives the incremental scan exactly
+ * as the base manifest alone used to.
+ *
+ * Crash consistency comes from the append discipline: a segment is
+ * framed by its byte length and an FNV checksum, so a torn tail write is
+ * detected on load and ignored - the log is simply as if that run had
+ * never persisted, and the base snapshot is never touched in place.
+ *
+ * Once the log outgrows a fraction of the base (should_compact), the
+ * caller writes a fresh full snapshot from the in-memory index it
+ * already holds and truncates the log - compaction is a rewrite of data
+ * the process has anyway, scheduled on the background build thread.
+ */
+namespace IndexDeltaLog {
+
+    /** @brief Every segment of the log, decoded and merged in append
+     *  order: the overlay to replay on top of the base snapshot. */
+    struct Delta {
+        /// Base (or earlier-segment) file ids whose postings are dead.
+        std::unordered_set<size_t> removed_files;
+        /// Per touched word, the appended occurrences, in append order
+        /// (ascending file_id across segments).
+        std::unordered_map<std::string,
+                           std::vector<PostingCodec::PackedOccurrence>>
+            postings;
+        /// Manifest records of files (re)indexed by the logged runs.
+        FileManifest manifest_updates;
+        size_t segments = 0;     ///< Valid segments decoded.
+        size_t total_bytes = 0;  ///< Log bytes consumed by them.
+
+        bool empty() const { return segments == 0; }
+    };
+
+    /**
+     * @brief Appends one segment for an incremental run.
+     *
+     * Walks the index once and writes, per word, only the occurrences
+     * whose file_id is in 'changed_ids' - the write is proportional to
+     * the change, the walk to the dictionary.
+     *
+     * @param path The delta log file (created if missing).
+     * @param index The fully rebuilt in-memory index.
+     * @param changed_ids Ids of the files (re)indexed by this run.
+     * @param removed_ids Ids whose previous postings are now dead
+     *        (deleted files, and the old ids of modified ones).
+     * @param manifest The current full manifest; entries for changed_ids
+     *        are the ones persisted.
+     * @return True on success; failures are logged to stderr.
+     */
+    bool append(const std::string& path, const InvertedIndex& index,
+                const std::unordered_set<size_t>& changed_ids,
+                const std::vector<size_t>& removed_ids,
+                const FileManifest& manifest);
+
+    /**
+     * @brief Decodes every valid segment of the log; an empty Delta if
+     * the file is missing. A corrupt or torn segment ends the replay
+     * there (with a stderr note) - everything before it still applies.
+     */
+    Delta load(const std::string& path);
+
+    /**
+     * @brief Compaction policy: true once the log has grown past a fixed
+     * fraction of the base snapshot, the point where replay cost and
+     * dead data outweigh the append savings.
+     */
+    bool should_compact(size_t delta_bytes, size_t base_bytes);
+
+    /** @brief Removes the log (after a full snapshot has subsumed it). */
+    void discard(const std::string& path);
+
+    /** @brief The manifest the next scan should diff against: the base
+     *  manifest with dead ids dropped and the delta's records overlaid. */
+    FileManifest overlay_manifest(const FileManifest& base,
+                                  const Delta& delta);
+
+} // namespace IndexDeltaLog
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "InvertedIndex.hpp"
+#include <scheduler/snapshot_ptr.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One immutable, queryable index generation.
+ *
+ * A generation bundles the full query surface behind type-erased callbacks,
+ * so the same handle can front either backend: a memory-mapped snapshot or
+ * an in-memory InvertedIndex. Whatever object the callbacks capture (the
+ * mapping, the index) lives exactly as long as some query or the handle
+ * still references the generation.
+ */
+struct IndexGeneration {
+    std::function<std::vector<WordOccurrence>(const std::string&)> search;
+    // Zero-copy single-word query; only the in-memory backend provides it
+    // (a mapped snapshot decodes anyway), so callers fall back to
+    // search() when unset. The generation shared_ptr the caller pins is
+    // what keeps the underlying index alive for the view's lifetime.
+    std::function<InvertedIndex::ResultView(const std::string&)> search_view;
+    std::function<std::vector<size_t>(const std::vector<std::string>&)> search_all;
+    std::function<std::vector<WordOccurrence>(const std::vector<std::string>&)> search_phrase;
+    std::function<std::vector<ScoredFile>(const std::string&, size_t)> search_ranked;
+    std::function<std::vector<std::string>(const std::string&)> search_prefix;
+    std::function<std::string(size_t)> path_of;
+};
+
+/**
+ * @brief RCU-style published-index handle: queries pin the current
+ * generation through a hazard-slot read (no shared refcount traffic at
+ * all), and a rebuild publishes its finished generation with one swap.
+ *
+ * This is what lets re-indexing run while queries are being served: the
+ * new index is built entirely off to the side and readers never see it
+ * until it is complete, so they never contend with the writers' exclusive
+ * shard locks. A reader that pinned the old generation just before a swap
+ * finishes its query against a consistent view; the publisher defers
+ * destroying the old generation until every such pin is gone.
+ *
+ * The pin used to be an atomic<shared_ptr> load, which costs two
+ * contended refcount RMWs per query - every reader writing the same
+ * control-block cache line. scheduler::snapshot_ptr replaces that with a
+ * per-reader hazard slot, so concurrent queries share no written line.
+ */
+class IndexHandle {
+public:
+    /** @brief Pinned view of one generation; dereferences like the
+     *  shared_ptr it replaced and releases the pin on destruction. */
+    using Generation = scheduler::snapshot_ptr<IndexGeneration>::guard;
+
+    /** @brief Atomically replaces the current generation. Generations no
+     *  reader still pins are reclaimed here or on a later publish. */
+    void publish(std::shared_ptr<const IndexGeneration> next) {
+        current_.store(std::move(next));
+    }
+
+    /**
+     * @brief Pins the current generation for the duration of the caller's
+     * query; the returned guard must not outlive the handle.
+     */
+    Generation current() const {
+        return current_.load();
+    }
+
+private:
+    scheduler::snapshot_ptr<IndexGeneration> current_;
+};
@@ -0,0 +1,1041 @@
+#include "IndexSnapshot.hpp"
+#include <scheduler/profile.hpp>     // PROFILE_SCOPE (Task-Scheduler)
+#include <scheduler/thread_pool.hpp> // Parallel snapshot serialization
+#include <latch>     // For joining the serializer tasks
+#include <thread>    // For hardware_concurrency (serializer sizing)
+
+#include <algorithm> // For std::sort
+#include <cstddef>   // For offsetof
+#include <cstdio>    // For std::rename, std::remove
+#include <cstring>   // For std::memcpy, std::memcmp
+#include <fstream>   // For the writer
+#include <iostream>  // For error logging
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap, munmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For close
+#endif
+
+namespace IndexSnapshot {
+
+namespace {
+
+    constexpr char kMagic[8] = {'P', 'I', 'D', 'X', 'S', 'N', 'A', 'P'};
+    // v6 stores the postings section's per-block checksums as their own
+    // section, so a reader validates each 4 MiB block on its first touch
+    // instead of streaming the whole section - what makes serving an
+    // index larger than RAM possible;
+    // v5 added per-section checksums to the header;
+    // v4 added per-file document lengths to FileEntry (BM25 ranking);
+    // v3 switched posting runs from raw uint64 arrays to delta-varint
+    // streams carrying the index's compressed position blobs verbatim.
+    // Older snapshots fail validation and trigger one full re-index.
+    constexpr uint64_t kVersion = 6;
+
+    /** @brief Fixed-size snapshot header; 104 bytes, all 8-byte fields. */
+    struct Header {
+        char magic[8];
+        uint64_t version;
+        uint64_t word_count;
+        uint64_t file_count;
+        uint64_t words_off;      ///< WordEntry array.
+        uint64_t postings_off;   ///< Posting runs.
+        uint64_t block_sums_off; ///< Per-4MiB-block postings checksums.
+        uint64_t files_off;      ///< FileEntry array.
+        uint64_t blob_off;       ///< Word/path bytes.
+        uint64_t words_sum;      ///< Per-section checksums (see
+        uint64_t postings_sum;   ///< section_checksum); the postings one
+        uint64_t files_sum;      ///< is an FNV over the block sums and is
+        uint64_t blob_sum;       ///< checked at open(), cheaply.
+    };
+    static_assert(sizeof(Header) == 104, "snapshot header layout drifted");
+
+    /** @brief One dictionary entry; the array is sorted by word bytes. */
+    struct WordEntry {
+        uint64_t word_off;     ///< Offset of the word bytes in the blob.
+        uint64_t word_len;
+        uint64_t postings_off; ///< Absolute offset of this word's posting run.
+        uint64_t occ_count;    ///< Number of occurrences in the run.
+    };
+    static_assert(sizeof(WordEntry) == 32, "word entry layout drifted");
+
+    /** @brief One file-table entry; the array is sorted by file_id. */
+    struct FileEntry {
+        uint64_t file_id;
+        uint64_t path_off;     ///< Offset of the path bytes in the blob.
+        uint64_t path_len;
+        uint64_t size;         ///< File size when indexed.
+        int64_t mtime_ns;      ///< Last-write time when indexed.
+        uint64_t doc_length;   ///< Indexed token count, for BM25 scoring.
+    };
+    static_assert(sizeof(FileEntry) == 48, "file entry layout drifted");
+
+    /** @brief FNV-1a over a byte range, seedable for chaining. */
+    uint64_t fnv1a(const void* data, size_t len,
+                   uint64_t hash = 14695981039346656037ull) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /** @brief Checksum blocks are fixed-size so writer and reader chunk
+     *  identically no matter how either parallelizes. */
+    constexpr size_t kChecksumBlock = size_t{1} << 22; // 4 MiB.
+
+    /**
+     * @brief Section checksum: FNV-1a per fixed 4 MiB block, then FNV-1a
+     * over the block sums. The two-level shape lets the writer hash
+     * blocks on ThreadPool workers and still agree with a reader hashing
+     * them serially (or vice versa).
+     */
+    uint64_t section_checksum(const uint8_t* data, size_t len) {
+        std::vector<uint64_t> block_sums;
+        block_sums.reserve(len / kChecksumBlock + 1);
+        for (size_t off = 0; off < len; off += kChecksumBlock) {
+            block_sums.push_back(
+                fnv1a(data + off, std::min(kChecksumBlock, len - off)));
+        }
+        return fnv1a(block_sums.data(), block_sums.size() * sizeof(uint64_t));
+    }
+
+    /** @brief Reads a uint64_t from the mapping without aliasing UB. */
+    uint64_t read_u64(const char* base, size_t offset) {
+        uint64_t value;
+        std::memcpy(&value, base + offset, sizeof(value));
+        return value;
+    }
+
+    /** @brief The word bytes a WordEntry at 'entry_off' points at. */
+    std::string_view entry_word(const char* base, size_t blob_off,
+                                size_t entry_off) {
+        const uint64_t word_off = read_u64(base, entry_off);
+        const uint64_t word_len = read_u64(base, entry_off + 8);
+        return std::string_view(base + blob_off + word_off, word_len);
+    }
+
+    /**
+     * @brief Serializes one word's posting run: per occurrence the file_id
+     * delta from its predecessor, the position count, the last position,
+     * the blob length, then the compressed position blob verbatim.
+     */
+    void encode_run(std::vector<uint8_t>& out,
+                    const std::vector<PostingCodec::PackedOccurrence>& occurrences) {
+        size_t previous_id = 0;
+        for (const PostingCodec::PackedOccurrence& occ : occurrences) {
+            PostingCodec::encode_varint(out, occ.file_id - previous_id);
+            previous_id = occ.file_id;
+            PostingCodec::encode_varint(out, occ.position_count);
+            PostingCodec::encode_varint(out, occ.last_position);
+            PostingCodec::encode_varint(out, occ.packed_positions.size());
+            out.insert(out.end(), occ.packed_positions.begin(),
+                       occ.packed_positions.end());
+        }
+    }
+
+    /**
+     * @brief Parses one occurrence's run header, advancing 'p' to its blob
+     * (which the caller consumes or skips via the returned length).
+     */
+    struct RunOccurrence {
+        uint64_t file_id;
+        uint64_t position_count;
+        uint64_t last_position;
+        uint64_t blob_len;
+    };
+    /** @brief Upper bound of one encoded run header: four varints of at
+     *  most ten bytes each. What a reader must validate before decoding. */
+    constexpr size_t kMaxRunHeaderBytes = 40;
+
+    RunOccurrence decode_run_header(const uint8_t*& p, uint64_t previous_id) {
+        RunOccurrence occ;
+        occ.file_id = previous_id + PostingCodec::decode_varint(p);
+        occ.position_count = PostingCodec::decode_varint(p);
+        occ.last_position = PostingCodec::decode_varint(p);
+        occ.blob_len = PostingCodec::decode_varint(p);
+        return occ;
+    }
+
+    constexpr char kHotMagic[8] = {'P', 'I', 'D', 'X', 'H', 'O', 'T', '1'};
+
+    /**
+     * @brief Header of the hot-page sidecar (snapshot path + ".hot"):
+     * after it, page_count uint64_t page indices into the mapping,
+     * hottest first. The mapping length and postings checksum
+     * fingerprint the snapshot the pages were recorded against, so a
+     * sidecar left over from before a rewrite is ignored, not replayed.
+     */
+    struct HotHeader {
+        char magic[8];
+        uint64_t mapping_length;
+        uint64_t postings_sum;
+        uint64_t page_count;
+        uint64_t pages_sum; ///< FNV-1a over the page-index array.
+    };
+    static_assert(sizeof(HotHeader) == 40, "hot sidecar header layout drifted");
+
+} // anonymous namespace
+
+bool save(const std::string& path, const InvertedIndex& index,
+          const FileManifest& manifest) {
+    // Copy the index out under its shard locks, then sort the dictionary so
+    // the reader can binary-search it in place. Occurrences stay in their
+    // compressed form throughout.
+    std::vector<std::pair<std::string,
+                          std::vector<PostingCodec::PackedOccurrence>>> words;
+    words.reserve(index.size());
+    index.visit_all(
+        [&words](std::string_view word,
+                 const std::vector<PostingCodec::PackedOccurrence>& occurrences) {
+            words.emplace_back(word, occurrences);
+        });
+    std::sort(words.begin(), words.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    struct FileRow {
+        size_t id;
+        const std::string* path;
+        uint64_t size;
+        int64_t mtime_ns;
+    };
+    std::vector<FileRow> files;
+    files.reserve(manifest.size());
+    for (const auto& [file_path, entry] : manifest) {
+        files.push_back({entry.id, &file_path, entry.size, entry.mtime_ns});
+    }
+    std::sort(files.begin(), files.end(),
+              [](const FileRow& a, const FileRow& b) { return a.id < b.id; });
+
+    // Serialize the posting runs in parallel: one contiguous chunk of the
+    // sorted dictionary per worker, each encoded into its own buffer by a
+    // ThreadPool task. (The index's shards cannot serialize independently
+    // into the file because the dictionary must land globally sorted;
+    // equal chunks of the sorted array spread the same work across cores
+    // without a merge step.)
+    const size_t workers = std::min<size_t>(
+        8, std::max<size_t>(1, std::thread::hardware_concurrency()));
+    const size_t chunk_count =
+        (words.size() >= 4096 && workers > 1) ? workers : 1;
+
+    std::vector<std::vector<uint8_t>> chunk_bytes(chunk_count);
+    std::vector<std::vector<uint64_t>> chunk_runs(chunk_count);
+    std::unique_ptr<scheduler::ThreadPool> pool;
+    if (chunk_count > 1) {
+        pool = std::make_unique<scheduler::ThreadPool>(chunk_count);
+    }
+
+    auto encode_chunk = [&](size_t c) {
+        const size_t begin = c * words.size() / chunk_count;
+        const size_t end = (c + 1) * words.size() / chunk_count;
+        chunk_runs[c].reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            chunk_runs[c].push_back(chunk_bytes[c].size());
+            encode_run(chunk_bytes[c], words[i].second);
+        }
+    };
+    if (pool) {
+        std::latch done(static_cast<std::ptrdiff_t>(chunk_count));
+        for (size_t c = 0; c < chunk_count; ++c) {
+            pool->enqueue([&encode_chunk, &done, c] {
+                encode_chunk(c);
+                done.count_down();
+            });
+        }
+        done.wait();
+    } else {
+        encode_chunk(0);
+    }
+
+    // Stitch the chunks into one postings section, rebasing each chunk's
+    // run offsets. The runs are variable-length, so the section is padded
+    // to 8 bytes to keep the FileEntry array aligned.
+    std::vector<uint64_t> run_offsets; ///< Per word, relative to the section.
+    run_offsets.reserve(words.size());
+    size_t postings_size = 0;
+    for (size_t c = 0; c < chunk_count; ++c) {
+        for (const uint64_t offset : chunk_runs[c]) {
+            run_offsets.push_back(postings_size + offset);
+        }
+        postings_size += chunk_bytes[c].size();
+    }
+    std::vector<uint8_t> postings;
+    postings.reserve((postings_size + 7) & ~static_cast<size_t>(7));
+    for (std::vector<uint8_t>& chunk : chunk_bytes) {
+        postings.insert(postings.end(), chunk.begin(), chunk.end());
+        chunk = {}; // Return each chunk's memory as soon as it is copied.
+    }
+    postings.resize((postings.size() + 7) & ~static_cast<size_t>(7), 0);
+
+    // Lay the sections out: header, word entries, postings, block sums,
+    // file entries, blob.
+    const size_t block_count =
+        postings.empty() ? 0
+                         : (postings.size() + kChecksumBlock - 1) / kChecksumBlock;
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.word_count = words.size();
+    header.file_count = files.size();
+    header.words_off = sizeof(Header);
+    header.postings_off = header.words_off + words.size() * sizeof(WordEntry);
+    header.block_sums_off = header.postings_off + postings.size();
+    header.files_off = header.block_sums_off + block_count * sizeof(uint64_t);
+    header.blob_off = header.files_off + files.size() * sizeof(FileEntry);
+
+    // Build the fixed-width sections and the blob in memory so every
+    // section can be checksummed before a byte hits the disk.
+    std::vector<WordEntry> word_entries;
+    word_entries.reserve(words.size());
+    uint64_t blob_cursor = 0;
+    for (size_t i = 0; i < words.size(); ++i) {
+        const auto& [word, occurrences] = words[i];
+        WordEntry entry{};
+        entry.word_off = blob_cursor;
+        entry.word_len = word.size();
+        entry.postings_off = header.postings_off + run_offsets[i];
+        entry.occ_count = occurrences.size();
+        word_entries.push_back(entry);
+        blob_cursor += word.size();
+    }
+
+    // File table (doubles as the incremental-scan manifest).
+    std::vector<FileEntry> file_entries;
+    file_entries.reserve(files.size());
+    for (const FileRow& row : files) {
+        FileEntry entry{};
+        entry.file_id = row.id;
+        entry.path_off = blob_cursor;
+        entry.path_len = row.path->size();
+        entry.size = row.size;
+        entry.mtime_ns = row.mtime_ns;
+        entry.doc_length = index.document_length(row.id);
+        file_entries.push_back(entry);
+        blob_cursor += row.path->size();
+    }
+
+    // Blob: word bytes in dictionary order, then path bytes in id order.
+    std::string blob;
+    blob.reserve(blob_cursor); // Total word + path bytes.
+    for (const auto& [word, occurrences] : words) {
+        blob.append(word);
+    }
+    for (const FileRow& row : files) {
+        blob.append(*row.path);
+    }
+
+    // Checksums. The postings blocks are hashed on the pool (the section
+    // dominates the file); the small sections go serially. The per-block
+    // sums are persisted as their own section so the reader can validate
+    // one block on first touch; the header's postings_sum is the FNV over
+    // them, which the reader checks at open() to vouch for the stored
+    // sums themselves.
+    std::vector<uint64_t> block_sums(block_count);
+    if (pool && block_count > 1) {
+        std::latch done(static_cast<std::ptrdiff_t>(block_count));
+        for (size_t b = 0; b < block_count; ++b) {
+            pool->enqueue([&postings, &block_sums, &done, b] {
+                const size_t offset = b * kChecksumBlock;
+                block_sums[b] =
+                    fnv1a(postings.data() + offset,
+                          std::min(kChecksumBlock, postings.size() - offset));
+                done.count_down();
+            });
+        }
+        done.wait();
+    } else {
+        for (size_t b = 0; b < block_count; ++b) {
+            const size_t offset = b * kChecksumBlock;
+            block_sums[b] =
+                fnv1a(postings.data() + offset,
+                      std::min(kChecksumBlock, postings.size() - offset));
+        }
+    }
+    header.postings_sum =
+        fnv1a(block_sums.data(), block_sums.size() * sizeof(uint64_t));
+    header.words_sum = section_checksum(
+        reinterpret_cast<const uint8_t*>(word_entries.data()),
+        word_entries.size() * sizeof(WordEntry));
+    header.files_sum = section_checksum(
+        reinterpret_cast<const uint8_t*>(file_entries.data()),
+        file_entries.size() * sizeof(FileEntry));
+    header.blob_sum = section_checksum(
+        reinterpret_cast<const uint8_t*>(blob.data()), blob.size());
+
+    const std::string tmp_path = path + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "[Snapshot Error] Could not create: " << tmp_path << std::endl;
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(word_entries.data()),
+              static_cast<std::streamsize>(word_entries.size() *
+                                           sizeof(WordEntry)));
+    out.write(reinterpret_cast<const char*>(postings.data()),
+              static_cast<std::streamsize>(postings.size()));
+    out.write(reinterpret_cast<const char*>(block_sums.data()),
+              static_cast<std::streamsize>(block_sums.size() *
+                                           sizeof(uint64_t)));
+    out.write(reinterpret_cast<const char*>(file_entries.data()),
+              static_cast<std::streamsize>(file_entries.size() *
+                                           sizeof(FileEntry)));
+    out.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+
+    out.close();
+    if (!out) {
+        std::cerr << "[Snapshot Error] Write failed: " << tmp_path << std::endl;
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+
+    // Atomic publish: readers either see the old snapshot or the new one.
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::cerr << "[Snapshot Error] Could not rename " << tmp_path
+                  << " to " << path << std::endl;
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<MappedIndex> MappedIndex::open(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr; // Missing snapshot is not an error; caller re-indexes.
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        std::cerr << "[Snapshot Error] Truncated snapshot: " << path << std::endl;
+        ::close(fd);
+        return nullptr;
+    }
+    const size_t length = static_cast<size_t>(st.st_size);
+
+    void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file alive.
+    if (mapping == MAP_FAILED) {
+        std::cerr << "[Snapshot Error] mmap failed for: " << path << std::endl;
+        return nullptr;
+    }
+    const char* base = static_cast<const char*>(mapping);
+
+    Header header;
+    std::memcpy(&header, base, sizeof(header));
+    const size_t postings_len = header.block_sums_off - header.postings_off;
+    const size_t block_count =
+        postings_len == 0 ? 0
+                          : (postings_len + kChecksumBlock - 1) / kChecksumBlock;
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kVersion ||
+        header.words_off > header.postings_off ||
+        header.postings_off > header.block_sums_off ||
+        header.block_sums_off > header.files_off ||
+        header.files_off > header.blob_off || header.blob_off > length ||
+        header.files_off - header.block_sums_off !=
+            block_count * sizeof(uint64_t)) {
+        std::cerr << "[Snapshot Error] Bad header in: " << path << std::endl;
+        ::munmap(mapping, length);
+        return nullptr;
+    }
+
+    // Validate the small sections eagerly - they are about to be touched
+    // by every query anyway. The postings section (the multi-GB one) is
+    // never streamed here: only its stored block-sum array is verified
+    // against the header, and postings_range_valid() then checks each
+    // 4 MiB block against its stored sum the first time a query touches
+    // it. That keeps a cold open at milliseconds - and resident memory
+    // bounded - no matter how far past RAM the index has grown.
+    const size_t words_len = header.postings_off - header.words_off;
+    const size_t files_len = header.blob_off - header.files_off;
+    const size_t blob_len = length - header.blob_off;
+    if (section_checksum(reinterpret_cast<const uint8_t*>(base) +
+                             header.words_off,
+                         words_len) != header.words_sum ||
+        fnv1a(base + header.block_sums_off,
+              block_count * sizeof(uint64_t)) != header.postings_sum ||
+        section_checksum(reinterpret_cast<const uint8_t*>(base) +
+                             header.files_off,
+                         files_len) != header.files_sum ||
+        section_checksum(reinterpret_cast<const uint8_t*>(base) +
+                             header.blob_off,
+                         blob_len) != header.blob_sum) {
+        std::cerr << "[Snapshot Error] Section checksum mismatch in: " << path
+                  << std::endl;
+        ::munmap(mapping, length);
+        return nullptr;
+    }
+
+    auto index = std::unique_ptr<MappedIndex>(new MappedIndex());
+    index->base_ = base;
+    index->length_ = length;
+    index->word_count_ = header.word_count;
+    index->file_count_ = header.file_count;
+    index->words_off_ = header.words_off;
+    index->files_off_ = header.files_off;
+    index->postings_off_ = header.postings_off;
+    index->postings_len_ = postings_len;
+    index->postings_sum_ = header.postings_sum;
+    index->block_sums_off_ = header.block_sums_off;
+    index->postings_blocks_ = block_count;
+    index->blocks_checked_ = std::make_unique<std::atomic<uint64_t>[]>(
+        (block_count + 63) / 64);
+
+    // Disk-resident serving: once the snapshot outgrows memory, linear
+    // readahead through the postings would just thrash the page cache.
+    // Hint random access so the kernel pages in exactly the blocks
+    // queries touch and evicts least-recently-used ones as it goes -
+    // the same binary serves a small index entirely from RAM and an
+    // archive-tier one from disk, with no mode switch.
+    const long phys_pages = ::sysconf(_SC_PHYS_PAGES);
+    const long page_size = ::sysconf(_SC_PAGE_SIZE);
+    if (phys_pages > 0 && page_size > 0 &&
+        length > static_cast<size_t>(phys_pages) *
+                     static_cast<size_t>(page_size) / 2) {
+        ::madvise(const_cast<char*>(base) + header.postings_off,
+                  postings_len, MADV_RANDOM);
+        std::cout << "[Snapshot] Index (" << length / (1024 * 1024)
+                  << " MiB) exceeds half of physical memory; serving "
+                     "disk-resident with on-demand postings paging."
+                  << std::endl;
+    }
+    // One pass over the (small) file table up front, so ranked queries get
+    // the corpus token count without rescanning it.
+    for (size_t i = 0; i < index->file_count_; ++i) {
+        index->total_doc_tokens_ +=
+            read_u64(base, header.files_off + i * sizeof(FileEntry) +
+                               offsetof(FileEntry, doc_length));
+    }
+    // Warm-start bookkeeping: one counter per page (a 1 GiB snapshot
+    // costs 512 KiB of counters), then replay last session's hot set as
+    // readahead hints while the caller's first queries proceed.
+    index->path_ = path;
+    index->page_count_ = (length + kPageBytes - 1) / kPageBytes;
+    index->page_hits_ = std::make_unique<std::atomic<uint16_t>[]>(
+        index->page_count_);
+    index->start_prefetch();
+    return index;
+#else
+    (void)path;
+    return nullptr; // No mmap on this platform; caller re-indexes.
+#endif
+}
+
+MappedIndex::~MappedIndex() {
+    // The prefetch thread madvises over the mapping; it must be done
+    // before the mapping goes away.
+    if (prefetch_thread_.joinable()) {
+        prefetch_thread_.join();
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    if (base_ != nullptr) {
+        ::munmap(const_cast<char*>(base_), length_);
+    }
+#endif
+}
+
+std::string_view MappedIndex::probe_word(size_t blob_off,
+                                         size_t entry_off) const {
+    const std::string_view word = entry_word(base_, blob_off, entry_off);
+    note_range(entry_off, sizeof(WordEntry));
+    note_range(static_cast<size_t>(word.data() - base_), word.size());
+    return word;
+}
+
+void MappedIndex::start_prefetch() {
+#if defined(__unix__) || defined(__APPLE__)
+    std::ifstream in(path_ + ".hot", std::ios::binary);
+    if (!in.is_open()) {
+        return; // First serving session; nothing recorded yet.
+    }
+    HotHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, kHotMagic, sizeof(kHotMagic)) != 0 ||
+        header.mapping_length != length_ ||
+        header.postings_sum != postings_sum_ ||
+        header.page_count == 0 || header.page_count > page_count_) {
+        std::cerr << "[Snapshot] Ignoring stale hot-page sidecar (snapshot "
+                     "was rewritten since it was recorded)." << std::endl;
+        return;
+    }
+    std::vector<uint64_t> pages(header.page_count);
+    in.read(reinterpret_cast<char*>(pages.data()),
+            static_cast<std::streamsize>(pages.size() * sizeof(uint64_t)));
+    if (!in || fnv1a(pages.data(), pages.size() * sizeof(uint64_t)) !=
+                   header.pages_sum) {
+        std::cerr << "[Snapshot] Ignoring corrupt hot-page sidecar."
+                  << std::endl;
+        return;
+    }
+
+    // Coalesce adjacent pages (the order is hottest-first, so runs of
+    // neighbours are common: binary-search upper levels, dense posting
+    // runs) into one madvise range each, preserving the priority order.
+    std::vector<std::pair<size_t, size_t>> ranges; // (offset, length)
+    for (const uint64_t page : pages) {
+        if (page >= page_count_) {
+            continue; // Defensive; the fingerprint should preclude this.
+        }
+        const size_t offset = static_cast<size_t>(page) * kPageBytes;
+        if (!ranges.empty() &&
+            ranges.back().first + ranges.back().second == offset) {
+            ranges.back().second += kPageBytes;
+        } else {
+            ranges.emplace_back(offset, kPageBytes);
+        }
+    }
+    if (ranges.empty()) {
+        return;
+    }
+    std::cout << "[Snapshot] Warm start: prefetching " << pages.size()
+              << " hot pages (" << pages.size() * kPageBytes / 1024
+              << " KiB) recorded by the previous session." << std::endl;
+    // WILLNEED only queues readahead, but a queue-full or cold device can
+    // still make it block - so the hints go out on their own thread and
+    // the first queries never wait on them.
+    prefetch_thread_ = std::thread([this, ranges = std::move(ranges)] {
+        for (const auto& [offset, range_len] : ranges) {
+            ::madvise(const_cast<char*>(base_) + offset,
+                      std::min(range_len, length_ - offset), MADV_WILLNEED);
+        }
+    });
+#endif
+}
+
+bool MappedIndex::save_hot_pages() const {
+    if (page_hits_ == nullptr) {
+        return false;
+    }
+    // Touched pages only, hottest first; ties break toward lower offsets
+    // so header/dictionary pages lead their equally-warm neighbours.
+    std::vector<std::pair<uint16_t, uint64_t>> hot; // (hits, page)
+    for (size_t page = 0; page < page_count_; ++page) {
+        const uint16_t hits = page_hits_[page].load(std::memory_order_relaxed);
+        if (hits != 0) {
+            hot.emplace_back(hits, page);
+        }
+    }
+    if (hot.empty()) {
+        return true; // No queries ran; keep any previous sidecar as-is.
+    }
+    std::sort(hot.begin(), hot.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    std::vector<uint64_t> pages;
+    pages.reserve(hot.size());
+    for (const auto& [hits, page] : hot) {
+        pages.push_back(page);
+    }
+
+    HotHeader header{};
+    std::memcpy(header.magic, kHotMagic, sizeof(kHotMagic));
+    header.mapping_length = length_;
+    header.postings_sum = postings_sum_;
+    header.page_count = pages.size();
+    header.pages_sum = fnv1a(pages.data(), pages.size() * sizeof(uint64_t));
+
+    const std::string hot_path = path_ + ".hot";
+    const std::string tmp_path = hot_path + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "[Snapshot Error] Could not create: " << tmp_path
+                  << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(pages.data()),
+              static_cast<std::streamsize>(pages.size() * sizeof(uint64_t)));
+    out.close();
+    if (!out || std::rename(tmp_path.c_str(), hot_path.c_str()) != 0) {
+        std::cerr << "[Snapshot Error] Could not write hot-page sidecar: "
+                  << hot_path << std::endl;
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    std::cout << "[Snapshot] Hot-page sidecar: " << pages.size()
+              << " pages recorded for the next run's warm start."
+              << std::endl;
+    return true;
+}
+
+bool MappedIndex::postings_range_valid(size_t offset, size_t len) const {
+    if (postings_corrupt_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (len == 0 || postings_blocks_ == 0) {
+        return true;
+    }
+    const size_t first = (offset - postings_off_) / kChecksumBlock;
+    size_t last = (offset + len - 1 - postings_off_) / kChecksumBlock;
+    if (last >= postings_blocks_) {
+        last = postings_blocks_ - 1;
+    }
+    for (size_t b = first; b <= last; ++b) {
+        const uint64_t bit = uint64_t{1} << (b % 64);
+        if ((blocks_checked_[b / 64].load(std::memory_order_acquire) & bit) !=
+            0) {
+            continue;
+        }
+        // A racing duplicate check is benign - both sides compute the
+        // same answer, same as the old whole-section path.
+        const size_t block_off = postings_off_ + b * kChecksumBlock;
+        const size_t block_len =
+            std::min(kChecksumBlock, postings_off_ + postings_len_ - block_off);
+        if (fnv1a(base_ + block_off, block_len) !=
+            read_u64(base_, block_sums_off_ + b * sizeof(uint64_t))) {
+            std::cerr << "[Snapshot Error] Postings block " << b
+                      << " checksum mismatch; snapshot queries disabled."
+                      << std::endl;
+            postings_corrupt_.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        blocks_checked_[b / 64].fetch_or(bit, std::memory_order_release);
+    }
+    return true;
+}
+
+std::vector<WordOccurrence> MappedIndex::search(std::string_view word) const {
+    PROFILE_SCOPE("MappedIndex::search");
+    const size_t blob_off = read_u64(base_, offsetof(Header, blob_off));
+    // Validates the blocks a run's bytes land in, on their first touch.
+    const auto run_valid = [this](const uint8_t* p, size_t len) {
+        return postings_range_valid(
+            static_cast<size_t>(reinterpret_cast<const char*>(p) - base_), len);
+    };
+
+    // Binary search over the sorted WordEntry array, comparing bytes
+    // directly in the mapping.
+    size_t lo = 0;
+    size_t hi = word_count_;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const size_t entry_off = words_off_ + mid * sizeof(WordEntry);
+        const std::string_view candidate = probe_word(blob_off, entry_off);
+        if (candidate < word) {
+            lo = mid + 1;
+        } else if (word < candidate) {
+            hi = mid;
+        } else {
+            // Hit: decode this word's posting run, positions included.
+            const uint64_t postings_off = read_u64(base_, entry_off + 16);
+            const uint64_t occ_count = read_u64(base_, entry_off + 24);
+            std::vector<WordOccurrence> results;
+            results.reserve(occ_count);
+            const uint8_t* p =
+                reinterpret_cast<const uint8_t*>(base_) + postings_off;
+            uint64_t previous_id = 0;
+            for (uint64_t i = 0; i < occ_count; ++i) {
+                if (!run_valid(p, kMaxRunHeaderBytes)) {
+                    return {};
+                }
+                const RunOccurrence run = decode_run_header(p, previous_id);
+                if (!run_valid(p, run.blob_len)) {
+                    return {};
+                }
+                previous_id = run.file_id;
+                WordOccurrence occ;
+                occ.file_id = run.file_id;
+                occ.positions.reserve(run.position_count);
+                const uint8_t* blob = p;
+                size_t previous_position = 0;
+                for (uint64_t pos = 0; pos < run.position_count; ++pos) {
+                    previous_position += PostingCodec::decode_varint(blob);
+                    occ.positions.push_back(previous_position);
+                }
+                p += run.blob_len;
+                results.push_back(std::move(occ));
+            }
+            note_range(postings_off,
+                       static_cast<size_t>(
+                           p - reinterpret_cast<const uint8_t*>(base_)) -
+                           postings_off);
+            return results;
+        }
+    }
+    return {};
+}
+
+std::vector<size_t> MappedIndex::search_all(
+    const std::vector<std::string>& terms) const {
+    if (terms.empty()) {
+        return {};
+    }
+    const size_t blob_off = read_u64(base_, offsetof(Header, blob_off));
+    const auto run_valid = [this](const uint8_t* p, size_t len) {
+        return postings_range_valid(
+            static_cast<size_t>(reinterpret_cast<const char*>(p) - base_), len);
+    };
+
+    // Extract each term's file-ID list (the run headers alone; position
+    // blobs are skipped via their stored length), then intersect with the
+    // shared galloping routine.
+    auto file_ids_for = [&](std::string_view word) {
+        std::vector<size_t> ids;
+        size_t lo = 0;
+        size_t hi = word_count_;
+        while (lo < hi) {
+            const size_t mid = lo + (hi - lo) / 2;
+            const size_t entry_off = words_off_ + mid * sizeof(WordEntry);
+            const std::string_view candidate = probe_word(blob_off, entry_off);
+            if (candidate < word) {
+                lo = mid + 1;
+            } else if (word < candidate) {
+                hi = mid;
+            } else {
+                const uint64_t postings_off = read_u64(base_, entry_off + 16);
+                const uint64_t occ_count = read_u64(base_, entry_off + 24);
+                ids.reserve(occ_count);
+                const uint8_t* p =
+                    reinterpret_cast<const uint8_t*>(base_) + postings_off;
+                uint64_t previous_id = 0;
+                for (uint64_t i = 0; i < occ_count; ++i) {
+                    if (!run_valid(p, kMaxRunHeaderBytes)) {
+                        ids.clear();
+                        break;
+                    }
+                    const RunOccurrence run = decode_run_header(p, previous_id);
+                    previous_id = run.file_id;
+                    ids.push_back(run.file_id);
+                    p += run.blob_len;
+                }
+                note_range(postings_off,
+                           static_cast<size_t>(
+                               p - reinterpret_cast<const uint8_t*>(base_)) -
+                               postings_off);
+                break;
+            }
+        }
+        return ids;
+    };
+
+    std::vector<std::vector<size_t>> id_lists;
+    id_lists.reserve(terms.size());
+    for (const std::string& term : terms) {
+        id_lists.push_back(file_ids_for(term));
+    }
+
+    std::vector<const std::vector<size_t>*> lists;
+    lists.reserve(id_lists.size());
+    for (const auto& list : id_lists) {
+        lists.push_back(&list);
+    }
+    return intersect_postings(lists);
+}
+
+std::vector<ScoredFile> MappedIndex::search_ranked(std::string_view term,
+                                                   size_t k) const {
+    const size_t blob_off = read_u64(base_, offsetof(Header, blob_off));
+    const auto run_valid = [this](const uint8_t* p, size_t len) {
+        return postings_range_valid(
+            static_cast<size_t>(reinterpret_cast<const char*>(p) - base_), len);
+    };
+
+    // Locate the term and collect (file_id, term frequency) pairs from the
+    // run headers, skipping every position blob.
+    std::vector<std::pair<size_t, size_t>> tf_by_file;
+    size_t lo = 0;
+    size_t hi = word_count_;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const size_t entry_off = words_off_ + mid * sizeof(WordEntry);
+        const std::string_view candidate = probe_word(blob_off, entry_off);
+        if (candidate < term) {
+            lo = mid + 1;
+        } else if (term < candidate) {
+            hi = mid;
+        } else {
+            const uint64_t postings_off = read_u64(base_, entry_off + 16);
+            const uint64_t occ_count = read_u64(base_, entry_off + 24);
+            tf_by_file.reserve(occ_count);
+            const uint8_t* p =
+                reinterpret_cast<const uint8_t*>(base_) + postings_off;
+            uint64_t previous_id = 0;
+            for (uint64_t i = 0; i < occ_count; ++i) {
+                if (!run_valid(p, kMaxRunHeaderBytes)) {
+                    tf_by_file.clear();
+                    break;
+                }
+                const RunOccurrence run = decode_run_header(p, previous_id);
+                previous_id = run.file_id;
+                tf_by_file.emplace_back(run.file_id, run.position_count);
+                p += run.blob_len;
+            }
+            note_range(postings_off,
+                       static_cast<size_t>(
+                           p - reinterpret_cast<const uint8_t*>(base_)) -
+                           postings_off);
+            break;
+        }
+    }
+
+    const double avg_doc_length =
+        file_count_ == 0 ? 1.0
+                         : static_cast<double>(total_doc_tokens_) /
+                               static_cast<double>(file_count_);
+    return rank_postings(
+        tf_by_file, [this](size_t file_id) { return doc_length_of(file_id); },
+        file_count_, avg_doc_length, k);
+}
+
+/**
+ * @brief Phrase query: per-term lookups against the mapping, then the
+ * shared match pass over the decoded positions.
+ */
+std::vector<WordOccurrence> MappedIndex::search_phrase(
+    const std::vector<std::string>& terms) const {
+    if (terms.empty()) {
+        return {};
+    }
+    std::vector<size_t> term_offsets(terms.size(), 0);
+    std::vector<std::vector<WordOccurrence>> occurrences_by_term;
+    occurrences_by_term.reserve(terms.size());
+    for (size_t t = 0; t < terms.size(); ++t) {
+        if (t > 0) {
+            term_offsets[t] = term_offsets[t - 1] + terms[t - 1].size() + 1;
+        }
+        occurrences_by_term.push_back(search(terms[t]));
+    }
+    return match_phrase(occurrences_by_term, term_offsets);
+}
+
+std::vector<std::string> MappedIndex::search_prefix(
+    std::string_view prefix) const {
+    const size_t blob_off = read_u64(base_, offsetof(Header, blob_off));
+
+    // Lower bound over the sorted word table, then scan while the prefix
+    // holds - the dictionary's sort order doubles as the prefix structure.
+    size_t lo = 0;
+    size_t hi = word_count_;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const size_t entry_off = words_off_ + mid * sizeof(WordEntry);
+        if (probe_word(blob_off, entry_off) < prefix) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    std::vector<std::string> results;
+    for (size_t i = lo; i < word_count_; ++i) {
+        const std::string_view word =
+            probe_word(blob_off, words_off_ + i * sizeof(WordEntry));
+        if (!word.starts_with(prefix)) {
+            break;
+        }
+        results.emplace_back(word);
+    }
+    return results;
+}
+
+size_t MappedIndex::doc_length_of(size_t file_id) const {
+    // The file table is sorted by id.
+    size_t lo = 0;
+    size_t hi = file_count_;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const size_t entry_off = files_off_ + mid * sizeof(FileEntry);
+        note_range(entry_off, sizeof(FileEntry));
+        const uint64_t candidate = read_u64(base_, entry_off);
+        if (candidate < file_id) {
+            lo = mid + 1;
+        } else if (file_id < candidate) {
+            hi = mid;
+        } else {
+            return read_u64(base_, entry_off + offsetof(FileEntry, doc_length));
+        }
+    }
+    return 0;
+}
+
+std::string_view MappedIndex::file_path(size_t file_id) const {
+    const size_t blob_off = read_u64(base_, offsetof(Header, blob_off));
+
+    // The file table is sorted by id.
+    size_t lo = 0;
+    size_t hi = file_count_;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const size_t entry_off = files_off_ + mid * sizeof(FileEntry);
+        note_range(entry_off, sizeof(FileEntry));
+        const uint64_t candidate = read_u64(base_, entry_off);
+        if (candidate < file_id) {
+            lo = mid + 1;
+        } else if (file_id < candidate) {
+            hi = mid;
+        } else {
+            const uint64_t path_off = read_u64(base_, entry_off + 8);
+            const uint64_t path_len = read_u64(base_, entry_off + 16);
+            note_range(blob_off + path_off, path_len);
+            return std::string_view(base_ + blob_off + path_off, path_len);
+        }
+    }
+    return {};
+}
+
+FileManifest MappedIndex::manifest() const {
+    const size_t blob_off = read_u64(base_, offsetof(Header, blob_off));
+
+    FileManifest manifest;
+    manifest.reserve(file_count_);
+    for (size_t i = 0; i < file_count_; ++i) {
+        const size_t entry_off = files_off_ + i * sizeof(FileEntry);
+        const uint64_t file_id = read_u64(base_, entry_off);
+        const uint64_t path_off = read_u64(base_, entry_off + 8);
+        const uint64_t path_len = read_u64(base_, entry_off + 16);
+        const uint64_t size = read_u64(base_, entry_off + 24);
+        const int64_t mtime_ns = static_cast<int64_t>(read_u64(base_, entry_off + 32));
+        manifest.emplace(std::string(base_ + blob_off + path_off, path_len),
+                         ManifestEntry{file_id, size, mtime_ns});
+    }
+    return manifest;
+}
+
+void MappedIndex::visit_all(
+    const std::function<void(std::string_view,
+                             std::vector<PostingCodec::PackedOccurrence>&&)>&
+        visitor) const {
+    // The rebuild reads every posting byte anyway, so validate the whole
+    // section up front (one sequential block-sum pass, exactly what the
+    // old whole-section check cost). A corrupt section forces the
+    // caller's full re-index.
+    if (!postings_range_valid(postings_off_, postings_len_)) {
+        return;
+    }
+    const size_t blob_off = read_u64(base_, offsetof(Header, blob_off));
+
+    // One linear pass: word entries, postings, and blob are all read in
+    // roughly ascending offsets, which the kernel readahead loves. The
+    // position blobs are memcpy'd out verbatim, never decoded.
+    for (size_t i = 0; i < word_count_; ++i) {
+        const size_t entry_off = words_off_ + i * sizeof(WordEntry);
+        const std::string_view word = entry_word(base_, blob_off, entry_off);
+        const uint64_t postings_off = read_u64(base_, entry_off + 16);
+        const uint64_t occ_count = read_u64(base_, entry_off + 24);
+
+        std::vector<PostingCodec::PackedOccurrence> occurrences;
+        occurrences.reserve(occ_count);
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(base_) + postings_off;
+        uint64_t previous_id = 0;
+        for (uint64_t o = 0; o < occ_count; ++o) {
+            const RunOccurrence run = decode_run_header(p, previous_id);
+            previous_id = run.file_id;
+            PostingCodec::PackedOccurrence occ;
+            occ.file_id = run.file_id;
+            occ.position_count = run.position_count;
+            occ.last_position = run.last_position;
+            occ.packed_positions.assign(p, p + run.blob_len);
+            p += run.blob_len;
+            occurrences.push_back(std::move(occ));
+        }
+        visitor(word, std::move(occurrences));
+    }
+}
+
+} // namespace IndexSnapshot
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "FileInfo.hpp"
+#include "InvertedIndex.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Persistence for the inverted index: a flat binary snapshot that can
+ * be memory-mapped and searched immediately on the next startup, with no
+ * deserialization into hash maps.
+ *
+ * Layout (all integers little-endian uint64_t, every numeric section
+ * 8-byte aligned):
+ *
+ *   Header      - magic, version, counts, section offsets, per-section
+ *                 checksums.
+ *   WordEntry[] - sorted lexicographically by word bytes, so lookup is a
+ *                 binary search directly over the mapping.
+ *   Postings    - per word, a varint run: for each occurrence the file_id
+ *                 delta from the previous one, position_count,
+ *                 last_position, the packed-blob byte length, then the
+ *                 delta-varint position blob verbatim (padded to 8 bytes
+ *                 at the end of the section).
+ *   BlockSum[]  - one FNV-1a per 4 MiB postings block, so readers can
+ *                 validate blocks individually as queries touch them.
+ *   FileEntry[] - sorted by file_id: {file_id, path_off, path_len, size,
+ *                 mtime, doc_length}; doubles as the manifest for
+ *                 incremental scans and carries the BM25 length stats.
+ *   Blob        - raw word and path bytes (unaligned, referenced by offset).
+ */
+namespace IndexSnapshot {
+
+    /**
+     * @brief Serializes the index and the file-id-to-path table to 'path'.
+     * Writes to a temporary file and renames, so a crash never leaves a
+     * half-written snapshot behind.
+     *
+     * The expensive parts run in parallel: the sorted dictionary is split
+     * into one contiguous chunk per worker and each chunk's posting runs
+     * are encoded by a ThreadPool task into its own buffer, as is the
+     * postings section's block checksum. Every section's checksum lands
+     * in the header so the reader can validate what it maps.
+     *
+     * @param path Destination snapshot file.
+     * @param index The index to serialize (visited under shared locks).
+     * @param manifest Per-file path, ID, size, and mtime; persisted as the
+     *        file table so the next run can scan incrementally.
+     * @return True on success; failures are logged to stderr.
+     */
+    bool save(const std::string& path, const InvertedIndex& index,
+              const FileManifest& manifest);
+
+    /**
+     * @brief A read-only index view over a memory-mapped snapshot.
+     *
+     * open() validates the header plus the checksums of the small sections
+     * (word table, file table, blob) and maps the file; search()
+     * binary-searches the sorted word table in place - the kernel pages in
+     * only what the lookup touches, so cold start is milliseconds
+     * regardless of index size. The postings section - the multi-GB one -
+     * is validated one 4 MiB block at a time, as queries first touch each
+     * block, against checksums stored in the snapshot itself: corruption
+     * detection without ever streaming the section. Combined with the
+     * demand paging (the page cache is the block cache, evicted LRU under
+     * memory pressure) that lets one binary serve a small index entirely
+     * from RAM and an archive-tier index bigger than RAM from disk; when
+     * the mapping exceeds half of physical memory, open() additionally
+     * hints MADV_RANDOM over the postings so readahead cannot thrash the
+     * cache.
+     *
+     * Warm start: that same demand paging makes the first minute of a
+     * serving session slow - every cold query eats major faults on the
+     * dictionary and its posting runs. So the query paths count which
+     * 4 KiB pages of the mapping they touch, save_hot_pages() persists
+     * the touched set hottest-first in a sidecar beside the snapshot,
+     * and the next open() replays it as madvise(WILLNEED) hints from a
+     * background thread - queries serve immediately while the kernel
+     * fetches last session's working set behind them.
+     */
+    class MappedIndex {
+    public:
+        /**
+         * @brief Maps and validates a snapshot.
+         * @param path The snapshot file to open.
+         * @return The mapped index, or nullptr if the file is missing or
+         *         malformed (logged to stderr).
+         */
+        static std::unique_ptr<MappedIndex> open(const std::string& path);
+
+        ~MappedIndex();
+        MappedIndex(const MappedIndex&) = delete;
+        MappedIndex& operator=(const MappedIndex&) = delete;
+
+        /**
+         * @brief Searches for a word; same result contract as
+         * InvertedIndex::search.
+         */
+        std::vector<WordOccurrence> search(std::string_view word) const;
+
+        /**
+         * @brief Multi-term AND query; same contract as
+         * InvertedIndex::search_all. Snapshot posting lists are written
+         * sorted by file_id, so the galloping intersection applies as-is.
+         */
+        std::vector<size_t> search_all(const std::vector<std::string>& terms) const;
+
+        /**
+         * @brief Phrase query; same contract as
+         * InvertedIndex::search_phrase. Position blobs are decoded only
+         * for the phrase's terms.
+         */
+        std::vector<WordOccurrence> search_phrase(
+            const std::vector<std::string>& terms) const;
+
+        /**
+         * @brief Ranked single-term query; same contract as
+         * InvertedIndex::search_ranked. Term frequencies come from the run
+         * headers and document lengths from the file table, so no position
+         * blob is decoded.
+         */
+        std::vector<ScoredFile> search_ranked(std::string_view term,
+                                              size_t k) const;
+
+        /**
+         * @brief Prefix query; same contract as
+         * InvertedIndex::search_prefix. The snapshot's word table is
+         * already sorted, so this is a binary search plus range scan
+         * directly over the mapping.
+         */
+        std::vector<std::string> search_prefix(std::string_view prefix) const;
+
+        /**
+         * @brief Looks up the path of a file ID from the snapshot's file
+         * table; empty view if unknown. The view aliases the mapping.
+         */
+        std::string_view file_path(size_t file_id) const;
+
+        /**
+         * @brief Reconstructs the manifest (path -> id/size/mtime) from the
+         * snapshot's file table, for comparison against a fresh scan.
+         */
+        FileManifest manifest() const;
+
+        /**
+         * @brief Walks every word's postings sequentially, for rebuilding
+         * an in-memory index during incremental re-indexing. Far cheaper
+         * than re-tokenizing the corpus: one linear pass over the mapping,
+         * and the compressed position blobs are copied verbatim - never
+         * decoded.
+         *
+         * @param visitor Invoked once per word; the view aliases the
+         *        mapping, the occurrence vector is the visitor's to keep.
+         */
+        void visit_all(
+            const std::function<void(std::string_view,
+                                     std::vector<PostingCodec::PackedOccurrence>&&)>&
+                visitor) const;
+
+        /**
+         * @brief Writes the hot-page sidecar (snapshot path + ".hot"):
+         * the mapping pages this session's queries touched, hottest
+         * first, fingerprinted against the snapshot so a rewrite
+         * invalidates it. Meant for a clean exit of a session that
+         * served from the mapping; a no-op if no query touched a page
+         * (the previous sidecar, if any, stays valid).
+         * @return True on success or nothing-to-record; failures are
+         *         logged to stderr (the sidecar is advisory, so the
+         *         caller need not care).
+         */
+        bool save_hot_pages() const;
+
+        /** @brief Number of unique words in the snapshot. */
+        size_t word_count() const { return word_count_; }
+
+        /** @brief Number of files in the snapshot's file table. */
+        size_t file_count() const { return file_count_; }
+
+    private:
+        MappedIndex() = default;
+
+        const char* base_ = nullptr;   ///< Start of the mapping.
+        size_t length_ = 0;            ///< Mapped byte count.
+        size_t word_count_ = 0;
+        size_t file_count_ = 0;
+        size_t words_off_ = 0;         ///< WordEntry array offset.
+        size_t files_off_ = 0;         ///< FileEntry array offset.
+        uint64_t total_doc_tokens_ = 0; ///< Corpus token count, for BM25 avgdl.
+
+        size_t postings_off_ = 0;      ///< Posting-run section offset.
+        size_t postings_len_ = 0;      ///< Posting-run section bytes.
+        uint64_t postings_sum_ = 0;    ///< FNV over the stored block sums.
+        size_t block_sums_off_ = 0;    ///< Stored per-block checksum array.
+        size_t postings_blocks_ = 0;   ///< 4 MiB checksum blocks in the section.
+        /// Lazy per-block validation: bit b set once block b has been
+        /// checked against its stored sum. Bounded work per query, never
+        /// a whole-section pass - the property that lets an index larger
+        /// than RAM serve from disk.
+        mutable std::unique_ptr<std::atomic<uint64_t>[]> blocks_checked_;
+        mutable std::atomic<bool> postings_corrupt_{false};
+
+        /// Warm-start state: one saturating counter per 4 KiB page of the
+        /// mapping, bumped by the query paths. Relaxed and lossy under
+        /// races - the counts only order the prefetch hints.
+        static constexpr size_t kPageBytes = 4096;
+        size_t page_count_ = 0;
+        mutable std::unique_ptr<std::atomic<uint16_t>[]> page_hits_;
+        std::string path_;            ///< Snapshot path; the sidecar lives beside it.
+        std::thread prefetch_thread_; ///< Issues the WILLNEED hints; joined in ~.
+
+        /** @brief Counts the mapping pages covering [offset, offset+len)
+         *  as touched by a query. */
+        void note_range(size_t offset, size_t len) const {
+            if (page_hits_ == nullptr || len == 0) {
+                return;
+            }
+            size_t last = (offset + len - 1) / kPageBytes;
+            if (last >= page_count_) {
+                last = page_count_ - 1;
+            }
+            for (size_t page = offset / kPageBytes; page <= last; ++page) {
+                if (page_hits_[page].load(std::memory_order_relaxed) !=
+                    UINT16_MAX) {
+                    page_hits_[page].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /** @brief One binary-search probe: the word a WordEntry points at,
+         *  with the entry and word pages counted as touched. */
+        std::string_view probe_word(size_t blob_off, size_t entry_off) const;
+
+        /** @brief Reads the sidecar, validates its fingerprint, and starts
+         *  the background WILLNEED pass over its hot ranges. */
+        void start_prefetch();
+
+        /** @brief Validates the 4 MiB postings blocks covering
+         *  [offset, offset+len) on their first touch; false (and one
+         *  stderr line, with queries disabled) on a mismatch. */
+        bool postings_range_valid(size_t offset, size_t len) const;
+
+        /** @brief A file's indexed token count from the file table; 0 if unknown. */
+        size_t doc_length_of(size_t file_id) const;
+    };
+
+} // namespace IndexSnapshot
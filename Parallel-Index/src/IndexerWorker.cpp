@@ -1,59 +1,191 @@
 #include "IndexerWorker.hpp"
+#include <scheduler/profile.hpp> // PROFILE_SCOPE (Task-Scheduler)
+#include <algorithm> // For std::min (binary sniff window)
+#include <cstring>   // For memchr (binary sniff)
 #include <string>
-#include <sstream> // For std::stringstream
+#include <string_view>
 #include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h> // For munmap
+#endif
+
+namespace {
+    /**
+     * @brief How many payloads a worker claims per queue wakeup. Small
+     * enough to keep work spread across workers, large enough to amortize
+     * the queue mutex over several files.
+     */
+    constexpr size_t kPopBatch = 8;
+
+    /**
+     * @brief How far into a payload the binary sniff looks. A NUL byte in
+     * the first window marks the payload as binary (text encodings this
+     * project indexes never contain one); misnamed binaries then skip
+     * tokenization instead of flooding the dictionary with garbage terms.
+     */
+    constexpr size_t kSniffBytes = 512;
+
+    /** @brief True if the payload looks binary; see kSniffBytes. */
+    bool looks_binary(std::string_view content) {
+        const size_t window = std::min(content.size(), kSniffBytes);
+        return memchr(content.data(), '\0', window) != nullptr;
+    }
+}
 
 /**
  * @brief Constructs an IndexerWorker.
- * @param file_queue A reference to the ConcurrentQueue from which to pull files.
+ * @param content_queue The queue of loaded payloads from the readers.
  * @param index A reference to the InvertedIndex to update.
+ * @param buffer_pool The shared pool read buffers are returned to.
  */
-IndexerWorker::IndexerWorker(ConcurrentQueue<FileInfo>& file_queue, InvertedIndex& index)
-    : file_queue_(file_queue), index_(index) {}
+IndexerWorker::IndexerWorker(ConcurrentQueue<FileContent>& content_queue,
+                             InvertedIndex& index, BufferPool& buffer_pool,
+                             WorkerCounters& counters)
+    : content_queue_(content_queue), index_(index), buffer_pool_(buffer_pool),
+      counters_(counters) {}
 
 
 /**
  * @brief The main execution logic for the worker thread.
  * This method should be called by std::thread.
- * It continuously processes files until the queue is closed and empty.
+ * It continuously processes payloads until the queue is closed and empty.
  */
-void IndexerWorker::operator()() {
-    FileInfo file_info;
+void IndexerWorker::operator()(std::stop_token stop) {
+    std::vector<FileContent> batch;
     std::cout << "[Worker " << std::this_thread::get_id() << "] Starting..." << std::endl;
-    while (file_queue_.wait_and_pop(file_info)) { // Blocking pop until item or queue closed+empty
-        // std::cout << "[Worker " << std::this_thread::get_id() << "] Processing file: " << file_info.path << " (ID: " << file_info.id << ")" << std::endl;
-        process_file(file_info);
+    // Blocking bulk pop: each wakeup drains up to kPopBatch payloads under
+    // one queue lock instead of re-acquiring it per file.
+    while (true) {
+        bool popped;
+        {
+            // An empty content queue means the readers are behind; count
+            // the starvation as queue wait.
+            ScopedWaitTimer timer(counters_.queue_wait_ns);
+            popped = content_queue_.wait_and_pop_bulk(batch, kPopBatch, stop);
+        }
+        if (!popped) {
+            break;
+        }
+        for (FileContent& content : batch) {
+            process_content(std::move(content));
+        }
+    }
+    if (stop.stop_requested()) {
+        std::cout << "[Worker " << std::this_thread::get_id()
+                  << "] Stopping; leaving queued payloads unindexed." << std::endl;
+    } else {
+        std::cout << "[Worker " << std::this_thread::get_id() << "] Exiting. Queue closed and empty." << std::endl;
     }
-    std::cout << "[Worker " << std::this_thread::get_id() << "] Exiting. Queue closed and empty." << std::endl;
 }
 
 
 /**
- * @brief Processes a single file: reads, tokenizes, and indexes its content.
- * @param file_info The FileInfo object containing path and ID.
+ * @brief Tokenizes and indexes one loaded payload, then releases its bytes.
+ *
+ * The reader stage already did all the I/O: the payload is either a pooled
+ * buffer or an mmap'd region. Afterwards the buffer is recycled into the
+ * pool (keeping its capacity warm) or the mapping is unmapped.
+ *
+ * @param content The loaded file payload; consumed.
  */
-void IndexerWorker::process_file(const FileInfo& file_info) {
-    std::ifstream file(file_info.path);
-    if (!file.is_open()) {
-        std::cerr << "[Worker Error] Could not open file: " << file_info.path << std::endl;
+void IndexerWorker::process_content(FileContent&& content) {
+    PROFILE_SCOPE("IndexerWorker::process_content");
+    counters_.files.fetch_add(1, std::memory_order_relaxed);
+    counters_.bytes.fetch_add(content.view().size(), std::memory_order_relaxed);
+
+    // Content sniff: an extension can lie (a .log that is really a core
+    // dump). Binary payloads are dropped here, before any tokenization.
+    if (looks_binary(content.view())) {
+        std::cerr << "[Worker] Skipping binary content in "
+                  << content.info.path << std::endl;
+    } else {
+        // One streaming case-fold pass over the whole payload up front, so
+        // the tokenizer's no-allocation fast path (all [a-z0-9]) also hits
+        // for words that were merely uppercase. Mapped payloads are private
+        // copy-on-write, so the write never reaches the file. Source files
+        // skip the prefold: their tokenizer splits identifiers at camelCase
+        // boundaries, which a bulk fold would erase.
+        if (content.info.extraction != Extraction::kSource) {
+            Utils::to_lower_in_place(content.mutable_data(),
+                                     content.view().size());
+        }
+
+        index_content(content.info, content.view());
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    if (content.mapped != nullptr) {
+        ::munmap(content.mapped, content.mapped_length);
+        content.mapped = nullptr;
         return;
     }
+#endif
+    buffer_pool_.release(std::move(content.buffer));
+}
+
+
+/**
+ * @brief Tokenizes and indexes file content, line by line.
+ *
+ * The content is viewed in place (for the mmap path it lives in the page
+ * cache and is never copied); only the line handed to the tokenizer is
+ * materialized.
+ *
+ * @param file_info The FileInfo object containing path and ID.
+ * @param content The complete file content.
+ */
+void IndexerWorker::index_content(const FileInfo& file_info, std::string_view content) {
+    // Positions start at the slice's offset within the file, so chunks of a
+    // split file index with the same positions a whole-file pass would give.
+    size_t position_offset = file_info.offset;
+    while (!content.empty()) {
+        const size_t newline = content.find('\n');
+        const std::string_view line = content.substr(0, newline);
 
-    std::string line;
-    size_t position_offset = 0; // Keep track of byte offset
-    while (std::getline(file, line)) {
-        std::vector<std::string> tokens = Utils::tokenize(line);
+        // Zero-copy tokens: views into the (possibly mmap'd) buffer, or
+        // into the arena for the few words that needed cleaning. The
+        // vector and arena are worker members, so the per-line loop
+        // allocates nothing once their capacity has warmed up. Text runs
+        // the prefolded policy (the bulk case fold already handled A-Z);
+        // source runs the identifier splitter on the unfolded bytes.
+        if (file_info.extraction == Extraction::kSource) {
+            Utils::tokenize<Utils::kSourceTokens>(line, token_arena_, tokens_);
+        } else {
+            Utils::tokenize<Utils::kPrefoldedTokens>(line, token_arena_,
+                                                     tokens_);
+        }
+        counters_.tokens.fetch_add(tokens_.size(), std::memory_order_relaxed);
         size_t current_word_pos = 0; // Keep track of word index within the line
-        for (const std::string& token : tokens) {
+        for (const Utils::HashedToken& token : tokens_) {
             // Note: This position calculation is simplified. For true byte offset,
             // you'd need to consider character encodings and multi-byte characters.
             // For simplicity, we'll just use a running counter for rough position.
-            // Or, ideally, you could read char by char, or store byte offset from file.
-            // For now, let's just add the word's position in the line as a basic example.
-            index_.add_word_occurrence(token, file_info.id, position_offset + current_word_pos);
-            current_word_pos += token.length() + 1; // +1 for assumed space/delimiter
+            local_.add(token.text, token.hash,
+                       position_offset + current_word_pos);
+            current_word_pos += token.text.length() + 1; // +1 for assumed space/delimiter
         }
+
         position_offset += line.length() + 1; // +1 for newline character
+        if (newline == std::string_view::npos) {
+            break;
+        }
+        content.remove_prefix(newline + 1);
     }
-    file.close();
-}
\ No newline at end of file
+
+    // One bulk merge per file: shard locks are taken once each and each
+    // word's positions are compressed straight out of the local buffer.
+    // Must happen while the file buffer (and token arena) backing the
+    // token views is still alive. The merge is where this thread contends
+    // with the others on the shard locks, so its wall time is tracked
+    // separately from tokenization.
+    {
+        ScopedWaitTimer timer(counters_.index_wait_ns);
+        index_.merge(file_info.id, std::move(local_));
+    }
+
+    // One rewind per file retires every cleaned token and position
+    // vector; the slabs stay for the next file.
+    token_arena_.clear();
+}
@@ -1,27 +1,35 @@
 #pragma once
 
 #include "ConcurrentQueue.hpp"
+#include "FileContent.hpp"
+#include "IndexingStats.hpp"
 #include "InvertedIndex.hpp"
 #include "FileInfo.hpp"
 #include "Utils.hpp"
-#include <fstream>    // For std::ifstream
 #include <iostream>   // For std::cerr
+#include <stop_token>
+#include <string_view>
 
 /**
- * @brief A worker thread that processes files from a ConcurrentQueue and updates an InvertedIndex.
+ * @brief The tokenize/index stage of the indexing pipeline.
  *
  * This class is designed to be run as a separate thread. It continuously
- * pulls FileInfo objects from the queue, reads the file content, tokenizes it,
- * and adds word occurrences to the shared InvertedIndex.
+ * pulls loaded FileContent payloads from the reader stage, tokenizes the
+ * bytes in place, and adds word occurrences to the shared InvertedIndex.
+ * It never touches the disk itself - the reader threads own all I/O - so
+ * it stays purely CPU-bound.
  */
 class IndexerWorker {
 public:
     /**
      * @brief Constructs an IndexerWorker.
-     * @param file_queue A reference to the ConcurrentQueue from which to pull files.
+     * @param content_queue The queue of loaded payloads from the readers.
      * @param index A reference to the InvertedIndex to update.
+     * @param buffer_pool The shared pool read buffers are returned to.
+     * @param counters This thread's throughput counter slot.
      */
-    IndexerWorker(ConcurrentQueue<FileInfo>& file_queue, InvertedIndex& index);
+    IndexerWorker(ConcurrentQueue<FileContent>& content_queue, InvertedIndex& index,
+                  BufferPool& buffer_pool, WorkerCounters& counters);
 
     // No copying or moving
     IndexerWorker(const IndexerWorker&) = delete;
@@ -32,17 +40,44 @@ public:
     /**
      * @brief The main execution logic for the worker thread.
      * This method should be called by std::jthread or std::thread.
-     * It continuously processes files until the queue is closed and empty.
+     * It continuously processes payloads until the queue is closed and empty.
+     * @param stop Optional cancellation token: once signalled the worker
+     *        finishes the batch in hand and exits without taking more
+     *        payloads. Leftover queue entries are the caller's to sweep
+     *        (and to release - they hold buffers and mappings).
      */
-    void operator()(); // Overload operator() to make it callable by a thread
+    void operator()(std::stop_token stop = {}); // Callable by a thread
 
 private:
-    ConcurrentQueue<FileInfo>& file_queue_; ///< Reference to the queue of files to process.
-    InvertedIndex& index_;                  ///< Reference to the shared inverted index.
+    ConcurrentQueue<FileContent>& content_queue_; ///< Loaded payloads to index.
+    InvertedIndex& index_;                        ///< Reference to the shared inverted index.
+    BufferPool& buffer_pool_;                     ///< Recycled read buffers.
+    WorkerCounters& counters_;                    ///< This thread's stats slot.
 
     /**
-     * @brief Processes a single file: reads, tokenizes, and indexes its content.
+     * @brief Tokenizes and indexes one loaded payload, then releases its
+     * bytes (buffer back to the pool, mapping unmapped).
+     * @param content The loaded file payload; consumed.
+     */
+    void process_content(FileContent&& content);
+
+    /**
+     * @brief Tokenizes and indexes already-loaded (or mapped) file content.
      * @param file_info The FileInfo object containing path and ID.
+     * @param content The complete file content, viewed in place.
      */
-    void process_file(const FileInfo& file_info);
-};
\ No newline at end of file
+    void index_content(const FileInfo& file_info, std::string_view content);
+
+    // Per-file scratch, reused across every file this worker indexes: the
+    // token arena's slabs, the token vector's capacity and the local
+    // buffer's table and position slabs all persist, so in steady state a
+    // file is tokenized and buffered without a single heap allocation.
+    // Each is reset once per file, not freed per token.
+    Utils::TokenArena token_arena_;        ///< Bytes of cleaned tokens.
+    /// One line's tokens, each paired with the hash the tokenizer computed
+    /// while scanning it (reused by the local buffer and the shard-routed
+    /// merge). 32 inline slots cover typical lines, so the buffer is
+    /// allocation-free from the first line, not just once warm.
+    cds::small_vector<Utils::HashedToken, 32> tokens_;
+    LocalIndex local_;                     ///< One file's postings.
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "../../Concurrent-Data-Structures/sync/padded.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief One pipeline thread's counters, updated with relaxed atomics and
+ * only ever read approximately (progress lines, final breakdown).
+ *
+ * Padded to a cache line so neighbouring workers' counters never
+ * false-share: each thread increments only its own slot, and the hot
+ * indexing loops must not stall on each other's counter traffic.
+ */
+struct alignas(cds::kCacheLineSize) WorkerCounters {
+    std::atomic<uint64_t> files{0};         ///< Payloads processed.
+    std::atomic<uint64_t> bytes{0};         ///< Payload bytes processed.
+    std::atomic<uint64_t> tokens{0};        ///< Tokens produced (indexers only).
+    std::atomic<uint64_t> queue_wait_ns{0}; ///< Time blocked on queue pops/pushes.
+    std::atomic<uint64_t> index_wait_ns{0}; ///< Time inside index merges (indexers only).
+};
+
+/**
+ * @brief Accumulates 'ns' of wall time into a counter on destruction.
+ * Wrap a blocking call in one of these to attribute its wait to a stage.
+ */
+class ScopedWaitTimer {
+public:
+    explicit ScopedWaitTimer(std::atomic<uint64_t>& sink)
+        : sink_(sink), start_(std::chrono::steady_clock::now()) {}
+
+    ScopedWaitTimer(const ScopedWaitTimer&) = delete;
+    ScopedWaitTimer& operator=(const ScopedWaitTimer&) = delete;
+
+    ~ScopedWaitTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        sink_.fetch_add(static_cast<uint64_t>(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                elapsed).count()),
+                        std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t>& sink_;
+    const std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Trivially copyable aggregate of the pipeline counters, published
+ * through a cds::seqlock by the progress monitor once per tick (and once
+ * more, final, when the build ends).
+ *
+ * The stats export reads this instead of summing the per-worker slots
+ * itself: one consistent word-wise copy per dump, never a walk over the
+ * counter lines while the workers hammer them. At most one tick stale -
+ * the same trade the scheduler's PublishedStats makes.
+ */
+struct PublishedBuildStats {
+    uint64_t reader_files = 0;
+    uint64_t reader_bytes = 0;
+    uint64_t reader_queue_wait_ns = 0;
+    uint64_t indexer_files = 0;
+    uint64_t indexer_tokens = 0;
+    uint64_t indexer_queue_wait_ns = 0;
+    uint64_t indexer_merge_ns = 0;
+    uint64_t elapsed_ms = 0;
+    uint64_t build_done = 0; ///< 1 once the pipeline has fully drained.
+};
+
+/**
+ * @brief Per-worker throughput counters for the indexing pipeline.
+ *
+ * Holds one padded counter slot per reader and per indexer thread, handed
+ * out by reference at spawn time. Whoever wants a picture of the run -
+ * the periodic progress line, the final per-stage breakdown - sums the
+ * slots; the workers themselves never synchronize on anything shared.
+ * Slot references stay valid for the lifetime of this object (the vectors
+ * are sized once and never grown).
+ */
+class IndexingStats {
+public:
+    /** @brief Aggregated view of one stage's slots. */
+    struct Totals {
+        uint64_t files = 0;
+        uint64_t bytes = 0;
+        uint64_t tokens = 0;
+        uint64_t queue_wait_ns = 0;
+        uint64_t index_wait_ns = 0;
+    };
+
+    IndexingStats(size_t reader_count, size_t indexer_count)
+        : reader_counters_(reader_count), indexer_counters_(indexer_count) {}
+
+    // Workers hold references into the slot vectors; no copying or moving.
+    IndexingStats(const IndexingStats&) = delete;
+    IndexingStats& operator=(const IndexingStats&) = delete;
+
+    /** @brief The i-th reader thread's counter slot. */
+    WorkerCounters& reader(size_t i) { return reader_counters_[i]; }
+
+    /** @brief The i-th indexer thread's counter slot. */
+    WorkerCounters& indexer(size_t i) { return indexer_counters_[i]; }
+
+    /** @brief Sums the reader slots (approximate while threads run). */
+    Totals reader_totals() const { return sum(reader_counters_); }
+
+    /** @brief Sums the indexer slots (approximate while threads run). */
+    Totals indexer_totals() const { return sum(indexer_counters_); }
+
+private:
+    static Totals sum(const std::vector<WorkerCounters>& counters) {
+        Totals totals;
+        for (const WorkerCounters& c : counters) {
+            totals.files += c.files.load(std::memory_order_relaxed);
+            totals.bytes += c.bytes.load(std::memory_order_relaxed);
+            totals.tokens += c.tokens.load(std::memory_order_relaxed);
+            totals.queue_wait_ns += c.queue_wait_ns.load(std::memory_order_relaxed);
+            totals.index_wait_ns += c.index_wait_ns.load(std::memory_order_relaxed);
+        }
+        return totals;
+    }
+
+    std::vector<WorkerCounters> reader_counters_;
+    std::vector<WorkerCounters> indexer_counters_;
+};
@@ -1,6 +1,126 @@
 #include "InvertedIndex.hpp"
-#include <algorithm> // For std::find_if
+#include <scheduler/profile.hpp>     // PROFILE_SCOPE (Task-Scheduler)
+#include <scheduler/thread_pool.hpp> // Parallel term lookups (Task-Scheduler)
+#include <algorithm> // For std::lower_bound, std::merge, std::sort
+#include <iostream>  // For spill-failure diagnostics
+#include <iterator>  // For std::back_inserter
+#include <cmath>     // For std::log (BM25 IDF)
+#include <bit>       // For std::countr_zero (bitmap-AND expansion)
+#include <cstdint>   // For SIZE_MAX (planner's spilled-term sentinel)
+#include <latch>     // For joining the parallel term lookups
 #include <mutex>
+#include <queue>     // For the bounded top-k min-heap
+#include <thread>    // For hardware_concurrency (query pool sizing)
+
+#include <fcntl.h>   // For open (spill file)
+#include <unistd.h>  // For pread/pwrite/ftruncate/close/unlink
+
+namespace {
+
+    // Standard BM25 constants: k1 saturates term frequency, b controls how
+    // strongly long documents are penalized.
+    constexpr double kBm25K1 = 1.2;
+    constexpr double kBm25B = 0.75;
+
+    // Cost model for search_all: below this many terms a query stays on
+    // the calling thread - per-term shard lookups are microseconds, so
+    // the pool handoff and wakeup only pay off once several of them can
+    // overlap (the dashboards' 20-term queries, not interactive 2-term
+    // ANDs).
+    constexpr size_t kParallelQueryTerms = 4;
+
+    // Query-planner regime boundaries for search_all. A term rarer than
+    // kRareTermDf drives the probe strategy: its handful of candidates
+    // are checked against the other terms' dictionary slots directly,
+    // and nothing else is copied or scanned. kBitmapMinDf gates the
+    // counting-scan strategy for the opposite regime, where even the
+    // rarest term is common and per-candidate probing degenerates into
+    // touching most of every list anyway.
+    constexpr size_t kRareTermDf = 64;
+    constexpr size_t kBitmapMinDf = 2048;
+
+    /**
+     * @brief Folds another packed run for the same file into an existing
+     * one. Happens only when a large file was split into chunks and more
+     * than one chunk contains the word. Chunks finish in arbitrary order,
+     * so the existing run may hold any subset of the file's chunks; both
+     * runs are sorted, so a standard merge restores the full ascending
+     * position list. Chunk merges are rare enough that the unpack/repack
+     * round trip does not matter.
+     */
+    void merge_packed_runs(PostingCodec::PackedOccurrence& existing,
+                           const PostingCodec::PackedOccurrence& incoming) {
+        const std::vector<size_t> a = PostingCodec::unpack_positions(existing);
+        const std::vector<size_t> b = PostingCodec::unpack_positions(incoming);
+        std::vector<size_t> merged;
+        merged.reserve(a.size() + b.size());
+        std::merge(a.begin(), a.end(), b.begin(), b.end(),
+                   std::back_inserter(merged));
+        existing = PostingCodec::pack_positions(existing.file_id, merged);
+    }
+
+    /**
+     * @brief Records a freshly interned word in a shard's sorted
+     * dictionary. Called under the shard's exclusive lock; the view must
+     * be arena-backed (stable).
+     */
+    void register_sorted_word(std::vector<std::string_view>& dict,
+                              std::string_view word) {
+        dict.insert(std::lower_bound(dict.begin(), dict.end(), word), word);
+    }
+
+    /** @brief Applies a signed accounting delta to a shard's byte counter. */
+    void adjust_bytes(std::atomic<size_t>& bytes, int64_t delta) {
+        if (delta >= 0) {
+            bytes.fetch_add(static_cast<size_t>(delta), std::memory_order_relaxed);
+        } else {
+            bytes.fetch_sub(static_cast<size_t>(-delta), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Serializes one word's occurrence list for the spill file,
+     * mirroring the snapshot's Postings run layout: count, then per
+     * occurrence the file_id delta, position_count, last_position, blob
+     * length, and the delta-varint position blob verbatim.
+     */
+    std::vector<uint8_t> encode_run(const PostingList& list) {
+        std::vector<uint8_t> out;
+        PostingCodec::encode_varint(out, list.size());
+        size_t previous = 0;
+        for (size_t i = 0; i < list.size(); ++i) {
+            const PostingList::View occ = list.at(i);
+            PostingCodec::encode_varint(out, occ.file_id - previous);
+            previous = occ.file_id;
+            PostingCodec::encode_varint(out, occ.position_count);
+            PostingCodec::encode_varint(out, occ.last_position);
+            PostingCodec::encode_varint(out, occ.blob_size);
+            out.insert(out.end(), occ.blob, occ.blob + occ.blob_size);
+        }
+        return out;
+    }
+
+    /** @brief Decodes an encode_run() buffer back into an occurrence list. */
+    std::vector<PostingCodec::PackedOccurrence> decode_run(const uint8_t* p) {
+        std::vector<PostingCodec::PackedOccurrence> list;
+        const size_t count = PostingCodec::decode_varint(p);
+        list.reserve(count);
+        size_t previous = 0;
+        for (size_t i = 0; i < count; ++i) {
+            PostingCodec::PackedOccurrence occ;
+            occ.file_id = previous + PostingCodec::decode_varint(p);
+            previous = occ.file_id;
+            occ.position_count = PostingCodec::decode_varint(p);
+            occ.last_position = PostingCodec::decode_varint(p);
+            const size_t blob_size = PostingCodec::decode_varint(p);
+            occ.packed_positions.assign(p, p + blob_size);
+            p += blob_size;
+            list.push_back(std::move(occ));
+        }
+        return list;
+    }
+
+} // anonymous namespace
 
 /**
  * @brief Adds a word occurrence to the index.
@@ -12,43 +132,152 @@
  * @param position The byte offset of the word within the file.
  */
 void InvertedIndex::add_word_occurrence(const std::string& word, size_t file_id, size_t position) {
-    // Use std::unique_lock for exclusive access during write operations
-    std::unique_lock<std::shared_mutex> lock(mutex_);
+    add_word_occurrence(std::string_view(word), file_id, position);
+}
+
+/**
+ * @brief Adds a word occurrence keyed by a string_view.
+ * Heterogeneous lookup probes the map with the view directly; an owned
+ * std::string key is only created on first insertion of the word.
+ *
+ * Positions for a given (word, file) must arrive in ascending order (the
+ * indexing pipeline scans files front to back, which guarantees this);
+ * each one appends a single varint delta to the compressed blob.
+ *
+ * @param word The word to add; need not outlive the call.
+ * @param file_id The ID of the file where the word occurs.
+ * @param position The byte offset of the word within the file.
+ */
+void InvertedIndex::add_word_occurrence(std::string_view word, size_t file_id, size_t position) {
+    // One hash serves shard routing, the unspill probe, and the
+    // dictionary lookup below.
+    const size_t hash = StringHash{}(word);
+    const size_t shard_index = hash & (kNumShards - 1);
+    Shard& shard = shards_[shard_index];
 
-    // Find the entry for the given word
-    auto& occurrences_for_word = index_[word]; // operator[] handles insertion if word not present
+    // Exclusive lock, but only on the shard that owns this word - writers
+    // for other shards proceed concurrently.
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
 
-    // Check if an occurrence for this file_id already exists
-    auto it = std::find_if(occurrences_for_word.begin(), occurrences_for_word.end(),
-                           [file_id](const WordOccurrence& occ) {
-                               return occ.file_id == file_id;
-                           });
+    // A spilled word must come back in before it can grow.
+    unspill_if_needed(shard, word, hash);
 
-    if (it != occurrences_for_word.end()) {
-        // If file_id found, add position to existing occurrence
-        it->positions.push_back(position);
+    int64_t grown = 0;
+
+    // Find the entry for the given word; first sighting interns the bytes.
+    auto map_it = shard.words.find(word, hash);
+    if (map_it == shard.words.end()) {
+        const size_t arena_before = shard.arena.allocated_bytes();
+        const size_t dict_before = shard.sorted_words.capacity();
+        const size_t map_before = shard.words.allocated_bytes();
+        map_it = shard.words.emplace(shard.arena.intern(word), hash,
+                                     PostingList()).first;
+        register_sorted_word(shard.sorted_words, map_it->first);
+        unique_words_.increment();
+        grown += static_cast<int64_t>(
+            (shard.words.allocated_bytes() - map_before) +
+            (shard.arena.allocated_bytes() - arena_before) +
+            (shard.sorted_words.capacity() - dict_before) *
+                sizeof(std::string_view));
+    }
+    PostingList& list = map_it->second;
+    const size_t list_before = list.allocated_bytes();
+
+    const size_t slot = list.slot_for(file_id);
+    if (list.file_at(slot, file_id)) {
+        // If file_id found, append the position to its blob
+        list.append_position(slot, position);
     } else {
-        // If file_id not found, create a new WordOccurrence entry
-        occurrences_for_word.push_back({file_id, {position}});
+        // If file_id not found, create a new compressed entry in order
+        list.insert(slot, PostingCodec::pack_positions(file_id, {position}));
     }
+    grown += static_cast<int64_t>(list.allocated_bytes()) -
+             static_cast<int64_t>(list_before);
+    adjust_bytes(shard.bytes, grown);
+    lock.unlock();
+
+    // The shard's posting lists changed; cached results for its words are
+    // stale. Other shards' caches stay warm.
+    query_caches_[shard_index].invalidate();
+
+    add_document_tokens(file_id, 1);
+    maybe_spill();
 }
 
 /**
  * @brief Searches for a word in the index.
- * This operation is thread-safe (shared lock for reads).
+ * This operation is thread-safe (shared lock for reads). The word's
+ * compressed blobs are decoded here - and only here.
+ *
+ * Hot queries never reach the shard lock: the owning shard's LRU cache is
+ * probed first, and a hit (including a cached empty result) is copied
+ * straight out of it. Misses decode the postings as before and prime the
+ * cache on the way out.
  *
  * @param word The word to search for.
  * @return A vector of WordOccurrence structures indicating where the word was found.
  */
-std::vector<WordOccurrence> InvertedIndex::search(const std::string& word) const {
-    // Use std::shared_lock for shared access during read operations
-    std::shared_lock<std::shared_mutex> lock(mutex_);
+std::vector<WordOccurrence> InvertedIndex::search(std::string_view word) const {
+    PROFILE_SCOPE("InvertedIndex::search");
+    const size_t shard_index = StringHash{}(word) & (kNumShards - 1);
+
+    std::vector<WordOccurrence> results;
+    if (query_caches_[shard_index].lookup(word, results)) {
+        return results;
+    }
+
+    const Shard& shard = shards_[shard_index];
+    {
+        // Use std::shared_lock for shared access during read operations;
+        // only the owning shard is touched.
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
 
-    auto it = index_.find(word);
-    if (it != index_.end()) {
-        return it->second; // Return the vector of occurrences
+        auto it = shard.words.find(word);
+        if (it != shard.words.end()) {
+            const PostingList& list = it->second;
+            results.reserve(list.size());
+            for (size_t i = 0; i < list.size(); ++i) {
+                const PostingList::View occ = list.at(i);
+                results.push_back(
+                    {occ.file_id,
+                     PostingCodec::unpack_positions(occ.blob,
+                                                    occ.position_count)});
+            }
+        } else if (auto spilled_it = shard.spilled.find(word);
+                   spilled_it != shard.spilled.end()) {
+            // Budget-evicted list: one pread brings it back for this query
+            // (it stays on disk; the result is cached like any other).
+            const auto list = load_spilled(spilled_it->second);
+            results.reserve(list.size());
+            for (const PostingCodec::PackedOccurrence& occ : list) {
+                results.push_back({occ.file_id, PostingCodec::unpack_positions(occ)});
+            }
+        }
     }
-    return {}; // Return an empty vector if word not found
+
+    query_caches_[shard_index].insert(word, results);
+    return results;
+}
+
+InvertedIndex::ResultView InvertedIndex::search_view(std::string_view word) const {
+    PROFILE_SCOPE("InvertedIndex::search_view");
+    const Shard& shard = shard_for(word);
+
+    ResultView view;
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    if (auto it = shard.words.find(word); it != shard.words.end()) {
+        // The lock rides inside the view: the postings stay valid and
+        // unmodified until the caller drops it.
+        view.list_ = &it->second;
+        view.lock_ = std::move(lock);
+    } else if (auto spilled_it = shard.spilled.find(word);
+               spilled_it != shard.spilled.end()) {
+        // Budget-evicted list: the one pread is unavoidable, but the view
+        // owns the loaded postings and still decodes positions lazily.
+        view.owned_ = load_spilled(spilled_it->second);
+    }
+    return view;
 }
 
 /**
@@ -56,17 +285,1048 @@ std::vector<WordOccurrence> InvertedIndex::search(const std::string& word) const
  * This operation is thread-safe (exclusive lock).
  */
 void InvertedIndex::clear() {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    index_.clear();
+    for (size_t s = 0; s < kNumShards; ++s) {
+        std::unique_lock<std::shared_mutex> lock(shards_[s].mutex);
+        shards_[s].words.clear(); // Keys dangle past this line; drop them first.
+        shards_[s].spilled.clear();
+        shards_[s].sorted_words.clear();
+        shards_[s].arena.clear();
+        shards_[s].bytes.store(0, std::memory_order_relaxed);
+        query_caches_[s].invalidate();
+    }
+    {
+        // Every spilled list is gone; reclaim the spill file's space.
+        std::lock_guard<std::mutex> spill_lock(spill_mutex_);
+        if (spill_fd_ >= 0 && ::ftruncate(spill_fd_, 0) != 0) {
+            std::cerr << "InvertedIndex: failed to truncate spill file "
+                      << spill_path_ << std::endl;
+        }
+        spill_size_ = 0;
+    }
+    spilled_words_.store(0, std::memory_order_relaxed);
+    spilled_bytes_.store(0, std::memory_order_relaxed);
+    unique_words_.reset();
+    std::unique_lock<std::shared_mutex> lock(doc_mutex_);
+    doc_lengths_.clear();
+    total_tokens_ = 0;
 }
 
 /**
- * @brief Returns the total number of unique words in the index.
- * This operation is thread-safe (shared lock).
- *
- * @return The number of unique words.
+ * @brief Returns the total number of unique words in the index - the
+ * striped counter maintained by the insertion paths, so no shard lock is
+ * touched and the progress thread's polling never stalls an indexer.
+ * Spilled words count: they are still in the index. A moment stale while
+ * indexing runs.
  */
 size_t InvertedIndex::size() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    return index_.size();
-}
\ No newline at end of file
+    return unique_words_.load_size();
+}
+
+/**
+ * @brief Merges a whole file's (or one chunk's) postings in bulk.
+ *
+ * Groups the postings by owning shard, then locks each touched shard
+ * exactly once and splices every word under that single lock. Positions
+ * were compressed at tokenize time; the blobs are copied out of the
+ * buffer's arena outside the lock and moved in. Chunks of a split file
+ * merge independently, in whatever order their workers finish.
+ *
+ * @param file_id The ID of the file the postings belong to.
+ * @param local The per-file buffer; left empty afterwards.
+ */
+void InvertedIndex::merge(size_t file_id, LocalIndex&& local) {
+    // Bucket by shard before taking any lock. The buffer's runs were
+    // delta-varint encoded as the file was tokenized, so wrapping one as a
+    // PackedOccurrence is a byte copy out of the arena, not a second
+    // encoding pass over every position. Each run carries the hash the
+    // tokenizer computed for its word, so routing here and the dictionary
+    // probes below never hash the key bytes again.
+    struct Pending {
+        std::string_view word;
+        size_t hash; ///< The word's StringHash, carried from tokenization.
+        PostingCodec::PackedOccurrence packed;
+    };
+    std::array<std::vector<Pending>, kNumShards> buckets;
+    size_t token_count = 0;
+    for (auto& [word, run] : local.postings_) {
+        token_count += run.count;
+        buckets[run.hash & (kNumShards - 1)].push_back(
+            {word, run.hash,
+             PostingCodec::PackedOccurrence{
+                 file_id, run.count, run.last,
+                 std::vector<uint8_t>(run.blob.begin(), run.blob.end())}});
+    }
+    add_document_tokens(file_id, token_count);
+
+    for (size_t s = 0; s < kNumShards; ++s) {
+        if (buckets[s].empty()) {
+            continue;
+        }
+        Shard& shard = shards_[s];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        int64_t grown = 0;
+        for (auto& [word, hash, packed] : buckets[s]) {
+            // A budget-spilled word must come back in before it can grow.
+            unspill_if_needed(shard, word, hash);
+            auto map_it = shard.words.find(word, hash);
+            if (map_it == shard.words.end()) {
+                const size_t arena_before = shard.arena.allocated_bytes();
+                const size_t dict_before = shard.sorted_words.capacity();
+                const size_t map_before = shard.words.allocated_bytes();
+                map_it = shard.words.emplace(shard.arena.intern(word), hash,
+                                             PostingList()).first;
+                register_sorted_word(shard.sorted_words, map_it->first);
+                unique_words_.increment();
+                grown += static_cast<int64_t>(
+                    (shard.words.allocated_bytes() - map_before) +
+                    (shard.arena.allocated_bytes() - arena_before) +
+                    (shard.sorted_words.capacity() - dict_before) *
+                        sizeof(std::string_view));
+            }
+            // Insert at the sorted slot (lists stay ordered by file_id).
+            // The file_id is already present only when this file was split
+            // into chunks and another chunk got here first; fold the runs.
+            PostingList& list = map_it->second;
+            const size_t list_before = list.allocated_bytes();
+            const size_t slot = list.slot_for(file_id);
+            if (list.file_at(slot, file_id)) {
+                PostingCodec::PackedOccurrence existing = list.extract(slot);
+                merge_packed_runs(existing, packed);
+                list.replace(slot, std::move(existing));
+            } else {
+                list.insert(slot, std::move(packed));
+            }
+            grown += static_cast<int64_t>(list.allocated_bytes()) -
+                     static_cast<int64_t>(list_before);
+        }
+        adjust_bytes(shard.bytes, grown);
+        lock.unlock();
+        query_caches_[s].invalidate(); // This shard's cached results are stale.
+    }
+
+    local.clear();
+    maybe_spill();
+}
+
+/**
+ * @brief Visits every (word, occurrences) entry in compressed form, shard
+ * by shard under shared locks.
+ *
+ * @param visitor Invoked once per unique word.
+ */
+void InvertedIndex::visit_all(
+    const std::function<void(std::string_view,
+                             const std::vector<PostingCodec::PackedOccurrence>&)>&
+        visitor) const {
+    for (const Shard& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto& [word, list] : shard.words) {
+            if (const auto* heap = list.heap_list()) {
+                visitor(word, *heap);
+            } else {
+                // Inline tail entry: materialize the one-or-two occurrence
+                // copy the visitor signature wants (cheap by construction).
+                const auto occurrences = list.materialize();
+                visitor(word, occurrences);
+            }
+        }
+        // Budget-spilled lists are part of the index too; read each back
+        // for its visit (they stay on disk).
+        for (const auto& [word, entry] : shard.spilled) {
+            const auto occurrences = load_spilled(entry);
+            visitor(word, occurrences);
+        }
+    }
+}
+
+/**
+ * @brief Bulk-installs a word's full occurrence list (snapshot rebuild).
+ * The word must not already be present.
+ *
+ * @param word The word to install.
+ * @param occurrences Its complete compressed occurrence list; moved in.
+ */
+void InvertedIndex::restore(std::string_view word,
+                            std::vector<PostingCodec::PackedOccurrence>&& occurrences) {
+    // Rebuild the restored files' document lengths as a side effect; the
+    // term frequency of every word is right in the run headers.
+    for (const PostingCodec::PackedOccurrence& occ : occurrences) {
+        add_document_tokens(occ.file_id, occ.position_count);
+    }
+
+    const size_t hash = StringHash{}(word);
+    const size_t shard_index = hash & (kNumShards - 1);
+    Shard& shard = shards_[shard_index];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    const size_t arena_before = shard.arena.allocated_bytes();
+    const size_t dict_before = shard.sorted_words.capacity();
+    const size_t map_before = shard.words.allocated_bytes();
+    PostingList list(std::move(occurrences));
+    const size_t installed = list.allocated_bytes();
+    auto map_it = shard.words.emplace(shard.arena.intern(word), hash,
+                                      std::move(list)).first;
+    register_sorted_word(shard.sorted_words, map_it->first);
+    unique_words_.increment();
+    adjust_bytes(shard.bytes,
+                 static_cast<int64_t>(
+                     installed +
+                     (shard.words.allocated_bytes() - map_before) +
+                     (shard.arena.allocated_bytes() - arena_before) +
+                     (shard.sorted_words.capacity() - dict_before) *
+                         sizeof(std::string_view)));
+    lock.unlock();
+    query_caches_[shard_index].invalidate();
+    maybe_spill();
+}
+
+void InvertedIndex::restore_merge(
+    std::string_view word,
+    std::vector<PostingCodec::PackedOccurrence>&& occurrences) {
+    for (const PostingCodec::PackedOccurrence& occ : occurrences) {
+        add_document_tokens(occ.file_id, occ.position_count);
+    }
+
+    const size_t hash = StringHash{}(word);
+    const size_t shard_index = hash & (kNumShards - 1);
+    Shard& shard = shards_[shard_index];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    unspill_if_needed(shard, word, hash);
+    auto map_it = shard.words.find(word, hash);
+    if (map_it == shard.words.end()) {
+        // New word: same installation as restore().
+        const size_t arena_before = shard.arena.allocated_bytes();
+        const size_t dict_before = shard.sorted_words.capacity();
+        const size_t map_before = shard.words.allocated_bytes();
+        PostingList list(std::move(occurrences));
+        const size_t installed = list.allocated_bytes();
+        map_it = shard.words.emplace(shard.arena.intern(word), hash,
+                                     std::move(list)).first;
+        register_sorted_word(shard.sorted_words, map_it->first);
+        unique_words_.increment();
+        adjust_bytes(shard.bytes,
+                     static_cast<int64_t>(
+                         installed +
+                         (shard.words.allocated_bytes() - map_before) +
+                         (shard.arena.allocated_bytes() - arena_before) +
+                         (shard.sorted_words.capacity() - dict_before) *
+                             sizeof(std::string_view)));
+    } else {
+        // Existing word: fold each occurrence in at its sorted slot (in
+        // practice the end - delta ids postdate everything carried over).
+        PostingList& list = map_it->second;
+        const size_t list_before = list.allocated_bytes();
+        for (auto& occ : occurrences) {
+            list.insert(list.slot_for(occ.file_id), std::move(occ));
+        }
+        adjust_bytes(shard.bytes,
+                     static_cast<int64_t>(list.allocated_bytes()) -
+                         static_cast<int64_t>(list_before));
+    }
+    lock.unlock();
+    query_caches_[shard_index].invalidate();
+    maybe_spill();
+}
+
+/**
+ * @brief Sums the per-shard query-cache counters.
+ */
+InvertedIndex::CacheStats InvertedIndex::cache_stats() const {
+    CacheStats stats;
+    for (const auto& cache : query_caches_) {
+        stats.hits += cache.hits();
+        stats.misses += cache.misses();
+    }
+    return stats;
+}
+
+InvertedIndex::InvertedIndex() = default;
+
+InvertedIndex::~InvertedIndex() {
+    if (spill_fd_ >= 0) {
+        ::close(spill_fd_);
+        ::unlink(spill_path_.c_str());
+    }
+}
+
+/**
+ * @brief Sums the incrementally maintained per-shard byte counters, plus
+ * the parts cheapest to read on demand: bucket arrays and the
+ * document-length table.
+ */
+size_t InvertedIndex::memory_usage() const {
+    size_t total = 0;
+    for (const Shard& shard : shards_) {
+        // The dictionary's own table is part of the incremental counter
+        // (its growth is captured at each inserting call site).
+        total += shard.bytes.load(std::memory_order_relaxed);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.spilled.allocated_bytes();
+    }
+    std::shared_lock<std::shared_mutex> lock(doc_mutex_);
+    total += doc_lengths_.size() *
+                 (sizeof(std::pair<const size_t, size_t>) + 2 * sizeof(void*)) +
+             doc_lengths_.bucket_count() * sizeof(void*);
+    return total;
+}
+
+/**
+ * @brief Installs the budget. Call before indexing starts; the spill file
+ * itself is only created the first time a list actually spills.
+ */
+void InvertedIndex::set_memory_budget(size_t bytes,
+                                      const std::string& spill_path) {
+    memory_budget_ = bytes;
+    spill_path_ = spill_path;
+}
+
+InvertedIndex::SpillStats InvertedIndex::spill_stats() const {
+    return {spilled_words_.load(std::memory_order_relaxed),
+            spilled_bytes_.load(std::memory_order_relaxed)};
+}
+
+/**
+ * @brief Budget enforcement, called after every write. The fast path is
+ * one memory_usage() sum; only when over budget does it walk shards,
+ * spilling each shard's largest lists first until usage is back under
+ * 7/8 of the budget (hysteresis, so the very next merge does not
+ * immediately re-trigger a pass).
+ */
+void InvertedIndex::maybe_spill() {
+    if (memory_budget_ == 0 || spill_path_.empty()) {
+        return;
+    }
+    size_t usage = memory_usage();
+    if (usage <= memory_budget_) {
+        return;
+    }
+    const size_t target = memory_budget_ - memory_budget_ / 8;
+
+    for (size_t s = 0; s < kNumShards && usage > target; ++s) {
+        Shard& shard = shards_[s];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        // Largest lists first: fewest spilled words per byte freed.
+        std::vector<std::pair<size_t, std::string_view>> candidates;
+        candidates.reserve(shard.words.size());
+        for (const auto& [word, list] : shard.words) {
+            candidates.emplace_back(list.allocated_bytes(), word);
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  std::greater<std::pair<size_t, std::string_view>>());
+
+        for (const auto& [bytes, word] : candidates) {
+            if (usage <= target) {
+                break;
+            }
+            if (bytes == 0) {
+                break; // Inline tail entries own no heap; nothing to free.
+            }
+            auto it = shard.words.find(word);
+            PostingList list = std::move(it->second);
+            shard.words.erase(it); // Backward shift; the table keeps its capacity.
+            const size_t freed = spill_list(shard, word, std::move(list));
+            if (freed == 0) {
+                return; // Spill file unusable; budget disabled, logged.
+            }
+            adjust_bytes(shard.bytes, -static_cast<int64_t>(freed));
+            usage -= std::min(freed, usage);
+        }
+        // Spilling moves lists without changing their contents, so the
+        // shard's cached query results stay valid.
+    }
+}
+
+/**
+ * @brief Appends one encoded list to the spill file and records its stub.
+ * Called with the shard's exclusive lock held. On I/O failure the list is
+ * put back in memory, the budget is disabled, and 0 is returned - an
+ * index that keeps growing beats one that loses postings.
+ */
+size_t InvertedIndex::spill_list(Shard& shard, std::string_view word,
+                                 PostingList&& list) {
+    const std::vector<uint8_t> encoded = encode_run(list);
+    // Only the list's own heap comes back; the dictionary slot stays
+    // allocated (erase never shrinks the flat table).
+    const size_t freed = list.allocated_bytes();
+
+    {
+        std::lock_guard<std::mutex> spill_lock(spill_mutex_);
+        if (spill_fd_ < 0) {
+            spill_fd_ = ::open(spill_path_.c_str(),
+                               O_CREAT | O_RDWR | O_TRUNC, 0644);
+        }
+        bool written = spill_fd_ >= 0;
+        if (written) {
+            written = ::pwrite(spill_fd_, encoded.data(), encoded.size(),
+                               static_cast<off_t>(spill_size_)) ==
+                      static_cast<ssize_t>(encoded.size());
+        }
+        if (!written) {
+            std::cerr << "InvertedIndex: cannot write spill file "
+                      << spill_path_
+                      << "; memory budget disabled." << std::endl;
+            memory_budget_ = 0;
+            shard.words.emplace(word, std::move(list));
+            return 0;
+        }
+        shard.spilled.emplace(word, SpilledList{spill_size_, encoded.size()});
+        spill_size_ += encoded.size();
+    }
+
+    spilled_words_.fetch_add(1, std::memory_order_relaxed);
+    spilled_bytes_.fetch_add(encoded.size(), std::memory_order_relaxed);
+    return freed;
+}
+
+/**
+ * @brief Reads one spilled list back with pread (no file-position state,
+ * so concurrent readers under shared shard locks need no extra lock).
+ */
+std::vector<PostingCodec::PackedOccurrence>
+InvertedIndex::load_spilled(const SpilledList& entry) const {
+    std::vector<uint8_t> encoded(entry.bytes);
+    if (::pread(spill_fd_, encoded.data(), encoded.size(),
+                static_cast<off_t>(entry.offset)) !=
+        static_cast<ssize_t>(encoded.size())) {
+        std::cerr << "InvertedIndex: failed to read spilled postings from "
+                  << spill_path_ << std::endl;
+        return {};
+    }
+    return decode_run(encoded.data());
+}
+
+/**
+ * @brief Pulls a spilled word back into memory so a writer can merge into
+ * it. The on-disk copy becomes garbage (reclaimed at clear()); the word
+ * may well spill again once the write pushes usage back over budget.
+ */
+void InvertedIndex::unspill_if_needed(Shard& shard, std::string_view word,
+                                      size_t hash) {
+    auto it = shard.spilled.find(word, hash);
+    if (it == shard.spilled.end()) {
+        return;
+    }
+    // Re-key by the spilled map's view: it is arena-backed, the caller's
+    // may alias a transient file buffer.
+    const std::string_view stable_key = it->first;
+    PostingList list(load_spilled(it->second));
+    spilled_words_.fetch_sub(1, std::memory_order_relaxed);
+    spilled_bytes_.fetch_sub(it->second.bytes, std::memory_order_relaxed);
+    shard.spilled.erase(it);
+    const size_t map_before = shard.words.allocated_bytes();
+    const size_t added = list.allocated_bytes();
+    shard.words.emplace(stable_key, hash, std::move(list));
+    adjust_bytes(shard.bytes,
+                 static_cast<int64_t>(
+                     added + (shard.words.allocated_bytes() - map_before)));
+}
+
+/**
+ * @brief Intersects sorted file-ID lists; see the header for the contract.
+ */
+std::vector<size_t> intersect_postings(
+    const std::vector<const std::vector<size_t>*>& lists) {
+    std::vector<size_t> result;
+    if (lists.empty()) {
+        return result;
+    }
+    for (const auto* list : lists) {
+        if (list->empty()) {
+            return result; // Any empty list empties the intersection.
+        }
+    }
+
+    // Smallest list first: it bounds the result, and every other list is
+    // only probed - never scanned.
+    std::vector<const std::vector<size_t>*> ordered(lists);
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto* a, const auto* b) { return a->size() < b->size(); });
+
+    // Skip pointers for the worst-case terms (boilerplate words that
+    // occur in nearly every file): fixed-size blocks, each recording its
+    // max file ID. A probe walks the compact block-max array first and
+    // lands directly in the one block that can hold the candidate, so
+    // whole blocks of a huge list are skipped without touching a single
+    // entry - galloping alone still strides through the big list's cache
+    // lines. Short lists skip the setup and gallop as before.
+    constexpr size_t kBlockEntries = 128; // 1 KiB of IDs per block.
+    constexpr size_t kMinBlocks = 4;      // Below this, blocks cost more
+                                          // than they save.
+
+    struct ProbedList {
+        const std::vector<size_t>* ids;
+        std::vector<size_t> block_max; ///< Empty for short lists.
+        size_t cursor = 0;
+    };
+    std::vector<ProbedList> probed;
+    probed.reserve(ordered.size() - 1);
+    for (size_t i = 1; i < ordered.size(); ++i) {
+        ProbedList entry{ordered[i], {}, 0};
+        const std::vector<size_t>& list = *ordered[i];
+        if (list.size() >= kBlockEntries * kMinBlocks) {
+            const size_t blocks =
+                (list.size() + kBlockEntries - 1) / kBlockEntries;
+            entry.block_max.reserve(blocks);
+            for (size_t b = 0; b < blocks; ++b) {
+                const size_t last =
+                    std::min((b + 1) * kBlockEntries, list.size()) - 1;
+                entry.block_max.push_back(list[last]);
+            }
+        }
+        probed.push_back(std::move(entry));
+    }
+
+    // Candidates arrive in ascending order, so each cursor only moves
+    // forward. Blocked lists binary-search within one block; unblocked
+    // ones gallop (double the step until bracketed, then binary-search
+    // the bracket) exactly as before.
+    auto contains_from = [](ProbedList& p, size_t file_id) {
+        const std::vector<size_t>& list = *p.ids;
+        if (!p.block_max.empty()) {
+            size_t block = p.cursor / kBlockEntries;
+            while (block < p.block_max.size() &&
+                   p.block_max[block] < file_id) {
+                ++block; // Skipped without touching the block's entries.
+            }
+            if (block == p.block_max.size()) {
+                p.cursor = list.size();
+                return false;
+            }
+            const size_t block_begin = block * kBlockEntries;
+            p.cursor = std::max(p.cursor, block_begin);
+            const size_t block_end =
+                std::min(block_begin + kBlockEntries, list.size());
+            const auto begin =
+                list.begin() + static_cast<std::ptrdiff_t>(p.cursor);
+            const auto end =
+                list.begin() + static_cast<std::ptrdiff_t>(block_end);
+            // The block's max is >= file_id, so the answer is in here.
+            const auto it = std::lower_bound(begin, end, file_id);
+            p.cursor = static_cast<size_t>(it - list.begin());
+            return it != end && *it == file_id;
+        }
+        size_t step = 1;
+        size_t hi = p.cursor;
+        while (hi < list.size() && list[hi] < file_id) {
+            p.cursor = hi + 1;
+            hi += step;
+            step *= 2;
+        }
+        const auto begin =
+            list.begin() + static_cast<std::ptrdiff_t>(p.cursor);
+        const auto end = list.begin() + static_cast<std::ptrdiff_t>(
+                                            std::min(hi + 1, list.size()));
+        const auto it = std::lower_bound(begin, end, file_id);
+        p.cursor = static_cast<size_t>(it - list.begin());
+        return it != list.end() && *it == file_id;
+    };
+
+    result.reserve(ordered.front()->size());
+    for (const size_t file_id : *ordered.front()) {
+        bool in_all = true;
+        for (ProbedList& p : probed) {
+            if (!contains_from(p, file_id)) {
+                in_all = false;
+                break;
+            }
+        }
+        if (in_all) {
+            result.push_back(file_id);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief The sorted file-ID list of one word; no position blob is decoded.
+ */
+std::vector<size_t> InvertedIndex::file_ids_for(std::string_view word) const {
+    const Shard& shard = shard_for(word);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto it = shard.words.find(word);
+    if (it == shard.words.end()) {
+        if (auto spilled_it = shard.spilled.find(word);
+            spilled_it != shard.spilled.end()) {
+            const auto list = load_spilled(spilled_it->second);
+            std::vector<size_t> ids;
+            ids.reserve(list.size());
+            for (const PostingCodec::PackedOccurrence& occ : list) {
+                ids.push_back(occ.file_id);
+            }
+            return ids;
+        }
+        return {};
+    }
+    const PostingList& list = it->second;
+    std::vector<size_t> ids;
+    ids.reserve(list.size());
+    for (size_t i = 0; i < list.size(); ++i) {
+        ids.push_back(list.at(i).file_id);
+    }
+    return ids;
+}
+
+/**
+ * @brief Planner statistics for one term; see the header for the contract.
+ */
+InvertedIndex::TermStats InvertedIndex::term_stats(std::string_view word) const {
+    const Shard& shard = shard_for(word);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    TermStats stats;
+    if (auto it = shard.words.find(word); it != shard.words.end()) {
+        const PostingList& list = it->second;
+        stats.df = list.size();
+        stats.bytes = list.allocated_bytes();
+        stats.max_file_id = list.max_file_id();
+        stats.dense = list.bitmap() != nullptr;
+    } else if (auto spilled_it = shard.spilled.find(word);
+               spilled_it != shard.spilled.end()) {
+        stats.spilled = true;
+        stats.bytes = spilled_it->second.bytes;
+        // df would require loading the list; the planner treats spilled
+        // terms as arbitrarily common and takes the copying path.
+        stats.df = SIZE_MAX;
+    }
+    return stats;
+}
+
+/**
+ * @brief Copies out a dense term's file-ID bitmap; see the header.
+ */
+std::vector<uint64_t> InvertedIndex::bitmap_for(std::string_view word) const {
+    const Shard& shard = shard_for(word);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    if (auto it = shard.words.find(word); it != shard.words.end()) {
+        if (const std::vector<uint64_t>* bits = it->second.bitmap()) {
+            return *bits;
+        }
+    }
+    return {};
+}
+
+/**
+ * @brief Membership probe for one (term, file) pair; see the header.
+ */
+bool InvertedIndex::term_contains(std::string_view word, size_t file_id) const {
+    const Shard& shard = shard_for(word);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    if (auto it = shard.words.find(word); it != shard.words.end()) {
+        return it->second.contains(file_id);
+    }
+    if (auto spilled_it = shard.spilled.find(word);
+        spilled_it != shard.spilled.end()) {
+        // Rare: the planner avoids probing spilled terms, but stay
+        // correct if one spills between the stats read and the probe.
+        const auto list = load_spilled(spilled_it->second);
+        const auto found = std::lower_bound(
+            list.begin(), list.end(), file_id,
+            [](const PostingCodec::PackedOccurrence& occ, size_t id) {
+                return occ.file_id < id;
+            });
+        return found != list.end() && found->file_id == file_id;
+    }
+    return false;
+}
+
+/**
+ * @brief Lazily starts the shared query pool; sized to the hardware but
+ * capped - term lookups are short and mostly lock-free, so a few workers
+ * already cover a 20-term query's useful parallelism.
+ */
+scheduler::ThreadPool& InvertedIndex::query_pool() const {
+    std::call_once(query_pool_once_, [this] {
+        const size_t workers =
+            std::min<size_t>(4, std::max(2u, std::thread::hardware_concurrency()));
+        query_pool_ = std::make_unique<scheduler::ThreadPool>(workers);
+    });
+    return *query_pool_;
+}
+
+/**
+ * @brief Multi-term AND query over the in-memory index.
+ *
+ * @param terms The words that must all occur; empty yields {}.
+ * @return Matching file IDs, ascending.
+ */
+std::vector<size_t> InvertedIndex::search_all(
+    const std::vector<std::string>& terms) const {
+    if (terms.empty()) {
+        return {};
+    }
+
+    // Plan the query from per-term statistics: df, bytes, and max file ID
+    // all live in the dictionary slot, so the whole planning pass is a
+    // few O(1) probes under shared locks.
+    std::vector<TermStats> stats;
+    stats.reserve(terms.size());
+    size_t rarest = 0;
+    size_t total_df = 0;
+    size_t max_file_id = 0;
+    bool any_spilled = false;
+    for (size_t i = 0; i < terms.size(); ++i) {
+        stats.push_back(term_stats(terms[i]));
+        if (stats[i].df == 0) {
+            return {}; // A term nobody contains: certain miss, zero work.
+        }
+        if (stats[i].df < stats[rarest].df) {
+            rarest = i;
+        }
+        any_spilled = any_spilled || stats[i].spilled;
+        if (!stats[i].spilled) {
+            total_df += stats[i].df;
+            max_file_id = std::max(max_file_id, stats[i].max_file_id);
+        }
+    }
+
+    // Rare-term regime (the interactive case): the rarest term bounds the
+    // result to a handful of candidates, so probe each one against the
+    // other terms' dictionary slots directly - no list is ever copied,
+    // however common the other terms are.
+    if (terms.size() > 1 && !any_spilled && stats[rarest].df <= kRareTermDf) {
+        std::vector<size_t> result;
+        for (const size_t file_id : file_ids_for(terms[rarest])) {
+            bool in_all = true;
+            for (size_t i = 0; i < terms.size(); ++i) {
+                if (i != rarest && !term_contains(terms[i], file_id)) {
+                    in_all = false;
+                    break;
+                }
+            }
+            if (in_all) {
+                result.push_back(file_id);
+            }
+        }
+        return result;
+    }
+
+    // Dense-term regime: every term carries a file-ID bitmap, so
+    // intersect word-at-a-time - copy each bitmap out under its shard
+    // lock, AND into the accumulator, then expand the surviving bits.
+    // That is sequential 64-bit loads and ANDs end to end:
+    // memory-bandwidth-bound, not branch-bound like list merging.
+    bool all_dense = terms.size() > 1;
+    for (const TermStats& term : stats) {
+        all_dense = all_dense && term.dense;
+    }
+    if (all_dense) {
+        std::vector<uint64_t> acc = bitmap_for(terms[0]);
+        for (size_t i = 1; i < terms.size() && !acc.empty(); ++i) {
+            const std::vector<uint64_t> bits = bitmap_for(terms[i]);
+            if (bits.empty()) {
+                acc.clear(); // Raced away (spilled); take the copy path.
+                break;
+            }
+            if (bits.size() < acc.size()) {
+                acc.resize(bits.size());
+            }
+            for (size_t w = 0; w < acc.size(); ++w) {
+                acc[w] &= bits[w];
+            }
+        }
+        if (!acc.empty()) {
+            std::vector<size_t> result;
+            for (size_t w = 0; w < acc.size(); ++w) {
+                uint64_t bits = acc[w];
+                while (bits != 0) {
+                    result.push_back(
+                        w * 64 + static_cast<size_t>(std::countr_zero(bits)));
+                    bits &= bits - 1;
+                }
+            }
+            return result;
+        }
+    }
+
+    // Copy each term's file-ID list out under its shard lock (positions
+    // stay compressed and untouched), then intersect without any lock.
+    std::vector<std::vector<size_t>> id_lists(terms.size());
+    if (terms.size() >= kParallelQueryTerms) {
+        // Wide query: every term's lookup touches only its own shard, so
+        // the lookups run concurrently on the pool. The latch joins them;
+        // captures stay valid because this frame outlives the wait.
+        scheduler::ThreadPool& pool = query_pool();
+        std::latch done(static_cast<std::ptrdiff_t>(terms.size()));
+        for (size_t i = 0; i < terms.size(); ++i) {
+            pool.enqueue([this, &terms, &id_lists, &done, i] {
+                id_lists[i] = file_ids_for(terms[i]);
+                done.count_down();
+            });
+        }
+        done.wait();
+    } else {
+        // Cheap query: the pool handoff would dominate the lookups.
+        for (size_t i = 0; i < terms.size(); ++i) {
+            id_lists[i] = file_ids_for(terms[i]);
+        }
+    }
+
+    // Common-term regime (the dashboard case): when even the rarest list
+    // is large, per-candidate probing touches most of every list anyway,
+    // so a counting scan wins - one sequential pass per list over a byte
+    // array indexed by file ID (IDs are dense: one atomic counter in the
+    // scanner). Sized from the copied lists, so spilled terms are
+    // covered too. The density guard keeps a pathological sparse ID
+    // space from buying a huge, mostly-untouched array.
+    size_t min_copied = SIZE_MAX;
+    size_t total_copied = 0;
+    size_t max_copied_id = 0;
+    for (const auto& list : id_lists) {
+        if (list.empty()) {
+            return {};
+        }
+        min_copied = std::min(min_copied, list.size());
+        total_copied += list.size();
+        max_copied_id = std::max(max_copied_id, list.back());
+    }
+    if (terms.size() > 1 && terms.size() < 255 &&
+        min_copied > kBitmapMinDf && max_copied_id < total_copied * 8) {
+        std::vector<uint8_t> counts(max_copied_id + 1, 0);
+        for (const auto& list : id_lists) {
+            for (const size_t file_id : list) {
+                ++counts[file_id];
+            }
+        }
+        std::vector<size_t> result;
+        const uint8_t wanted = static_cast<uint8_t>(terms.size());
+        for (const size_t file_id : id_lists.front()) {
+            if (counts[file_id] == wanted) {
+                result.push_back(file_id);
+            }
+        }
+        return result;
+    }
+
+    std::vector<const std::vector<size_t>*> lists;
+    lists.reserve(id_lists.size());
+    for (const auto& list : id_lists) {
+        lists.push_back(&list);
+    }
+    return intersect_postings(lists);
+}
+
+/**
+ * @brief Filters per-term occurrence lists down to phrase matches; see the
+ * header for the contract.
+ */
+std::vector<WordOccurrence> match_phrase(
+    const std::vector<std::vector<WordOccurrence>>& occurrences_by_term,
+    const std::vector<size_t>& term_offsets) {
+    std::vector<WordOccurrence> results;
+    if (occurrences_by_term.empty()) {
+        return results;
+    }
+    for (const auto& list : occurrences_by_term) {
+        if (list.empty()) {
+            return results; // A term nobody contains empties the phrase.
+        }
+    }
+
+    // Two-pointer intersection by file: every list is sorted by file_id,
+    // and candidates arrive in ascending order, so each cursor only moves
+    // forward.
+    std::vector<size_t> cursors(occurrences_by_term.size(), 0);
+    for (const WordOccurrence& first : occurrences_by_term[0]) {
+        bool in_all = true;
+        for (size_t t = 1; t < occurrences_by_term.size(); ++t) {
+            const auto& list = occurrences_by_term[t];
+            size_t& cursor = cursors[t];
+            while (cursor < list.size() && list[cursor].file_id < first.file_id) {
+                ++cursor;
+            }
+            if (cursor == list.size() || list[cursor].file_id != first.file_id) {
+                in_all = false;
+                break;
+            }
+        }
+        if (!in_all) {
+            continue;
+        }
+
+        // Adjacency: start from term 0's positions and filter them against
+        // each following term with one linear merge - both sides are
+        // sorted, so every pass is a single forward walk.
+        std::vector<size_t> starts = first.positions;
+        for (size_t t = 1; t < occurrences_by_term.size() && !starts.empty(); ++t) {
+            const std::vector<size_t>& next =
+                occurrences_by_term[t][cursors[t]].positions;
+            std::vector<size_t> kept;
+            size_t j = 0;
+            for (const size_t start : starts) {
+                const size_t wanted = start + term_offsets[t];
+                while (j < next.size() && next[j] < wanted) {
+                    ++j;
+                }
+                if (j < next.size() && next[j] == wanted) {
+                    kept.push_back(start);
+                }
+            }
+            starts.swap(kept);
+        }
+        if (!starts.empty()) {
+            results.push_back({first.file_id, std::move(starts)});
+        }
+    }
+    return results;
+}
+
+/**
+ * @brief Phrase query: per-term lookups (cache-assisted, like any single
+ * word search), then one shared match pass over the decoded positions.
+ */
+std::vector<WordOccurrence> InvertedIndex::search_phrase(
+    const std::vector<std::string>& terms) const {
+    if (terms.empty()) {
+        return {};
+    }
+
+    // The tokenizer counts a word's successor at +(length + 1), so the
+    // k-th phrase term must sit at the sum of its predecessors' extents.
+    std::vector<size_t> term_offsets(terms.size(), 0);
+    std::vector<std::vector<WordOccurrence>> occurrences_by_term;
+    occurrences_by_term.reserve(terms.size());
+    for (size_t t = 0; t < terms.size(); ++t) {
+        if (t > 0) {
+            term_offsets[t] = term_offsets[t - 1] + terms[t - 1].size() + 1;
+        }
+        occurrences_by_term.push_back(search(terms[t]));
+    }
+    return match_phrase(occurrences_by_term, term_offsets);
+}
+
+/**
+ * @brief Prefix query over the per-shard sorted dictionaries.
+ *
+ * Each shard holds a lexicographic slice of its own words, so the match is
+ * a lower_bound plus a scan while the prefix holds - per shard - and one
+ * merge-by-sort at the end (the shards partition by hash, not by prefix).
+ */
+std::vector<std::string> InvertedIndex::search_prefix(
+    std::string_view prefix) const {
+    std::vector<std::string> results;
+    for (const Shard& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = std::lower_bound(shard.sorted_words.begin(),
+                                   shard.sorted_words.end(), prefix);
+        for (; it != shard.sorted_words.end() && it->starts_with(prefix); ++it) {
+            results.emplace_back(*it);
+        }
+    }
+    std::sort(results.begin(), results.end());
+    return results;
+}
+
+/**
+ * @brief Adds 'tokens' to a file's length (and the corpus total).
+ */
+void InvertedIndex::add_document_tokens(size_t file_id, size_t tokens) {
+    if (tokens == 0) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(doc_mutex_);
+    doc_lengths_[file_id] += tokens;
+    total_tokens_ += tokens;
+}
+
+/**
+ * @brief The number of tokens indexed for a file; 0 for unknown files.
+ */
+size_t InvertedIndex::document_length(size_t file_id) const {
+    std::shared_lock<std::shared_mutex> lock(doc_mutex_);
+    auto it = doc_lengths_.find(file_id);
+    return it == doc_lengths_.end() ? 0 : it->second;
+}
+
+/**
+ * @brief BM25 top-k over one term's posting list; see the header.
+ */
+std::vector<ScoredFile> rank_postings(
+    const std::vector<std::pair<size_t, size_t>>& tf_by_file,
+    const std::function<size_t(size_t)>& doc_length,
+    size_t doc_count, double avg_doc_length, size_t k) {
+    if (tf_by_file.empty() || doc_count == 0 || k == 0) {
+        return {};
+    }
+
+    // Rarity weight: documents-containing-term vs. corpus size.
+    const double df = static_cast<double>(tf_by_file.size());
+    const double n = static_cast<double>(doc_count);
+    const double idf = std::log(1.0 + (n - df + 0.5) / (df + 0.5));
+
+    // Bounded min-heap: the worst of the current top-k sits on top, so a
+    // posting either beats it (pop+push, O(log k)) or is discarded in O(1).
+    auto worse = [](const ScoredFile& a, const ScoredFile& b) {
+        return a.score > b.score;
+    };
+    std::priority_queue<ScoredFile, std::vector<ScoredFile>, decltype(worse)>
+        heap(worse);
+    for (const auto& [file_id, tf_count] : tf_by_file) {
+        const double tf = static_cast<double>(tf_count);
+        const double dl = static_cast<double>(doc_length(file_id));
+        const double norm =
+            kBm25K1 * (1.0 - kBm25B + kBm25B * dl / avg_doc_length);
+        const double score = idf * (tf * (kBm25K1 + 1.0)) / (tf + norm);
+        if (heap.size() < k) {
+            heap.push({file_id, score});
+        } else if (score > heap.top().score) {
+            heap.pop();
+            heap.push({file_id, score});
+        }
+    }
+
+    std::vector<ScoredFile> results(heap.size());
+    for (auto it = results.rbegin(); it != results.rend(); ++it) {
+        *it = heap.top(); // Min-heap pops worst first; fill back to front.
+        heap.pop();
+    }
+    return results;
+}
+
+/**
+ * @brief Ranked single-term query; term frequencies are read from the run
+ * headers under the shard lock, scoring happens outside any lock.
+ */
+std::vector<ScoredFile> InvertedIndex::search_ranked(std::string_view term,
+                                                     size_t k) const {
+    std::vector<std::pair<size_t, size_t>> tf_by_file;
+    {
+        const Shard& shard = shard_for(term);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.words.find(term);
+        if (it != shard.words.end()) {
+            const PostingList& list = it->second;
+            tf_by_file.reserve(list.size());
+            for (size_t i = 0; i < list.size(); ++i) {
+                const PostingList::View occ = list.at(i);
+                tf_by_file.emplace_back(occ.file_id, occ.position_count);
+            }
+        } else if (auto spilled_it = shard.spilled.find(term);
+                   spilled_it != shard.spilled.end()) {
+            const auto list = load_spilled(spilled_it->second);
+            tf_by_file.reserve(list.size());
+            for (const PostingCodec::PackedOccurrence& occ : list) {
+                tf_by_file.emplace_back(occ.file_id, occ.position_count);
+            }
+        } else {
+            return {};
+        }
+    }
+
+    size_t doc_count;
+    double avg_doc_length;
+    {
+        std::shared_lock<std::shared_mutex> lock(doc_mutex_);
+        doc_count = doc_lengths_.size();
+        avg_doc_length = doc_count == 0
+                             ? 1.0
+                             : static_cast<double>(total_tokens_) /
+                                   static_cast<double>(doc_count);
+    }
+
+    return rank_postings(
+        tf_by_file, [this](size_t file_id) { return document_length(file_id); },
+        doc_count, avg_doc_length, k);
+}
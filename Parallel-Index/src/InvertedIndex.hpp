@@ -1,10 +1,28 @@
 #pragma once
 
+#include "FlatMap.hpp"
+#include "PostingCodec.hpp"
+#include "PostingList.hpp"
+#include "QueryCache.hpp"
+#include "Utils.hpp" // For Utils::TokenHash (the shared dictionary hash)
+#include "../../Concurrent-Data-Structures/memory/monotonic_arena.hpp"
+#include "../../Concurrent-Data-Structures/sync/striped_counter.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <shared_mutex>
 
+namespace scheduler {
+    class ThreadPool; // Task-Scheduler's pool; runs parallel term lookups.
+}
+
 /**
  * @brief Represents an occurrence of a word within a specific file.
  * Includes the file ID and the positions (offsets) where the word appears.
@@ -14,17 +32,164 @@ struct WordOccurrence {
     std::vector<size_t> positions; ///< A list of byte offsets where the word starts in the file.
 };
 
+/**
+ * @brief One ranked search result: a file and its relevance score.
+ */
+struct ScoredFile {
+    size_t file_id;
+    double score; ///< BM25 score; higher is more relevant.
+};
+
+/**
+ * @brief Intersects file-ID lists (each sorted ascending) and returns the
+ * IDs present in every one of them.
+ *
+ * Uses galloping (exponential-then-binary) search seeded from the smallest
+ * list, so a rare term intersected against a huge one probes
+ * O(small * log(big)) entries instead of scanning both. Lists long enough
+ * to matter additionally get skip pointers - fixed-size blocks, each
+ * recording its max file ID - so a probe lands in the one block that can
+ * hold the candidate and whole blocks are skipped untouched. Operating on
+ * bare ID lists means an AND query never decompresses a single position
+ * blob. Shared by the in-memory index and the mmap-snapshot reader.
+ *
+ * @param lists The ID lists to intersect; empty input yields {}.
+ * @return Matching file IDs, ascending.
+ */
+std::vector<size_t> intersect_postings(
+    const std::vector<const std::vector<size_t>*>& lists);
+
+/**
+ * @brief Filters per-term occurrence lists down to phrase matches.
+ *
+ * Intersects the lists by file (all are sorted by file_id), then verifies
+ * adjacency inside each common file with a linear merge over the sorted
+ * position vectors: a phrase starting at p requires term k at exactly
+ * p + term_offsets[k]. Shared by the in-memory index and the mmap-snapshot
+ * reader.
+ *
+ * @param occurrences_by_term Decoded occurrences of each phrase term, in
+ *        phrase order.
+ * @param term_offsets Byte offset of each term from the phrase start
+ *        (term_offsets[0] == 0), as the tokenizer counts positions.
+ * @return Per matching file: the positions where the whole phrase starts.
+ */
+std::vector<WordOccurrence> match_phrase(
+    const std::vector<std::vector<WordOccurrence>>& occurrences_by_term,
+    const std::vector<size_t>& term_offsets);
+
+/**
+ * @brief Scores one term's posting list with BM25 and returns the top-k
+ * files, best first.
+ *
+ * A bounded min-heap of size k tracks the current top results, so ranking
+ * a common term costs O(df * log k) and returns k entries instead of the
+ * whole posting list. Term frequencies come straight from the posting run
+ * headers - no position blob is decoded. Shared by the in-memory index and
+ * the mmap-snapshot reader.
+ *
+ * @param tf_by_file Per file containing the term: (file_id, term frequency).
+ * @param doc_length Resolves a file ID to its indexed token count.
+ * @param doc_count Total number of documents in the index.
+ * @param avg_doc_length Mean indexed token count across all documents.
+ * @param k The most results to return.
+ * @return Up to k ScoredFile entries, descending by score.
+ */
+std::vector<ScoredFile> rank_postings(
+    const std::vector<std::pair<size_t, size_t>>& tf_by_file,
+    const std::function<size_t(size_t)>& doc_length,
+    size_t doc_count, double avg_doc_length, size_t k);
+
+/**
+ * @brief A private, unsynchronized posting buffer for one file.
+ *
+ * An IndexerWorker accumulates every (word, position) of a file here with
+ * no locking at all, then hands the whole thing to InvertedIndex::merge in
+ * one call - amortizing shard locking from per-token to per-file. Keys are
+ * string_views aliasing the file buffer (or the worker's token arena), so
+ * the buffer must be merged before that memory is unmapped.
+ */
+class LocalIndex {
+public:
+    /**
+     * @brief One word's positions, already delta-varint encoded.
+     *
+     * Positions arrive in ascending scan order, so add() can encode each
+     * one against the run's tail as it is recorded - the same single pass
+     * that tokenizes the file produces the compressed blob, and the bulk
+     * merge copies bytes instead of re-walking every position through the
+     * codec. The blob's storage lives in the buffer's arena.
+     */
+    struct PositionRun {
+        using ByteVector = std::vector<uint8_t, cds::arena_allocator<uint8_t>>;
+        PositionRun() = default; ///< Empty-slot value for the FlatMap.
+        explicit PositionRun(cds::monotonic_arena& arena)
+            : blob(cds::arena_allocator<uint8_t>(arena)) {}
+        ByteVector blob;  ///< Delta-varint byte stream (PostingCodec format).
+        size_t count = 0; ///< Positions encoded in the blob.
+        size_t last = 0;  ///< Tail value, the base for the next delta.
+        size_t hash = 0;  ///< The word's TokenHash, carried to the merge.
+    };
+
+    /** @brief Records one occurrence of 'word' at 'position' (>= the
+     *  word's previous position in this file). 'hash' is the word's
+     *  Utils::TokenHash, precomputed by the tokenizer in the same scan
+     *  that produced the token; it probes the map here and is stashed in
+     *  the run so the merge can route and probe shards without ever
+     *  re-reading the word's bytes. */
+    void add(std::string_view word, size_t hash, size_t position) {
+        auto it = postings_.find(word, hash);
+        if (it == postings_.end()) {
+            PositionRun run(arena_);
+            run.hash = hash;
+            it = postings_.emplace(word, hash, std::move(run)).first;
+        }
+        PositionRun& run = it->second;
+        PostingCodec::encode_varint(run.blob,
+                                    position - (run.count == 0 ? 0 : run.last));
+        run.last = position;
+        ++run.count;
+    }
+
+    bool empty() const { return postings_.empty(); }
+
+    /**
+     * @brief Drops all postings; keeps nothing aliased. One arena rewind
+     * retires every position blob's storage (their deallocate is a
+     * no-op), and the retained slabs - like the map's table - make a
+     * reused buffer allocation-free in steady state.
+     */
+    void clear() {
+        postings_.clear();
+        arena_.reset();
+    }
+
+private:
+    friend class InvertedIndex;
+    // Thousands of short-lived position vectors per file: bump-allocated
+    // here instead of a malloc/free pair each. Must outlive postings_.
+    cds::monotonic_arena arena_;
+    // Same hasher as the shard dictionaries, so one tokenizer-computed
+    // hash serves this map, shard routing, and the shard maps alike.
+    FlatMap<std::string_view, PositionRun, Utils::TokenHash> postings_;
+};
+
 /**
  * @brief A thread-safe inverted index for storing word-to-file mappings.
  *
  * This class allows multiple threads to add word occurrences concurrently during indexing
- * and multiple threads to search for words concurrently. It uses std::shared_mutex
- * to optimize for scenarios with more reads than writes.
+ * and multiple threads to search for words concurrently.
+ *
+ * The index is sharded: words are partitioned by hash across independently
+ * locked sub-maps, so writers for different words proceed in parallel
+ * instead of serializing on one global lock. Each shard uses a
+ * std::shared_mutex to optimize for scenarios with more reads than writes.
  */
 class InvertedIndex {
 public:
-    InvertedIndex() = default;
-    ~InvertedIndex() = default;
+    // Both out of line: the query pool member is an incomplete type here.
+    InvertedIndex();
+    ~InvertedIndex(); ///< Stops the query pool; closes and removes the spill file.
 
     // Delete copy constructor and assignment operator to prevent accidental copying
     InvertedIndex(const InvertedIndex&) = delete;
@@ -41,14 +206,297 @@ public:
      */
     void add_word_occurrence(const std::string& word, size_t file_id, size_t position);
 
+    /**
+     * @brief Adds a word occurrence keyed by a string_view (e.g. a token
+     * aliasing an mmap'd file buffer). The word's bytes are interned into
+     * the shard's arena the first time it is seen; every later occurrence
+     * of the same word allocates nothing.
+     *
+     * @param word The word to add; need not outlive the call.
+     * @param file_id The ID of the file where the word occurs.
+     * @param position The byte offset of the word within the file.
+     */
+    void add_word_occurrence(std::string_view word, size_t file_id, size_t position);
+
+    /**
+     * @brief Merges a whole file's postings in bulk.
+     *
+     * Postings are grouped by owning shard first, so each shard lock is
+     * taken at most once per file (instead of once per token). The buffer
+     * already holds each word's positions delta-varint encoded (see
+     * LocalIndex::PositionRun), so no encoding happens here at all - and
+     * each word's hash rides along from tokenization, so shard routing
+     * and the dictionary probes never re-read the key bytes either.
+     *
+     * @param file_id The ID of the file the postings belong to.
+     * @param local The per-file buffer; left empty afterwards.
+     */
+    void merge(size_t file_id, LocalIndex&& local);
+
+    /**
+     * @brief Bulk-installs a word's full occurrence list, e.g. when
+     * rebuilding from a snapshot during incremental re-indexing. The word
+     * must not already be present.
+     *
+     * @param word The word to install.
+     * @param occurrences Its complete occurrence list (already compressed,
+     *        e.g. straight out of a snapshot); moved in.
+     */
+    void restore(std::string_view word,
+                 std::vector<PostingCodec::PackedOccurrence>&& occurrences);
+
+    /**
+     * @brief Like restore(), but the word may already be present: the
+     * occurrences are folded into its existing posting list at their
+     * sorted slots. Used when overlaying delta-log postings on top of a
+     * base snapshot's carried postings - the delta's file ids are newer
+     * than (and disjoint from) anything the base installed.
+     *
+     * @param word The word to install or extend.
+     * @param occurrences Its additional occurrences (compressed, sorted
+     *        by file_id); moved in.
+     */
+    void restore_merge(std::string_view word,
+                       std::vector<PostingCodec::PackedOccurrence>&& occurrences);
+
+    /**
+     * @brief Visits every (word, occurrences) entry in the index, shard by
+     * shard under shared locks, in compressed form. Used by snapshot
+     * serialization (the blobs are written verbatim); the views and
+     * references passed to the visitor are only valid during the call.
+     *
+     * @param visitor Invoked once per unique word.
+     */
+    void visit_all(
+        const std::function<void(std::string_view,
+                                 const std::vector<PostingCodec::PackedOccurrence>&)>&
+            visitor) const;
+
     /**
      * @brief Searches for a word in the index.
-     * This operation is thread-safe (shared lock for reads).
+     * This operation is thread-safe (shared lock for reads). Position
+     * blobs are decompressed here, lazily - words nobody queries are never
+     * decoded.
      *
      * @param word The word to search for.
      * @return A vector of WordOccurrence structures indicating where the word was found.
      */
-    std::vector<WordOccurrence> search(const std::string& word) const;
+    std::vector<WordOccurrence> search(std::string_view word) const;
+
+    /**
+     * @brief Zero-copy query result: iterates one word's postings in
+     * place instead of copying them out of the index. The view holds the
+     * owning shard's shared lock for its lifetime - writers to that shard
+     * wait until it is dropped, so hold it briefly. The caller must also
+     * keep the index alive for as long as the view exists; on the rebuild
+     * pipeline that means pinning the published generation's shared_ptr,
+     * which the search loop does anyway. Position blobs decode lazily
+     * (see PostingCodec::PositionRange); copies are opt-in via
+     * materialize(). A spilled word is the one case that owns storage:
+     * its list comes back from disk into the view.
+     */
+    class ResultView {
+    public:
+        /** @brief One posting: a file and a lazy view of its positions. */
+        struct Entry {
+            size_t file_id;
+            size_t position_count;
+            PostingCodec::PositionRange positions;
+        };
+
+        class iterator {
+        public:
+            using value_type = Entry;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::input_iterator_tag;
+
+            Entry operator*() const { return view_->at(index_); }
+            iterator& operator++() {
+                ++index_;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator tmp = *this;
+                ++index_;
+                return tmp;
+            }
+            bool operator==(const iterator& other) const {
+                return index_ == other.index_;
+            }
+            bool operator!=(const iterator& other) const {
+                return index_ != other.index_;
+            }
+
+        private:
+            friend class ResultView;
+            iterator(const ResultView* view, size_t index)
+                : view_(view), index_(index) {}
+
+            const ResultView* view_;
+            size_t index_;
+        };
+
+        size_t size() const { return list_ ? list_->size() : owned_.size(); }
+        bool empty() const { return size() == 0; }
+
+        /** @brief The index-th posting, ascending by file ID. */
+        Entry at(size_t index) const {
+            if (list_) {
+                const PostingList::View occ = list_->at(index);
+                return {occ.file_id, occ.position_count,
+                        PostingCodec::PositionRange(occ.blob,
+                                                    occ.position_count)};
+            }
+            const PostingCodec::PackedOccurrence& occ = owned_[index];
+            return {occ.file_id, occ.position_count,
+                    PostingCodec::PositionRange(occ.packed_positions.data(),
+                                                occ.position_count)};
+        }
+
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, size()); }
+
+        /** @brief The opt-in copy, same shape as search() returns. */
+        std::vector<WordOccurrence> materialize() const {
+            std::vector<WordOccurrence> results;
+            results.reserve(size());
+            for (size_t i = 0; i < size(); ++i) {
+                const Entry entry = at(i);
+                results.push_back({entry.file_id, entry.positions.materialize()});
+            }
+            return results;
+        }
+
+    private:
+        friend class InvertedIndex;
+        ResultView() = default;
+
+        std::shared_lock<std::shared_mutex> lock_; ///< Pins the shard.
+        const PostingList* list_ = nullptr;        ///< In-place postings.
+        std::vector<PostingCodec::PackedOccurrence> owned_; ///< Spill load.
+    };
+
+    /**
+     * @brief Zero-copy variant of search(): same result contents, but
+     * nothing is copied and no position blob is decoded until the caller
+     * asks. Bypasses the per-shard query cache - there is no materialized
+     * vector to share. See ResultView for the lifetime contract.
+     */
+    ResultView search_view(std::string_view word) const;
+
+    /**
+     * @brief Multi-term AND query: returns the IDs of files containing
+     * every term, picking the evaluation strategy from per-term
+     * statistics (see term_stats). A term with zero matches ends the
+     * query before anything is copied. A rare enough term drives direct
+     * dictionary probes of the other terms - nanosecond-cheap however
+     * common those are. When every term is dense enough to carry a
+     * file-ID bitmap, the bitmaps are ANDed word-at-a-time; common terms
+     * without bitmaps get a counting scan instead of per-candidate
+     * searching. Everything in between takes the galloping skip-block
+     * intersection.
+     *
+     * Wide queries resolve their terms in parallel: each term's posting
+     * list lives on its own shard (own lock, own cache lines), so the
+     * lookups are independent and run on the shared query pool. Short
+     * queries stay on the calling thread - below a handful of terms the
+     * pool handoff costs more than the lookups.
+     *
+     * @param terms The words that must all occur; empty yields {}.
+     * @return Matching file IDs, ascending.
+     */
+    std::vector<size_t> search_all(const std::vector<std::string>& terms) const;
+
+    /**
+     * @brief Phrase query: files where the terms occur adjacently, in
+     * order. Posting lists are intersected by file first; adjacency is
+     * then verified against the stored positions, so "thread pool" only
+     * matches the two words back to back (within one line).
+     *
+     * @param terms The phrase's words, in order; empty yields {}.
+     * @return Per matching file: the phrase's start positions.
+     */
+    std::vector<WordOccurrence> search_phrase(
+        const std::vector<std::string>& terms) const;
+
+    /**
+     * @brief Prefix query: every indexed word starting with 'prefix',
+     * sorted. Served from the per-shard sorted dictionaries by binary
+     * search plus range scan - no hash-map key scan.
+     *
+     * @param prefix The word prefix to match; empty matches everything.
+     * @return The matching words, ascending.
+     */
+    std::vector<std::string> search_prefix(std::string_view prefix) const;
+
+    /**
+     * @brief Ranked single-term query: the top-k files for 'term' by BM25
+     * score (term frequency vs. document length, rarity-weighted).
+     *
+     * @param term The word to rank files for.
+     * @param k The most results to return.
+     * @return Up to k results, best first.
+     */
+    std::vector<ScoredFile> search_ranked(std::string_view term, size_t k) const;
+
+    /**
+     * @brief The number of tokens indexed for a file (stop words excluded),
+     * as accumulated by merge/restore; 0 for unknown files. Persisted into
+     * snapshots so ranked queries work against the mapped index too.
+     */
+    size_t document_length(size_t file_id) const;
+
+    /**
+     * @brief Query-cache hit/miss totals across all shards, for the stats
+     * surface. Query logs are heavily skewed, so the hit count should
+     * dwarf the miss count on realistic traffic.
+     */
+    struct CacheStats {
+        size_t hits = 0;
+        size_t misses = 0;
+    };
+
+    /** @brief Aggregated query-cache counters. */
+    CacheStats cache_stats() const;
+
+    /**
+     * @brief Bytes the index currently holds in memory: interned
+     * dictionary bytes (arena slabs), posting vectors and their compressed
+     * blobs (by capacity, since that is what the allocator handed out),
+     * hash-map nodes and bucket arrays, the sorted dictionaries, and the
+     * document-length table. Spilled lists cost only their stub entry.
+     *
+     * Maintained incrementally by the mutation paths, so this is a sum of
+     * per-shard counters - never a walk of the index.
+     */
+    size_t memory_usage() const;
+
+    /**
+     * @brief Caps memory_usage() at 'bytes'. When a merge pushes the index
+     * over the cap, the largest in-memory posting lists are spilled to
+     * 'spill_path' (in the snapshot's varint run format) until usage drops
+     * below the cap again, instead of growing until the OOM killer fires.
+     * Every read path consults the spill file transparently, and merging
+     * new postings into a spilled word loads it back first.
+     *
+     * Largest-first is the eviction policy: nothing queries the index
+     * mid-build, hot query results live on in the per-shard LRU caches
+     * anyway, and the biggest lists free the most bytes per spilled word.
+     *
+     * @param bytes The budget; 0 disables spilling (the default).
+     * @param spill_path Side file for spilled lists; created lazily,
+     *        truncated by clear(), removed on destruction.
+     */
+    void set_memory_budget(size_t bytes, const std::string& spill_path);
+
+    /** @brief How much the budget has pushed out to disk so far. */
+    struct SpillStats {
+        size_t words = 0; ///< Posting lists currently living on disk.
+        size_t bytes = 0; ///< Their on-disk footprint.
+    };
+
+    /** @brief Current spill counters; zeros when no budget is set. */
+    SpillStats spill_stats() const;
 
     /**
      * @brief Clears all entries from the index.
@@ -57,18 +505,214 @@ public:
     void clear();
 
     /**
-     * @brief Returns the total number of unique words in the index.
-     * This operation is thread-safe (shared lock).
+     * @brief Returns the total number of unique words in the index
+     * (spilled words included). Lock-free: reads a striped counter
+     * maintained by the insertion paths, so monitoring polls never take
+     * a shard lock. May be a moment stale while indexing runs.
      *
      * @return The number of unique words.
      */
     size_t size() const;
 
 private:
-    // The main index: maps a word to a list of its occurrences in different files.
-    // The inner map could store positions for each file_id: std::unordered_map<size_t, std::vector<size_t>>
-    // For simplicity and to use the WordOccurrence struct, we'll keep it as a vector of structs.
-    std::unordered_map<std::string, std::vector<WordOccurrence>> index_;
+    /**
+     * @brief Hashes the word bytes; also used to pick the owning shard, so
+     * shard routing and map probing agree on one hash. Delegates to
+     * Utils::TokenHash - the hash the tokenizer precomputes per token -
+     * so a hash carried in from tokenization routes the shard and probes
+     * the dictionary without the word's bytes being read again.
+     */
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view sv) const {
+            return Utils::TokenHash{}(sv);
+        }
+    };
+
+    // Power of two so the owning shard is a mask of the word's hash.
+    static constexpr size_t kNumShards = 16;
+
+    /**
+     * @brief An append-only string arena for interned dictionary keys.
+     *
+     * Every unique word's bytes are copied once into a large slab, and the
+     * map keys are string_views into the slabs - no per-word heap
+     * allocation, and dictionary bytes sit contiguously instead of
+     * scattered across thousands of small std::string blocks. Slabs are
+     * never reallocated, so interned views stay valid until clear().
+     *
+     * A thin wrapper over cds::monotonic_arena (whose slab scheme this
+     * was the prototype for), keeping the dictionary-facing vocabulary.
+     */
+    class WordArena {
+    public:
+        /** @brief Copies 'word' into the arena; the view outlives 'word'. */
+        std::string_view intern(std::string_view word) {
+            return arena_.copy(word);
+        }
+
+        /** @brief Total bytes of all slabs, for memory accounting. */
+        size_t allocated_bytes() const { return arena_.allocated_bytes(); }
+
+        /** @brief Frees all slabs; every interned view becomes dangling. */
+        void clear() { arena_.release(); }
+
+    private:
+        cds::monotonic_arena arena_;
+    };
+
+    /**
+     * @brief One independently locked partition of the index.
+     * Maps a word to a list of its occurrences in different files; keys
+     * are views into the shard's arena, interned on first insertion.
+     * Cache-line aligned so neighbouring shard locks don't false-share.
+     */
+    /**
+     * @brief Where a spilled posting list lives in the spill file; the
+     * in-memory list is replaced by this 16-byte stub.
+     */
+    struct SpilledList {
+        uint64_t offset; ///< Byte offset of the encoded run in the file.
+        uint64_t bytes;  ///< Encoded length.
+    };
+
+    struct alignas(64) Shard {
+        // Open-addressing dictionary: probes walk one flat array instead
+        // of chasing per-node pointers, which is where search spent its
+        // hottest data-dependent loads. Values are small-size-optimized
+        // posting lists: the long tail of one-or-two-occurrence words
+        // lives inline in the slot, no heap allocation at all.
+        FlatMap<std::string_view, PostingList, StringHash> words;
+        WordArena arena; ///< Owns every key's bytes; guarded by 'mutex'.
+        // Secondary dictionary: the same interned views, kept sorted so
+        // prefix queries binary-search instead of scanning hash buckets.
+        // Spilled words stay listed: they are still in the index.
+        std::vector<std::string_view> sorted_words;
+        // Posting lists evicted to the spill file by the memory budget,
+        // keyed by the same arena-backed views. Guarded by 'mutex'.
+        FlatMap<std::string_view, SpilledList, StringHash> spilled;
+        // Accounted heap bytes of this shard's maps, lists, and arena.
+        // Written under the exclusive lock; relaxed loads let the budget
+        // fast path sum usage without touching any shard lock.
+        std::atomic<size_t> bytes{0};
+        mutable std::shared_mutex mutex;
+    };
+
+    /**
+     * @brief The sorted file-ID list of one word, without decoding any
+     * position blob; feeds the AND-query intersection.
+     */
+    std::vector<size_t> file_ids_for(std::string_view word) const;
+
+    /**
+     * @brief Per-term statistics for the query planner, read straight out
+     * of the dictionary slot in O(1) under the shard's shared lock: the
+     * PostingList already knows its document frequency (size), heap bytes
+     * and largest file ID, so no separate counters are maintained.
+     */
+    struct TermStats {
+        size_t df = 0;          ///< Files containing the term.
+        size_t bytes = 0;       ///< Heap bytes of the posting list.
+        size_t max_file_id = 0; ///< Largest file ID in the list.
+        bool spilled = false;   ///< On disk; df unknown without loading.
+        bool dense = false;     ///< Carries a file-ID bitmap.
+    };
+    TermStats term_stats(std::string_view word) const;
+
+    /**
+     * @brief A copy of 'word''s file-ID bitmap, taken under the shard's
+     * shared lock; empty when the term has none (sparse or spilled).
+     */
+    std::vector<uint64_t> bitmap_for(std::string_view word) const;
+
+    /**
+     * @brief True if 'word' occurs in 'file_id': a binary search inside
+     * the dictionary slot, no list copied or decoded. The planner's
+     * rare-term strategy is built on this probe.
+     */
+    bool term_contains(std::string_view word, size_t file_id) const;
+
+    /** @brief Returns the shard that owns 'word'. */
+    Shard& shard_for(std::string_view word) {
+        return shards_[StringHash{}(word) & (kNumShards - 1)];
+    }
+    const Shard& shard_for(std::string_view word) const {
+        return shards_[StringHash{}(word) & (kNumShards - 1)];
+    }
+
+    /** @brief Adds 'tokens' to a file's length (and the corpus total). */
+    void add_document_tokens(size_t file_id, size_t tokens);
+
+    /**
+     * @brief Enforces the budget after a write: while usage exceeds it,
+     * spills the largest in-memory posting lists shard by shard until
+     * usage is back under the cap. No-op (one relaxed sum) when under.
+     */
+    void maybe_spill();
+
+    /**
+     * @brief Moves one word's list from 'shard.words' to the spill file.
+     * Called with the shard's exclusive lock held. Returns the bytes the
+     * shard's accounting should give back.
+     */
+    size_t spill_list(Shard& shard, std::string_view word,
+                      PostingList&& list);
+
+    /** @brief Reads one spilled list back; pread, so safe under any lock. */
+    std::vector<PostingCodec::PackedOccurrence>
+    load_spilled(const SpilledList& entry) const;
+
+    /**
+     * @brief Pulls a spilled word back into 'shard.words' so a writer can
+     * merge into it; no-op if the word is not spilled. Called with the
+     * shard's exclusive lock held; 'hash' is the word's StringHash, which
+     * every caller already has in hand.
+     */
+    void unspill_if_needed(Shard& shard, std::string_view word, size_t hash);
+
+    /**
+     * @brief The shared pool for parallel term lookups, created on the
+     * first query wide enough to want it - an index that only ever sees
+     * single-word queries never starts a pool thread.
+     */
+    scheduler::ThreadPool& query_pool() const;
+
+    std::array<Shard, kNumShards> shards_;
+
+    // Unique-word count across all shards (spilled words included),
+    // bumped under the owning shard's exclusive lock on first insertion.
+    // Striped so writers on different shards never share a cache line;
+    // size() sums it without touching any shard lock.
+    cds::striped_counter unique_words_;
+
+    // Lazily created by query_pool(); destroyed (workers joined) with the
+    // index. unique_ptr to an incomplete type is fine: the destructor is
+    // out of line.
+    mutable std::unique_ptr<scheduler::ThreadPool> query_pool_;
+    mutable std::once_flag query_pool_once_;
+
+    // Memory budget state. The spill file is append-only and lazily
+    // created; spill_mutex_ guards appends (and the running file size),
+    // reads go through pread and need no lock. Space freed by loading a
+    // list back in is not reclaimed until clear() truncates the file.
+    size_t memory_budget_ = 0;  ///< 0 = unlimited.
+    std::string spill_path_;
+    int spill_fd_ = -1;
+    uint64_t spill_size_ = 0;   ///< Guarded by spill_mutex_.
+    mutable std::mutex spill_mutex_;
+    std::atomic<size_t> spilled_words_{0};
+    std::atomic<size_t> spilled_bytes_{0};
+
+    // One LRU result cache per shard, probed by search() before the shard
+    // lock is touched. A write to shard i invalidates only cache i, so
+    // indexing one file doesn't cold-start the whole cache.
+    mutable std::array<QueryCache<std::vector<WordOccurrence>>, kNumShards>
+        query_caches_;
 
-    mutable std::shared_mutex mutex_; // Mutex for thread-safe access to 'index_'
+    // Per-document indexed token counts, for BM25 length normalization.
+    // Guarded separately from the shards: every merge touches it once, not
+    // once per word.
+    std::unordered_map<size_t, size_t> doc_lengths_;
+    size_t total_tokens_ = 0;
+    mutable std::shared_mutex doc_mutex_;
 };
\ No newline at end of file
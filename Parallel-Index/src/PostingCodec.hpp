@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Compressed posting-list storage: ascending position lists are
+ * delta-encoded and LEB128-varint-packed into byte blobs.
+ *
+ * Positions within a file are small ascending integers, so their deltas
+ * almost always fit one or two bytes instead of the eight a raw size_t
+ * costs - a 5-8x reduction on text corpora, and far fewer cache lines
+ * touched per posting. Blobs are decoded lazily: only when a query
+ * actually asks for a word's positions.
+ */
+namespace PostingCodec {
+
+    /**
+     * @brief One word's occurrences in one file, positions compressed.
+     * This is the index's internal posting representation; the snapshot
+     * stores these blobs verbatim.
+     */
+    struct PackedOccurrence {
+        size_t file_id;
+        size_t position_count;               ///< Decoded length of the blob.
+        size_t last_position;                ///< Tail value, for O(1) appends.
+        std::vector<uint8_t> packed_positions; ///< Delta-varint byte stream.
+    };
+
+    /** @brief Appends 'value' to 'out' as an LEB128 varint (7 bits/byte).
+     *  Templated on the byte vector so arena-backed buffers (the
+     *  tokenize-time encoder in LocalIndex) use it too. */
+    template <class ByteVector>
+    inline void encode_varint(ByteVector& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    /** @brief Decodes one varint, advancing 'p' past it. */
+    inline uint64_t decode_varint(const uint8_t*& p) {
+        uint64_t value = 0;
+        unsigned shift = 0;
+        while (*p & 0x80) {
+            value |= static_cast<uint64_t>(*p & 0x7F) << shift;
+            shift += 7;
+            ++p;
+        }
+        value |= static_cast<uint64_t>(*p) << shift;
+        ++p;
+        return value;
+    }
+
+    /**
+     * @brief Compresses an ascending position list for one file.
+     * @param file_id The file the positions belong to.
+     * @param positions Byte offsets, ascending (the indexing pipeline emits
+     *        them in scan order, which guarantees this).
+     */
+    inline PackedOccurrence pack_positions(size_t file_id,
+                                           const size_t* positions,
+                                           size_t count) {
+        PackedOccurrence occ;
+        occ.file_id = file_id;
+        occ.position_count = count;
+        occ.last_position = count == 0 ? 0 : positions[count - 1];
+        occ.packed_positions.reserve(count * 2);
+        size_t previous = 0;
+        for (size_t i = 0; i < count; ++i) {
+            encode_varint(occ.packed_positions, positions[i] - previous);
+            previous = positions[i];
+        }
+        return occ;
+    }
+
+    /** @brief Vector convenience; the indexer's arena-backed position
+     *  vectors go through the pointer form above. */
+    inline PackedOccurrence pack_positions(size_t file_id,
+                                           const std::vector<size_t>& positions) {
+        return pack_positions(file_id, positions.data(), positions.size());
+    }
+
+    /**
+     * @brief Appends one more position (>= the current last) to a blob.
+     */
+    inline void append_position(PackedOccurrence& occ, size_t position) {
+        const size_t previous = occ.position_count == 0 ? 0 : occ.last_position;
+        encode_varint(occ.packed_positions, position - previous);
+        occ.last_position = position;
+        ++occ.position_count;
+    }
+
+    /** @brief Decodes a raw delta-varint blob back into positions. */
+    inline std::vector<size_t> unpack_positions(const uint8_t* blob,
+                                                size_t position_count) {
+        std::vector<size_t> positions;
+        positions.reserve(position_count);
+        size_t previous = 0;
+        for (size_t i = 0; i < position_count; ++i) {
+            previous += decode_varint(blob);
+            positions.push_back(previous);
+        }
+        return positions;
+    }
+
+    /** @brief Decodes a blob back into raw positions. */
+    inline std::vector<size_t> unpack_positions(const PackedOccurrence& occ) {
+        return unpack_positions(occ.packed_positions.data(), occ.position_count);
+    }
+
+    /**
+     * @brief Lazily-decoded position list: iteration decodes the delta
+     * varints in place, one value at a time, so a caller that only counts
+     * hits or looks at the first position never allocates. The underlying
+     * blob must outlive the range (see InvertedIndex::ResultView for the
+     * lifetime contract on the query path).
+     */
+    class PositionRange {
+    public:
+        class iterator {
+        public:
+            using value_type = size_t;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::input_iterator_tag;
+
+            size_t operator*() const { return value_; }
+            iterator& operator++() {
+                if (--remaining_ != 0) {
+                    value_ += decode_varint(p_);
+                }
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+            bool operator==(const iterator& other) const {
+                return remaining_ == other.remaining_;
+            }
+            bool operator!=(const iterator& other) const {
+                return remaining_ != other.remaining_;
+            }
+
+        private:
+            friend class PositionRange;
+            iterator(const uint8_t* p, size_t remaining)
+                : p_(p), remaining_(remaining) {
+                if (remaining_ != 0) {
+                    value_ = decode_varint(p_);
+                }
+            }
+
+            const uint8_t* p_ = nullptr;
+            size_t remaining_ = 0;
+            size_t value_ = 0;
+        };
+
+        PositionRange() = default;
+        PositionRange(const uint8_t* blob, size_t count)
+            : blob_(blob), count_(count) {}
+
+        size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+        iterator begin() const { return iterator(blob_, count_); }
+        iterator end() const { return iterator(nullptr, 0); }
+
+        /** @brief The opt-in copy: decodes the whole list into a vector. */
+        std::vector<size_t> materialize() const {
+            return unpack_positions(blob_, count_);
+        }
+
+    private:
+        const uint8_t* blob_ = nullptr;
+        size_t count_ = 0;
+    };
+
+} // namespace PostingCodec
@@ -0,0 +1,397 @@
+#pragma once
+
+#include "PostingCodec.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <vector>
+
+/**
+ * @brief A small-size-optimized posting list for one dictionary word.
+ *
+ * The long tail dominates real dictionaries: most terms occur in one or
+ * two files, yet a std::vector<PackedOccurrence> charges each of them a
+ * heap allocation for the vector plus one per compressed blob - two
+ * allocations and two pointer chases to read a couple of positions. Here
+ * up to two occurrences with short blobs live inline in the dictionary
+ * slot itself (no heap at all); a term that outgrows the inline capacity
+ * is promoted once to the familiar vector-of-PackedOccurrence form and
+ * stays there.
+ *
+ * The opposite end of the distribution gets the opposite treatment: a
+ * promoted list that grows dense over the file-ID space (boilerplate
+ * terms in >~6% of files) additionally maintains a file-ID bitmap next
+ * to its occurrence vector. Membership probes become one bit test, and
+ * AND queries over dense terms can intersect word-at-a-time instead of
+ * merging lists. The bitmap only covers file IDs - positions stay in the
+ * per-occurrence compressed blobs, which phrase queries keep using
+ * unchanged.
+ *
+ * Occurrences are kept sorted by file_id in both forms, same as before.
+ * Readers go through at()/size(); writers use slot_for()/file_at() to
+ * find the sorted slot and insert()/append_position()/replace() to
+ * mutate it. Not thread-safe; guarded by the owning shard's lock like
+ * the value it replaces.
+ */
+class PostingList {
+    /** @brief One inline occurrence: fixed-capacity blob, no heap. */
+    struct InlineEntry {
+        uint64_t file_id;
+        uint64_t last_position;
+        uint16_t position_count;
+        uint8_t blob_size;
+        uint8_t blob[16];
+    };
+    static constexpr size_t kInlineEntries = 2;
+    static constexpr size_t kInlineBlobBytes = sizeof(InlineEntry::blob);
+    static constexpr size_t kInlineMaxPositions = UINT16_MAX;
+
+    /** @brief A list this long is considered for the bitmap... */
+    static constexpr size_t kBitmapMinEntries = 1024;
+    /** @brief ...once at least one file ID in kBitmapSparsity is present
+     *  (entries * sparsity >= max file ID). */
+    static constexpr size_t kBitmapSparsity = 16;
+
+    /** @brief The promoted form: occurrence vector plus the (possibly
+     *  empty) dense-term bitmap. Fits the union alongside the inline
+     *  entries. */
+    struct HeapForm {
+        std::vector<PostingCodec::PackedOccurrence> occurrences;
+        std::vector<uint64_t> bitmap; ///< Empty until the list is dense.
+    };
+
+public:
+    /** @brief Read-only view of one occurrence, either representation. */
+    struct View {
+        size_t file_id;
+        size_t position_count;
+        size_t last_position;
+        const uint8_t* blob;
+        size_t blob_size;
+    };
+
+    PostingList() = default;
+
+    /**
+     * @brief Adopts a complete occurrence list (snapshot restore, spill
+     * load); stays inline when it fits, otherwise takes the vector over.
+     */
+    explicit PostingList(std::vector<PostingCodec::PackedOccurrence>&& occurrences) {
+        bool fits = occurrences.size() <= kInlineEntries;
+        for (const auto& occ : occurrences) {
+            fits = fits && occ.packed_positions.size() <= kInlineBlobBytes &&
+                   occ.position_count <= kInlineMaxPositions;
+        }
+        if (fits) {
+            for (const auto& occ : occurrences) {
+                store_inline(inline_count_++, occ);
+            }
+        } else {
+            new (&storage_.heap) HeapForm{std::move(occurrences), {}};
+            heap_mode_ = true;
+            maybe_build_bitmap();
+        }
+    }
+
+    PostingList(PostingList&& other) noexcept { adopt(std::move(other)); }
+    PostingList& operator=(PostingList&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            adopt(std::move(other));
+        }
+        return *this;
+    }
+    PostingList(const PostingList& other) { clone(other); }
+    PostingList& operator=(const PostingList& other) {
+        if (this != &other) {
+            destroy();
+            clone(other);
+        }
+        return *this;
+    }
+    ~PostingList() { destroy(); }
+
+    size_t size() const {
+        return heap_mode_ ? storage_.heap.occurrences.size() : inline_count_;
+    }
+    bool empty() const { return size() == 0; }
+
+    /** @brief The sorted position for 'file_id' (lower_bound semantics). */
+    size_t slot_for(size_t file_id) const {
+        const size_t count = size();
+        size_t slot = 0;
+        while (slot < count && at(slot).file_id < file_id) {
+            ++slot;
+        }
+        return slot;
+    }
+
+    /** @brief True if 'slot' holds an occurrence for exactly 'file_id'. */
+    bool file_at(size_t slot, size_t file_id) const {
+        return slot < size() && at(slot).file_id == file_id;
+    }
+
+    /** @brief True if the list has an occurrence for 'file_id': one bit
+     *  test when the dense bitmap is up, binary search in the vector
+     *  form, a scan of the (<= 2) inline entries otherwise. Feeds the
+     *  AND-query planner's rare-term probes. */
+    bool contains(size_t file_id) const {
+        if (heap_mode_) {
+            const HeapForm& heap = storage_.heap;
+            if (!heap.bitmap.empty()) {
+                const size_t word = file_id / 64;
+                return word < heap.bitmap.size() &&
+                       (heap.bitmap[word] >> (file_id % 64)) & 1u;
+            }
+            const auto it = std::lower_bound(
+                heap.occurrences.begin(), heap.occurrences.end(), file_id,
+                [](const PostingCodec::PackedOccurrence& occ, size_t id) {
+                    return occ.file_id < id;
+                });
+            return it != heap.occurrences.end() && it->file_id == file_id;
+        }
+        for (size_t i = 0; i < inline_count_; ++i) {
+            if (storage_.inline_entries[i].file_id == file_id) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** @brief The largest file_id in the list (lists are sorted); 0 when
+     *  empty. Bounds the planner's counting-scan allocation. */
+    size_t max_file_id() const {
+        const size_t count = size();
+        return count == 0 ? 0 : at(count - 1).file_id;
+    }
+
+    /** @brief The dense-term file-ID bitmap (64 IDs per word, LSB
+     *  first), or nullptr while the list is sparse. */
+    const std::vector<uint64_t>* bitmap() const {
+        return heap_mode_ && !storage_.heap.bitmap.empty()
+                   ? &storage_.heap.bitmap
+                   : nullptr;
+    }
+
+    /** @brief Occurrence 'index'; the blob pointer is valid until the next
+     *  mutation (or move) of this list. */
+    View at(size_t index) const {
+        if (heap_mode_) {
+            const PostingCodec::PackedOccurrence& occ =
+                storage_.heap.occurrences[index];
+            return {occ.file_id, occ.position_count, occ.last_position,
+                    occ.packed_positions.data(), occ.packed_positions.size()};
+        }
+        const InlineEntry& entry = storage_.inline_entries[index];
+        return {entry.file_id, entry.position_count, entry.last_position,
+                entry.blob, entry.blob_size};
+    }
+
+    /** @brief Inserts a new occurrence at its sorted slot; promotes to the
+     *  vector form when the inline capacity or blob size is exceeded. */
+    void insert(size_t slot, PostingCodec::PackedOccurrence&& occ) {
+        if (!heap_mode_) {
+            if (inline_count_ < kInlineEntries &&
+                occ.packed_positions.size() <= kInlineBlobBytes &&
+                occ.position_count <= kInlineMaxPositions) {
+                for (size_t i = inline_count_; i > slot; --i) {
+                    storage_.inline_entries[i] = storage_.inline_entries[i - 1];
+                }
+                ++inline_count_;
+                store_inline(slot, occ);
+                return;
+            }
+            promote();
+        }
+        const size_t file_id = occ.file_id;
+        storage_.heap.occurrences.insert(
+            storage_.heap.occurrences.begin() +
+                static_cast<std::ptrdiff_t>(slot),
+            std::move(occ));
+        if (!storage_.heap.bitmap.empty()) {
+            set_bit(file_id);
+        } else {
+            maybe_build_bitmap();
+        }
+    }
+
+    /** @brief Appends one position (>= the entry's last) to the occurrence
+     *  at 'slot', promoting if the inline blob runs out of room. */
+    void append_position(size_t slot, size_t position) {
+        if (!heap_mode_) {
+            InlineEntry& entry = storage_.inline_entries[slot];
+            const size_t previous =
+                entry.position_count == 0 ? 0 : entry.last_position;
+            uint8_t delta[10];
+            size_t delta_size = 0;
+            uint64_t value = position - previous;
+            while (value >= 0x80) {
+                delta[delta_size++] = static_cast<uint8_t>(value) | 0x80;
+                value >>= 7;
+            }
+            delta[delta_size++] = static_cast<uint8_t>(value);
+            if (entry.blob_size + delta_size <= kInlineBlobBytes &&
+                entry.position_count < kInlineMaxPositions) {
+                std::memcpy(entry.blob + entry.blob_size, delta, delta_size);
+                entry.blob_size += static_cast<uint8_t>(delta_size);
+                entry.last_position = position;
+                ++entry.position_count;
+                return;
+            }
+            promote();
+        }
+        // Same file, new position: the bitmap is unaffected.
+        PostingCodec::append_position(storage_.heap.occurrences[slot],
+                                      position);
+    }
+
+    /** @brief Copies the occurrence at 'slot' out in packed form (for the
+     *  chunk-merge round trip). */
+    PostingCodec::PackedOccurrence extract(size_t slot) const {
+        const View view = at(slot);
+        PostingCodec::PackedOccurrence occ;
+        occ.file_id = view.file_id;
+        occ.position_count = view.position_count;
+        occ.last_position = view.last_position;
+        occ.packed_positions.assign(view.blob, view.blob + view.blob_size);
+        return occ;
+    }
+
+    /** @brief Replaces the occurrence at 'slot' (same file_id) wholesale. */
+    void replace(size_t slot, PostingCodec::PackedOccurrence&& occ) {
+        if (!heap_mode_) {
+            if (occ.packed_positions.size() <= kInlineBlobBytes &&
+                occ.position_count <= kInlineMaxPositions) {
+                store_inline(slot, occ);
+                return;
+            }
+            promote();
+        }
+        // Same file_id by contract, so the bitmap is unaffected.
+        storage_.heap.occurrences[slot] = std::move(occ);
+    }
+
+    /** @brief The vector form, or nullptr while the list is still inline
+     *  (callers materialize() instead - snapshot save, spilling). */
+    const std::vector<PostingCodec::PackedOccurrence>* heap_list() const {
+        return heap_mode_ ? &storage_.heap.occurrences : nullptr;
+    }
+
+    /** @brief A packed copy of the whole list, whichever form it is in. */
+    std::vector<PostingCodec::PackedOccurrence> materialize() const {
+        if (heap_mode_) {
+            return storage_.heap.occurrences;
+        }
+        std::vector<PostingCodec::PackedOccurrence> list;
+        list.reserve(inline_count_);
+        for (size_t i = 0; i < inline_count_; ++i) {
+            list.push_back(extract(i));
+        }
+        return list;
+    }
+
+    /** @brief Heap bytes this list owns; 0 while inline - which is the
+     *  whole point for the long tail. */
+    size_t allocated_bytes() const {
+        if (!heap_mode_) {
+            return 0;
+        }
+        size_t bytes = storage_.heap.occurrences.capacity() *
+                           sizeof(PostingCodec::PackedOccurrence) +
+                       storage_.heap.bitmap.capacity() * sizeof(uint64_t);
+        for (const auto& occ : storage_.heap.occurrences) {
+            bytes += occ.packed_positions.capacity();
+        }
+        return bytes;
+    }
+
+private:
+    /** @brief Writes 'occ' into inline entry 'slot' (must fit). */
+    void store_inline(size_t slot, const PostingCodec::PackedOccurrence& occ) {
+        InlineEntry& entry = storage_.inline_entries[slot];
+        entry.file_id = occ.file_id;
+        entry.last_position = occ.last_position;
+        entry.position_count = static_cast<uint16_t>(occ.position_count);
+        entry.blob_size = static_cast<uint8_t>(occ.packed_positions.size());
+        std::memcpy(entry.blob, occ.packed_positions.data(),
+                    occ.packed_positions.size());
+    }
+
+    /** @brief Marks 'file_id' present, growing the bitmap as file IDs
+     *  climb (they are handed out by one monotonic counter). */
+    void set_bit(size_t file_id) {
+        std::vector<uint64_t>& bitmap = storage_.heap.bitmap;
+        const size_t word = file_id / 64;
+        if (word >= bitmap.size()) {
+            bitmap.resize(word + 1, 0);
+        }
+        bitmap[word] |= uint64_t{1} << (file_id % 64);
+    }
+
+    /** @brief Builds the bitmap once the list is both long and dense:
+     *  below the density bound the bitmap would be mostly zero words and
+     *  a binary search beats streaming them. One-way, like promote(). */
+    void maybe_build_bitmap() {
+        const std::vector<PostingCodec::PackedOccurrence>& occurrences =
+            storage_.heap.occurrences;
+        if (occurrences.size() < kBitmapMinEntries ||
+            occurrences.back().file_id >=
+                occurrences.size() * kBitmapSparsity) {
+            return;
+        }
+        storage_.heap.bitmap.assign(occurrences.back().file_id / 64 + 1, 0);
+        for (const auto& occ : occurrences) {
+            storage_.heap.bitmap[occ.file_id / 64] |=
+                uint64_t{1} << (occ.file_id % 64);
+        }
+    }
+
+    /** @brief One-way switch to the vector form. */
+    void promote() {
+        std::vector<PostingCodec::PackedOccurrence> list = materialize();
+        new (&storage_.heap) HeapForm{std::move(list), {}};
+        heap_mode_ = true;
+        inline_count_ = 0;
+    }
+
+    void adopt(PostingList&& other) noexcept {
+        heap_mode_ = other.heap_mode_;
+        inline_count_ = other.inline_count_;
+        if (heap_mode_) {
+            new (&storage_.heap) HeapForm(std::move(other.storage_.heap));
+        } else {
+            storage_.inline_entries = other.storage_.inline_entries;
+        }
+    }
+
+    void clone(const PostingList& other) {
+        heap_mode_ = other.heap_mode_;
+        inline_count_ = other.inline_count_;
+        if (heap_mode_) {
+            new (&storage_.heap) HeapForm(other.storage_.heap);
+        } else {
+            storage_.inline_entries = other.storage_.inline_entries;
+        }
+    }
+
+    void destroy() {
+        if (heap_mode_) {
+            storage_.heap.~HeapForm();
+            heap_mode_ = false;
+        }
+        inline_count_ = 0;
+    }
+
+    /** @brief Inline entries and the promoted form share storage; the
+     *  active member is tracked by heap_mode_. */
+    union Storage {
+        Storage() : inline_entries() {}
+        ~Storage() {}
+        std::array<InlineEntry, kInlineEntries> inline_entries;
+        HeapForm heap;
+    } storage_;
+    bool heap_mode_ = false;
+    uint8_t inline_count_ = 0;
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief A small LRU cache of query results, keyed by the query string.
+ *
+ * Query logs are heavily skewed - a handful of hot terms dominate - so
+ * serving repeats from a cache avoids re-walking the index (and its shard
+ * lock) for most traffic. The cache is guarded by its own plain mutex,
+ * held only for the map probe and recency splice; the cached value is
+ * copied out so the caller never holds the lock.
+ *
+ * The owner is responsible for invalidation: call invalidate() whenever
+ * the data the cached results were computed from changes. One QueryCache
+ * per index shard keeps that invalidation cheap and local - a write to
+ * one shard only empties that shard's cache.
+ *
+ * @tparam Value The cached result type (e.g. a vector of occurrences).
+ */
+template <typename Value>
+class QueryCache {
+public:
+    /** @param capacity The most entries kept before LRU eviction. */
+    explicit QueryCache(size_t capacity = 64) : capacity_(capacity) {}
+
+    // The mutex makes the cache non-copyable and non-movable.
+    QueryCache(const QueryCache&) = delete;
+    QueryCache& operator=(const QueryCache&) = delete;
+
+    /**
+     * @brief Probes the cache and refreshes the entry's recency on a hit.
+     * @param query The query string to look up.
+     * @param out Receives a copy of the cached value on a hit.
+     * @return True on a hit; false (and 'out' untouched) on a miss.
+     */
+    bool lookup(std::string_view query, Value& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = map_.find(query);
+        if (it == map_.end()) {
+            ++misses_;
+            return false;
+        }
+        // Most recently used entries live at the front.
+        entries_.splice(entries_.begin(), entries_, it->second);
+        out = entries_.front().second;
+        ++hits_;
+        return true;
+    }
+
+    /**
+     * @brief Inserts (or refreshes) a query's result, evicting the least
+     * recently used entry when over capacity.
+     * @param query The query string; copied into the cache.
+     * @param value The result to cache; moved in.
+     */
+    void insert(std::string_view query, Value value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = map_.find(query);
+        if (it != map_.end()) {
+            entries_.splice(entries_.begin(), entries_, it->second);
+            entries_.front().second = std::move(value);
+            return;
+        }
+        entries_.emplace_front(std::string(query), std::move(value));
+        // The key view points into the list node's string; std::list nodes
+        // never move, so the view stays valid until the entry is erased.
+        map_.emplace(entries_.front().first, entries_.begin());
+        if (entries_.size() > capacity_) {
+            map_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+    }
+
+    /** @brief Drops every entry (the underlying data changed). */
+    void invalidate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        map_.clear();
+        entries_.clear();
+    }
+
+    /** @brief Queries answered from the cache so far. */
+    size_t hits() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hits_;
+    }
+
+    /** @brief Queries that had to fall through to the index so far. */
+    size_t misses() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return misses_;
+    }
+
+private:
+    /** @brief Transparent hash so lookups probe with a string_view. */
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view sv) const {
+            return std::hash<std::string_view>{}(sv);
+        }
+    };
+
+    using Entry = std::pair<std::string, Value>;
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_; ///< Front = most recently used.
+    std::unordered_map<std::string_view, typename std::list<Entry>::iterator,
+                       StringHash, std::equal_to<>>
+        map_; ///< Keys view the list nodes' strings.
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+    const size_t capacity_;
+};
@@ -0,0 +1,283 @@
+#include "ReaderWorker.hpp"
+#include <algorithm> // For std::min (slice clamping)
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap, madvise
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For close
+#endif
+
+namespace {
+    /**
+     * @brief Files at or above this size are memory-mapped instead of read
+     * through an ifstream. Below it the fixed cost of mmap/munmap (page table
+     * setup, TLB shootdown on unmap) outweighs the copy it avoids.
+     */
+    constexpr size_t kMmapThreshold = 64 * 1024;
+
+    /** @brief How many files a reader claims per queue wakeup. */
+    constexpr size_t kPopBatch = 8;
+
+    /**
+     * @brief Submission-queue depth of each reader's io_uring, and how many
+     * files it claims per wakeup when the ring is available. Small-file
+     * corpora are dominated by per-file syscall overhead, so the batch is
+     * sized to hand the device a full queue in one submission.
+     */
+    constexpr size_t kUringDepth = 64;
+}
+
+/**
+ * @brief Constructs a ReaderWorker.
+ * @param file_queue The scanner's queue of files to load.
+ * @param content_queue The queue of loaded payloads for the indexers.
+ * @param buffer_pool The shared pool of recycled read buffers.
+ */
+ReaderWorker::ReaderWorker(ConcurrentQueue<FileInfo>& file_queue,
+                           ConcurrentQueue<FileContent>& content_queue,
+                           BufferPool& buffer_pool, WorkerCounters& counters)
+    : file_queue_(file_queue), content_queue_(content_queue),
+      buffer_pool_(buffer_pool), counters_(counters),
+      uring_(static_cast<unsigned>(kUringDepth)) {}
+
+/**
+ * @brief The main execution logic for the reader thread.
+ */
+void ReaderWorker::operator()(std::stop_token stop) {
+    stop_ = std::move(stop);
+    std::vector<FileInfo> batch;
+    // With a working ring, claim a full submission queue's worth per
+    // wakeup so one io_uring_enter covers the whole batch.
+    const size_t pop_batch = uring_.available() ? kUringDepth : kPopBatch;
+    std::cout << "[Reader " << std::this_thread::get_id() << "] Starting..." << std::endl;
+    while (true) {
+        bool popped;
+        {
+            // Attribute time spent waiting for the scanner to the queue.
+            ScopedWaitTimer timer(counters_.queue_wait_ns);
+            popped = file_queue_.wait_and_pop_bulk(batch, pop_batch, stop_);
+        }
+        if (!popped) {
+            break;
+        }
+        read_batch(batch);
+    }
+    if (stop_.stop_requested()) {
+        std::cout << "[Reader " << std::this_thread::get_id()
+                  << "] Stopping; leaving queued files unread." << std::endl;
+    } else {
+        std::cout << "[Reader " << std::this_thread::get_id() << "] Exiting. Queue closed and empty." << std::endl;
+    }
+}
+
+/**
+ * @brief Loads one popped batch.
+ *
+ * Small files (the pooled-buffer population) are opened up front and
+ * their reads batch-submitted through the ring: one syscall hands the
+ * device every read at once, instead of a queue depth of one per file.
+ * Large payloads keep the mmap path - the kernel already fetches those
+ * pages asynchronously on first touch. Without a usable ring everything
+ * goes through the synchronous per-file path unchanged.
+ *
+ * @param batch The popped FileInfo entries.
+ */
+void ReaderWorker::read_batch(const std::vector<FileInfo>& batch) {
+#if defined(__linux__)
+    if (uring_.available()) {
+        std::vector<UringReader::Request> requests;
+        std::vector<FileContent> payloads;
+        requests.reserve(batch.size());
+        // Reserved up front: requests hold pointers into these buffers, so
+        // the vector must never reallocate while a read is in flight.
+        payloads.reserve(batch.size());
+
+        for (const FileInfo& file_info : batch) {
+            // Expected payload from scan-time metadata; the read result is
+            // the ground truth if the file shrank meanwhile.
+            const uint64_t end =
+                file_info.length == 0
+                    ? file_info.size
+                    : std::min<uint64_t>(file_info.offset + file_info.length,
+                                         file_info.size);
+            const uint64_t payload =
+                end > file_info.offset ? end - file_info.offset : 0;
+            if (payload >= kMmapThreshold) {
+                read_file(file_info); // mmap path, unchanged.
+                continue;
+            }
+            const int fd = ::open(file_info.path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                std::cerr << "[Reader Error] Could not open file: "
+                          << file_info.path << std::endl;
+                continue;
+            }
+            FileContent content;
+            content.info = file_info;
+            content.buffer = buffer_pool_.acquire(payload);
+            content.buffer.resize(payload);
+            payloads.push_back(std::move(content));
+            requests.push_back({fd, file_info.offset,
+                                payloads.back().buffer.data(),
+                                static_cast<unsigned>(payload), 0});
+        }
+        if (requests.empty()) {
+            return;
+        }
+
+        if (!uring_.read_batch(requests)) {
+            // Submission failed outright; redo these files synchronously.
+            for (size_t i = 0; i < requests.size(); ++i) {
+                ::close(requests[i].fd);
+                buffer_pool_.release(std::move(payloads[i].buffer));
+                read_file(payloads[i].info);
+            }
+            return;
+        }
+
+        for (size_t i = 0; i < requests.size(); ++i) {
+            ::close(requests[i].fd);
+            FileContent& content = payloads[i];
+            if (requests[i].result < 0) {
+                std::cerr << "[Reader Error] Read failed for file: "
+                          << content.info.path << std::endl;
+                buffer_pool_.release(std::move(content.buffer));
+                continue;
+            }
+            content.buffer.resize(static_cast<size_t>(requests[i].result));
+            counters_.files.fetch_add(1, std::memory_order_relaxed);
+            counters_.bytes.fetch_add(content.buffer.size(),
+                                      std::memory_order_relaxed);
+            deliver(std::move(content));
+        }
+        return;
+    }
+#endif
+    for (const FileInfo& file_info : batch) {
+        read_file(file_info);
+    }
+}
+
+/**
+ * @brief Loads one file slice into a FileContent payload and enqueues it.
+ *
+ * Large payloads are memory-mapped so tokenization later runs directly
+ * over the page cache; small ones are read into a pooled buffer. Either
+ * way the payload's bytes stay valid until the indexer stage releases
+ * them. The FileInfo's [offset, offset+length) slice is honoured (a chunk
+ * of a split file); length 0 means "through end of file".
+ *
+ * @param file_info The file slice to load.
+ */
+void ReaderWorker::read_file(const FileInfo& file_info) {
+    FileContent content;
+    content.info = file_info;
+
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = ::open(file_info.path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "[Reader Error] Could not open file: " << file_info.path << std::endl;
+        return;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0) {
+        // Clamp the slice to the file's current size; it may have shrunk
+        // since the scanner stat'd it.
+        const size_t file_size = static_cast<size_t>(st.st_size);
+        const size_t begin = std::min<size_t>(file_info.offset, file_size);
+        const size_t end =
+            file_info.length == 0
+                ? file_size
+                : std::min<size_t>(file_info.offset + file_info.length, file_size);
+        const size_t payload = end - begin;
+
+        if (payload >= kMmapThreshold) {
+            // mmap offsets must be page-aligned; map from the enclosing
+            // page boundary and skip the leading bytes when viewing.
+            const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            const size_t map_start = begin & ~(page - 1);
+            const size_t map_length = (begin - map_start) + payload;
+            // PROT_WRITE on a private mapping is copy-on-write: the
+            // indexer's in-place case-fold pass dirties private pages
+            // without ever touching the file.
+            void* mapping = ::mmap(nullptr, map_length, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE, fd, static_cast<off_t>(map_start));
+            if (mapping != MAP_FAILED) {
+                // The whole slice will be scanned front to back exactly once.
+                ::madvise(mapping, map_length, MADV_SEQUENTIAL);
+                ::close(fd);
+                content.mapped = static_cast<char*>(mapping);
+                content.mapped_length = map_length;
+                content.mapped_skip = begin - map_start;
+                counters_.files.fetch_add(1, std::memory_order_relaxed);
+                counters_.bytes.fetch_add(payload, std::memory_order_relaxed);
+                deliver(std::move(content));
+                return;
+            }
+            // mmap can fail (e.g. address space pressure); fall through to
+            // the read path rather than dropping the slice.
+        }
+    }
+    ::close(fd);
+#endif
+
+    std::ifstream file(file_info.path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[Reader Error] Could not open file: " << file_info.path << std::endl;
+        return;
+    }
+    content.buffer = buffer_pool_.acquire(file_info.length);
+    if (file_info.offset > 0) {
+        file.seekg(static_cast<std::streamoff>(file_info.offset));
+    }
+    if (file_info.length > 0) {
+        content.buffer.resize(file_info.length);
+        file.read(content.buffer.data(),
+                  static_cast<std::streamsize>(file_info.length));
+        content.buffer.resize(static_cast<size_t>(std::max<std::streamsize>(
+            0, file.gcount())));
+    } else {
+        content.buffer.assign((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+    }
+    counters_.files.fetch_add(1, std::memory_order_relaxed);
+    counters_.bytes.fetch_add(content.buffer.size(), std::memory_order_relaxed);
+    deliver(std::move(content));
+}
+
+/**
+ * @brief Hands one loaded payload to the indexer stage.
+ *
+ * The plain push would be enough until a stop request: the indexers
+ * carry the same token and may have exited with the bounded content
+ * queue still full, which would park this thread on it forever. The
+ * stop-aware push backs out instead; the payload's bytes are released
+ * here and its path recorded so main can prune it from the manifest
+ * (a file listed but never indexed would otherwise be skipped by every
+ * future incremental scan).
+ *
+ * @param content The loaded payload; consumed either way.
+ */
+void ReaderWorker::deliver(FileContent&& content) {
+    {
+        // A full content queue means the indexers are behind; count the
+        // backpressure as queue wait.
+        ScopedWaitTimer timer(counters_.queue_wait_ns);
+        if (content_queue_.push(content, stop_)) {
+            return;
+        }
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    if (content.mapped != nullptr) {
+        ::munmap(content.mapped, content.mapped_length);
+        content.mapped = nullptr;
+    }
+#endif
+    buffer_pool_.release(std::move(content.buffer));
+    dropped_paths_.push_back(content.info.path);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "ConcurrentQueue.hpp"
+#include "FileContent.hpp"
+#include "FileInfo.hpp"
+#include "IndexingStats.hpp"
+#include "UringReader.hpp"
+#include <iostream> // For std::cerr
+#include <stop_token>
+#include <vector>
+
+/**
+ * @brief The I/O stage of the indexing pipeline.
+ *
+ * Reader threads pull FileInfo entries from the scanner's queue, load each
+ * file's bytes (pooled buffer for small files, mmap for large ones), and
+ * push FileContent payloads to the tokenizer/indexer stage. Splitting the
+ * stages lets the I/O-bound and CPU-bound halves of indexing saturate
+ * independently: readers block on the disk while indexers chew through
+ * already-loaded bytes, instead of every thread alternating between the
+ * two. The content queue is bounded, so readers throttle to indexing
+ * speed rather than buffering the whole corpus.
+ */
+class ReaderWorker {
+public:
+    /**
+     * @brief Constructs a ReaderWorker.
+     * @param file_queue The scanner's queue of files to load.
+     * @param content_queue The queue of loaded payloads for the indexers.
+     * @param buffer_pool The shared pool of recycled read buffers.
+     * @param counters This thread's throughput counter slot.
+     */
+    ReaderWorker(ConcurrentQueue<FileInfo>& file_queue,
+                 ConcurrentQueue<FileContent>& content_queue,
+                 BufferPool& buffer_pool, WorkerCounters& counters);
+
+    // No copying or moving
+    ReaderWorker(const ReaderWorker&) = delete;
+    ReaderWorker& operator=(const ReaderWorker&) = delete;
+    ReaderWorker(ReaderWorker&&) = delete;
+    ReaderWorker& operator=(ReaderWorker&&) = delete;
+
+    /**
+     * @brief The main execution logic for the reader thread.
+     * Loads files until the file queue is closed and empty. The caller
+     * closes the content queue once every reader has been joined.
+     * @param stop Optional cancellation token: once signalled the worker
+     *        finishes the batch it already popped and exits without
+     *        taking more files - the skipped I/O is the bulk of what a
+     *        cancelled run saves. Leftover queue entries are the
+     *        caller's to sweep.
+     */
+    void operator()(std::stop_token stop = {});
+
+    /**
+     * @brief Files this worker loaded but could not hand off because the
+     * run was stopped (their bytes have been released). The caller must
+     * drop them from the manifest, or future incremental scans would
+     * treat them as already indexed. Valid after the thread is joined.
+     */
+    const std::vector<std::string>& dropped_paths() const {
+        return dropped_paths_;
+    }
+
+private:
+    ConcurrentQueue<FileInfo>& file_queue_;       ///< Files to load.
+    ConcurrentQueue<FileContent>& content_queue_; ///< Loaded payloads out.
+    BufferPool& buffer_pool_;                     ///< Recycled read buffers.
+    WorkerCounters& counters_;                    ///< This thread's stats slot.
+    UringReader uring_;                           ///< Per-thread ring; may be unavailable.
+    std::stop_token stop_;                        ///< This run's cancellation token.
+    std::vector<std::string> dropped_paths_;      ///< Loaded but undeliverable (stop).
+
+    /**
+     * @brief Hands one loaded payload to the indexer stage. On a stop
+     * the push backs out instead of blocking on a full queue (the
+     * indexers may already be gone); the payload's bytes are released
+     * and its path recorded in dropped_paths_.
+     * @param content The loaded payload; consumed either way.
+     */
+    void deliver(FileContent&& content);
+
+    /**
+     * @brief Loads one file into a FileContent payload and enqueues it.
+     * @param file_info The file to load.
+     */
+    void read_file(const FileInfo& file_info);
+
+    /**
+     * @brief Loads a whole popped batch: small files are batch-submitted
+     * through the io_uring so the device sees them all at once, large
+     * ones take the mmap path as before. Falls back to read_file when the
+     * ring is unavailable or a submission fails.
+     * @param batch The popped FileInfo entries.
+     */
+    void read_batch(const std::vector<FileInfo>& batch);
+};
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Minimal streaming JSON writer for the stats export.
+ *
+ * Appends to a caller-owned string; no DOM, no allocation beyond the
+ * output's own growth. Supports exactly what the stats document needs:
+ * nested objects and number/string fields. Keys are emitted in call
+ * order, string values are escaped, and commas are managed per nesting
+ * level - a provider just calls field() and the punctuation comes out
+ * right.
+ */
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : out_(out) {}
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    /** @brief Opens an anonymous object (the document root). */
+    void begin_object() {
+        out_ += '{';
+        first_.push_back(true);
+    }
+
+    /** @brief Opens a named nested object: '"name": {'. */
+    void begin_object(std::string_view name) {
+        key(name);
+        out_ += '{';
+        first_.push_back(true);
+    }
+
+    void end_object() {
+        out_ += '}';
+        first_.pop_back();
+    }
+
+    void field(std::string_view name, uint64_t value) {
+        key(name);
+        out_ += std::to_string(value);
+    }
+
+    void field(std::string_view name, double value) {
+        key(name);
+        out_ += std::to_string(value);
+    }
+
+    void field(std::string_view name, std::string_view value) {
+        key(name);
+        append_escaped(value);
+    }
+
+    void field(std::string_view name, bool value) {
+        key(name);
+        out_ += value ? "true" : "false";
+    }
+
+private:
+    /** @brief Emits the separating comma (if needed) and the quoted key. */
+    void key(std::string_view name) {
+        if (!first_.empty()) {
+            if (!first_.back()) {
+                out_ += ',';
+            }
+            first_.back() = false;
+        }
+        append_escaped(name);
+        out_ += ':';
+    }
+
+    /** @brief Quotes 'text', escaping the characters JSON requires. */
+    void append_escaped(std::string_view text) {
+        out_ += '"';
+        for (const char c : text) {
+            switch (c) {
+                case '"': out_ += "\\\""; break;
+                case '\\': out_ += "\\\\"; break;
+                case '\n': out_ += "\\n"; break;
+                case '\t': out_ += "\\t"; break;
+                case '\r': out_ += "\\r"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x",
+                                      static_cast<unsigned>(c));
+                        out_ += buf;
+                    } else {
+                        out_ += c;
+                    }
+            }
+        }
+        out_ += '"';
+    }
+
+    std::string& out_;
+    std::vector<bool> first_; ///< Per nesting level: no field emitted yet.
+};
+
+/**
+ * @brief Process-wide registry of stats sections for the machine-readable
+ * export.
+ *
+ * The instrumentation lives in many places - per-worker pipeline
+ * counters, queue wait histograms, index cache and spill counters - each
+ * already readable without perturbing the threads it measures (relaxed
+ * atomics, or an aggregate published through a cds::seqlock). This
+ * registry is the one place they all plug into: a component registers a
+ * named provider at startup, and dump_json() emits every section as one
+ * JSON document that external tooling can scrape, instead of parsing the
+ * human-oriented console lines.
+ *
+ * A provider is invoked with a JsonWriter positioned inside its own
+ * object ('"its-name": { ... }') and fills in flat fields; it must only
+ * read - snapshots of live counters are approximate by design, exactly
+ * like the progress line. Providers capture references to the components
+ * they report on, so they must be registered by code that keeps those
+ * components alive for as long as dumps can happen (in practice: main,
+ * for objects that outlive the search loop).
+ *
+ * Registration and dumping take one mutex; both are rare (startup and
+ * explicit dump requests), so nothing here is on any hot path.
+ */
+class StatsRegistry {
+public:
+    using Provider = std::function<void(JsonWriter&)>;
+
+    /** @brief The process's registry. */
+    static StatsRegistry& instance() {
+        static StatsRegistry registry;
+        return registry;
+    }
+
+    StatsRegistry(const StatsRegistry&) = delete;
+    StatsRegistry& operator=(const StatsRegistry&) = delete;
+
+    /**
+     * @brief Registers 'provider' to emit the section named 'name'.
+     * Sections appear in the document in registration order.
+     */
+    void register_provider(std::string name, Provider provider) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        providers_.emplace_back(std::move(name), std::move(provider));
+    }
+
+    /**
+     * @brief One JSON document with every registered section, plus a
+     * wall-clock timestamp so scraped documents order themselves. Each
+     * section's counters are read at dump time - a live snapshot, not a
+     * cached one.
+     */
+    std::string dump_json() const {
+        std::string out;
+        JsonWriter writer(out);
+        writer.begin_object();
+        writer.field("timestamp_ms",
+                     static_cast<uint64_t>(
+                         std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count()));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [name, provider] : providers_) {
+                writer.begin_object(name);
+                provider(writer);
+                writer.end_object();
+            }
+        }
+        writer.end_object();
+        return out;
+    }
+
+private:
+    StatsRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::vector<std::pair<std::string, Provider>> providers_;
+};
@@ -0,0 +1,143 @@
+#include "UringReader.hpp"
+
+#if defined(__linux__)
+
+#include <cstring>       // For std::memset
+#include <linux/io_uring.h>
+#include <sys/mman.h>    // For mmap/munmap (ring regions)
+#include <sys/syscall.h> // For __NR_io_uring_setup/enter
+#include <unistd.h>      // For syscall, close
+
+namespace {
+
+    // Raw syscall shims; glibc exposes no wrappers for these.
+    int sys_io_uring_setup(unsigned entries, io_uring_params* params) {
+        return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                           unsigned flags) {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                          min_complete, flags, nullptr, 0));
+    }
+
+} // anonymous namespace
+
+/**
+ * @brief Sets up the ring and maps its three regions. Any failure tears
+ * everything down and leaves the instance unavailable - callers are
+ * expected to fall back to synchronous reads, not to treat this as fatal.
+ */
+UringReader::UringReader(unsigned queue_depth) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd_ = sys_io_uring_setup(queue_depth, &params);
+    if (ring_fd_ < 0) {
+        return; // No io_uring here (old kernel or seccomp); stay unavailable.
+    }
+    sq_entries_ = params.sq_entries;
+
+    sq_ring_bytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_bytes_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqe_bytes_ = params.sq_entries * sizeof(io_uring_sqe);
+
+    sq_ring_ = ::mmap(nullptr, sq_ring_bytes_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    cq_ring_ = ::mmap(nullptr, cq_ring_bytes_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+    sqes_ = ::mmap(nullptr, sqe_bytes_, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED ||
+        sqes_ == MAP_FAILED) {
+        if (sq_ring_ != MAP_FAILED) ::munmap(sq_ring_, sq_ring_bytes_);
+        if (cq_ring_ != MAP_FAILED) ::munmap(cq_ring_, cq_ring_bytes_);
+        if (sqes_ != MAP_FAILED) ::munmap(sqes_, sqe_bytes_);
+        ::close(ring_fd_);
+        ring_fd_ = -1;
+        return;
+    }
+
+    char* sq = static_cast<char*>(sq_ring_);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    char* cq = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = cq + params.cq_off.cqes;
+}
+
+UringReader::~UringReader() {
+    if (ring_fd_ < 0) {
+        return;
+    }
+    ::munmap(sq_ring_, sq_ring_bytes_);
+    ::munmap(cq_ring_, cq_ring_bytes_);
+    ::munmap(sqes_, sqe_bytes_);
+    ::close(ring_fd_);
+}
+
+/**
+ * @brief One syscall submits the whole batch; the kernel runs the reads
+ * at device queue depth while we wait for the last completion. CQEs can
+ * arrive in any order, so each is matched to its request via user_data.
+ */
+bool UringReader::read_batch(std::vector<Request>& requests) {
+    if (!available() || requests.empty() || requests.size() > sq_entries_) {
+        return false;
+    }
+
+    auto* sqes = static_cast<io_uring_sqe*>(sqes_);
+    const unsigned mask = *sq_mask_;
+    unsigned tail = *sq_tail_; // Sole submitter: plain read is fine.
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const unsigned slot = tail & mask;
+        io_uring_sqe& sqe = sqes[slot];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = requests[i].fd;
+        sqe.addr = reinterpret_cast<uint64_t>(requests[i].buffer);
+        sqe.len = requests[i].length;
+        sqe.off = requests[i].offset;
+        sqe.user_data = i;
+        sq_array_[slot] = slot;
+        ++tail;
+    }
+    // Publish the new tail before the kernel looks at it.
+    __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+
+    const unsigned count = static_cast<unsigned>(requests.size());
+    if (sys_io_uring_enter(ring_fd_, count, count, IORING_ENTER_GETEVENTS) < 0) {
+        return false;
+    }
+
+    // Reap exactly 'count' completions (they may arrive in waves).
+    auto* cqes = static_cast<io_uring_cqe*>(cqes_);
+    const unsigned cq_mask = *cq_mask_;
+    unsigned head = *cq_head_;
+    size_t reaped = 0;
+    while (reaped < count) {
+        const unsigned ready = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        while (head != ready && reaped < count) {
+            const io_uring_cqe& cqe = cqes[head & cq_mask];
+            requests[cqe.user_data].result = cqe.res;
+            ++head;
+            ++reaped;
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        if (reaped < count) {
+            sys_io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+        }
+    }
+    return true;
+}
+
+#else // !__linux__
+
+UringReader::UringReader(unsigned) {}
+UringReader::~UringReader() = default;
+bool UringReader::read_batch(std::vector<Request>&) { return false; }
+
+#endif
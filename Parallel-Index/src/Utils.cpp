@@ -1,13 +1,510 @@
 #include "Utils.hpp"
-#include <algorithm>  // For std::transform
+#include <algorithm>  // For std::binary_search (stop-word overflow bucket)
 #include <cctype>     // For std::tolower, std::isalnum
-#include <sstream>    // For std::stringstream
+#include <cstdint>    // For uint64_t (stop-word length mask)
+#include <cstring>    // For std::memcmp (packed stop-word probe)
 #include <string>     // For std::string
+#include <type_traits> // For std::is_same_v (hashed-token emission)
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define UTILS_X86_SIMD 1
+#include <immintrin.h> // For SSE2/AVX2 intrinsics
+#endif
 
 namespace Utils {
 
-    // Internal static set for stop words. Protected from external access.
-    static std::set<std::string> stop_words_;
+    /**
+     * @brief The stop-word list, flattened for the per-token hot path.
+     *
+     * Words are bucketed by length and packed into one contiguous buffer
+     * per length, sorted, so a membership probe is: one bit test on the
+     * length mask (rejects most tokens outright), then a binary search
+     * over fixed-stride entries compared with memcmp. No tree walk, no
+     * per-node pointer chase, no allocation - the probe touches one or two
+     * cache lines for a typical 200-word list.
+     */
+    struct StopWordTable {
+        /** packed[len] = every stop word of that length, sorted, abutted. */
+        std::vector<std::string> packed;
+        uint64_t length_mask = 0;         ///< Bit L set = some word has length L.
+        std::vector<std::string> overflow; ///< Sorted words of length >= 64 (rare).
+    };
+
+    // Internal static table for stop words. Protected from external access.
+    static StopWordTable stop_words_;
+
+    namespace {
+
+        /** @brief The whitespace set operator>> skips in the "C" locale. */
+        bool is_space_scalar(unsigned char c) {
+            return c == ' ' || (c >= 0x09 && c <= 0x0D);
+        }
+
+        /**
+         * @brief Scalar word-boundary scanner: the portable fallback, and
+         * the reference the SIMD variants are checked against. Calls
+         * emit(begin, end) for every whitespace-delimited raw word.
+         */
+        template <class Emit>
+        void for_each_word_scalar(std::string_view text, Emit&& emit) {
+            const char* p = text.data();
+            const char* const end = p + text.size();
+            while (p != end) {
+                while (p != end && is_space_scalar(static_cast<unsigned char>(*p))) {
+                    ++p;
+                }
+                const char* word_begin = p;
+                while (p != end && !is_space_scalar(static_cast<unsigned char>(*p))) {
+                    ++p;
+                }
+                if (p != word_begin) {
+                    emit(word_begin, p);
+                }
+            }
+        }
+
+#ifdef UTILS_X86_SIMD
+
+        /**
+         * @brief SSE2 scanner: classifies 16 bytes per instruction into a
+         * whitespace bitmask (' ' or 0x09..0x0D), then jumps between word
+         * boundaries with mask tests instead of per-byte branches.
+         */
+        template <class Emit>
+        void for_each_word_sse2(std::string_view text, Emit&& emit) {
+            const char* const data = text.data();
+            const size_t n = text.size();
+            const __m128i space = _mm_set1_epi8(' ');
+            const __m128i lo = _mm_set1_epi8(0x08);  // > 0x08
+            const __m128i hi = _mm_set1_epi8(0x0E);  // < 0x0E
+
+            size_t i = 0;
+            size_t word_begin = 0;
+            bool in_word = false;
+            for (; i + 16 <= n; i += 16) {
+                const __m128i chunk =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                // 0x09..0x0D are positive in signed compare; bytes >= 0x80
+                // are negative and correctly classified as non-space.
+                const __m128i ctrl = _mm_and_si128(_mm_cmpgt_epi8(chunk, lo),
+                                                   _mm_cmpgt_epi8(hi, chunk));
+                const __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(chunk, space), ctrl);
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(ws));
+
+                if (!in_word && mask == 0xFFFFu) {
+                    continue;  // All whitespace - skip the whole block.
+                }
+                if (in_word && mask == 0) {
+                    continue;  // Entirely inside a word.
+                }
+                for (unsigned bit = 0; bit < 16; ++bit) {
+                    const bool space_here = (mask >> bit) & 1u;
+                    if (!in_word && !space_here) {
+                        word_begin = i + bit;
+                        in_word = true;
+                    } else if (in_word && space_here) {
+                        emit(data + word_begin, data + i + bit);
+                        in_word = false;
+                    }
+                }
+            }
+            for (; i < n; ++i) {
+                const bool space_here =
+                    is_space_scalar(static_cast<unsigned char>(data[i]));
+                if (!in_word && !space_here) {
+                    word_begin = i;
+                    in_word = true;
+                } else if (in_word && space_here) {
+                    emit(data + word_begin, data + i);
+                    in_word = false;
+                }
+            }
+            if (in_word) {
+                emit(data + word_begin, data + n);
+            }
+        }
+
+        /**
+         * @brief AVX2 scanner: same mask-driven scan as the SSE2 variant at
+         * 32 bytes per instruction. Compiled with a target attribute so the
+         * binary still runs on pre-AVX2 machines; only the cpuid dispatch
+         * below ever calls it.
+         */
+        template <class Emit>
+        __attribute__((target("avx2")))
+        void for_each_word_avx2(std::string_view text, Emit&& emit) {
+            const char* const data = text.data();
+            const size_t n = text.size();
+            const __m256i space = _mm256_set1_epi8(' ');
+            const __m256i lo = _mm256_set1_epi8(0x08);
+            const __m256i hi = _mm256_set1_epi8(0x0E);
+
+            size_t i = 0;
+            size_t word_begin = 0;
+            bool in_word = false;
+            for (; i + 32 <= n; i += 32) {
+                const __m256i chunk =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                const __m256i ctrl = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, lo),
+                                                      _mm256_cmpgt_epi8(hi, chunk));
+                const __m256i ws =
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), ctrl);
+                const unsigned mask =
+                    static_cast<unsigned>(_mm256_movemask_epi8(ws));
+
+                if (!in_word && mask == 0xFFFFFFFFu) {
+                    continue;
+                }
+                if (in_word && mask == 0) {
+                    continue;
+                }
+                for (unsigned bit = 0; bit < 32; ++bit) {
+                    const bool space_here = (mask >> bit) & 1u;
+                    if (!in_word && !space_here) {
+                        word_begin = i + bit;
+                        in_word = true;
+                    } else if (in_word && space_here) {
+                        emit(data + word_begin, data + i + bit);
+                        in_word = false;
+                    }
+                }
+            }
+            for (; i < n; ++i) {
+                const bool space_here =
+                    is_space_scalar(static_cast<unsigned char>(data[i]));
+                if (!in_word && !space_here) {
+                    word_begin = i;
+                    in_word = true;
+                } else if (in_word && space_here) {
+                    emit(data + word_begin, data + i);
+                    in_word = false;
+                }
+            }
+            if (in_word) {
+                emit(data + word_begin, data + n);
+            }
+        }
+
+#endif // UTILS_X86_SIMD
+
+        /**
+         * @brief Scalar case fold: the portable fallback, and the tail
+         * handler for the vector variants. `c | 0x20` maps A-Z onto a-z.
+         */
+        void lower_scalar(char* p, char* const end) {
+            for (; p != end; ++p) {
+                const unsigned char c = static_cast<unsigned char>(*p);
+                if (c >= 'A' && c <= 'Z') {
+                    *p = static_cast<char>(c | 0x20);
+                }
+            }
+        }
+
+#ifdef UTILS_X86_SIMD
+
+        /**
+         * @brief SSE2 case fold, 16 bytes per instruction: build an A-Z
+         * byte mask with two signed compares and OR 0x20 into exactly
+         * those lanes.
+         */
+        void lower_sse2(char* data, size_t n) {
+            const __m128i below_a = _mm_set1_epi8('A' - 1);
+            const __m128i above_z = _mm_set1_epi8('Z' + 1);
+            const __m128i case_bit = _mm_set1_epi8(0x20);
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                __m128i chunk =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                // A-Z are positive in signed compare; bytes >= 0x80 are
+                // negative and never match, so UTF-8 continuation bytes
+                // pass through untouched.
+                const __m128i upper =
+                    _mm_and_si128(_mm_cmpgt_epi8(chunk, below_a),
+                                  _mm_cmpgt_epi8(above_z, chunk));
+                chunk = _mm_or_si128(chunk, _mm_and_si128(upper, case_bit));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), chunk);
+            }
+            lower_scalar(data + i, data + n);
+        }
+
+        /**
+         * @brief AVX2 case fold: the same mask-and-OR at 32 bytes per
+         * instruction. Target attribute keeps the binary runnable on
+         * pre-AVX2 machines; only the cpuid dispatch ever calls it.
+         */
+        __attribute__((target("avx2")))
+        void lower_avx2(char* data, size_t n) {
+            const __m256i below_a = _mm256_set1_epi8('A' - 1);
+            const __m256i above_z = _mm256_set1_epi8('Z' + 1);
+            const __m256i case_bit = _mm256_set1_epi8(0x20);
+            size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                __m256i chunk =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                const __m256i upper =
+                    _mm256_and_si256(_mm256_cmpgt_epi8(chunk, below_a),
+                                     _mm256_cmpgt_epi8(above_z, chunk));
+                chunk = _mm256_or_si256(chunk, _mm256_and_si256(upper, case_bit));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), chunk);
+            }
+            lower_scalar(data + i, data + n);
+        }
+
+#endif // UTILS_X86_SIMD
+
+        enum class IsaLevel { Scalar, Sse2, Avx2 };
+
+        /**
+         * @brief Detects the widest scanner the running CPU supports.
+         * Evaluated once (cpuid under the hood).
+         */
+        IsaLevel detect_isa() {
+#ifdef UTILS_X86_SIMD
+            if (__builtin_cpu_supports("avx2")) {
+                return IsaLevel::Avx2;
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return IsaLevel::Sse2;
+            }
+#endif
+            return IsaLevel::Scalar;
+        }
+
+        /**
+         * @brief Runs emit(begin, end) over every raw whitespace-delimited
+         * word in text, using the widest scanner the CPU supports.
+         */
+        template <class Emit>
+        void for_each_word(std::string_view text, Emit&& emit) {
+            static const IsaLevel isa = detect_isa();
+#ifdef UTILS_X86_SIMD
+            switch (isa) {
+                case IsaLevel::Avx2:
+                    for_each_word_avx2(text, emit);
+                    return;
+                case IsaLevel::Sse2:
+                    for_each_word_sse2(text, emit);
+                    return;
+                case IsaLevel::Scalar:
+                    break;
+            }
+#else
+            (void)isa;
+#endif
+            for_each_word_scalar(text, emit);
+        }
+
+        /**
+         * @brief True if cleaning under policy P would leave the word
+         * unchanged - the zero-allocation fast path. The test compiles
+         * down to exactly the properties P can change: a policy that
+         * does not fold accepts A-Z as clean, and a policy that neither
+         * folds nor strips accepts everything without looking.
+         *
+         * With Hashed set, the same loop also folds each byte into 'hash'
+         * (seeded with TokenHash::kOffset by the caller): a clean word -
+         * the overwhelming majority - leaves this function already hashed,
+         * so tokenizing and hashing cost one pass over its bytes. A dirty
+         * word abandons the partial hash along with the early return.
+         */
+        template <TokenizePolicy P, bool Hashed>
+        bool is_clean_word(const char* begin, const char* end, size_t& hash) {
+            if constexpr (!P.fold_case && !P.strip_punct && !Hashed) {
+                (void)begin;
+                (void)end;
+                (void)hash;
+                return true;
+            }
+            for (const char* p = begin; p != end; ++p) {
+                const unsigned char c = static_cast<unsigned char>(*p);
+                if constexpr (Hashed) {
+                    hash = TokenHash::step(hash, c);
+                }
+                if constexpr (P.strip_punct) {
+                    if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+                        continue;
+                    }
+                    if constexpr (!P.fold_case) {
+                        if (c >= 'A' && c <= 'Z') {
+                            continue;
+                        }
+                    }
+                    return false;
+                } else if constexpr (P.fold_case) {
+                    // Fold-only policy: anything but A-Z passes through.
+                    if (c >= 'A' && c <= 'Z') {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /** @brief True if 'Tokens' carries HashedToken entries. */
+        template <class Tokens>
+        inline constexpr bool emits_hashes =
+            std::is_same_v<typename Tokens::value_type, HashedToken>;
+
+        /**
+         * @brief Emits one finished token, pairing it with its TokenHash
+         * when the container asks for one. Used by the paths that rewrote
+         * the token's bytes (cleaning, identifier folding) - those already
+         * re-touch every byte, so hashing the final form here keeps the
+         * "one extra pass" confined to the rare dirty-word cases; the
+         * clean fast path gets its hash fused into the validity scan.
+         */
+        template <class Tokens>
+        void emit_token(Tokens& tokens, std::string_view word) {
+            if constexpr (emits_hashes<Tokens>) {
+                tokens.push_back(HashedToken{word, TokenHash{}(word)});
+            } else {
+                tokens.push_back(word);
+            }
+        }
+
+        /**
+         * @brief Cleans one raw word under policy P: strips and/or folds
+         * per the policy's flags, each branch resolved at compile time.
+         */
+        template <TokenizePolicy P>
+        std::string clean_word(const char* begin, const char* end) {
+            std::string cleaned_word;
+            for (const char* p = begin; p != end; ++p) {
+                unsigned char c = static_cast<unsigned char>(*p);
+                if constexpr (P.strip_punct) {
+                    if (!std::isalnum(c)) {
+                        continue;
+                    }
+                }
+                if constexpr (P.fold_case) {
+                    c = static_cast<unsigned char>(std::tolower(c));
+                }
+                cleaned_word += static_cast<char>(c);
+            }
+            return cleaned_word;
+        }
+
+        /**
+         * @brief Flat stop-word probe; see StopWordTable. The length-mask
+         * test makes the common case (no stop word of this length, or no
+         * stop words at all) a single AND and branch.
+         */
+        bool is_stop_word(std::string_view word) {
+            const size_t len = word.size();
+            if (len >= 64) {
+                return std::binary_search(stop_words_.overflow.begin(),
+                                          stop_words_.overflow.end(), word);
+            }
+            if (((stop_words_.length_mask >> len) & 1u) == 0) {
+                return false;
+            }
+            const std::string& bucket = stop_words_.packed[len];
+            size_t lo = 0;
+            size_t hi = bucket.size() / len;
+            while (lo < hi) {
+                const size_t mid = lo + (hi - lo) / 2;
+                const int cmp =
+                    std::memcmp(bucket.data() + mid * len, word.data(), len);
+                if (cmp == 0) {
+                    return true;
+                }
+                if (cmp < 0) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Splits one raw word into identifier parts and emits each.
+         *
+         * Part boundaries are runs of non-alphanumeric bytes (snake_case,
+         * scoped::names, kebab-case) and camelCase transitions, including
+         * the acronym form (XMLParser -> xml, parser). An all-lowercase
+         * part is emitted as a view straight into the buffer; parts with
+         * uppercase are folded once into the arena. Only used by policies
+         * with split_identifiers, which therefore must not be fed
+         * bulk-prefolded text - the case bits are the boundaries.
+         */
+        template <TokenizePolicy P, class Tokens>
+        void emit_identifier_parts(const char* begin, const char* end,
+                                   TokenArena& arena, Tokens& tokens) {
+            const auto is_alnum = [](unsigned char c) {
+                return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                       (c >= '0' && c <= '9');
+            };
+            const auto is_upper = [](unsigned char c) {
+                return c >= 'A' && c <= 'Z';
+            };
+
+            const char* p = begin;
+            while (p != end) {
+                while (p != end && !is_alnum(static_cast<unsigned char>(*p))) {
+                    ++p;
+                }
+                if (p == end) {
+                    break;
+                }
+                const char* start = p;
+                bool has_upper = is_upper(static_cast<unsigned char>(*p));
+                ++p;
+                while (p != end && is_alnum(static_cast<unsigned char>(*p))) {
+                    const unsigned char c = static_cast<unsigned char>(*p);
+                    const unsigned char prev = static_cast<unsigned char>(p[-1]);
+                    if (is_upper(c) && !is_upper(prev)) {
+                        break; // camelCase: ...eX -> split before X.
+                    }
+                    if (is_upper(prev) && !is_upper(c) && c >= 'a' &&
+                        p - 1 != start) {
+                        --p; // XMLParser: the P starts the next part.
+                        break;
+                    }
+                    has_upper |= is_upper(c);
+                    ++p;
+                }
+
+                std::string_view part(start, static_cast<size_t>(p - start));
+                if (has_upper) {
+                    std::string folded(part);
+                    to_lower_in_place(folded.data(), folded.size());
+                    part = arena.store(folded);
+                }
+                if constexpr (P.filter_stop_words) {
+                    if (is_stop_word(part)) {
+                        continue;
+                    }
+                }
+                emit_token(tokens, part);
+            }
+        }
+
+    } // anonymous namespace
+
+    /**
+     * @brief Lowercases ASCII A-Z in place; see the header. Dispatches to
+     * the widest case-fold variant the CPU supports.
+     */
+    void to_lower_in_place(char* data, size_t size) {
+        static const IsaLevel isa = detect_isa();
+#ifdef UTILS_X86_SIMD
+        switch (isa) {
+            case IsaLevel::Avx2:
+                lower_avx2(data, size);
+                return;
+            case IsaLevel::Sse2:
+                lower_sse2(data, size);
+                return;
+            case IsaLevel::Scalar:
+                break;
+        }
+#else
+        (void)isa;
+#endif
+        lower_scalar(data, data + size);
+    }
 
     /**
      * @brief Converts a string to lowercase.
@@ -16,8 +513,7 @@ namespace Utils {
      */
     std::string to_lower(const std::string& s) {
         std::string lower_s = s;
-        std::transform(lower_s.begin(), lower_s.end(), lower_s.begin(),
-                       [](unsigned char c){ return std::tolower(c); });
+        to_lower_in_place(lower_s.data(), lower_s.size());
         return lower_s;
     }
 
@@ -26,41 +522,153 @@ namespace Utils {
      * Converts words to lowercase and removes non-alphanumeric characters.
      * Words that are defined as stop words are ignored.
      *
+     * Dispatches at runtime to an AVX2 or SSE2 boundary scanner on capable
+     * CPUs, falling back to a scalar loop elsewhere; all variants produce
+     * identical output.
+     *
      * @param text The input text string.
      * @return A vector of processed word strings.
      */
     std::vector<std::string> tokenize(const std::string& text) {
         std::vector<std::string> tokens;
-        std::stringstream ss(text);
-        std::string word;
+        for_each_word(text, [&tokens](const char* begin, const char* end) {
+            std::string cleaned_word = clean_word<kSearchTokens>(begin, end);
+            if (!cleaned_word.empty() && !is_stop_word(cleaned_word)) {
+                tokens.push_back(std::move(cleaned_word));
+            }
+        });
+        return tokens;
+    }
 
-        while (ss >> word) {
-            // Remove non-alphanumeric characters and convert to lowercase
-            std::string cleaned_word;
-            for (char c : word) {
-                if (std::isalnum(static_cast<unsigned char>(c))) {
-                    cleaned_word += std::tolower(static_cast<unsigned char>(c));
+    /**
+     * @brief Zero-copy tokenizer: yields string_view slices instead of
+     * owned strings.
+     *
+     * A word that is already clean (all lowercase alphanumeric - the
+     * overwhelmingly common case in real text) is returned as a view
+     * straight into the caller's buffer with no allocation at all. Words
+     * that need cleaning are materialized once into the arena and viewed
+     * from there. Same output as the owning overload, same stop-word
+     * filtering.
+     *
+     * @param text The input text; the returned views alias it, so it must
+     *        outlive them.
+     * @param arena Backing storage for the few tokens that need cleaning;
+     *        appended to, never cleared - the caller clears it once all the
+     *        views from a batch of calls are dead, so tokens can safely be
+     *        accumulated across lines of a file.
+     * @return Views of the processed words, valid while text and arena live.
+     */
+    std::vector<std::string_view> tokenize(std::string_view text, TokenArena& arena) {
+        std::vector<std::string_view> tokens;
+        tokenize(text, arena, tokens);
+        return tokens;
+    }
+
+    /**
+     * @brief Zero-copy tokenizer into a caller-owned vector; see the
+     * returning overload for the token semantics. One vector and one
+     * arena for a whole file, so a per-line loop allocates nothing in
+     * steady state.
+     */
+    void tokenize(std::string_view text, TokenArena& arena,
+                  std::vector<std::string_view>& tokens) {
+        tokenize<kSearchTokens>(text, arena, tokens);
+    }
+
+    /**
+     * @brief The policy-specialized tokenizer core. Every policy flag is
+     * resolved by if constexpr, so each instantiation is the loop a
+     * hand-written variant would be: the verbatim policy, for instance,
+     * contains no cleaning, stop-word or arena code at all.
+     */
+    template <TokenizePolicy P, class Tokens>
+    void tokenize(std::string_view text, TokenArena& arena, Tokens& tokens) {
+        tokens.clear();
+        for_each_word(text, [&tokens, &arena](const char* begin, const char* end) {
+            (void)arena;
+            size_t hash = TokenHash::kOffset;
+            if (is_clean_word<P, emits_hashes<Tokens>>(begin, end, hash)) {
+                const std::string_view word(begin,
+                                            static_cast<size_t>(end - begin));
+                if constexpr (P.filter_stop_words) {
+                    if (is_stop_word(word)) {
+                        return;
+                    }
                 }
+                // For hashed containers 'hash' was finished by the
+                // cleanliness scan itself - the fused single pass.
+                if constexpr (emits_hashes<Tokens>) {
+                    tokens.push_back(HashedToken{word, hash});
+                } else {
+                    tokens.push_back(word);
+                }
+                return;
             }
-
-            if (!cleaned_word.empty()) {
-                // Check if it's a stop word
-                if (stop_words_.find(cleaned_word) == stop_words_.end()) {
-                    tokens.push_back(cleaned_word);
+            if constexpr (P.split_identifiers) {
+                // Not plain lowercase: treat it as an identifier and
+                // index its parts instead of one glued term.
+                emit_identifier_parts<P>(begin, end, arena, tokens);
+                return;
+            }
+            std::string cleaned_word = clean_word<P>(begin, end);
+            if (cleaned_word.empty()) {
+                return;
+            }
+            if constexpr (P.filter_stop_words) {
+                if (is_stop_word(cleaned_word)) {
+                    return;
                 }
             }
-        }
-        return tokens;
+            // Slab storage: growth never moves earlier bytes, so
+            // previously returned views stay valid.
+            emit_token(tokens, arena.store(cleaned_word));
+        });
     }
 
+    // The (policy, container) pairs the project actually runs, compiled
+    // here once; a new combination needs a matching line or it will not
+    // link. The indexer's per-line buffer is a small_vector of hashed
+    // tokens - allocation-free from the very first line, and each token
+    // leaves the tokenizer with its dictionary hash already computed.
+    template void tokenize<kSearchTokens>(std::string_view, TokenArena&,
+                                          std::vector<std::string_view>&);
+    template void tokenize<kPrefoldedTokens>(std::string_view, TokenArena&,
+                                             std::vector<std::string_view>&);
+    template void tokenize<kVerbatimTokens>(std::string_view, TokenArena&,
+                                            std::vector<std::string_view>&);
+    template void tokenize<kPrefoldedTokens>(
+        std::string_view, TokenArena&,
+        cds::small_vector<HashedToken, 32>&);
+    template void tokenize<kSourceTokens>(
+        std::string_view, TokenArena&,
+        cds::small_vector<HashedToken, 32>&);
+
     /**
      * @brief Sets the stop words to be ignored during tokenization.
      * Words in this set will not be returned by the tokenize function.
      *
+     * Rebuilds the flat lookup table: words are bucketed by length and
+     * packed contiguously. A std::set iterates in lexicographic order, and
+     * for equal-length strings that coincides with memcmp order, so each
+     * bucket comes out sorted by construction.
+     *
      * @param words A set of strings representing the stop words.
      */
     void set_stop_words(const std::set<std::string>& words) {
-        stop_words_ = words;
+        stop_words_ = StopWordTable{};
+        stop_words_.packed.resize(64);
+        for (const std::string& word : words) {
+            if (word.empty()) {
+                continue;
+            }
+            if (word.size() >= 64) {
+                stop_words_.overflow.push_back(word); // Set order = sorted.
+                continue;
+            }
+            stop_words_.packed[word.size()] += word;
+            stop_words_.length_mask |= uint64_t{1} << word.size();
+        }
     }
 
-} // namespace Utils
\ No newline at end of file
+} // namespace Utils
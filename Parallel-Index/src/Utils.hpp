@@ -1,6 +1,10 @@
 #pragma once
 
+#include "../../Concurrent-Data-Structures/memory/monotonic_arena.hpp"
+#include "../../Concurrent-Data-Structures/memory/small_vector.hpp"
+
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set> // For optional stop words
 
@@ -16,6 +20,20 @@ namespace Utils {
      */
     std::string to_lower(const std::string& s);
 
+    /**
+     * @brief Lowercases ASCII A-Z in place, as one streaming pass.
+     *
+     * Vectorized (32 or 16 bytes per instruction on capable CPUs) using
+     * the `c | 0x20` bit trick on the A-Z range; every other byte is left
+     * untouched. Meant to run once over a whole file buffer before token
+     * scanning, so case folding costs one pass over memory instead of one
+     * allocation per mixed-case token.
+     *
+     * @param data The buffer to fold; written in place.
+     * @param size The buffer length in bytes.
+     */
+    void to_lower_in_place(char* data, size_t size);
+
     /**
      * @brief Tokenizes a given text string into words.
      * Converts words to lowercase and removes non-alphanumeric characters.
@@ -25,6 +43,147 @@ namespace Utils {
      */
     std::vector<std::string> tokenize(const std::string& text);
 
+    /**
+     * @brief Backing storage for the zero-copy tokenize overload.
+     *
+     * Holds owned copies of the (rare) tokens that needed cleaning, bump-
+     * allocated into monotonic slabs that never relocate - already-returned
+     * views stay valid until clear(). clear() rewinds the slabs but keeps
+     * them, so an arena reused per file frees nothing in steady state.
+     */
+    struct TokenArena {
+        cds::monotonic_arena arena;
+
+        /** @brief Copies 'word' into the arena; the view outlives 'word'. */
+        std::string_view store(std::string_view word) {
+            return arena.copy(word);
+        }
+
+        void clear() { arena.reset(); }
+    };
+
+    /**
+     * @brief Zero-copy tokenizer: yields string_view slices over the input
+     * buffer. Tokens that are already clean (lowercase alphanumeric) alias
+     * 'text' directly; the rest are materialized once into 'arena'.
+     *
+     * @param text The input text; must outlive the returned views.
+     * @param arena Backing storage for cleaned tokens. Appended to, never
+     *        cleared - views from successive calls stay valid until the
+     *        caller clears the arena itself.
+     * @return Views of the processed words, valid while text and arena live.
+     */
+    std::vector<std::string_view> tokenize(std::string_view text, TokenArena& arena);
+
+    /**
+     * @brief Zero-copy tokenizer into a caller-owned vector.
+     *
+     * Same semantics as the returning overload, but 'tokens' is cleared
+     * and refilled in place - a caller tokenizing line after line keeps
+     * one vector whose capacity is reused instead of allocating a fresh
+     * vector per line. Equivalent to tokenize<kSearchTokens> below.
+     *
+     * @param text The input text; must outlive the produced views.
+     * @param arena Backing storage for cleaned tokens; appended to.
+     * @param tokens Cleared, then filled with the processed words.
+     */
+    void tokenize(std::string_view text, TokenArena& arena,
+                  std::vector<std::string_view>& tokens);
+
+    /**
+     * @brief FNV-1a over a token's bytes - the one hash the whole indexing
+     * path agrees on.
+     *
+     * The tokenizer folds this into its scan (see HashedToken), the
+     * per-worker LocalIndex probes its dictionary with it, and
+     * InvertedIndex routes shards and probes its per-shard maps with it.
+     * One functor shared by all of them is what lets a hash computed while
+     * tokenizing be reused downstream without anyone re-reading the key.
+     */
+    struct TokenHash {
+        static constexpr size_t kOffset = 14695981039346656037ull;
+        static constexpr size_t kPrime = 1099511628211ull;
+
+        /** @brief Folds one byte into a running hash; seed with kOffset. */
+        static constexpr size_t step(size_t hash, unsigned char c) {
+            return (hash ^ c) * kPrime;
+        }
+
+        constexpr size_t operator()(std::string_view sv) const {
+            size_t hash = kOffset;
+            for (const char c : sv) {
+                hash = step(hash, static_cast<unsigned char>(c));
+            }
+            return hash;
+        }
+    };
+
+    /**
+     * @brief A token plus its TokenHash, emitted by the hashed tokenizer
+     * instantiations.
+     *
+     * For the common clean-word case the hash is accumulated by the same
+     * loop that checks the bytes, so tokenizing and hashing cost one pass
+     * over the token instead of two - and the consumers that reuse the
+     * hash (dictionary probe, shard routing) never read the bytes again
+     * except for the final key-equality check.
+     */
+    struct HashedToken {
+        std::string_view text;
+        size_t hash;
+    };
+
+    /**
+     * @brief Compile-time tokenizer configuration.
+     *
+     * Passed as a template parameter, so each configuration compiles to
+     * its own specialized loop: a feature that is off costs no per-
+     * character branch, and the per-word fast-path test ("would cleaning
+     * change this word at all?") only checks the properties the policy
+     * can actually change.
+     */
+    struct TokenizePolicy {
+        bool fold_case;         ///< Lowercase A-Z while cleaning.
+        bool strip_punct;       ///< Drop non-alphanumeric bytes.
+        bool filter_stop_words; ///< Drop words on the stop-word list.
+        /// Emit identifiers as their parts: split at non-alphanumeric
+        /// bytes and at camelCase boundaries instead of gluing them.
+        bool split_identifiers = false;
+    };
+
+    /** @brief Full cleaning: what search-facing text wants. */
+    inline constexpr TokenizePolicy kSearchTokens{true, true, true};
+
+    /** @brief For input already case-folded in bulk (the indexer runs
+     *  to_lower_in_place over the whole buffer first): no per-character
+     *  fold, punctuation stripped, stop words dropped. */
+    inline constexpr TokenizePolicy kPrefoldedTokens{false, true, true};
+
+    /** @brief Raw whitespace-delimited words, untouched: every token is
+     *  a view into 'text', the arena is never used. */
+    inline constexpr TokenizePolicy kVerbatimTokens{false, false, false};
+
+    /** @brief For source code: identifiers index as their parts
+     *  (add_word_occurrence -> add, word, occurrence; FileScanner ->
+     *  file, scanner), so code files stop minting one-off glued terms.
+     *  Folds per character - the camel boundaries ARE the case bits, so
+     *  the buffer must not be bulk-prefolded first. */
+    inline constexpr TokenizePolicy kSourceTokens{true, true, true, true};
+
+    /**
+     * @brief Policy-specialized zero-copy tokenizer; same contract as
+     * the overload above. 'Tokens' is any push_back/clear container of
+     * string_view - std::vector, or cds::small_vector for callers whose
+     * per-line buffer should be allocation-free from the first line. A
+     * container of HashedToken instead gets each token paired with its
+     * TokenHash, computed in the same scan that validates the bytes.
+     * Defined in Utils.cpp and explicitly instantiated there for the
+     * (policy, container) pairs the project runs - a new combination
+     * needs one new instantiation line.
+     */
+    template <TokenizePolicy P, class Tokens>
+    void tokenize(std::string_view text, TokenArena& arena, Tokens& tokens);
+
     /**
      * @brief Sets the stop words to be ignored during tokenization.
      * Words in this set will not be returned by the tokenize function.
@@ -1,5 +1,10 @@
 #include "FileScanner.hpp"
+#include "IndexDeltaLog.hpp"
+#include "IndexHandle.hpp"
+#include "IndexSnapshot.hpp"
 #include "IndexerWorker.hpp"
+#include "IndexingStats.hpp"
+#include "ReaderWorker.hpp"
 #include "InvertedIndex.hpp"
 #include "ConcurrentQueue.hpp"
 #include "FileInfo.hpp" // Required for FileInfo type
@@ -9,27 +14,350 @@
 #include <iostream>      // For console input/output
 #include <vector>        // For std::vector
 #include <thread>        // Explicitly using std::thread for multi-threading
+#include "ThreadGroup.hpp"
 #include <string>        // For std::string
 #include <chrono>        // For measuring time (high_resolution_clock)
 #include <set>           // For std::set (used for unique file IDs in search results, and stop words)
-#include <unordered_map> // For std::unordered_map (used for g_file_id_to_path_map)
+#include "FileTable.hpp" // Dense file-ID -> path table for search display
+#include "StatsRegistry.hpp" // Machine-readable stats export ('stats', SIGUSR1)
+#include "../../Concurrent-Data-Structures/sync/seqlock.hpp" // Published build stats
+#include <scheduler/profile.hpp> // PROFILE_SCOPE aggregation ('profile' command)
+#include <atomic>        // For the build-done and stats-dump flags
+#include <csignal>       // For the SIGUSR1 dump trigger
 #include <stdexcept>     // For std::out_of_range
+#include <functional>    // For std::function (search loop callbacks)
+#include <sstream>       // For splitting multi-word queries
+#include <filesystem>    // For file_size (delta-log compaction check)
+#include <unordered_set> // For the changed-file id set handed to the delta log
+#include <stop_token>    // For the 'stop' command's cancellation plumbing
+#include <optional>      // For sweeping leftover queue entries after a stop
+#include <sys/mman.h>    // For munmap (releasing swept mapped payloads)
 
-// A global map to store file ID to path mapping for search results.
-std::unordered_map<size_t, std::string> g_file_id_to_path_map;
+// A global table to store file ID to path mapping for search results.
+// File IDs are dense (one atomic counter in the scanner), so resolving a
+// result is an array index into the table's path arena, not a hash probe.
+FileTable g_file_table;
+
+// Snapshot file kept inside the indexed directory. Its extension is not in
+// the scanner's indexable set, so it is never indexed itself.
+static const char* kSnapshotName = ".parallel_index.snapshot";
+
+// How many results a ranked ('top <word>') query returns.
+static constexpr size_t kTopK = 10;
+
+// Set by the SIGUSR1 handler, polled by the stats watcher thread. Fleet
+// tooling signals the process and scrapes the JSON document the watcher
+// prints - the same document the 'stats' command produces on demand.
+static std::atomic<bool> g_stats_dump_requested{false};
+
+// The handler itself does nothing but flip the flag (one lock-free store
+// is all that is async-signal-safe here); the watcher thread does the
+// actual dump from a normal context.
+static void request_stats_dump(int) {
+    g_stats_dump_requested.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Wraps a mapped snapshot as a publishable generation. The callbacks
+ * copy the shared_ptr, so the mapping stays alive as long as any query can
+ * still reach this generation - even after a rebuild publishes its
+ * replacement and main drops its own reference.
+ */
+static std::shared_ptr<const IndexGeneration> make_snapshot_generation(
+    std::shared_ptr<IndexSnapshot::MappedIndex> snap) {
+    auto gen = std::make_shared<IndexGeneration>();
+    gen->search = [snap](const std::string& word) { return snap->search(word); };
+    gen->search_all = [snap](const std::vector<std::string>& terms) { return snap->search_all(terms); };
+    gen->search_phrase = [snap](const std::vector<std::string>& terms) { return snap->search_phrase(terms); };
+    gen->search_ranked = [snap](const std::string& term, size_t k) { return snap->search_ranked(term, k); };
+    gen->search_prefix = [snap](const std::string& prefix) { return snap->search_prefix(prefix); };
+    gen->path_of = [snap](size_t file_id) { return std::string(snap->file_path(file_id)); };
+    return gen;
+}
+
+/**
+ * @brief Wraps the in-memory index as a publishable generation. The index
+ * and the global file table both live in main's scope and outlive the
+ * search loop, so capturing by reference is safe.
+ */
+static std::shared_ptr<const IndexGeneration> make_index_generation(
+    const InvertedIndex& index) {
+    auto gen = std::make_shared<IndexGeneration>();
+    gen->search = [&index](const std::string& word) { return index.search(word); };
+    gen->search_view = [&index](const std::string& word) { return index.search_view(word); };
+    gen->search_all = [&index](const std::vector<std::string>& terms) { return index.search_all(terms); };
+    gen->search_phrase = [&index](const std::vector<std::string>& terms) { return index.search_phrase(terms); };
+    gen->search_ranked = [&index](const std::string& term, size_t k) { return index.search_ranked(term, k); };
+    gen->search_prefix = [&index](const std::string& prefix) { return index.search_prefix(prefix); };
+    gen->path_of = [](size_t file_id) { return std::string(g_file_table.path_of(file_id)); };
+    return gen;
+}
+
+/**
+ * @brief The pre-publication generation for a first run: there is no
+ * previous index to serve, so every query answers empty until the initial
+ * build publishes.
+ */
+static std::shared_ptr<const IndexGeneration> make_empty_generation() {
+    auto gen = std::make_shared<IndexGeneration>();
+    gen->search = [](const std::string&) { return std::vector<WordOccurrence>{}; };
+    gen->search_all = [](const std::vector<std::string>&) { return std::vector<size_t>{}; };
+    gen->search_phrase = [](const std::vector<std::string>&) { return std::vector<WordOccurrence>{}; };
+    gen->search_ranked = [](const std::string&, size_t) { return std::vector<ScoredFile>{}; };
+    gen->search_prefix = [](const std::string&) { return std::vector<std::string>{}; };
+    gen->path_of = [](size_t) { return std::string(); };
+    return gen;
+}
+
+/**
+ * @brief The interactive search loop, shared by the in-memory and the
+ * mmap-snapshot paths.
+ * Single-word queries list occurrences; multi-word queries are treated as
+ * an AND over all terms and list the files containing every one; a quoted
+ * query (e.g. '"thread pool"') matches only files where the words occur
+ * adjacently, in order; 'top <word>' ranks the best matches for a term by
+ * BM25 score; a trailing '*' (e.g. 'auto*') lists every indexed word with
+ * that prefix.
+ * @param handle The published index; each query loads the current
+ *        generation, so a rebuild finishing mid-session takes effect on
+ *        the very next query without the loop noticing.
+ * @param build_stop The background build's stop source, or nullptr when
+ *        no build is running. 'stop' signals it: discovery halts, each
+ *        worker finishes the batch it holds, and the partial index is
+ *        published and flushed - the way out when a bad corpus path
+ *        turns out to be terabytes, without kill -9 losing everything.
+ */
+static void run_search_loop(const IndexHandle& handle,
+                            std::stop_source* build_stop = nullptr) {
+    std::string query;
+    std::cout << "\n--- Search Mode ---" << std::endl;
+    std::cout << "Enter 'q' or 'quit' to exit, 'top <word>' for ranked results, 'word*' for prefix matches, '\"some words\"' for phrase matches, 'stats' for a JSON stats dump, 'stop' to cancel a running index build." << std::endl;
+
+    while (true) {
+        std::cout << "\nEnter word to search: ";
+        std::getline(std::cin, query); // Use getline to handle spaces in query (though we only tokenize single words)
+
+        if (query == "q" || query == "quit") {
+            break;
+        }
+        if (query.empty()) {
+            continue;
+        }
+
+        // 'profile': dump the aggregated PROFILE_SCOPE histograms
+        // (indexing stages and queries so far).
+        if (query == "profile") {
+            std::cout << scheduler::Profiler::instance().report();
+            continue;
+        }
+
+        // 'stats': the machine-readable counterpart of 'profile' - one
+        // JSON document with every registered stats section, for tooling
+        // rather than eyeballs. SIGUSR1 produces the same document.
+        if (query == "stats") {
+            std::cout << StatsRegistry::instance().dump_json() << std::endl;
+            continue;
+        }
+
+        // 'stop': cancel the background indexing run. In-flight work is
+        // finished, the rest is dropped, and what was indexed so far is
+        // still published and persisted.
+        if (query == "stop") {
+            if (build_stop != nullptr && build_stop->request_stop()) {
+                std::cout << "Stop requested: halting discovery, finishing "
+                             "in-flight files, flushing the partial index."
+                          << std::endl;
+            } else {
+                std::cout << "No indexing run to stop." << std::endl;
+            }
+            continue;
+        }
+
+        // Pin the current generation for this query; a concurrent publish
+        // swaps what the next query sees, never this one. The guard's
+        // hazard slot (not a refcount) is what holds the pin.
+        const IndexHandle::Generation gen = handle.current();
+
+        std::string processed_query = Utils::to_lower(query); // Convert query to lowercase for consistent search
+
+        // '"some words"': phrase query - the terms must occur adjacently,
+        // in order, verified against the stored positions.
+        if (processed_query.size() >= 2 && processed_query.front() == '"' &&
+            processed_query.back() == '"') {
+            std::vector<std::string> phrase_terms;
+            {
+                std::stringstream ss(
+                    processed_query.substr(1, processed_query.size() - 2));
+                std::string term;
+                while (ss >> term) {
+                    phrase_terms.push_back(term);
+                }
+            }
+            if (phrase_terms.empty()) {
+                continue;
+            }
+            auto phrase_start_time = std::chrono::high_resolution_clock::now();
+            std::vector<WordOccurrence> matches = gen->search_phrase(phrase_terms);
+            auto phrase_end_time = std::chrono::high_resolution_clock::now();
+            auto phrase_us = std::chrono::duration_cast<std::chrono::microseconds>(phrase_end_time - phrase_start_time);
+
+            if (matches.empty()) {
+                std::cout << "No files contain the phrase " << processed_query
+                          << "." << std::endl;
+            } else {
+                std::cout << "Phrase " << processed_query << " found in "
+                          << matches.size() << " files:" << std::endl;
+                for (const WordOccurrence& match : matches) {
+                    const std::string path = gen->path_of(match.file_id);
+                    std::cout << "- " << match.positions.size() << "x in ";
+                    if (!path.empty()) {
+                        std::cout << path << " (ID: " << match.file_id << ")" << std::endl;
+                    } else {
+                        std::cout << "File ID " << match.file_id << std::endl;
+                    }
+                }
+            }
+            std::cout << "Search time: " << phrase_us.count() << " us" << std::endl;
+            continue;
+        }
+
+        // Multiple words = AND query: report the files containing them all.
+        std::vector<std::string> terms;
+        {
+            std::stringstream ss(processed_query);
+            std::string term;
+            while (ss >> term) {
+                terms.push_back(term);
+            }
+        }
+        // 'word*': prefix query, list the indexed words that match.
+        if (terms.size() == 1 && terms[0].size() > 1 && terms[0].back() == '*') {
+            const std::string prefix = terms[0].substr(0, terms[0].size() - 1);
+            auto prefix_start_time = std::chrono::high_resolution_clock::now();
+            std::vector<std::string> words = gen->search_prefix(prefix);
+            auto prefix_end_time = std::chrono::high_resolution_clock::now();
+            auto prefix_us = std::chrono::duration_cast<std::chrono::microseconds>(prefix_end_time - prefix_start_time);
+
+            if (words.empty()) {
+                std::cout << "No indexed words start with '" << prefix << "'." << std::endl;
+            } else {
+                std::cout << words.size() << " indexed words start with '"
+                          << prefix << "':" << std::endl;
+                for (const std::string& word : words) {
+                    std::cout << "- " << word << std::endl;
+                }
+            }
+            std::cout << "Search time: " << prefix_us.count() << " us" << std::endl;
+            continue;
+        }
+
+        // 'top <word>': ranked query, k best files by BM25 score.
+        if (terms.size() == 2 && terms[0] == "top") {
+            auto rank_start_time = std::chrono::high_resolution_clock::now();
+            std::vector<ScoredFile> ranked = gen->search_ranked(terms[1], kTopK);
+            auto rank_end_time = std::chrono::high_resolution_clock::now();
+            auto rank_us = std::chrono::duration_cast<std::chrono::microseconds>(rank_end_time - rank_start_time);
+
+            if (ranked.empty()) {
+                std::cout << "No matches found for '" << terms[1] << "'." << std::endl;
+            } else {
+                std::cout << "Top " << ranked.size() << " files for '"
+                          << terms[1] << "':" << std::endl;
+                for (const ScoredFile& result : ranked) {
+                    const std::string path = gen->path_of(result.file_id);
+                    std::cout << "- Score " << result.score << ": ";
+                    if (!path.empty()) {
+                        std::cout << path << " (ID: " << result.file_id << ")" << std::endl;
+                    } else {
+                        std::cout << "File ID " << result.file_id << std::endl;
+                    }
+                }
+            }
+            std::cout << "Search time: " << rank_us.count() << " us" << std::endl;
+            continue;
+        }
+
+        if (terms.size() > 1) {
+            auto and_start_time = std::chrono::high_resolution_clock::now();
+            std::vector<size_t> matched = gen->search_all(terms);
+            auto and_end_time = std::chrono::high_resolution_clock::now();
+            auto and_us = std::chrono::duration_cast<std::chrono::microseconds>(and_end_time - and_start_time);
+
+            if (matched.empty()) {
+                std::cout << "No files contain all of '" << query << "'." << std::endl;
+            } else {
+                std::cout << "All terms of '" << query << "' found in "
+                          << matched.size() << " files:" << std::endl;
+                for (size_t file_id : matched) {
+                    const std::string path = gen->path_of(file_id);
+                    if (!path.empty()) {
+                        std::cout << "- File: " << path << " (ID: " << file_id << ")" << std::endl;
+                    } else {
+                        std::cout << "- File ID: " << file_id << std::endl;
+                    }
+                }
+            }
+            std::cout << "Search time: " << and_us.count() << " us" << std::endl;
+            continue;
+        }
+
+        auto search_start_time = std::chrono::high_resolution_clock::now();
+        // Collect unique file IDs to display paths only once per file.
+        // The display needs only file IDs, so the in-memory backend's
+        // zero-copy view avoids materializing every position vector; the
+        // snapshot backend falls back to the copying search().
+        std::set<size_t> matched_file_ids;
+        size_t occurrence_count = 0;
+        if (gen->search_view) {
+            const InvertedIndex::ResultView view = gen->search_view(processed_query);
+            occurrence_count = view.size();
+            for (const auto& entry : view) {
+                matched_file_ids.insert(entry.file_id);
+            }
+        } else {
+            const std::vector<WordOccurrence> results = gen->search(processed_query);
+            occurrence_count = results.size();
+            for (const auto& occ : results) {
+                matched_file_ids.insert(occ.file_id);
+            }
+        }
+        auto search_end_time = std::chrono::high_resolution_clock::now();
+        auto search_duration_us = std::chrono::duration_cast<std::chrono::microseconds>(search_end_time - search_start_time);
+
+        if (matched_file_ids.empty()) {
+            std::cout << "No matches found for '" << query << "'." << std::endl;
+        } else {
+            std::cout << "Found '" << query << "' in " << matched_file_ids.size() << " unique files (" << occurrence_count << " occurrences total):" << std::endl;
+            for (size_t file_id : matched_file_ids) {
+                const std::string path = gen->path_of(file_id);
+                if (!path.empty()) {
+                    std::cout << "- File: " << path << " (ID: " << file_id << ")" << std::endl;
+                } else {
+                    std::cout << "- File ID: " << file_id << std::endl;
+                }
+            }
+        }
+        std::cout << "Search time: " << search_duration_us.count() << " us" << std::endl;
+    }
+}
 
 int main(int argc, char* argv[]) {
     std::cout << "--- ParallelIndex: Concurrent File Indexer & Search Engine ---" << std::endl;
 
+    // Shipped on: an enabled probe is two timestamp reads and a ring
+    // store, so the 'profile' command always has data.
+    scheduler::Profiler::instance().enable();
+
     // Command-line argument parsing
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <directory_to_index> [num_indexer_threads]" << std::endl;
-        std::cerr << "Example: " << argv[0] << " ./my_documents 8" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <directory_to_index> [num_indexer_threads] [num_reader_threads] [memory_budget_mib]" << std::endl;
+        std::cerr << "Example: " << argv[0] << " ./my_documents 8 2 512" << std::endl;
         return 1;
     }
 
     std::string root_dir_str = argv[1];
     int num_indexer_threads = 4; // Default number of worker threads
+    int num_reader_threads = 2;  // Default number of I/O (reader) threads
 
     if (argc >= 3) {
         try {
@@ -41,109 +369,631 @@ int main(int argc, char* argv[]) {
             std::cerr << "Warning: Invalid number of threads provided (" << argv[2] << "). Error: " << e.what() << ". Using default " << num_indexer_threads << " threads." << std::endl;
         }
     }
+    if (argc >= 4) {
+        try {
+            num_reader_threads = std::stoi(argv[3]);
+            if (num_reader_threads <= 0) {
+                throw std::out_of_range("Number of threads must be positive.");
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: Invalid number of reader threads provided (" << argv[3] << "). Error: " << e.what() << ". Using default " << num_reader_threads << " threads." << std::endl;
+        }
+    }
+    // Optional hard cap on index memory, for containerized runs: when the
+    // index outgrows it, cold posting lists spill to disk instead of the
+    // OOM killer deciding for us. 0 (the default) disables the cap.
+    size_t memory_budget_mib = 0;
+    if (argc >= 5) {
+        try {
+            const long long budget = std::stoll(argv[4]);
+            if (budget < 0) {
+                throw std::out_of_range("Memory budget must not be negative.");
+            }
+            memory_budget_mib = static_cast<size_t>(budget);
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: Invalid memory budget provided (" << argv[4] << "). Error: " << e.what() << ". Running without a budget." << std::endl;
+        }
+    }
 
     // Set some common stop words to be ignored during tokenization
     // Utils::set_stop_words({"a", "an", "the", "and", "or", "but", "is", "are", "was", "were", "of", "in", "to", "for", "on", "with", "as", "at", "it", "its", "by"});
     Utils::set_stop_words({});
 
-    // Instantiate core components
-    ConcurrentQueue<FileInfo> file_queue;
+    // --- Snapshot / incremental startup ---
+    // A previous run's snapshot gives us two shortcuts: if nothing on disk
+    // changed (by size+mtime) we serve queries straight from the mapping,
+    // and if only some files changed we rebuild the unchanged postings from
+    // the snapshot and re-index just the delta.
+    const std::string snapshot_path = root_dir_str + "/" + kSnapshotName;
+    auto load_start_time = std::chrono::high_resolution_clock::now();
+    std::shared_ptr<IndexSnapshot::MappedIndex> mapped =
+        IndexSnapshot::MappedIndex::open(snapshot_path);
+    const bool incremental = (mapped != nullptr);
+
+    // Segments appended by earlier incremental runs that have not been
+    // compacted yet. They overlay the base snapshot; without a base the
+    // log is meaningless and the full build below will discard it.
+    const std::string delta_path = snapshot_path + ".delta";
+    IndexDeltaLog::Delta delta;
+    if (mapped) {
+        delta = IndexDeltaLog::load(delta_path);
+        if (!delta.empty()) {
+            std::cout << "Delta log: " << delta.segments << " segment(s), "
+                      << delta.postings.size()
+                      << " touched words to overlay on the snapshot."
+                      << std::endl;
+        }
+    }
+
+    // Instantiate core components. For a full scan the file queue is
+    // bounded, so a scanner that outruns the indexers blocks instead of
+    // buffering a whole huge tree's worth of FileInfo (path strings
+    // included) in memory. The incremental path scans synchronously before
+    // any worker starts - a bound would deadlock it - but it only ever
+    // queues the changed files, so it stays unbounded.
+    ConcurrentQueue<FileInfo> file_queue(incremental ? 0 : 4096);
+    // The reader-to-indexer queue holds loaded file contents, so its bound
+    // is tight: enough in flight to keep every indexer busy, no more.
+    ConcurrentQueue<FileContent> content_queue(
+        static_cast<size_t>(num_indexer_threads) * 16);
+    // Idle read buffers are capped in bytes (the read side's memory
+    // budget): room for every in-flight payload to come back as a warm
+    // 64 KiB-class buffer (the mmap threshold bounds pooled payloads).
+    BufferPool buffer_pool(static_cast<size_t>(num_indexer_threads) * 16 *
+                           64 * 1024);
     InvertedIndex inverted_index;
+    if (memory_budget_mib > 0) {
+        inverted_index.set_memory_budget(
+            memory_budget_mib * 1024 * 1024,
+            root_dir_str + "/.parallel_index.spill");
+    }
+    // One padded counter slot per pipeline thread; summed for progress
+    // lines and the final per-stage breakdown.
+    IndexingStats stats(static_cast<size_t>(num_reader_threads),
+                        static_cast<size_t>(num_indexer_threads));
+
+    // --- Stats export wiring ---
+    // Every section of the machine-readable dump ('stats' command, or
+    // SIGUSR1) registers here. The pipeline section reads the tick
+    // aggregate the progress monitor publishes through this seqlock -
+    // one consistent copy per dump, no walk over the live worker
+    // counters; the queue and index sections read counters that are
+    // already safe to sample in flight (relaxed atomics, striped
+    // counters). All captured objects live in this scope and outlive
+    // the search loop, which is the last place a dump can happen.
+    cds::seqlock<PublishedBuildStats> published_build;
+    StatsRegistry::instance().register_provider(
+        "build", [&published_build](JsonWriter& w) {
+            const PublishedBuildStats s = published_build.load();
+            w.field("done", s.build_done != 0);
+            w.field("elapsed_ms", s.elapsed_ms);
+            w.field("reader_files", s.reader_files);
+            w.field("reader_bytes", s.reader_bytes);
+            w.field("reader_queue_wait_ns", s.reader_queue_wait_ns);
+            w.field("indexer_files", s.indexer_files);
+            w.field("indexer_tokens", s.indexer_tokens);
+            w.field("indexer_queue_wait_ns", s.indexer_queue_wait_ns);
+            w.field("indexer_merge_ns", s.indexer_merge_ns);
+        });
+    StatsRegistry::instance().register_provider(
+        "queues", [&file_queue, &content_queue](JsonWriter& w) {
+            const auto emit =
+                [&w](const char* name, uint64_t depth,
+                     const cds::latency_histogram::snapshot_data& waits) {
+                    w.begin_object(name);
+                    w.field("depth", depth);
+                    w.field("wait_count", waits.total);
+                    w.field("wait_p50_ns", waits.percentile(0.50));
+                    w.field("wait_p90_ns", waits.percentile(0.90));
+                    w.field("wait_p99_ns", waits.percentile(0.99));
+                    w.end_object();
+                };
+            emit("file", file_queue.size(), file_queue.wait_snapshot());
+            emit("content", content_queue.size(),
+                 content_queue.wait_snapshot());
+        });
+    StatsRegistry::instance().register_provider(
+        "index", [&inverted_index](JsonWriter& w) {
+            w.field("unique_words",
+                    static_cast<uint64_t>(inverted_index.size()));
+            w.field("memory_bytes",
+                    static_cast<uint64_t>(inverted_index.memory_usage()));
+            const InvertedIndex::CacheStats cache =
+                inverted_index.cache_stats();
+            w.field("cache_hits", static_cast<uint64_t>(cache.hits));
+            w.field("cache_misses", static_cast<uint64_t>(cache.misses));
+            const InvertedIndex::SpillStats spill =
+                inverted_index.spill_stats();
+            w.field("spilled_words", static_cast<uint64_t>(spill.words));
+            w.field("spilled_bytes", static_cast<uint64_t>(spill.bytes));
+        });
+
+    // SIGUSR1-triggered stats dump, live from here on whichever path the
+    // run takes (full build, incremental, or snapshot-only): the handler
+    // only flips a flag, and this watcher turns it into a JSON document
+    // on stdout from a normal thread context. A 200 ms poll is invisible
+    // next to the pipeline, and a scrape is not latency-sensitive.
+    std::signal(SIGUSR1, request_stats_dump);
+    ThreadGroup stats_group("stats");
+    stats_group.spawn([](std::stop_token stop) {
+        while (!stop.stop_requested()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            if (g_stats_dump_requested.exchange(false,
+                                                std::memory_order_relaxed)) {
+                std::cout << StatsRegistry::instance().dump_json()
+                          << std::endl;
+            }
+        }
+    });
 
     // --- Indexing Phase ---
     auto start_time = std::chrono::high_resolution_clock::now();
 
     // 1. Create and start the FileScanner thread
     // The scanner will discover files and push them into 'file_queue'.
-    // std::thread is used, so we must explicitly call .join() later.
-    FileScanner scanner(root_dir_str, file_queue);
-    std::thread scanner_thread([&scanner]{ scanner.start_scanning(); });
-
-    // 2. Create and start multiple IndexerWorker threads
-    // Each worker will pull files from 'file_queue' and update 'inverted_index'.
-    // We use unique_ptr to manage the lifetime of IndexerWorker objects as they are non-copyable/movable.
-    std::vector<std::unique_ptr<IndexerWorker>> worker_objects;
-    std::vector<std::thread> worker_threads;
-
-    for (int i = 0; i < num_indexer_threads; ++i) {
-        // Create a unique IndexerWorker object
-        auto worker = std::make_unique<IndexerWorker>(file_queue, inverted_index);
-
-        // Store the unique_ptr in the vector. std::vector::push_back can take a movable unique_ptr.
-        worker_objects.push_back(std::move(worker));
-
-        // Start a thread. The lambda captures a raw pointer to the worker object.
-        // This is safe because worker_objects ensures the lifetime of the object,
-        // and all threads will be joined before worker_objects goes out of scope.
-        worker_threads.emplace_back([worker_ptr = worker_objects.back().get()]() {
-            (*worker_ptr)(); // Call the operator() of the IndexerWorker object
-        });
+    // In incremental mode it is given the snapshot's manifest and only
+    // enqueues new or modified files.
+    // The scan diffs against base+delta, so a file already re-indexed by a
+    // logged run is only queued again if it changed since that run.
+    FileManifest baseline_manifest;
+    std::unique_ptr<FileScanner> scanner_ptr;
+    if (mapped) {
+        baseline_manifest =
+            delta.empty()
+                ? mapped->manifest()
+                : IndexDeltaLog::overlay_manifest(mapped->manifest(), delta);
+        scanner_ptr = std::make_unique<FileScanner>(root_dir_str, file_queue,
+                                                    baseline_manifest);
+    } else {
+        scanner_ptr = std::make_unique<FileScanner>(root_dir_str, file_queue);
     }
+    FileScanner& scanner = *scanner_ptr;
 
-    std::cout << "Indexing started for directory: " << root_dir_str << " with " << num_indexer_threads << " worker threads." << std::endl;
+    if (mapped) {
+        // Incremental mode: the scan is stat-only and cheap, so run it
+        // synchronously to learn the delta before deciding anything.
+        scanner.start_scanning();
 
-    // Wait for the scanner thread to finish its work and close the file queue.
-    scanner_thread.join();
+        const bool nothing_removed =
+            scanner.kept_file_ids().size() == baseline_manifest.size();
+        // A pending delta means the mapping alone is stale; fall through
+        // to the rebuild path, which overlays the log and publishes.
+        if (delta.empty() && scanner.enqueued_count() == 0 && nothing_removed) {
+            // Corpus untouched: serve queries straight from the mapping.
+            auto load_end_time = std::chrono::high_resolution_clock::now();
+            auto load_us = std::chrono::duration_cast<std::chrono::microseconds>(load_end_time - load_start_time);
+            std::cout << "Corpus unchanged; serving snapshot " << snapshot_path
+                      << " (" << mapped->word_count() << " words, "
+                      << mapped->file_count() << " files), ready in "
+                      << load_us.count() << " us." << std::endl;
+            std::cout << "Delete the snapshot to force a full re-index." << std::endl;
+            IndexHandle handle;
+            // Keep a reference past the publish: at exit the mapping's
+            // per-page access counts become the next run's warm-start
+            // prefetch list.
+            const std::shared_ptr<IndexSnapshot::MappedIndex> serving = mapped;
+            handle.publish(make_snapshot_generation(std::move(mapped)));
+            // No pipeline ran, but the 'stats' command should still have
+            // a document: what is being served, and from where. The
+            // captured shared_ptr keeps the mapping alive for the
+            // provider's whole lifetime.
+            StatsRegistry::instance().register_provider(
+                "snapshot", [serving, snapshot_path](JsonWriter& w) {
+                    w.field("path", snapshot_path);
+                    w.field("words",
+                            static_cast<uint64_t>(serving->word_count()));
+                    w.field("files",
+                            static_cast<uint64_t>(serving->file_count()));
+                });
+            run_search_loop(handle);
+            stats_group.request_stop();
+            stats_group.join_all();
+            serving->save_hot_pages();
+            std::cout << "Exiting ParallelIndex. Goodbye!" << std::endl;
+            return 0;
+        }
+    }
 
-    // Wait for all worker threads to finish. They will naturally exit their loops
-    // once the file queue is closed AND becomes empty.
-    for (auto& t : worker_threads) {
-        t.join();
+    // --- RCU-style generation swap ---
+    // The rebuild runs entirely off to the side while the search loop is
+    // already live: queries go through the handle and see the previous
+    // snapshot (or an empty index on a first run) until the background
+    // build publishes its finished generation with one atomic pointer
+    // swap. Readers therefore never block on the writers' exclusive shard
+    // locks, no matter how long the re-index takes.
+    IndexHandle handle;
+    if (mapped) {
+        handle.publish(make_snapshot_generation(mapped));
+        std::cout << "Serving the previous snapshot while re-indexing in the "
+                     "background." << std::endl;
+    } else {
+        handle.publish(make_empty_generation());
+        std::cout << "First run: queries return nothing until the initial "
+                     "index is published." << std::endl;
     }
 
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    // Cooperative cancellation for the whole build: the search loop's
+    // 'stop' command signals this source, and the scanner and both worker
+    // stages carry its token. Discovery halts, workers finish the batch
+    // in hand and exit, and the build thread sweeps what they left.
+    std::stop_source build_stop;
 
-    std::cout << "\n--- Indexing Complete ---" << std::endl;
-    std::cout << "Total unique words indexed: " << inverted_index.size() << std::endl;
-    std::cout << "Indexing time: " << duration_ms.count() << " ms" << std::endl;
+    std::atomic<bool> build_done{false};
+    std::thread build_thread([&] {
+        if (mapped) {
+            // Rebuild unchanged files' postings from the snapshot (one linear
+            // pass; the compressed position blobs are carried over verbatim);
+            // removed and modified files are tombstoned simply by not carrying
+            // their postings over.
+            const auto& kept = scanner.kept_file_ids();
+            size_t carried = 0;
+            mapped->visit_all([&](std::string_view word,
+                                  std::vector<PostingCodec::PackedOccurrence>&& occurrences) {
+                std::vector<PostingCodec::PackedOccurrence> keep;
+                keep.reserve(occurrences.size());
+                for (auto& occ : occurrences) {
+                    if (kept.count(occ.file_id) != 0) {
+                        keep.push_back(std::move(occ));
+                    }
+                }
+                if (!keep.empty()) {
+                    ++carried;
+                    inverted_index.restore(word, std::move(keep));
+                }
+            });
+            // Fold in the logged runs' postings. Ids superseded since the
+            // append (files re-modified this run, or within a later
+            // segment) are dropped by the same kept filter as the base
+            // carry above; delta ids always postdate base ids, so the
+            // merged lists stay sorted.
+            size_t overlaid = 0;
+            for (auto& [word, occurrences] : delta.postings) {
+                std::vector<PostingCodec::PackedOccurrence> live;
+                live.reserve(occurrences.size());
+                for (auto& occ : occurrences) {
+                    if (kept.count(occ.file_id) != 0) {
+                        live.push_back(std::move(occ));
+                    }
+                }
+                if (!live.empty()) {
+                    ++overlaid;
+                    inverted_index.restore_merge(word, std::move(live));
+                }
+            }
+            delta.postings.clear();
+            // Drop our reference to the old snapshot; the published generation
+            // keeps the mapping alive until the swap retires it, so in-flight
+            // queries are unaffected (the rename on save replaces the file but
+            // not the mapped inode).
+            mapped.reset();
+            std::cout << "Incremental re-index: " << scanner.enqueued_count()
+                      << " new/changed files, " << kept.size()
+                      << " unchanged (postings for " << carried
+                      << " words carried over)." << std::endl;
+            if (overlaid > 0) {
+                std::cout << "Delta log overlay: postings for " << overlaid
+                          << " words folded in from " << delta.segments
+                          << " segment(s)." << std::endl;
+            }
+        }
 
-    // --- Search Phase ---
-    std::string query;
-    std::cout << "\n--- Search Mode ---" << std::endl;
-    std::cout << "Enter 'q' or 'quit' to exit." << std::endl;
+        ThreadGroup scanner_group("scan");
+        if (!incremental) {
+            // Full scan: overlap discovery with indexing as before.
+            scanner_group.spawn([&scanner, token = build_stop.get_token()] {
+                scanner.start_scanning(token);
+            });
+        }
 
-    while (true) {
-        std::cout << "\nEnter word to search: ";
-        std::getline(std::cin, query); // Use getline to handle spaces in query (though we only tokenize single words)
+        // 2. Create and start the pipeline stages: ReaderWorker threads doing
+        // the I/O (file queue in, loaded contents out) and IndexerWorker
+        // threads doing the CPU work (contents in, index updates out). The two
+        // stages are sized independently so neither disks nor cores sit idle
+        // waiting for the other.
+        // We use unique_ptr to manage the lifetime of the worker objects as they are non-copyable/movable.
+        std::vector<std::unique_ptr<ReaderWorker>> reader_objects;
+        ThreadGroup reader_threads("reader");
+        std::vector<std::unique_ptr<IndexerWorker>> worker_objects;
+        // Indexers are pinned round-robin so each worker's shard working
+        // set stays in one core's cache instead of migrating.
+        ThreadGroup worker_threads("indexer");
 
-        if (query == "q" || query == "quit") {
-            break;
+        for (int i = 0; i < num_reader_threads; ++i) {
+            reader_objects.push_back(std::make_unique<ReaderWorker>(
+                file_queue, content_queue, buffer_pool,
+                stats.reader(static_cast<size_t>(i))));
+            reader_threads.spawn([reader_ptr = reader_objects.back().get(),
+                                  token = build_stop.get_token()]() {
+                (*reader_ptr)(token);
+            });
         }
-        if (query.empty()) {
-            continue;
+
+        for (int i = 0; i < num_indexer_threads; ++i) {
+            // Create a unique IndexerWorker object
+            auto worker = std::make_unique<IndexerWorker>(content_queue, inverted_index,
+                                                          buffer_pool,
+                                                          stats.indexer(static_cast<size_t>(i)));
+
+            // Store the unique_ptr in the vector. std::vector::push_back can take a movable unique_ptr.
+            worker_objects.push_back(std::move(worker));
+
+            // Start a thread. The lambda captures a raw pointer to the worker object.
+            // This is safe because worker_objects ensures the lifetime of the object,
+            // and all threads will be joined before worker_objects goes out of scope.
+            const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+            worker_threads.spawn_pinned(static_cast<int>(i % hw),
+                                        [worker_ptr = worker_objects.back().get(),
+                                         token = build_stop.get_token()]() {
+                (*worker_ptr)(token); // Call the operator() of the IndexerWorker object
+            });
         }
 
-        std::string processed_query = Utils::to_lower(query); // Convert query to lowercase for consistent search
+        std::cout << "Indexing started for directory: " << root_dir_str << " with "
+                  << num_reader_threads << " reader and "
+                  << num_indexer_threads << " worker threads." << std::endl;
 
-        auto search_start_time = std::chrono::high_resolution_clock::now();
-        std::vector<WordOccurrence> results = inverted_index.search(processed_query);
-        auto search_end_time = std::chrono::high_resolution_clock::now();
-        auto search_duration_us = std::chrono::duration_cast<std::chrono::microseconds>(search_end_time - search_start_time);
+        // Periodic progress line: a monitor thread samples the counters every
+        // couple of seconds while the pipeline runs. Fast runs finish before
+        // the first tick and print nothing.
+        // Packs one sampling of the stage totals for the seqlock; shared
+        // by the per-tick publication below and the final one at drain.
+        const auto pack_build_stats = [start_time](
+                                          const IndexingStats::Totals& read,
+                                          const IndexingStats::Totals& indexed,
+                                          bool done) {
+            PublishedBuildStats s;
+            s.reader_files = read.files;
+            s.reader_bytes = read.bytes;
+            s.reader_queue_wait_ns = read.queue_wait_ns;
+            s.indexer_files = indexed.files;
+            s.indexer_tokens = indexed.tokens;
+            s.indexer_queue_wait_ns = indexed.queue_wait_ns;
+            s.indexer_merge_ns = indexed.index_wait_ns;
+            s.elapsed_ms = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::high_resolution_clock::now() - start_time)
+                    .count());
+            s.build_done = done ? 1 : 0;
+            return s;
+        };
 
-        if (results.empty()) {
-            std::cout << "No matches found for '" << query << "'." << std::endl;
-        } else {
-            // Collect unique file IDs to display paths only once per file
-            std::set<size_t> matched_file_ids;
-            for(const auto& occ : results) {
-                matched_file_ids.insert(occ.file_id);
+        ThreadGroup progress_group("progress");
+        progress_group.spawn([&stats, &published_build, start_time,
+                              pack_build_stats](std::stop_token stop) {
+            using namespace std::chrono;
+            auto next_tick = steady_clock::now() + seconds(2);
+            while (!stop.stop_requested()) {
+                std::this_thread::sleep_for(milliseconds(100));
+                if (stop.stop_requested() || steady_clock::now() < next_tick) {
+                    continue;
+                }
+                next_tick += seconds(2);
+                const IndexingStats::Totals read = stats.reader_totals();
+                const IndexingStats::Totals indexed = stats.indexer_totals();
+                // Publish the tick's aggregate for the stats export before
+                // printing the human-facing line from the same numbers.
+                published_build.store(pack_build_stats(read, indexed, false));
+                const double elapsed_s =
+                    duration_cast<duration<double>>(high_resolution_clock::now() -
+                                                    start_time).count();
+                const double mib = static_cast<double>(read.bytes) / (1024.0 * 1024.0);
+                std::cout << "[Progress] read " << read.files << " files ("
+                          << static_cast<uint64_t>(mib) << " MiB), indexed "
+                          << indexed.files << " (" << indexed.tokens << " tokens), "
+                          << static_cast<uint64_t>(mib / elapsed_s) << " MiB/s"
+                          << std::endl;
             }
+        });
 
-            std::cout << "Found '" << query << "' in " << matched_file_ids.size() << " unique files (" << results.size() << " occurrences total):" << std::endl;
-            for (size_t file_id : matched_file_ids) {
-                std::cout << "- File ID: " << file_id << std::endl;
-                // Example of how you'd use g_file_id_to_path_map if populated:
-                // if (g_file_id_to_path_map.count(file_id)) {
-                //     std::cout << "- File: " << g_file_id_to_path_map[file_id] << std::endl;
-                // } else {
-                //     std::cout << "- File ID: " << file_id << " (Path not available)" << std::endl;
-                // }
+        // Wait for the scanner thread to finish its work and close the file
+        // queue (in incremental mode the scan already ran synchronously).
+        scanner_group.join_all();
+
+        // The readers drain the file queue, then the content queue is closed so
+        // the indexers know no more payloads are coming.
+        reader_threads.join_all();
+
+        // A stop makes the workers back out with entries still queued, on
+        // purpose - not loading them is the saving. Sweep them here:
+        // their manifest entries must be pruned below (a file listed in
+        // the manifest but never indexed would be considered up to date
+        // and skipped by every future incremental scan), and swept
+        // payloads hold buffers and mappings that need releasing.
+        std::unordered_set<std::string> dropped_paths;
+        while (std::optional<FileInfo> leftover = file_queue.pop()) {
+            dropped_paths.insert(leftover->path);
+        }
+        // Payloads a reader loaded but could not hand off (stop-aware
+        // push backed out of a full queue) were released by the reader;
+        // only their paths survive, for the same manifest pruning.
+        for (const auto& reader : reader_objects) {
+            for (const std::string& path : reader->dropped_paths()) {
+                dropped_paths.insert(path);
             }
         }
-        std::cout << "Search time: " << search_duration_us.count() << " us" << std::endl;
+
+        content_queue.close();
+
+        // Wait for all worker threads to finish. They will naturally exit their loops
+        // once the content queue is closed AND becomes empty.
+        worker_threads.join_all();
+
+        while (std::optional<FileContent> leftover = content_queue.pop()) {
+            dropped_paths.insert(leftover->info.path);
+            if (leftover->mapped != nullptr) {
+                munmap(leftover->mapped, leftover->mapped_length);
+            } else {
+                buffer_pool.release(std::move(leftover->buffer));
+            }
+        }
+
+        progress_group.request_stop();
+        progress_group.join_all();
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+        std::cout << "\n--- Indexing Complete ---" << std::endl;
+        std::cout << "Total unique words indexed: " << inverted_index.size() << std::endl;
+        std::cout << "Indexing time: " << duration_ms.count() << " ms" << std::endl;
+
+        // Per-stage breakdown: whichever stage shows the big queue wait is the
+        // one waiting on the other, which is what to tune thread counts by.
+        const IndexingStats::Totals read = stats.reader_totals();
+        const IndexingStats::Totals indexed = stats.indexer_totals();
+        // Final publication: the counters are quiescent now, so dumps taken
+        // any time after this see the completed build's exact totals.
+        published_build.store(pack_build_stats(read, indexed, true));
+        const auto to_ms = [](uint64_t ns) { return ns / 1000000; };
+        std::cout << "Readers:  " << read.files << " payloads, "
+                  << read.bytes / 1024 << " KiB read, "
+                  << to_ms(read.queue_wait_ns) << " ms queue wait." << std::endl;
+        std::cout << "Indexers: " << indexed.files << " payloads, "
+                  << indexed.tokens << " tokens, "
+                  << to_ms(indexed.queue_wait_ns) << " ms queue wait, "
+                  << to_ms(indexed.index_wait_ns) << " ms merging." << std::endl;
+        // Queue-residency distributions (PARALLEL_INDEX_QUEUE_WAITS builds
+        // only; all-zero and skipped otherwise). How long items sat in
+        // each queue is the direct signal for rebalancing thread counts:
+        // a fat content-queue tail means add indexers, a fat file-queue
+        // tail means add readers.
+        const auto print_waits = [](const char* name,
+                                    const cds::latency_histogram::snapshot_data& w) {
+            std::cout << name << " residency: p50 <= "
+                      << w.percentile(0.50) / 1000 << " us, p90 <= "
+                      << w.percentile(0.90) / 1000 << " us, p99 <= "
+                      << w.percentile(0.99) / 1000 << " us ("
+                      << w.total << " items)." << std::endl;
+        };
+        if (const auto file_waits = file_queue.wait_snapshot();
+            file_waits.total != 0) {
+            print_waits("File queue", file_waits);
+        }
+        if (const auto content_waits = content_queue.wait_snapshot();
+            content_waits.total != 0) {
+            print_waits("Content queue", content_waits);
+        }
+        std::cout << "Index memory: "
+                  << inverted_index.memory_usage() / 1024 << " KiB";
+        if (memory_budget_mib > 0) {
+            const InvertedIndex::SpillStats spill = inverted_index.spill_stats();
+            std::cout << " (budget " << memory_budget_mib << " MiB; "
+                      << spill.words << " posting lists spilled, "
+                      << spill.bytes / 1024 << " KiB on disk)";
+        }
+        std::cout << "." << std::endl;
+
+        // Resolve file IDs to paths for search output and for the snapshot.
+        // Must happen before the publish: generation loads synchronize with it.
+        g_file_table = scanner.file_table();
+
+        // Publish the finished build. Queries switch to it on their next
+        // generation load; the previous generation (the old mapping, if any)
+        // is retired once its last in-flight query completes.
+        handle.publish(make_index_generation(inverted_index));
+        std::cout << "New index generation published; queries now see the "
+                     "rebuilt index." << std::endl;
+
+        // Persist so the next run skips straight to search mode. A full
+        // build rewrites the base snapshot; an incremental run appends one
+        // delta-log segment instead, so the write scales with the change,
+        // not the corpus. Once the log outgrows a quarter of the base it
+        // is compacted: a fresh full snapshot from the index this thread
+        // already holds, written here in the background while the search
+        // loop serves the published generation.
+        // A stopped run persists only what it actually indexed: swept
+        // files leave the manifest, so the next run re-discovers and
+        // indexes them. (A chunked file with only some chunks indexed is
+        // dropped whole; its orphaned postings are shed by the next
+        // run's carry-over, which keeps manifest-listed ids only.)
+        FileManifest pruned_manifest;
+        const FileManifest* current_manifest = &scanner.manifest();
+        if (!dropped_paths.empty()) {
+            pruned_manifest = scanner.manifest();
+            for (const std::string& path : dropped_paths) {
+                pruned_manifest.erase(path);
+            }
+            current_manifest = &pruned_manifest;
+            std::cout << "[Stop] " << dropped_paths.size()
+                      << " file(s) left unindexed and pruned from the "
+                         "manifest; the next run picks them up." << std::endl;
+        }
+
+        auto save_start_time = std::chrono::high_resolution_clock::now();
+        bool write_full = !incremental;
+        if (incremental) {
+            const auto& kept = scanner.kept_file_ids();
+            std::unordered_set<size_t> changed_ids;
+            for (const auto& [path, entry] : *current_manifest) {
+                if (kept.count(entry.id) == 0) {
+                    changed_ids.insert(entry.id);
+                }
+            }
+            std::vector<size_t> removed_ids;
+            for (const auto& [path, entry] : baseline_manifest) {
+                if (kept.count(entry.id) == 0) {
+                    removed_ids.push_back(entry.id);
+                }
+            }
+
+            if (!changed_ids.empty() || !removed_ids.empty()) {
+                if (IndexDeltaLog::append(delta_path, inverted_index,
+                                          changed_ids, removed_ids,
+                                          *current_manifest)) {
+                    auto append_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::high_resolution_clock::now() - save_start_time);
+                    std::cout << "Delta segment appended to " << delta_path
+                              << " (" << changed_ids.size() << " changed, "
+                              << removed_ids.size() << " removed file(s)) in "
+                              << append_ms.count() << " ms." << std::endl;
+                } else {
+                    write_full = true; // Append failed: fall back to a full write.
+                }
+            }
+            if (!write_full) {
+                std::error_code base_ec, log_ec;
+                const uintmax_t base_bytes =
+                    std::filesystem::file_size(snapshot_path, base_ec);
+                const uintmax_t log_bytes =
+                    std::filesystem::file_size(delta_path, log_ec);
+                if (!base_ec && !log_ec &&
+                    IndexDeltaLog::should_compact(log_bytes, base_bytes)) {
+                    std::cout << "Delta log (" << log_bytes / 1024
+                              << " KiB) outgrew the base snapshot ("
+                              << base_bytes / 1024
+                              << " KiB); compacting." << std::endl;
+                    write_full = true;
+                }
+            }
+        }
+        if (write_full) {
+            if (IndexSnapshot::save(snapshot_path, inverted_index, *current_manifest)) {
+                IndexDeltaLog::discard(delta_path); // Subsumed by the new base.
+                auto save_end_time = std::chrono::high_resolution_clock::now();
+                auto save_ms = std::chrono::duration_cast<std::chrono::milliseconds>(save_end_time - save_start_time);
+                std::cout << "Snapshot written to " << snapshot_path << " in " << save_ms.count() << " ms." << std::endl;
+            }
+        }
+
+        build_done.store(true);
+    }); // build_thread
+
+    // --- Search Phase ---
+    // Live from the start: the loop serves whatever generation is current,
+    // so it never waits on the build above; 'stop' cancels the build.
+    run_search_loop(handle, &build_stop);
+
+    if (!build_done.load()) {
+        std::cout << "Waiting for the background re-index to finish..." << std::endl;
     }
+    build_thread.join();
+
+    stats_group.request_stop();
+    stats_group.join_all();
 
+    const InvertedIndex::CacheStats cache_stats = inverted_index.cache_stats();
+    std::cout << "Query cache: " << cache_stats.hits << " hits, "
+              << cache_stats.misses << " misses." << std::endl;
     std::cout << "Exiting ParallelIndex. Goodbye!" << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,383 @@
+// End-to-end scheduler benchmark: synthetic DAG workloads plus replay of
+// production trace shapes, reported as tasks/sec and submit/dispatch
+// latency percentiles per thread configuration - the fixed baseline
+// every queue or lock change gets measured against.
+//
+// Synthetic workloads:
+//   chain    - independent chains of dependent tasks (pure edge-wiring
+//              and completion-cascade cost).
+//   fanout   - root -> W children -> join, repeated (batch submission,
+//              fan-in counting, wide ready bursts).
+//   mixed    - independent tasks at mixed priorities with bodies drawn
+//              log-uniform from ~100 ns to ~1 ms plus a 10 ms tail, so
+//              dispatch sees both churn and occupancy.
+//
+// Trace replay: pass a JSON file as the last argument. The format is the
+// shape export we pull from production:
+//
+//   {"tasks": [{"id": 0, "deps": [], "us": 50, "priority": "high"}, ...]}
+//
+// "us" (body microseconds, default 10) and "priority" (low/normal/high,
+// default normal) are optional; "deps" lists ids that appear earlier in
+// the array. The parser is deliberately minimal - it reads exactly this
+// shape, not general JSON.
+//
+// Usage: SchedulerBench [tasks_per_workload] [trace.json]
+#include "scheduler/task_scheduler.hpp"
+#include "../../Concurrent-Data-Structures/sync/latency_histogram.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// The worker counts each workload runs at.
+const std::vector<size_t> kThreadConfigs = {
+    1, 2, std::max<size_t>(4, std::thread::hardware_concurrency())};
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+// Busy body: occupies a worker for roughly 'ns' without sleeping, so the
+// scheduler sees real occupancy, not blocked threads.
+void spin_for(uint64_t ns) {
+    const uint64_t deadline = now_ns() + ns;
+    while (now_ns() < deadline) {
+    }
+}
+
+// One task in a workload: its dependencies (indices of earlier entries),
+// body length, and priority.
+struct BenchTask {
+    std::vector<size_t> deps;
+    uint64_t body_ns = 0;
+    Priority priority = Priority::NORMAL;
+};
+
+// A workload is a topologically ordered task list (deps always point at
+// earlier entries, like a production DAG export).
+struct Workload {
+    std::string name;
+    std::vector<BenchTask> tasks;
+};
+
+Workload make_chains(size_t total) {
+    // 64 chains: deep enough that completion cascades dominate, parallel
+    // enough that every worker has a chain to walk.
+    constexpr size_t kChains = 64;
+    Workload w{"chain", {}};
+    w.tasks.resize(total);
+    for (size_t i = 0; i < total; ++i) {
+        w.tasks[i].body_ns = 200;
+        if (i >= kChains) {
+            w.tasks[i].deps.push_back(i - kChains);
+        }
+    }
+    return w;
+}
+
+Workload make_fanout(size_t total) {
+    // Repeated root -> 32 children -> join diamonds.
+    constexpr size_t kWidth = 32;
+    Workload w{"fanout", {}};
+    size_t i = 0;
+    while (i + kWidth + 2 <= total) {
+        const size_t root = i;
+        w.tasks.push_back({{}, 500, Priority::NORMAL});
+        BenchTask join;
+        join.body_ns = 500;
+        for (size_t c = 0; c < kWidth; ++c) {
+            w.tasks.push_back({{root}, 2000, Priority::NORMAL});
+            join.deps.push_back(root + 1 + c);
+        }
+        w.tasks.push_back(std::move(join));
+        i += kWidth + 2;
+    }
+    return w;
+}
+
+Workload make_mixed(size_t total) {
+    Workload w{"mixed", {}};
+    w.tasks.resize(total);
+    std::mt19937 rng(42); // Fixed seed: identical workload run to run.
+    // Log-uniform over [100 ns, 1 ms]; every 200th task is a 10 ms hog,
+    // the tail that priority dispatch has to work around.
+    std::uniform_real_distribution<double> exponent(2.0, 6.0);
+    std::uniform_int_distribution<int> priority(0, 2);
+    for (size_t i = 0; i < total; ++i) {
+        w.tasks[i].body_ns =
+            i % 200 == 199
+                ? 10'000'000
+                : static_cast<uint64_t>(std::pow(10.0, exponent(rng)));
+        w.tasks[i].priority = static_cast<Priority>(priority(rng));
+    }
+    return w;
+}
+
+// --- Trace replay -----------------------------------------------------
+
+// Minimal reader for the production shape export documented above. Any
+// deviation from that shape fails loudly rather than guessing.
+Workload load_trace(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("cannot open trace: " + path);
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+
+    Workload w{"replay:" + path, {}};
+    std::vector<size_t> index_of_id; // id -> position in w.tasks.
+    size_t pos = 0;
+    auto skip_ws = [&] {
+        while (pos < text.size() &&
+               std::isspace(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+    };
+    auto expect = [&](char c) {
+        skip_ws();
+        if (pos >= text.size() || text[pos] != c) {
+            throw std::runtime_error("trace parse error near offset " +
+                                     std::to_string(pos) + ": expected '" +
+                                     c + "'");
+        }
+        ++pos;
+    };
+    auto read_string = [&] {
+        expect('"');
+        std::string s;
+        while (pos < text.size() && text[pos] != '"') {
+            s += text[pos++];
+        }
+        expect('"');
+        return s;
+    };
+    auto read_number = [&] {
+        skip_ws();
+        size_t end = pos;
+        while (end < text.size() &&
+               (std::isdigit(static_cast<unsigned char>(text[end])) ||
+                text[end] == '-')) {
+            ++end;
+        }
+        const uint64_t value = std::stoull(text.substr(pos, end - pos));
+        pos = end;
+        return value;
+    };
+
+    expect('{');
+    if (read_string() != "tasks") {
+        throw std::runtime_error("trace must start with a \"tasks\" array");
+    }
+    expect(':');
+    expect('[');
+    skip_ws();
+    while (pos < text.size() && text[pos] == '{') {
+        expect('{');
+        BenchTask task;
+        task.body_ns = 10'000; // Default body: 10 us.
+        uint64_t id = 0;
+        bool saw_id = false;
+        while (true) {
+            const std::string key = read_string();
+            expect(':');
+            if (key == "id") {
+                id = read_number();
+                saw_id = true;
+            } else if (key == "us") {
+                task.body_ns = read_number() * 1000;
+            } else if (key == "priority") {
+                const std::string p = read_string();
+                task.priority = p == "high"     ? Priority::HIGH
+                                : p == "low"    ? Priority::LOW
+                                                : Priority::NORMAL;
+            } else if (key == "deps") {
+                expect('[');
+                skip_ws();
+                while (text[pos] != ']') {
+                    const uint64_t dep = read_number();
+                    if (dep >= index_of_id.size()) {
+                        throw std::runtime_error(
+                            "trace dep " + std::to_string(dep) +
+                            " does not precede its dependent");
+                    }
+                    task.deps.push_back(index_of_id[dep]);
+                    skip_ws();
+                    if (text[pos] == ',') {
+                        ++pos;
+                        skip_ws();
+                    }
+                }
+                expect(']');
+            } else {
+                throw std::runtime_error("unknown trace key: " + key);
+            }
+            skip_ws();
+            if (text[pos] == ',') {
+                ++pos;
+                continue;
+            }
+            break;
+        }
+        expect('}');
+        if (!saw_id) {
+            throw std::runtime_error("trace task without an id");
+        }
+        if (id >= index_of_id.size()) {
+            index_of_id.resize(id + 1, SIZE_MAX);
+        }
+        index_of_id[id] = w.tasks.size();
+        w.tasks.push_back(std::move(task));
+        skip_ws();
+        if (pos < text.size() && text[pos] == ',') {
+            ++pos;
+            skip_ws();
+        }
+    }
+    expect(']');
+    expect('}');
+    return w;
+}
+
+// --- Measurement ------------------------------------------------------
+
+struct RunReport {
+    double seconds = 0.0;
+    size_t tasks = 0;
+    cds::latency_histogram::snapshot_data submit;
+    cds::latency_histogram::snapshot_data dispatch;
+};
+
+// Runs one workload on a fresh scheduler. Submit latency is the wall
+// time of each submit_task call. Dispatch latency (submission to body
+// start) is recorded for dependency-free tasks only - for a dependent
+// task it would mostly measure its predecessors' runtimes, not the
+// scheduler's dispatch path.
+RunReport run_workload(const Workload& workload, size_t threads) {
+    TaskScheduler scheduler(threads);
+    cds::latency_histogram submit_hist;
+    cds::latency_histogram dispatch_hist;
+
+    std::vector<TaskId> ids(workload.tasks.size());
+    std::vector<TaskId> deps;
+
+    const uint64_t start = now_ns();
+    for (size_t i = 0; i < workload.tasks.size(); ++i) {
+        const BenchTask& task = workload.tasks[i];
+        deps.clear();
+        for (size_t dep : task.deps) {
+            deps.push_back(ids[dep]);
+        }
+        const uint64_t body_ns = task.body_ns;
+        const uint64_t submitted = now_ns();
+        if (deps.empty()) {
+            ids[i] = scheduler.submit_task(
+                [body_ns, submitted, &dispatch_hist] {
+                    dispatch_hist.record(now_ns() - submitted);
+                    spin_for(body_ns);
+                },
+                task.priority);
+        } else {
+            ids[i] = scheduler.submit_task([body_ns] { spin_for(body_ns); },
+                                           task.priority, deps);
+        }
+        submit_hist.record(now_ns() - submitted);
+    }
+    scheduler.wait_for_all();
+
+    RunReport report;
+    report.seconds = static_cast<double>(now_ns() - start) / 1e9;
+    report.tasks = workload.tasks.size();
+    report.submit = submit_hist.snapshot();
+    report.dispatch = dispatch_hist.snapshot();
+    scheduler.shutdown();
+    return report;
+}
+
+void print_report(const Workload& workload, size_t threads,
+                  const RunReport& r) {
+    const auto us = [](uint64_t ns) {
+        return static_cast<double>(ns) / 1000.0;
+    };
+    std::cout << std::left << std::setw(16) << workload.name << std::right
+              << std::setw(8) << threads << std::setw(11)
+              << static_cast<uint64_t>(static_cast<double>(r.tasks) /
+                                       r.seconds)
+              << std::fixed << std::setprecision(1) << std::setw(10)
+              << us(r.submit.percentile(0.50)) << std::setw(10)
+              << us(r.submit.percentile(0.99)) << std::setw(10)
+              << us(r.dispatch.percentile(0.50)) << std::setw(10)
+              << us(r.dispatch.percentile(0.99)) << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    size_t tasks_per_workload = 20000;
+    std::string trace_path;
+    if (argc >= 2) {
+        // Validate rather than let std::stoul throw: '--help' (or any
+        // typo) should print the usage line, not std::terminate.
+        const std::string arg = argv[1];
+        const bool numeric =
+            !arg.empty() && std::all_of(arg.begin(), arg.end(),
+                                        [](unsigned char c) {
+                                            return std::isdigit(c) != 0;
+                                        });
+        try {
+            if (!numeric) {
+                throw std::invalid_argument(arg);
+            }
+            tasks_per_workload = std::stoul(arg);
+        } catch (const std::exception&) {
+            std::cerr << "Usage: SchedulerBench [tasks_per_workload] "
+                         "[trace.json]" << std::endl;
+            return 1;
+        }
+    }
+    if (argc >= 3) {
+        trace_path = argv[2];
+    }
+
+    std::vector<Workload> workloads;
+    workloads.push_back(make_chains(tasks_per_workload));
+    workloads.push_back(make_fanout(tasks_per_workload));
+    workloads.push_back(make_mixed(tasks_per_workload));
+    if (!trace_path.empty()) {
+        workloads.push_back(load_trace(trace_path));
+        std::cout << "Replaying " << workloads.back().tasks.size()
+                  << " tasks from " << trace_path << std::endl;
+    }
+
+    std::cout << std::left << std::setw(16) << "workload" << std::right
+              << std::setw(8) << "threads" << std::setw(11) << "tasks/s"
+              << std::setw(10) << "sub_p50" << std::setw(10) << "sub_p99"
+              << std::setw(10) << "dis_p50" << std::setw(10) << "dis_p99"
+              << "   (latencies in us, <= bucket bounds)" << std::endl;
+    for (const Workload& workload : workloads) {
+        for (size_t threads : kThreadConfigs) {
+            print_report(workload, threads,
+                         run_workload(workload, threads));
+        }
+    }
+    return 0;
+}
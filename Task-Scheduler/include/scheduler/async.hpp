@@ -0,0 +1,66 @@
+#ifndef SCHEDULER_ASYNC_HPP
+#define SCHEDULER_ASYNC_HPP
+
+#include "parallel_reduce.hpp"  // shares reduce_pool() for pool-less calls
+#include "thread_pool.hpp"
+
+#include <future>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace scheduler {
+
+// scheduler::async: std::async's interface without its thread-per-call
+// cost.
+//
+// std::async(launch::async, ...) spawns a fresh OS thread for every
+// invocation - tens of microseconds plus stack pages - which swamps
+// any task shorter than a few milliseconds. This routes the callable
+// through a ThreadPool via std::packaged_task instead: same
+// std::future<R> back, same exception propagation (a throw inside f
+// surfaces from future::get), but the thread cost is amortized to
+// zero after pool startup.
+//
+// Two deliberate differences from std::async:
+//
+//   - the returned future does NOT block in its destructor. Dropping
+//     it means the task still runs, its result discarded - the
+//     fire-and-forget that std::async quietly turns into a join.
+//   - there is no launch::deferred: the task is enqueued immediately.
+//
+// Don't block on one of these futures from INSIDE a pool task unless
+// the pool has spare workers: the waiter occupies the very worker the
+// awaited task may need. That caveat is inherent to any fixed pool.
+
+template<typename F, typename... Args>
+auto async(ThreadPool& pool, F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+{
+    using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+
+    // Arguments are captured by value now (decay-copied, as std::async
+    // does) and applied on the worker.
+    std::packaged_task<R()> task(
+        [fn = std::forward<F>(f),
+         tup = std::make_tuple(std::forward<Args>(args)...)]() mutable -> R {
+            return std::apply(std::move(fn), std::move(tup));
+        });
+    std::future<R> result = task.get_future();
+    pool.enqueue([task = std::move(task)]() mutable { task(); });
+    return result;
+}
+
+// Pool-less overload: runs on the shared pool parallel_reduce and
+// parallel_for_each use, so one worker set serves all three.
+template<typename F, typename... Args,
+         typename = std::enable_if_t<!std::is_convertible_v<F&, ThreadPool&>>>
+auto async(F&& f, Args&&... args)
+{
+    return async(reduce_pool(), std::forward<F>(f),
+                 std::forward<Args>(args)...);
+}
+
+} // namespace scheduler
+
+#endif // SCHEDULER_ASYNC_HPP
@@ -0,0 +1,262 @@
+#pragma once
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// Coroutine layer over the scheduler.
+//
+// task<T> is a lazy coroutine: the body does not run until the task is
+// awaited, and when it finishes its awaiter is resumed by symmetric
+// transfer - a tail-jump on the completing thread. A multi-stage pipeline
+// written as nested co_awaits therefore pays no future/promise allocation
+// and no thread wakeup between stages; only an explicit
+// `co_await scheduler.schedule(priority)` hops threads, and that costs
+// exactly one ready-queue submission.
+//
+// sync_wait() bridges back to blocking code: it starts the task and
+// futex-waits (std::atomic::wait) until it completes.
+
+namespace scheduler {
+
+namespace detail {
+
+// Resumes the awaiting coroutine (if any) when a task body finishes.
+// Returning the continuation handle performs symmetric transfer, so deep
+// pipelines unwind without growing the stack.
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template<typename Promise>
+    std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<Promise> handle) noexcept {
+        auto continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation = nullptr;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }  // Lazy
+    FinalAwaiter final_suspend() noexcept { return {}; }
+};
+
+}  // namespace detail
+
+template<typename T>
+class [[nodiscard]] task {
+public:
+    struct promise_type : detail::PromiseBase {
+        std::variant<std::monostate, T, std::exception_ptr> result;
+
+        task get_return_object() {
+            return task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        void return_value(T value) {
+            result.template emplace<1>(std::move(value));
+        }
+        void unhandled_exception() {
+            result.template emplace<2>(std::current_exception());
+        }
+    };
+
+    task(task&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr)) {}
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+    task& operator=(task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    ~task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    // Awaiting a task starts its body (symmetric transfer into it) and
+    // records the awaiter as the continuation to resume on completion.
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept {
+                return !handle || handle.done();
+            }
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() {
+                auto& result = handle.promise().result;
+                if (result.index() == 2) {
+                    std::rethrow_exception(std::get<2>(std::move(result)));
+                }
+                return std::get<1>(std::move(result));
+            }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    explicit task(std::coroutine_handle<promise_type> handle)
+        : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+template<>
+class [[nodiscard]] task<void> {
+public:
+    struct promise_type : detail::PromiseBase {
+        std::exception_ptr error;
+
+        task get_return_object() {
+            return task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    task(task&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr)) {}
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+    task& operator=(task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    ~task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept {
+                return !handle || handle.done();
+            }
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            void await_resume() {
+                if (handle.promise().error) {
+                    std::rethrow_exception(handle.promise().error);
+                }
+            }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    explicit task(std::coroutine_handle<promise_type> handle)
+        : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+// Helper coroutine for sync_wait: awaits the task, then flips a flag the
+// blocked thread futex-waits on.
+struct SyncWaitTask {
+    struct promise_type {
+        std::atomic<bool>* done = nullptr;
+
+        SyncWaitTask get_return_object() {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept {
+            struct Notify {
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(
+                    std::coroutine_handle<promise_type> handle) const noexcept {
+                    auto* flag = handle.promise().done;
+                    flag->store(true, std::memory_order_release);
+                    flag->notify_one();
+                }
+                void await_resume() const noexcept {}
+            };
+            return Notify{};
+        }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }  // Lambda body catches
+    };
+
+    std::coroutine_handle<promise_type> handle;
+
+    SyncWaitTask(std::coroutine_handle<promise_type> h) : handle(h) {}
+    SyncWaitTask(const SyncWaitTask&) = delete;
+    SyncWaitTask& operator=(const SyncWaitTask&) = delete;
+    ~SyncWaitTask() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+};
+
+// A named coroutine, not a lambda: reference parameters are copied into
+// the coroutine frame, whereas a lambda coroutine reaches its captures
+// through the closure object - a temporary that would be gone by the
+// first real suspension.
+template<typename T, typename Storage>
+SyncWaitTask sync_wait_runner(task<T>& awaitable, std::exception_ptr& error,
+                              Storage& value) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await awaitable;
+        } else {
+            value.emplace(co_await awaitable);
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+}
+
+}  // namespace detail
+
+// Runs the task to completion and returns its result. The calling thread
+// blocks on a futex while the pipeline runs, waking exactly once.
+template<typename T>
+T sync_wait(task<T> awaitable) {
+    std::atomic<bool> done{false};
+    std::exception_ptr error;
+    std::optional<std::conditional_t<std::is_void_v<T>, char, T>> value;
+
+    auto runner = detail::sync_wait_runner(awaitable, error, value);
+    runner.handle.promise().done = &done;
+    runner.handle.resume();
+    done.wait(false, std::memory_order_acquire);
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*value);
+    }
+}
+
+}  // namespace scheduler
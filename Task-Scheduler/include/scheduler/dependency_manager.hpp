@@ -1,20 +1,80 @@
 #pragma once
+#include <cstdint>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <shared_mutex>
+
+#include "hierarchical_mutex.hpp"
+#include "id_radix_map.hpp"
+#include "../../../Concurrent-Data-Structures/memory/small_vector.hpp"
+#include "../../../Concurrent-Data-Structures/sync/padded.hpp"
+#include "../../../Concurrent-Data-Structures/sync/striped_counter.hpp"
 #include <atomic>
+#include <memory>
 #include "task.hpp"
 
+// Tracks the dependency DAG between tasks.
+//
+// Acyclicity is maintained incrementally (Pearce-Kelly): every node in the
+// graph carries a topological order index, and an edge insertion that
+// already respects the order (the overwhelmingly common case - new tasks
+// depend on older ones) costs O(1) with no traversal and no allocation.
+// Only an insertion that violates the order triggers a DFS, and that DFS
+// is confined to the affected region between the two order indices rather
+// than the whole graph. A violating insertion that would close a cycle
+// throws std::runtime_error and leaves the graph untouched.
 class DependencyManager {
 private:
-    // Adjacency list: dependency_id -> set of dependent task IDs
-    std::unordered_map<TaskId, std::unordered_set<TaskId>> dependents_;
-    
-    // Track how many dependencies each task has left
-    std::unordered_map<TaskId, std::atomic<int>> dependency_count_;
-    
-    mutable std::shared_mutex mutex_;
+    // Adjacency list: dependency_id -> set of dependent task IDs. Keyed
+    // by direct index, not hash: the ids are this scheduler's own dense
+    // sequence, so the per-completion lookups are pointer arithmetic.
+    scheduler::id_radix_map<std::unordered_set<TaskId>> dependents_;
+
+    // Reverse adjacency: dependent -> its dependencies. Needed for the
+    // backward half of the affected-region discovery.
+    std::unordered_map<TaskId, std::unordered_set<TaskId>> dependencies_of_;
+
+    // Track how many dependencies each task has left. Same paged direct
+    // index as dependents_: every completion event decrements counters
+    // here, and hashing dense sequential ids was pure overhead. Padded:
+    // the counters are decremented from completion paths on every
+    // worker, and a direct-index page packs neighbouring ids' counters
+    // adjacently - without padding, hot counters of unrelated tasks
+    // would share lines.
+    scheduler::id_radix_map<cds::padded<std::atomic<int>>> dependency_count_;
+
+    // Mirrors dependency_count_.size() so get_pending_task_count() never
+    // takes the lock - it is a monitoring read, and serializing it
+    // against submissions and completions is pure overhead. Updated
+    // under the exclusive lock (uncontended relaxed add), summed without.
+    cds::striped_counter pending_count_;
+
+    // Direct handles for tasks still waiting on dependencies. Lets
+    // mark_completed hand ready tasks straight back to the caller instead
+    // of returning ids that must be re-resolved through the task registry
+    // under another lock.
+    std::unordered_map<TaskId, std::shared_ptr<Task>> pending_tasks_;
+
+    // Incremental topological order. Every path in the graph runs from
+    // lower to higher index; that invariant is what makes the O(1)
+    // fast-path check sound.
+    std::unordered_map<TaskId, std::int64_t> topo_order_;
+    std::int64_t next_order_ = 0;
+
+    // Scratch buffers reused by the reordering slow path (always under the
+    // exclusive lock, so sharing them is safe). They keep their capacity
+    // across calls, so even the slow path stops allocating once warm.
+    std::vector<TaskId> delta_forward_;
+    std::vector<TaskId> delta_backward_;
+    std::vector<TaskId> dfs_stack_;
+    std::unordered_set<TaskId> visited_scratch_;
+
+    // Wrapped for debug-build lock-ordering validation; in release
+    // this is a plain shared_mutex (see hierarchical_mutex.hpp).
+    mutable scheduler::HierarchicalMutex<std::shared_mutex> mutex_{
+        scheduler::lock_level::kDependency};
 
 public:
     // Non-copyable and non-movable
@@ -23,28 +83,70 @@ public:
     DependencyManager& operator=(const DependencyManager&) = delete;
     DependencyManager(DependencyManager&&) = delete;
     DependencyManager& operator=(DependencyManager&&) = delete;
-    
-    // Dependency management
+
+    // Dependency management. Throws std::runtime_error if the edge would
+    // create a cycle.
     void add_dependency(TaskId dependent, TaskId dependency);
-    std::vector<TaskId> mark_completed(TaskId task_id);
+    // Adds every edge dependent -> dependencies[i] under one lock
+    // acquisition - an N-dependency submission used to pay N exclusive
+    // acquires here. For a dependent the graph has never seen (every
+    // normal submission) the whole set is validated once up front: the
+    // fresh node is ordered after all its dependencies, so no per-edge
+    // order check or reorder DFS can fire. A known dependent falls back
+    // to the per-edge Pearce-Kelly path and throws on a cycle like
+    // add_dependency does.
+    void add_dependencies(TaskId dependent, std::span<const TaskId> dependencies);
+    // Graph-level bulk form: many (dependent, dependency) edges under one
+    // lock acquisition. Span-based, so callers hand over whatever edge
+    // storage they already built without a copy.
+    void add_dependency_batch(std::span<const std::pair<TaskId, TaskId>> edges);
+
+    // Registers the handle of a task that has dependencies. Must happen
+    // before its edges are added so a completion racing the wiring can
+    // always resolve the handle.
+    void register_pending(TaskId task_id, std::shared_ptr<Task> task);
+
+    // Returns the tasks made ready by this completion, as direct handles
+    // ready to be pushed to the ready queue - one lock domain per
+    // completion instead of three. Inline result: one completion rarely
+    // unblocks more than a few tasks, so the per-completion return
+    // vector stops costing an allocation.
+    cds::small_vector<std::shared_ptr<Task>, 4> mark_completed(TaskId task_id);
     void remove_task(TaskId task_id);
-    
+
+    // Cascade cancellation: walks the dependents adjacency downstream from
+    // 'root', reclaims every reached task's bookkeeping (counts, edges,
+    // order, pending handle) in one pass under one lock, and returns the
+    // handles of the still-pending tasks so the scheduler can mark them
+    // CANCELLED. 'root' itself is cleaned up but not returned.
+    std::vector<std::shared_ptr<Task>> cancel_dependents(TaskId root);
+
     // Queries
     bool has_dependencies(TaskId task_id) const;
     int get_dependency_count(TaskId task_id) const;
     std::vector<TaskId> get_dependents(TaskId task_id) const;
     size_t get_pending_task_count() const;
-    
-    // Cycle detection
+
+    // Cycle detection. O(1) for a task the graph has never seen (the
+    // normal submission case); otherwise a DFS bounded by the affected
+    // region.
     bool has_circular_dependency(TaskId task_id, const std::vector<TaskId>& new_dependencies) const;
-    
+
     // Cleanup
     void clear();
 
 private:
-    // Helper methods for cycle detection
-    bool creates_cycle(TaskId start, TaskId target) const;
-    bool dfs_cycle_detection(TaskId start, TaskId current, 
-                            std::unordered_set<TaskId>& visited,
-                            std::unordered_set<TaskId>& rec_stack) const;
-};
\ No newline at end of file
+    // Assigns a fresh (maximal) order index to unknown nodes.
+    void ensure_node(TaskId id);
+
+    // Inserts one edge with the lock already held.
+    void add_edge_locked(TaskId dependent, TaskId dependency);
+
+    // Restores the topological order after inserting edge
+    // dependency -> dependent would violate it. Returns false if the edge
+    // closes a cycle (graph left unchanged).
+    bool try_reorder(TaskId dependency, TaskId dependent);
+
+    // Forgets a node's graph bookkeeping (order, reverse edges).
+    void forget_node_locked(TaskId task_id);
+};
@@ -0,0 +1,167 @@
+#ifndef SCHEDULER_HIERARCHICAL_MUTEX_HPP
+#define SCHEDULER_HIERARCHICAL_MUTEX_HPP
+
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <mutex>
+
+namespace scheduler {
+
+// Lock-ordering validation that disappears in release builds.
+//
+// The scheduler nests three lock domains: the timer mutex at the top
+// (the timer thread submits work), DependencyManager's shared_mutex in
+// the middle, and ThreadPool's injection-queue mutex at the bottom.
+// The deadlock-free invariant is that locks are only ever acquired
+// DOWN that ladder - a thread holding the queue mutex must never wait
+// on the dependency mutex, and so on. HierarchicalMutex asserts that
+// invariant on every acquisition in debug builds; with NDEBUG the
+// checks compile to nothing and lock()/unlock() are exactly the
+// wrapped mutex's (the level argument is discarded, the bookkeeping
+// members don't exist).
+//
+// Each thread tracks the levels it holds in a small thread-local
+// stack. Acquiring requires a level STRICTLY below everything held
+// (two mutexes at one level can't nest, which also forbids
+// self-deadlock); releasing removes the most recent entry at that
+// level, so non-LIFO release of distinct levels is tolerated.
+//
+// The wrapped mutex's interface is forwarded, including the shared
+// flavour: members of a class template only instantiate when used, so
+// HierarchicalMutex<std::mutex> simply must not call lock_shared().
+// One knock-on cost: a condition variable waiting on a wrapped mutex
+// needs std::condition_variable_any, whose extra hop is paid only on
+// the wait path - cold everywhere we use it.
+
+// The scheduler's lock ladder, highest first. New locks get a level
+// here, not an ad-hoc number at the use site.
+namespace lock_level {
+    constexpr unsigned long kTimer = 3000;       // TaskScheduler::timer_mutex_
+    constexpr unsigned long kDependency = 2000;  // DependencyManager::mutex_
+    constexpr unsigned long kPoolQueue = 1000;   // ThreadPool::queue_mutex_
+}
+
+#ifndef NDEBUG
+namespace detail {
+    // Per-thread record of held levels. Sixteen simultaneously held
+    // locks is already a design smell; the assert on overflow is as
+    // much a diagnostic as the ordering check.
+    struct HeldLockLevels {
+        static constexpr std::size_t kMaxDepth = 16;
+        unsigned long levels[kMaxDepth];
+        std::size_t depth = 0;
+
+        unsigned long lowest_held() const {
+            unsigned long lowest = ULONG_MAX;
+            for (std::size_t i = 0; i < depth; ++i) {
+                if (levels[i] < lowest) {
+                    lowest = levels[i];
+                }
+            }
+            return lowest;
+        }
+
+        void push(unsigned long level) {
+            assert(depth < kMaxDepth && "lock nesting too deep");
+            levels[depth++] = level;
+        }
+
+        void remove(unsigned long level) {
+            for (std::size_t i = depth; i-- > 0;) {
+                if (levels[i] == level) {
+                    levels[i] = levels[--depth];
+                    return;
+                }
+            }
+            assert(false && "unlocking a level this thread does not hold");
+        }
+    };
+
+    inline thread_local HeldLockLevels held_lock_levels;
+} // namespace detail
+#endif // !NDEBUG
+
+template<typename Mutex = std::mutex>
+class HierarchicalMutex {
+public:
+#ifdef NDEBUG
+    explicit HierarchicalMutex(unsigned long) noexcept {}
+#else
+    explicit HierarchicalMutex(unsigned long level) noexcept : level_(level) {}
+#endif
+
+    HierarchicalMutex(const HierarchicalMutex&) = delete;
+    HierarchicalMutex& operator=(const HierarchicalMutex&) = delete;
+
+    void lock() {
+        check_order();
+        mutex_.lock();
+        record_acquire();
+    }
+
+    bool try_lock() {
+        check_order();
+        if (!mutex_.try_lock()) {
+            return false;
+        }
+        record_acquire();
+        return true;
+    }
+
+    void unlock() {
+        record_release();
+        mutex_.unlock();
+    }
+
+    // Shared flavour; instantiates only for mutexes that have it.
+    void lock_shared() {
+        check_order();
+        mutex_.lock_shared();
+        record_acquire();
+    }
+
+    bool try_lock_shared() {
+        check_order();
+        if (!mutex_.try_lock_shared()) {
+            return false;
+        }
+        record_acquire();
+        return true;
+    }
+
+    void unlock_shared() {
+        record_release();
+        mutex_.unlock_shared();
+    }
+
+private:
+#ifdef NDEBUG
+    void check_order() const {}
+    void record_acquire() const {}
+    void record_release() const {}
+
+    Mutex mutex_;
+#else
+    void check_order() const {
+        assert(detail::held_lock_levels.lowest_held() > level_ &&
+               "lock hierarchy violated: acquiring a level at or above one "
+               "already held by this thread");
+    }
+
+    void record_acquire() const {
+        detail::held_lock_levels.push(level_);
+    }
+
+    void record_release() const {
+        detail::held_lock_levels.remove(level_);
+    }
+
+    Mutex mutex_;
+    unsigned long const level_;
+#endif
+};
+
+} // namespace scheduler
+
+#endif // SCHEDULER_HIERARCHICAL_MUTEX_HPP
@@ -0,0 +1,144 @@
+#ifndef SCHEDULER_ID_RADIX_MAP_HPP
+#define SCHEDULER_ID_RADIX_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "task.hpp"
+
+namespace scheduler {
+
+// Paged direct-index map keyed by TaskId, for structures whose keys are
+// the scheduler's own sequential ids.
+//
+// TaskIds are minted by next_task_id_++, so within one scheduler they are
+// dense integers - yet the dependency bookkeeping hashed them through
+// unordered_map, paying a hash, a probe and a node allocation per lookup
+// for keys that are effectively array indices. This map indexes instead:
+// the sequence half of the id (the instance bits are masked off; one
+// scheduler's manager only ever sees its own instance) is split into a
+// page number and a slot, the directory is a vector of page pointers, and
+// a lookup is two array subscripts. Pages are allocated the first time an
+// id in their range appears and handed back to the allocator once every
+// id in the range has been erased - the natural lifecycle when ids grow
+// monotonically and old ranges complete.
+//
+// A per-page presence bitmap distinguishes live slots from
+// default-constructed ones, so erase/contains keep map semantics. Not
+// internally synchronized: callers guard it exactly as they guarded the
+// unordered_map it replaces.
+template<typename V, unsigned kPageBits = 9>
+class id_radix_map {
+private:
+    static constexpr std::size_t kPageSlots = std::size_t(1) << kPageBits;
+    static constexpr std::size_t kSlotMask = kPageSlots - 1;
+    static constexpr std::size_t kWords = kPageSlots / 64;
+
+    struct Page {
+        std::uint64_t present[kWords] = {};
+        std::size_t population = 0;
+        V slots[kPageSlots] = {};
+    };
+
+public:
+    // Pointer to the value for 'id', or nullptr when absent.
+    V* find(TaskId id) {
+        const std::size_t index = id & kTaskSequenceMask;
+        const std::size_t page_index = index >> kPageBits;
+        if (page_index >= directory_.size() || !directory_[page_index]) {
+            return nullptr;
+        }
+        Page& page = *directory_[page_index];
+        const std::size_t slot = index & kSlotMask;
+        if (!(page.present[slot / 64] & (std::uint64_t(1) << (slot % 64)))) {
+            return nullptr;
+        }
+        return &page.slots[slot];
+    }
+
+    const V* find(TaskId id) const {
+        return const_cast<id_radix_map*>(this)->find(id);
+    }
+
+    // Ensures a slot for 'id' exists (default-constructed on first use);
+    // second is true when the slot was newly brought live - the
+    // try_emplace 'inserted' signal the callers key their counting off.
+    std::pair<V*, bool> insert(TaskId id) {
+        const std::size_t index = id & kTaskSequenceMask;
+        const std::size_t page_index = index >> kPageBits;
+        if (page_index >= directory_.size()) {
+            directory_.resize(page_index + 1);
+        }
+        if (!directory_[page_index]) {
+            directory_[page_index] = std::make_unique<Page>();
+        }
+        Page& page = *directory_[page_index];
+        const std::size_t slot = index & kSlotMask;
+        std::uint64_t& word = page.present[slot / 64];
+        const std::uint64_t bit = std::uint64_t(1) << (slot % 64);
+        const bool inserted = !(word & bit);
+        if (inserted) {
+            word |= bit;
+            ++page.population;
+        }
+        return {&page.slots[slot], inserted};
+    }
+
+    // Resets the slot to a default-constructed value and marks it absent;
+    // the page is returned to the allocator once its last live slot goes.
+    // True when something was actually erased.
+    bool erase(TaskId id) {
+        const std::size_t index = id & kTaskSequenceMask;
+        const std::size_t page_index = index >> kPageBits;
+        if (page_index >= directory_.size() || !directory_[page_index]) {
+            return false;
+        }
+        Page& page = *directory_[page_index];
+        const std::size_t slot = index & kSlotMask;
+        std::uint64_t& word = page.present[slot / 64];
+        const std::uint64_t bit = std::uint64_t(1) << (slot % 64);
+        if (!(word & bit)) {
+            return false;
+        }
+        word &= ~bit;
+        page.slots[slot].~V();
+        ::new (static_cast<void*>(&page.slots[slot])) V();
+        if (--page.population == 0) {
+            directory_[page_index].reset();  // Range complete: recycle
+        }
+        return true;
+    }
+
+    // Visits every live value. Must not insert or erase from inside 'f'.
+    template<typename F>
+    void for_each(F&& f) {
+        for (auto& page_ptr : directory_) {
+            if (!page_ptr) {
+                continue;
+            }
+            Page& page = *page_ptr;
+            for (std::size_t w = 0; w < kWords; ++w) {
+                std::uint64_t word = page.present[w];
+                while (word) {
+                    const unsigned bit =
+                        static_cast<unsigned>(__builtin_ctzll(word));
+                    word &= word - 1;
+                    f(page.slots[w * 64 + bit]);
+                }
+            }
+        }
+    }
+
+    void clear() { directory_.clear(); }
+
+private:
+    std::vector<std::unique_ptr<Page>> directory_;
+};
+
+} // namespace scheduler
+
+#endif // SCHEDULER_ID_RADIX_MAP_HPP
@@ -0,0 +1,21 @@
+#ifndef SCHEDULER_MPMC_RING_HPP
+#define SCHEDULER_MPMC_RING_HPP
+
+#include "../../../Concurrent-Data-Structures/queue/mpmc_bounded_queue.hpp"
+
+namespace scheduler {
+
+// Bounded multi-producer/multi-consumer FIFO ring (Dmitry Vyukov's design).
+//
+// The implementation lives in the shared Concurrent-Data-Structures
+// header - one well-tested queue serving both this scheduler's ready path
+// and the indexer's pipeline - and this alias keeps the scheduler-side
+// name and call sites unchanged. See mpmc_bounded_queue.hpp for the
+// algorithm notes; the interface is try_push/try_pop with failure on
+// full/empty, plus size_approx() and capacity().
+template<typename T>
+using MpmcRing = cds::mpmc_bounded_queue<T>;
+
+} // namespace scheduler
+
+#endif // SCHEDULER_MPMC_RING_HPP
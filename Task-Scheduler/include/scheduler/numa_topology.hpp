@@ -0,0 +1,45 @@
+#ifndef SCHEDULER_NUMA_TOPOLOGY_HPP
+#define SCHEDULER_NUMA_TOPOLOGY_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace scheduler {
+
+// NumaTopology: which CPUs belong to which memory node.
+//
+// On a multi-socket box an access to memory homed on the other socket
+// costs roughly 1.5-2x a local one, and the coherence traffic of shared
+// lines crossing the interconnect is what actually caps scaling past one
+// socket. The fix starts with knowing the layout: detect() reads the
+// kernel's view from /sys/devices/system/node (no libnuma dependency),
+// and callers use it to pin workers node by node and to prefer
+// same-node victims when stealing. Memory then follows from first
+// touch: a pinned worker's allocations fault in on its own node.
+//
+// On single-node machines, non-Linux systems, or restricted containers
+// detect() degrades to one node holding every CPU, which makes every
+// NUMA-aware path collapse to the flat behaviour - callers never need
+// their own fallback.
+struct NumaTopology {
+    // node_cpus[n] lists node n's CPUs in kernel order. Never empty:
+    // at minimum one node with every CPU id.
+    std::vector<std::vector<int>> node_cpus;
+
+    std::size_t node_count() const { return node_cpus.size(); }
+
+    // The node owning 'cpu'; 0 if the CPU is not listed (possible when
+    // the cpuset shrank after detection).
+    std::size_t node_of(int cpu) const;
+
+    // Total CPUs across all nodes.
+    std::size_t cpu_count() const;
+
+    // Reads the topology from /sys; falls back to a single node with
+    // hardware_concurrency CPUs when that fails.
+    static NumaTopology detect();
+};
+
+} // namespace scheduler
+
+#endif // SCHEDULER_NUMA_TOPOLOGY_HPP
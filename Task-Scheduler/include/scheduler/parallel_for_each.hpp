@@ -0,0 +1,153 @@
+#ifndef SCHEDULER_PARALLEL_FOR_EACH_HPP
+#define SCHEDULER_PARALLEL_FOR_EACH_HPP
+
+#include "parallel_reduce.hpp"  // shares reduce_pool() for pool-less calls
+#include "thread_pool.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+
+namespace scheduler {
+
+// parallel_for_each: apply fn to every element of [first, last) on a
+// ThreadPool, splitting recursively so idle workers steal halves.
+//
+// Unlike parallel_reduce's up-front block partitioning, the range is
+// split lazily: each call keeps the lower half and enqueues the upper
+// half as a task that splits itself the same way. Splitting from a
+// worker thread lands in that worker's own deque, so halves are taken
+// LIFO locally (cache-warm) and stolen FIFO by idle workers - if every
+// element costs the same the eager blocks would tie, but when costs are
+// skewed (long documents among short ones) stealing rebalances where
+// fixed blocks cannot.
+//
+// grain_size is the largest chunk that is processed as one task; it
+// bounds both the scheduling overhead (roughly length/grain_size task
+// hand-offs) and the stealable granularity. Pass 0 to let the pool
+// pick: four chunks per thread, which leaves enough slack for stealing
+// without drowning small ranges in tasks.
+//
+// This replaces the thread-per-call std::async habit (see
+// concurrency/04_04_std_async_and_std_future.cpp): a spawned thread per
+// invocation costs more than most chunks of work.
+//
+// Requirements: forward iterators, fn callable concurrently from
+// several threads, and fn must not throw.
+
+namespace detail {
+
+    // Completion tracking for a dynamically splitting tree: the chunk
+    // count isn't known up front, so a fixed latch won't do. pending
+    // starts at 1 for the root; every enqueued half adds one.
+    class ForEachState {
+    public:
+        void add_task() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++pending_;
+        }
+
+        void task_done() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) {
+                done_.notify_one();
+            }
+        }
+
+        void wait() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this] { return pending_ == 0; });
+        }
+
+        bool done() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return pending_ == 0;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable done_;
+        std::size_t pending_ = 1;
+    };
+
+    // Keep the lower half, enqueue the upper, repeat until the piece in
+    // hand fits the grain; then run it. Iterative on the lower path so
+    // a huge range doesn't recurse log(n) frames deep.
+    template<typename Iterator, typename UnaryFn>
+    void for_each_split(ThreadPool& pool, Iterator first, Iterator last,
+                        std::size_t grain_size, UnaryFn& fn,
+                        ForEachState& state) {
+        std::size_t length =
+            static_cast<std::size_t>(std::distance(first, last));
+        while (length > grain_size) {
+            Iterator mid = first;
+            std::advance(mid, length / 2);
+            state.add_task();
+            pool.enqueue([&pool, mid, last, grain_size, &fn, &state] {
+                for_each_split(pool, mid, last, grain_size, fn, state);
+                state.task_done();
+            });
+            last = mid;
+            length /= 2;
+        }
+        for (; first != last; ++first) {
+            fn(*first);
+        }
+    }
+
+} // namespace detail
+
+template<typename Iterator, typename UnaryFn>
+void parallel_for_each(ThreadPool& pool, Iterator first, Iterator last,
+                       std::size_t grain_size, UnaryFn fn) {
+    std::size_t const length =
+        static_cast<std::size_t>(std::distance(first, last));
+    if (length == 0) {
+        return;
+    }
+
+    if (grain_size == 0) {
+        std::size_t const chunks = (pool.get_thread_count() + 1) * 4;
+        grain_size = length / chunks + 1;
+    }
+
+    if (length <= grain_size) {
+        // Fits in one chunk: no tasks, no waiting.
+        for (; first != last; ++first) {
+            fn(*first);
+        }
+        return;
+    }
+
+    detail::ForEachState state;
+    detail::for_each_split(pool, first, last, grain_size, fn, state);
+    state.task_done();  // The root's own share is finished
+
+    if (pool.is_worker_thread()) {
+        // Called from inside a task on this very pool: blocking here
+        // would idle a worker (and deadlock a fully-nested pool), so
+        // help instead - run pending tasks, ours or anyone's, until the
+        // tree completes.
+        while (!state.done()) {
+            if (!pool.run_pending_task()) {
+                std::this_thread::yield();
+            }
+        }
+    } else {
+        state.wait();
+    }
+}
+
+// Pool-less overload: runs on the same shared pool parallel_reduce
+// uses, so mixed reduce/for_each workloads share one set of workers.
+template<typename Iterator, typename UnaryFn>
+void parallel_for_each(Iterator first, Iterator last,
+                       std::size_t grain_size, UnaryFn fn) {
+    parallel_for_each(reduce_pool(), first, last, grain_size,
+                      std::move(fn));
+}
+
+} // namespace scheduler
+
+#endif // SCHEDULER_PARALLEL_FOR_EACH_HPP
@@ -0,0 +1,144 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
+namespace scheduler {
+
+// Aggregated latency distribution of one PROFILE_SCOPE name.
+struct ScopeStats {
+    std::string name;
+    std::uint64_t count = 0;
+    std::uint64_t p50_ns = 0;
+    std::uint64_t p95_ns = 0;
+    std::uint64_t p99_ns = 0;
+    std::uint64_t max_ns = 0;
+};
+
+// Process-wide scoped profiler behind the PROFILE_SCOPE macro.
+//
+// The same shape as TaskTracer, because the same constraint applies: the
+// probe has to be cheap enough to ship enabled. A hit is two rdtsc reads
+// (steady_clock on non-x86) and a store into the calling thread's own
+// fixed-size ring plus a relaxed index bump - no locks, no allocation,
+// no shared cache line; a few nanoseconds end to end. Each ring
+// overwrites its oldest samples when full, so an always-on probe bounds
+// memory and aggregate() reports the most recent window.
+//
+// Tick-to-nanosecond conversion is calibrated once against steady_clock
+// on the first aggregation (a cold path), not per sample. The registry
+// mutex guards thread registration and aggregation only.
+class Profiler {
+public:
+    static Profiler& instance();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    void enable() { enabled_.store(true, std::memory_order_release); }
+    void disable() { enabled_.store(false, std::memory_order_release); }
+    bool is_enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // Hot path: no-op unless enabled.
+    void record(const char* name, std::uint64_t ticks) {
+        if (!is_enabled()) {
+            return;
+        }
+        record_slow(name, ticks);
+    }
+
+    // The cheapest monotonic timestamp the platform offers, in ticks.
+    static std::uint64_t now() {
+#if defined(__x86_64__) || defined(_M_X64)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+#endif
+    }
+
+    // Buckets every buffered sample by scope name and reduces each bucket
+    // to percentiles. Recording may continue concurrently; samples written
+    // while aggregating may or may not appear.
+    std::vector<ScopeStats> aggregate();
+
+    // aggregate() formatted as an aligned text table, one scope per line.
+    std::string report();
+
+private:
+    struct Sample {
+        const char* name;     // PROFILE_SCOPE literal; never owned.
+        std::uint64_t ticks;
+    };
+
+    struct ThreadBuffer {
+        // 16k samples * 16 bytes = 256 KiB per recording thread.
+        static constexpr std::size_t kCapacity = 1u << 14;
+
+        std::array<Sample, kCapacity> samples;
+        // Monotonic write index; slot = next % kCapacity. Only the owning
+        // thread writes, so relaxed ordering suffices for the samples and
+        // a release on the index publishes them to the aggregator.
+        std::atomic<std::uint64_t> next{0};
+    };
+
+    Profiler() = default;
+
+    // Registers (once per thread) and appends to the thread's own ring.
+    void record_slow(const char* name, std::uint64_t ticks);
+
+    ThreadBuffer* local_buffer();
+
+    static double ns_per_tick();
+
+    std::atomic<bool> enabled_{false};
+
+    std::mutex registry_mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+    static thread_local ThreadBuffer* current_buffer_;
+};
+
+// RAII probe; use through PROFILE_SCOPE so disabled builds compile it out.
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : name_(name), start_(Profiler::now()) {}
+    ~ProfileScope() {
+        Profiler::instance().record(name_, Profiler::now() - start_);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    std::uint64_t start_;
+};
+
+}  // namespace scheduler
+
+// PROFILE_SCOPE("name") times the rest of the enclosing block. The name
+// must be a string literal (it is stored by pointer, never copied).
+// Defining SCHEDULER_PROFILING_DISABLED removes every probe at compile
+// time.
+#if defined(SCHEDULER_PROFILING_DISABLED)
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_SCOPE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_SCOPE_CONCAT(a, b) PROFILE_SCOPE_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) \
+    ::scheduler::ProfileScope PROFILE_SCOPE_CONCAT(profile_scope_, \
+                                                   __LINE__)(name)
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "mpmc_ring.hpp"
+#include "task.hpp"
+#include "../../../Concurrent-Data-Structures/sync/padded.hpp"
+
+// Lock-free ready queue for the scheduler.
+//
+// Priority is only a 3-value enum, so instead of a binary heap behind one
+// mutex (ThreadSafePriorityQueue) this queue keeps one MPMC FIFO ring per
+// priority level. push and try_pop are O(1) and lock-free; there is no heap
+// to rebalance and submitters never serialize against workers. Ordering is
+// strict across priorities (HIGH before NORMAL before LOW) and FIFO within
+// a priority - the same order the heap produced.
+//
+// A mutex/condition pair is used only to park consumers when every ring is
+// empty, and a small mutex-protected overflow list absorbs pushes that hit
+// a full ring; neither is touched on the hot path.
+class LockFreeReadyQueue {
+private:
+    static constexpr size_t kNumPriorities = 3;  // LOW, NORMAL, HIGH
+
+    // Indexed by static_cast<size_t>(Priority).
+    std::array<scheduler::MpmcRing<std::shared_ptr<Task>>, kNumPriorities> rings_;
+
+    // Overflow for the (rare) case a ring is full.
+    std::array<std::deque<std::shared_ptr<Task>>, kNumPriorities> overflow_;
+    std::mutex overflow_mutex_;
+    cds::padded<std::atomic<size_t>> overflow_count_;
+
+    // Total queued tasks; doubles as the sleep/wake predicate. Padded -
+    // every push and pop writes it, so sharing a line with the other
+    // counters would couple submitters, workers, and monitors.
+    cds::padded<std::atomic<size_t>> size_;
+
+    // Deepest the queue has ever been (monotone CAS-max); cheap depth
+    // telemetry for pool sizing.
+    cds::padded<std::atomic<size_t>> high_water_;
+
+    // Pop counter driving the anti-starvation scan rotation (see
+    // try_pop_unchecked): every kNormalBoost-th pop services NORMAL
+    // first and every kLowBoost-th services LOW first. Powers of two so
+    // the epoch check is a mask.
+    static constexpr std::uint64_t kNormalBoost = 16;
+    static constexpr std::uint64_t kLowBoost = 64;
+    cds::padded<std::atomic<std::uint64_t>> pop_epoch_;
+
+    // Only used to park/unpark consumers when the queue is empty.
+    std::mutex sleep_mutex_;
+    std::condition_variable condition_;
+
+public:
+    // Non-copyable and non-movable
+    LockFreeReadyQueue();
+    LockFreeReadyQueue(const LockFreeReadyQueue&) = delete;
+    LockFreeReadyQueue& operator=(const LockFreeReadyQueue&) = delete;
+    LockFreeReadyQueue(LockFreeReadyQueue&&) = delete;
+    LockFreeReadyQueue& operator=(LockFreeReadyQueue&&) = delete;
+
+    // Core operations
+    void push(std::shared_ptr<Task> task);
+    // Publishes a whole batch with a single notify_all instead of one
+    // notification per task.
+    void push_batch(std::vector<std::shared_ptr<Task>> tasks);
+    std::shared_ptr<Task> pop();
+    bool try_pop(std::shared_ptr<Task>& task);
+    std::shared_ptr<Task> try_pop_for(const std::chrono::milliseconds& timeout);
+
+    // Re-buckets a queued task whose priority was just raised: pushes a
+    // fresh entry into the ring of its new level. O(1) - nothing is
+    // removed from the old ring; the entry left behind becomes a stale
+    // duplicate that Task::claim_run_once filters at pop time.
+    void reprioritize(const std::shared_ptr<Task>& task);
+
+    // Status queries
+    bool empty() const;
+    size_t size() const;
+    size_t high_water_mark() const;
+
+    // Bulk operations
+    void clear();
+    std::vector<std::shared_ptr<Task>> drain();
+
+private:
+    // Scan HIGH -> NORMAL -> LOW without blocking. Does not touch size_.
+    bool try_pop_unchecked(std::shared_ptr<Task>& task);
+
+    // Raises the high-water mark to 'depth' if it grew.
+    void update_high_water(size_t depth);
+};
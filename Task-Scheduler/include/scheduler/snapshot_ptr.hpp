@@ -0,0 +1,206 @@
+#ifndef SCHEDULER_SNAPSHOT_PTR_HPP
+#define SCHEDULER_SNAPSHOT_PTR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace scheduler {
+
+// Deferred-reclamation pointer for read-mostly, swap-rarely data.
+//
+// A plain std::atomic<std::shared_ptr<T>> read costs two contended RMWs
+// per load (acquire and release of the control block's refcount) - every
+// reader hammers the same cache line, which caps read scaling long before
+// the data itself does. snapshot_ptr splits the two roles:
+//
+//   readers  announce the pointer they are about to use in a private
+//            hazard slot (one padded cache line per slot, never shared
+//            between concurrent readers) and get a guard that is valid
+//            until dropped - no shared-line writes at all;
+//   writers  swap the pointer under a mutex and retire the old value,
+//            destroying it only once no hazard slot still announces it.
+//
+// Ownership still travels as shared_ptr on the writer side, so producers
+// keep building generations exactly as before; only the read path changes.
+// Publishing is expected to be rare (index rebuilds, cache refreshes) -
+// the writer's slot scan is deliberately paid there, not on reads.
+template<typename T>
+class snapshot_ptr {
+private:
+    // Enough for every plausible concurrent reader in this codebase; a
+    // guard holds its slot only for the duration of one query. If all
+    // slots are somehow busy, the reader falls back to a shared_ptr pin
+    // taken under the writer mutex (correct, just pays the refcount).
+    static constexpr std::size_t kSlots = 64;
+
+    struct alignas(64) Slot {
+        std::atomic<bool> in_use{false};
+        std::atomic<const void*> hazard{nullptr};
+    };
+
+public:
+    snapshot_ptr() = default;
+
+    snapshot_ptr(const snapshot_ptr&) = delete;
+    snapshot_ptr& operator=(const snapshot_ptr&) = delete;
+
+    // The caller guarantees no guards are alive at destruction (the same
+    // contract atomic<shared_ptr> imposed on its last readers).
+    ~snapshot_ptr() = default;
+
+    // Pins the current value for as long as it is alive. Move-only;
+    // dereferences like the shared_ptr it replaces.
+    class guard {
+    public:
+        guard() = default;
+
+        guard(guard&& other) noexcept
+            : slot_(other.slot_), ptr_(other.ptr_),
+              owned_(std::move(other.owned_)) {
+            other.slot_ = nullptr;
+            other.ptr_ = nullptr;
+        }
+
+        guard& operator=(guard&& other) noexcept {
+            if (this != &other) {
+                release();
+                slot_ = other.slot_;
+                ptr_ = other.ptr_;
+                owned_ = std::move(other.owned_);
+                other.slot_ = nullptr;
+                other.ptr_ = nullptr;
+            }
+            return *this;
+        }
+
+        guard(const guard&) = delete;
+        guard& operator=(const guard&) = delete;
+
+        ~guard() { release(); }
+
+        const T* get() const noexcept { return ptr_; }
+        const T& operator*() const noexcept { return *ptr_; }
+        const T* operator->() const noexcept { return ptr_; }
+        explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    private:
+        friend class snapshot_ptr;
+
+        void release() noexcept {
+            if (slot_) {
+                // The slot write is the reader's only synchronization:
+                // release-clearing it lets the writer's scan observe the
+                // pin is gone and reclaim.
+                slot_->hazard.store(nullptr, std::memory_order_release);
+                slot_->in_use.store(false, std::memory_order_release);
+                slot_ = nullptr;
+            }
+            ptr_ = nullptr;
+            owned_.reset();
+        }
+
+        Slot* slot_ = nullptr;
+        const T* ptr_ = nullptr;
+        // Fallback pin only (slot exhaustion): a plain refcount copy,
+        // taken under the writer mutex. Empty on the hazard fast path.
+        std::shared_ptr<const T> owned_;
+    };
+
+    // Reader side: no locks, no shared-cache-line writes. The
+    // announce-then-recheck loop is the classic hazard-pointer handshake:
+    // once the recheck sees the announced pointer still current, the
+    // writer's scan (which runs after its swap) is guaranteed to see the
+    // announcement and defer destruction.
+    guard load() const {
+        Slot* slot = claim_slot();
+        guard g;
+        if (slot == nullptr) {
+            // All slots busy: take a refcount pin under the writer mutex
+            // instead. Degrades to the old shared_ptr cost for this one
+            // reader; the swap-then-sweep in store() runs under the same
+            // mutex, so the copy can never catch a half-retired value.
+            std::lock_guard<std::mutex> lock(mutex_);
+            g.owned_ = owner_;
+            g.ptr_ = g.owned_.get();
+            return g;
+        }
+        const T* p = current_.load(std::memory_order_acquire);
+        for (;;) {
+            slot->hazard.store(p, std::memory_order_seq_cst);
+            const T* now = current_.load(std::memory_order_seq_cst);
+            if (now == p) {
+                break;  // Announcement landed before any later swap's scan.
+            }
+            p = now;  // Lost the race with a swap; re-announce the new value.
+        }
+        g.slot_ = slot;
+        g.ptr_ = p;
+        return g;
+    }
+
+    // Writer side: swaps the published value and retires the old one.
+    // Retired values whose pointer no longer appears in any hazard slot
+    // are destroyed here (their shared_ptr dropped); pinned ones stay on
+    // the retired list until a later store finds them quiescent.
+    void store(std::shared_ptr<const T> next) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::shared_ptr<const T> old = std::move(owner_);
+        owner_ = std::move(next);
+        current_.store(owner_.get(), std::memory_order_seq_cst);
+        if (old) {
+            retired_.push_back(std::move(old));
+        }
+        // Sweep: keep only retired values some reader still announces.
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < retired_.size(); ++i) {
+            if (is_hazarded(retired_[i].get())) {
+                retired_[kept++] = std::move(retired_[i]);
+            }
+        }
+        retired_.resize(kept);
+    }
+
+private:
+    // Claims a free hazard slot, starting at a thread-local hint so a
+    // steady-state reader re-claims the same (already-local) line every
+    // query. Returns nullptr when every slot is taken.
+    Slot* claim_slot() const {
+        static thread_local std::size_t hint = 0;
+        for (std::size_t i = 0; i < kSlots; ++i) {
+            Slot& slot = slots_[(hint + i) % kSlots];
+            bool expected = false;
+            if (slot.in_use.compare_exchange_strong(
+                    expected, true, std::memory_order_acquire)) {
+                hint = (hint + i) % kSlots;
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    bool is_hazarded(const T* p) const {
+        for (std::size_t i = 0; i < kSlots; ++i) {
+            if (slots_[i].hazard.load(std::memory_order_seq_cst) == p) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // What readers race on: just the raw pointer. Ownership lives below,
+    // touched only under mutex_.
+    std::atomic<const T*> current_{nullptr};
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<const T> owner_;             // keeps current_ alive
+    std::vector<std::shared_ptr<const T>> retired_;  // swapped out, still pinned
+
+    mutable Slot slots_[kSlots];
+};
+
+} // namespace scheduler
+
+#endif // SCHEDULER_SNAPSHOT_PTR_HPP
@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "../../../Concurrent-Data-Structures/sync/padded.hpp"
+
+namespace scheduler {
+
+// One cache line of counters per worker. Workers only ever touch their
+// own line with relaxed increments, so instrumentation costs a handful
+// of uncontended adds - no shared counter ping-pong, no locks. Readers
+// aggregate with relaxed loads; a snapshot is a consistent-enough view
+// for sizing decisions, not a linearizable one.
+struct alignas(cds::kCacheLineSize) WorkerStats {
+    std::atomic<std::uint64_t> tasks_executed{0};
+    std::atomic<std::uint64_t> queue_wait_ns{0};
+    std::atomic<std::uint64_t> steal_attempts{0};
+    std::atomic<std::uint64_t> steals_successful{0};
+    std::atomic<std::uint64_t> lock_acquisitions{0};
+};
+
+// Plain-value copy of one worker's counters.
+struct WorkerStatsSnapshot {
+    std::uint64_t tasks_executed = 0;
+    std::uint64_t queue_wait_ns = 0;
+    std::uint64_t steal_attempts = 0;
+    std::uint64_t steals_successful = 0;
+    std::uint64_t lock_acquisitions = 0;
+};
+
+// Trivially copyable aggregate published through a cds::seqlock by the
+// scheduler's timer thread once per tick. Monitors polling at high
+// frequency read this instead of calling snapshot(): one consistent
+// word-wise copy, no walk over the worker lines, no perturbation of
+// the workers. At most one tick stale.
+struct PublishedStats {
+    std::uint64_t tasks_executed = 0;
+    std::uint64_t queue_wait_ns = 0;
+    std::uint64_t steal_attempts = 0;
+    std::uint64_t steals_successful = 0;
+    std::uint64_t lock_acquisitions = 0;
+    std::uint64_t ready_queue_high_water = 0;
+};
+
+// Aggregated view returned by TaskScheduler::snapshot().
+struct SchedulerStats {
+    std::uint64_t tasks_executed = 0;
+    std::uint64_t queue_wait_ns = 0;
+    std::uint64_t steal_attempts = 0;
+    std::uint64_t steals_successful = 0;
+    std::uint64_t lock_acquisitions = 0;
+
+    // Deepest the ready queue has ever been; resets only with the
+    // scheduler.
+    std::size_t ready_queue_high_water = 0;
+
+    // One entry per pool worker, plus a final entry for work done by
+    // non-worker threads (submitters hitting the injection queue).
+    std::vector<WorkerStatsSnapshot> per_worker;
+};
+
+}  // namespace scheduler
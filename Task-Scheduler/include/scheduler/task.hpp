@@ -1,9 +1,11 @@
 #pragma once
+#include <cstdint>
 #include <functional>
+#include "unique_function.hpp"
+#include "../../../Concurrent-Data-Structures/memory/small_vector.hpp"
 #include <future>
 #include <atomic>
 #include <chrono>
-#include <vector>
 #include <memory>
 
 enum class TaskState {
@@ -22,30 +24,106 @@ enum class Priority {
 
 using TaskId = std::size_t;
 
+// Federation split of a TaskId: the top bits carry the minting
+// scheduler's instance id, the low bits its sequential counter (see
+// TaskScheduler's id anatomy). Shared here because id-indexed structures
+// (id_radix_map) key on the dense sequence half alone.
+inline constexpr unsigned kTaskInstanceBits = 16;
+inline constexpr unsigned kTaskInstanceShift = 64 - kTaskInstanceBits;
+inline constexpr TaskId kTaskSequenceMask =
+    (static_cast<TaskId>(1) << kTaskInstanceShift) - 1;
+
+class TaskContext;
+
 class Task {
 private:
+    // Layout of the packed lifecycle word (word_). State, the cancel
+    // request, the finished mark, and the waiter/delivered handshake all
+    // live in one atomic, so every lifecycle transition is a single RMW
+    // on a single cache line - previously these were three separate
+    // atomics all touched by execute().
+    static constexpr std::uint32_t kStateMask    = 0x7;      // TaskState
+    static constexpr std::uint32_t kCancelBit    = 1u << 3;  // cancel requested
+    static constexpr std::uint32_t kFinishedBit  = 1u << 4;  // counted as terminal
+    static constexpr std::uint32_t kWaiterBit    = 1u << 5;  // a future exists
+    static constexpr std::uint32_t kDeliveredBit = 1u << 6;  // outcome recorded
+    static constexpr std::uint32_t kYieldBit     = 1u << 7;  // yield requested
+    static constexpr std::uint32_t kClaimBit     = 1u << 8;  // this arming ran
+
     TaskId id_;
-    std::function<void()> work_;
-    Priority priority_;
-    std::atomic<TaskState> state_;
-    std::vector<TaskId> dependencies_;
-    std::promise<void> completion_promise_;
-    std::atomic<bool> cancel_requested_;
+    scheduler::unique_function<void()> work_;
+    // Atomic because priority inheritance may raise it after submission
+    // (see TaskScheduler::inherit_priority) while queue consumers read it.
+    std::atomic<Priority> priority_;
+    std::atomic<std::uint32_t> word_;
+    // Inline for the first four ids: >90% of tasks carry 0-4
+    // dependencies, so the list almost never costs an allocation.
+    cds::small_vector<TaskId, 4> dependencies_;
+
+    // The completion promise is created lazily - most tasks are never
+    // waited on, so eagerly allocating the promise's shared state on every
+    // submission was pure allocator churn. promise_lock_ (a spinlock; the
+    // critical sections are a few instructions) guards creation against a
+    // concurrent completion, and delivered_/error_ remember the outcome so
+    // a future requested after completion is satisfied immediately.
+    std::atomic_flag promise_lock_ = ATOMIC_FLAG_INIT;
+    std::unique_ptr<std::promise<void>> completion_promise_;
+    std::exception_ptr error_;
+
+    // When the task entered the ready queue; written by the pusher,
+    // read by the popper (ordered by the queue itself). Feeds the
+    // queue-wait statistic.
+    std::chrono::steady_clock::time_point enqueue_time_{};
 
 public:
     // Constructor
-    Task(TaskId id, std::function<void()> work, Priority priority = Priority::NORMAL);
-    
+    Task(TaskId id, scheduler::unique_function<void()> work, Priority priority = Priority::NORMAL);
+
+    // Context-aware constructor: the work receives a TaskContext, whose
+    // yield() asks the scheduler to requeue this task instead of
+    // completing it when the work returns (see execute()).
+    Task(TaskId id, scheduler::unique_function<void(TaskContext&)> work,
+         Priority priority = Priority::NORMAL);
+
     // Getters
     TaskId get_id() const;
     Priority get_priority() const;
     TaskState get_state() const;
-    const std::vector<TaskId>& get_dependencies() const;
+    const cds::small_vector<TaskId, 4>& get_dependencies() const;
     
     // State management
     void set_state(TaskState new_state);
     bool is_ready() const;
     bool is_completed() const;
+
+    // Blocks (futex wait, zero CPU) until the task is COMPLETED or
+    // CANCELLED.
+    void wait_until_terminal() const;
+
+    // Returns true for exactly one caller, the first to observe the task
+    // finished.
+    bool mark_finished_once();
+
+    // Raises the priority to at least 'floor'; true if it changed.
+    // Priority never goes down - a boost from any dependent sticks.
+    bool raise_priority(Priority floor);
+
+    // Claims the current arming of the task: true for exactly one caller
+    // per trip through the ready queue. A priority re-bucket leaves a
+    // stale duplicate entry behind in the old ring (see
+    // LockFreeReadyQueue::reprioritize); whichever copy is popped first
+    // wins the claim and the other is discarded.
+    bool claim_run_once();
+
+    // Re-arms the claim before the task re-enters the ready queue (the
+    // cooperative-yield requeue path).
+    void rearm_run();
+
+    // Queue-wait bookkeeping (see enqueue_time_).
+    void mark_enqueued() { enqueue_time_ = std::chrono::steady_clock::now(); }
+    std::chrono::steady_clock::time_point get_enqueue_time() const {
+        return enqueue_time_;
+    }
     
     // Dependency management
     void add_dependency(TaskId dependency);
@@ -56,7 +134,44 @@ public:
     // Cancellation
     void request_cancel();
     bool is_cancel_requested() const;
-    
+
+    // Cooperative yield: marks the task so that when its work returns,
+    // execute() parks it back in READY instead of completing it. Set via
+    // TaskContext::yield() from inside the work function.
+    void request_yield();
+
     // Future support
     std::future<void> get_future();
+
+private:
+    // Records the outcome and satisfies the promise if one exists.
+    // 'error' is null for success.
+    void deliver_completion(std::exception_ptr error);
+
+    // Clears a pending yield request; true if one was set.
+    bool consume_yield_request();
+};
+
+// Handed to context-aware work functions (the submit_task overload taking
+// a void(TaskContext&) callable). yield() checkpoints the task: the work
+// must save whatever state it needs in its own closure and return
+// promptly, and the scheduler re-runs the same work later from the ready
+// queue at the task's priority. Between runs the task counts as
+// unfinished - dependents stay blocked and its future stays unsatisfied -
+// so a long-running job can share the pool without monopolizing a worker.
+class TaskContext {
+public:
+    // Requests a requeue once the current run returns.
+    void yield() { task_.request_yield(); }
+
+    // Cooperative cancellation poll, same as Task::is_cancel_requested.
+    bool cancel_requested() const { return task_.is_cancel_requested(); }
+
+    TaskId task_id() const { return task_.get_id(); }
+
+private:
+    friend class Task;
+    explicit TaskContext(Task& task) : task_(task) {}
+
+    Task& task_;
 };
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "unique_function.hpp"
+
+class TaskScheduler;
+
+namespace scheduler {
+
+// A reusable, pre-validated DAG of work items.
+//
+// Recurring workflows have a static shape, but rebuilding them through
+// submit_with_dependencies pays cycle detection and per-edge locking on
+// every run. A TaskGraph is built once: finalize() validates acyclicity
+// a single time (Kahn's algorithm) and flattens the structure into plain
+// arrays - an indegree per node and the dependent edges in CSR layout.
+// TaskScheduler::run() then replays the graph with one atomic decrement
+// per edge and zero per-run setup beyond an indegree array copy; the
+// shared_mutex-protected hash maps of DependencyManager are never
+// touched.
+//
+// Node work must be re-invocable: the same callable runs once per
+// replay.
+class TaskGraph {
+public:
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+    TaskGraph(TaskGraph&&) = default;
+    TaskGraph& operator=(TaskGraph&&) = default;
+
+    // Adds a node depending on earlier nodes (by index). Returns the new
+    // node's index. Throws if the graph is finalized or a dependency
+    // index is out of range.
+    std::size_t add_node(unique_function<void()> work,
+                         std::vector<std::size_t> dependencies = {});
+
+    // Validates the graph (throws std::runtime_error on a cycle) and
+    // builds the flat execution structures. No nodes may be added
+    // afterwards; run() requires a finalized graph.
+    void finalize();
+
+    bool is_finalized() const { return finalized_; }
+    std::size_t node_count() const { return works_.size(); }
+
+private:
+    friend class ::TaskScheduler;
+
+    // Build-time form.
+    std::vector<unique_function<void()>> works_;
+    std::vector<std::vector<std::size_t>> dependencies_;
+
+    // Execution form, produced by finalize(): indegree per node plus the
+    // dependent lists flattened into CSR (dependents of node i are
+    // edges_[edge_offsets_[i] .. edge_offsets_[i + 1])).
+    std::vector<int> indegree_;
+    std::vector<std::size_t> edge_offsets_;
+    std::vector<std::size_t> edges_;
+
+    bool finalized_ = false;
+};
+
+}  // namespace scheduler
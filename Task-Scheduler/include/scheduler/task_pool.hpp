@@ -0,0 +1,113 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "task.hpp"
+
+// Slab-backed object pool for Task storage.
+//
+// Every submission used to make_shared a Task and throw it away on
+// completion; under sustained load that is the scheduler's single biggest
+// source of allocator churn. The pool carves cells out of fixed-size
+// slabs and recycles them through a lock-free Treiber free list.
+// acquire() builds the Task with allocate_shared over a cell-backed
+// allocator, so the shared_ptr control block and the Task land in the
+// same cell (make_shared's combined layout, but in pooled storage) and a
+// task's steady-state cost is zero heap allocations. Slabs are only
+// allocated when the free list runs dry and are never returned to the OS
+// until the pool is destroyed.
+class TaskPool {
+private:
+    // Room for the control block allocate_shared prepends to the Task.
+    // Both mainstream standard libraries need at most a vtable pointer
+    // plus two reference counts (padded); the allocator static_asserts
+    // that the real node type fits.
+    static constexpr size_t kControlBlockHeadroom = 64;
+
+    // A free cell is large enough for either a shared_ptr node holding a
+    // Task or a link pointer.
+    union Cell {
+        Cell* next;
+        alignas(std::max_align_t) unsigned char
+            storage[sizeof(Task) + kControlBlockHeadroom];
+    };
+
+    // Minimal allocator handing out pool cells; allocate_shared rebinds
+    // it to its internal node type, which is why the fit check lives
+    // here rather than on Task itself.
+    template <typename T>
+    class CellAllocator {
+    public:
+        using value_type = T;
+
+        explicit CellAllocator(TaskPool* pool) : pool_(pool) {}
+        template <typename U>
+        CellAllocator(const CellAllocator<U>& other) : pool_(other.pool_) {}
+
+        T* allocate(size_t) {
+            static_assert(sizeof(T) <= sizeof(Cell) &&
+                              alignof(T) <= alignof(Cell),
+                          "shared_ptr node outgrew the pool cell; bump "
+                          "kControlBlockHeadroom");
+            return reinterpret_cast<T*>(pool_->take_cell());
+        }
+        void deallocate(T* ptr, size_t) {
+            pool_->push_cell(reinterpret_cast<Cell*>(ptr));
+        }
+
+        template <typename U>
+        bool operator==(const CellAllocator<U>& other) const {
+            return pool_ == other.pool_;
+        }
+        template <typename U>
+        bool operator!=(const CellAllocator<U>& other) const {
+            return pool_ != other.pool_;
+        }
+
+    private:
+        template <typename U> friend class CellAllocator;
+        TaskPool* pool_;
+    };
+
+    static constexpr size_t kTasksPerSlab = 256;
+
+    // Lock-free LIFO of recycled cells. The head packs a 16-bit
+    // generation tag into the unused upper bits of the pointer so a
+    // pop's CAS cannot succeed against a recycled head (the classic
+    // ABA problem with Treiber stacks).
+    std::atomic<std::uintptr_t> free_head_;
+
+    // Slab bookkeeping; only touched when the free list is empty.
+    mutable std::mutex slabs_mutex_;
+    std::vector<std::unique_ptr<Cell[]>> slabs_;
+
+public:
+    TaskPool();
+    ~TaskPool() = default;
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    // Constructs a Task and its control block in one pooled cell. The
+    // cell returns to the pool when the last reference drops.
+    std::shared_ptr<Task> acquire(TaskId id,
+                                  scheduler::unique_function<void()> work,
+                                  Priority priority);
+
+    // Same, for context-aware work (see TaskContext in task.hpp).
+    std::shared_ptr<Task> acquire(TaskId id,
+                                  scheduler::unique_function<void(TaskContext&)> work,
+                                  Priority priority);
+
+    // Number of slabs currently allocated (for monitoring).
+    size_t slab_count() const;
+
+private:
+    Cell* take_cell();
+    Cell* pop_cell();
+    void push_cell(Cell* cell);
+    void add_slab();
+};
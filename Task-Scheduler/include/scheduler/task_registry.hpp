@@ -0,0 +1,110 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "task.hpp"
+
+// Sharded task registry.
+//
+// The scheduler used to keep every live task in one unordered_map behind
+// one mutex, so status polling, cancellation, and submission all fought
+// over the same lock. The registry is now split into 64 stripes selected
+// by TaskId; since ids are handed out sequentially, consecutive
+// submissions land on different stripes and monitoring threads polling
+// one task no longer stall submitters touching another.
+class TaskRegistry {
+private:
+    static constexpr size_t kNumShards = 64;  // Power of two for cheap masking
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<TaskId, std::shared_ptr<Task>> tasks;
+    };
+
+    std::array<Shard, kNumShards> shards_;
+
+    static size_t shard_index(TaskId id) {
+        return id & (kNumShards - 1);
+    }
+
+public:
+    TaskRegistry() = default;
+    TaskRegistry(const TaskRegistry&) = delete;
+    TaskRegistry& operator=(const TaskRegistry&) = delete;
+
+    void insert(TaskId id, std::shared_ptr<Task> task) {
+        Shard& shard = shards_[shard_index(id)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.tasks[id] = std::move(task);
+    }
+
+    // Inserts a whole batch, acquiring each involved shard lock once
+    // instead of once per task.
+    void insert_batch(std::vector<std::pair<TaskId, std::shared_ptr<Task>>>& entries) {
+        // Bucket by shard first so each shard lock is taken exactly once.
+        std::array<std::vector<size_t>, kNumShards> buckets;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            buckets[shard_index(entries[i].first)].push_back(i);
+        }
+        for (size_t s = 0; s < kNumShards; ++s) {
+            if (buckets[s].empty()) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(shards_[s].mutex);
+            for (size_t i : buckets[s]) {
+                shards_[s].tasks[entries[i].first] = std::move(entries[i].second);
+            }
+        }
+    }
+
+    // Returns nullptr if the task is unknown.
+    std::shared_ptr<Task> find(TaskId id) const {
+        const Shard& shard = shards_[shard_index(id)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.tasks.find(id);
+        return it != shard.tasks.end() ? it->second : nullptr;
+    }
+
+    bool contains(TaskId id) const {
+        const Shard& shard = shards_[shard_index(id)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.tasks.find(id) != shard.tasks.end();
+    }
+
+    void erase(TaskId id) {
+        Shard& shard = shards_[shard_index(id)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.tasks.erase(id);
+    }
+
+    // Applies fn to every task, one shard at a time. fn must not call back
+    // into the registry.
+    template<typename Fn>
+    void for_each(Fn fn) const {
+        for (const Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto& pair : shard.tasks) {
+                fn(pair.second);
+            }
+        }
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total += shard.tasks.size();
+        }
+        return total;
+    }
+
+    void clear() {
+        for (Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.tasks.clear();
+        }
+    }
+};
@@ -2,28 +2,104 @@
 #include <memory>
 #include <unordered_map>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
 #include <future>
 #include <functional>
 #include <mutex>
+#include <span>
 #include <thread>
 
+#include "hierarchical_mutex.hpp"
+#include "../../../Concurrent-Data-Structures/sync/seqlock.hpp"
 #include "thread_pool.hpp"
-#include "priority_queue.hpp"
+#include "ready_queue.hpp"
+#include "timing_wheel.hpp"
+#include "coro_task.hpp"
 #include "dependency_manager.hpp"
+#include "task_pool.hpp"
+#include "task_registry.hpp"
 #include "task.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include "task_graph.hpp"
+
+// Describes one task in a batch submission. Entries may depend on earlier
+// entries of the same batch (by index) and on already-submitted tasks
+// (by TaskId); depending only on earlier indices keeps a batch acyclic by
+// construction, so no per-task cycle check is needed on the batch path.
+struct TaskSpec {
+    scheduler::unique_function<void()> work;
+    Priority priority = Priority::NORMAL;
+    std::vector<size_t> batch_dependencies;    // Indices of earlier batch entries
+    std::vector<TaskId> external_dependencies; // IDs of previously submitted tasks
+};
+
+// What the typed submit returns: the task's id (for wiring dependencies
+// on later submissions) plus a future carrying the callable's result.
+template<typename R>
+struct SubmitResult {
+    TaskId id;
+    std::future<R> result;
+};
 
 class TaskScheduler {
 private:
-    std::unique_ptr<ThreadPool> thread_pool_;
-    ThreadSafePriorityQueue ready_queue_;
+    // Declared first so the pooled Task storage outlives every shared_ptr
+    // released while the remaining members are destroyed.
+    TaskPool task_pool_;
+
+    std::unique_ptr<scheduler::ThreadPool> thread_pool_;
+    LockFreeReadyQueue ready_queue_;
     DependencyManager dependency_manager_;
     
-    std::unordered_map<TaskId, std::shared_ptr<Task>> all_tasks_;
-    mutable std::mutex tasks_mutex_;
+    // Sharded: see task_registry.hpp. Status polls no longer serialize
+    // against submissions.
+    TaskRegistry all_tasks_;
     
+    // Federation: TaskIds are namespaced per scheduler instance - the top
+    // kInstanceBits of every id carry instance_id_ - so ids minted by
+    // different schedulers in the same process never collide and a
+    // forwarded proxy id is safe to hand across instances.
+    static constexpr unsigned kInstanceBits = kTaskInstanceBits;
+    static constexpr unsigned kInstanceShift = kTaskInstanceShift;
+    std::uint32_t instance_id_;
     std::atomic<TaskId> next_task_id_;
     std::atomic<bool> shutdown_requested_;
 
+    // Cross-scheduler handoff links (see forward()): source task id ->
+    // proxies to settle on other instances when it finishes. The counter
+    // mirrors the map size so the completion hot path can skip the mutex
+    // while no forwards exist.
+    struct ForwardLink {
+        TaskScheduler* target;
+        TaskId proxy_id;
+    };
+    std::mutex forward_mutex_;
+    std::unordered_map<TaskId, std::vector<ForwardLink>> forwards_;
+    std::atomic<size_t> forward_count_{0};
+
+    // Tasks submitted but not yet terminal. wait_for_all futex-waits on
+    // this instead of polling pending_tasks().
+    std::atomic<size_t> unfinished_count_;
+
+    // Opt-in lifecycle tracing (see trace.hpp); one relaxed load per
+    // record call while disabled.
+    scheduler::TaskTracer tracer_;
+
+    // Delayed/recurring submissions. The wheel is passive; timer_thread_
+    // ticks it and feeds expired work into the normal submission path, so
+    // expiry lands straight in ready_queue_ with no second queue hop.
+    scheduler::TimingWheel timing_wheel_;
+    std::thread timer_thread_;
+    scheduler::HierarchicalMutex<> timer_mutex_{scheduler::lock_level::kTimer};
+    std::condition_variable_any timer_cv_;
+
+    // Written by the timer thread each tick (see publish_stats), read
+    // by monitors through published_stats() without locks.
+    cds::seqlock<scheduler::PublishedStats> published_stats_;  // waits on the wrapped mutex
+
 public:
     // Constructor and destructor
     explicit TaskScheduler(size_t num_threads = std::thread::hardware_concurrency());
@@ -35,46 +111,222 @@ public:
     TaskScheduler(TaskScheduler&&) = delete;
     TaskScheduler& operator=(TaskScheduler&&) = delete;
     
-    // Task submission
-    TaskId submit_task(std::function<void()> work, 
+    // Task submission. Submitting with dependencies applies priority
+    // inheritance: every incomplete dependency (transitively) is raised
+    // to at least this task's priority, so a HIGH task never waits on a
+    // LOW dependency stuck behind unrelated NORMAL work.
+    TaskId submit_task(scheduler::unique_function<void()> work,
                       Priority priority = Priority::NORMAL,
                       const std::vector<TaskId>& dependencies = {});
-    
-    // Template version for easier use
+
+    // Context-aware submission: the work receives a TaskContext whose
+    // yield() checkpoints the task back onto the ready queue at its
+    // priority (see TaskContext in task.hpp), so a long-running job can
+    // interleave with everything else sharing the pool instead of
+    // monopolizing a worker. The work is re-invoked from the top on each
+    // resumption; it carries its progress in its own closure state.
+    TaskId submit_task(scheduler::unique_function<void(TaskContext&)> work,
+                      Priority priority = Priority::NORMAL,
+                      const std::vector<TaskId>& dependencies = {});
+
+    // Batch submission: registers every task, wires every dependency, and
+    // publishes all initially-ready tasks with one registry lock
+    // acquisition and one dependency-manager lock acquisition, instead of
+    // paying locking and notification once per task. Returns the assigned
+    // IDs in batch order.
+    std::vector<TaskId> submit_batch(std::vector<TaskSpec> specs);
+
+    // Typed submission: the callable's return value (or thrown exception)
+    // travels through the returned future instead of being discarded, so
+    // callers no longer smuggle results out through captured shared state.
+    // Priorities and dependencies work exactly as with submit_task.
     template<typename F, typename... Args>
-    TaskId submit(F&& f, Args&&... args) {
-        auto task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
-        return submit_task(std::move(task));
+    auto submit(F&& f, Args&&... args)
+        -> SubmitResult<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    {
+        return submit_impl(Priority::NORMAL, {},
+                           std::forward<F>(f), std::forward<Args>(args)...);
     }
-    
+
     template<typename F, typename... Args>
-    TaskId submit_with_priority(Priority priority, F&& f, Args&&... args) {
-        auto task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
-        return submit_task(std::move(task), priority);
+    auto submit_with_priority(Priority priority, F&& f, Args&&... args)
+        -> SubmitResult<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    {
+        return submit_impl(priority, {},
+                           std::forward<F>(f), std::forward<Args>(args)...);
     }
-    
+
     template<typename F, typename... Args>
-    TaskId submit_with_dependencies(const std::vector<TaskId>& dependencies, F&& f, Args&&... args) {
-        auto task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
-        return submit_task(std::move(task), Priority::NORMAL, dependencies);
+    auto submit_with_dependencies(const std::vector<TaskId>& dependencies, F&& f, Args&&... args)
+        -> SubmitResult<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    {
+        return submit_impl(Priority::NORMAL, dependencies,
+                           std::forward<F>(f), std::forward<Args>(args)...);
     }
     
+    // This scheduler's TaskId namespace (the top bits of every id it
+    // mints). Distinct per instance within a process.
+    std::uint32_t instance_id() const { return instance_id_; }
+
+    // Cross-scheduler handoff: returns a proxy TaskId in 'target' that
+    // completes (or cancels) exactly when 'task_id' finishes here, usable
+    // in 'target' as an ordinary dependency. The proxy is settled
+    // directly on the completing worker thread - dependents land straight
+    // in target's ready queue with no glue thread and no future hop - and
+    // counts toward target's wait_for_all until then. A forward whose
+    // source never finishes before shutdown simply never fires. Both
+    // schedulers must outlive the handoff.
+    TaskId forward(TaskId task_id, TaskScheduler& target);
+
+    // Replays a finalized TaskGraph and blocks until every node has run.
+    // Per-run cost is one indegree-array copy plus one atomic decrement
+    // per edge; DependencyManager and its locks are not involved. If any
+    // node throws, the remaining nodes still run and the first exception
+    // is rethrown when the run completes. May be called repeatedly and
+    // from several threads (each call is an independent replay).
+    void run(scheduler::TaskGraph& graph);
+
+    // Coroutine hop: `co_await scheduler.schedule(priority)` suspends the
+    // coroutine and resumes it on a pool thread as an ordinary task. This
+    // is the only point in a coroutine pipeline that touches the ready
+    // queue; task<T> stage boundaries resume by symmetric transfer (see
+    // coro_task.hpp) with no future, no promise, and no wakeup. It also
+    // doubles as cooperative yielding for coroutine bodies: a mid-body
+    // `co_await schedule(priority)` is TaskContext::yield() with the
+    // checkpointing done by the compiler - the rest of the coroutine is
+    // requeued as a fresh task and the worker moves on.
+    auto schedule(Priority priority = Priority::NORMAL) {
+        struct ScheduleAwaiter {
+            TaskScheduler* self;
+            Priority priority;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) {
+                self->submit_task([handle] { handle.resume(); }, priority);
+            }
+            void await_resume() const noexcept {}
+        };
+        return ScheduleAwaiter{this, priority};
+    }
+
+    // Delayed submission: the work becomes a normal task (with the given
+    // priority) once the delay elapses. Returns a TimerId usable with
+    // cancel_timer until the timer fires; the task itself gets its TaskId
+    // only at expiry.
+    scheduler::TimerId submit_after(std::chrono::milliseconds delay,
+                                    scheduler::unique_function<void()> work,
+                                    Priority priority = Priority::NORMAL);
+
+    // Recurring submission: a fresh task is submitted every interval until
+    // the timer is cancelled. The work must be re-invocable.
+    scheduler::TimerId submit_periodic(std::chrono::milliseconds interval,
+                                       scheduler::unique_function<void()> work,
+                                       Priority priority = Priority::NORMAL);
+
+    // Cancels a timer from submit_after/submit_periodic. Does not affect
+    // tasks already submitted by earlier firings.
+    bool cancel_timer(scheduler::TimerId timer_id);
+
     // Task management
     std::future<void> get_task_future(TaskId task_id);
-    bool cancel_task(TaskId task_id);
+    // Cancels a task. With propagate=true the entire downstream subgraph
+    // (everything that transitively depends on it) is cancelled and its
+    // dependency bookkeeping reclaimed in one pass - otherwise those
+    // dependents would wait forever on a completion that can never come.
+    bool cancel_task(TaskId task_id, bool propagate = false);
     TaskState get_task_status(TaskId task_id) const;
     
     // Status queries
     size_t pending_tasks() const;
     size_t ready_tasks() const;
+
+    // Aggregates the per-worker counter lines and the ready-queue
+    // high-water mark with relaxed loads - workers are never stopped.
+    // Totals are sums over per_worker (the last entry covers non-worker
+    // threads).
+    scheduler::SchedulerStats snapshot() const;
+
+    // Seqlock-published totals, refreshed by the timer thread once per
+    // tick: the cheap polling interface for monitors. One consistent
+    // copy, never touches the worker lines, at most one tick stale.
+    scheduler::PublishedStats published_stats() const;
+
+    // Lifecycle tracing: while enabled, every submit/ready/start/end/
+    // cancel transition is recorded into per-thread ring buffers;
+    // dump_trace_json() serializes them as Chrome trace-event JSON
+    // (chrome://tracing).
+    void enable_tracing() { tracer_.enable(); }
+    void disable_tracing() { tracer_.disable(); }
+    std::string dump_trace_json() { return tracer_.dump_json(); }
     
     // Control
     void shutdown();
+    // Blocks with zero CPU (std::atomic::wait - a futex on Linux) until
+    // every submitted task is terminal; woken exactly when the count
+    // changes rather than re-checking on a timer.
     void wait_for_all();
+    // Blocks until each listed task is COMPLETED or CANCELLED. Unknown
+    // ids are ignored.
+    void wait_for_group(std::span<const TaskId> task_ids);
 
 private:
+    // Shared body of the typed submit overloads: wrap the call in a
+    // packaged_task (same recipe as scheduler::ThreadPool::submit - the
+    // move-only wrapper lets us capture it by move), then route through
+    // submit_task so priorities and dependencies behave identically.
+    template<typename F, typename... Args>
+    auto submit_impl(Priority priority, const std::vector<TaskId>& dependencies,
+                     F&& f, Args&&... args)
+        -> SubmitResult<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    {
+        using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+
+        std::packaged_task<R()> packaged(
+            [func = std::forward<F>(f),
+             tuple = std::make_tuple(std::forward<Args>(args)...)]() mutable -> R {
+                return std::apply(std::move(func), std::move(tuple));
+            });
+
+        std::future<R> result = packaged.get_future();
+        TaskId id = submit_task(
+            [packaged = std::move(packaged)]() mutable { packaged(); },
+            priority, dependencies);
+
+        return {id, std::move(result)};
+    }
+
+    // Ticks the timing wheel until shutdown.
+    void timer_loop();
+    void publish_stats();
+
+    // One in-flight replay of a TaskGraph.
+    struct GraphRun;
+    // Executes node 'index' and releases its dependents.
+    void run_graph_node(const std::shared_ptr<GraphRun>& run, size_t index);
+
     // Internal methods
     TaskId generate_task_id();
+    // Shared tail of the submit_task overloads: registers an acquired
+    // task, wires its dependencies, and publishes it if ready.
+    TaskId publish_task(TaskId task_id, std::shared_ptr<Task> task,
+                        const std::vector<TaskId>& dependencies);
+    // Priority inheritance: raises 'task' and, transitively, its
+    // incomplete dependencies to at least 'floor'. A dependency already
+    // at or above the floor stops the walk - its own dependencies were
+    // boosted when it was submitted. Queued tasks are re-bucketed in
+    // O(1) (see LockFreeReadyQueue::reprioritize).
+    void inherit_priority(const std::shared_ptr<Task>& task, Priority floor);
+    // Federation plumbing. create_proxy registers a dependency-only
+    // placeholder task (no work, never queued) in this instance's
+    // namespace; settle_proxy finishes it - completing or cancelling its
+    // downstream subgraph - on the caller's thread; notify_forwards
+    // extracts and settles every link registered for a finished source
+    // task (extraction is exclusive, so links fire exactly once).
+    TaskId create_proxy();
+    void settle_proxy(TaskId proxy_id, bool cancelled);
+    void notify_forwards(TaskId task_id, bool cancelled);
     void schedule_ready_tasks();
     void execute_task(std::shared_ptr<Task> task);
+    // Decrements the outstanding counter exactly once per task.
+    void on_task_finished(const std::shared_ptr<Task>& task);
 };
\ No newline at end of file
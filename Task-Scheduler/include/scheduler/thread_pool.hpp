@@ -8,31 +8,187 @@
 #include <condition_variable>
 #include <functional>
 #include <future>
+#include <memory>
+#include <atomic>
 #include <stdexcept>
 
+#include "hierarchical_mutex.hpp"
+#include "numa_topology.hpp"
+#include "work_stealing_deque.hpp"
+#include "unique_function.hpp"
+#include "stats.hpp"
+
 namespace scheduler {
 
+// Work-stealing thread pool.
+//
+// Each worker owns a lock-free WorkStealingDeque. Tasks enqueued from a
+// worker thread go into that worker's local deque (popped LIFO for cache
+// locality); tasks enqueued from outside the pool go into a shared
+// injection queue. An idle worker first drains its own deque, then steals
+// FIFO from the other workers, and only then touches the mutex-protected
+// injection queue - so the shared lock is off the hot path entirely.
 class ThreadPool {
 public:
+    // Fixed-size pool: exactly num_threads workers for the pool's
+    // lifetime.
     explicit ThreadPool(size_t num_threads);
+
+    // Adaptive pool: starts at min_threads and a controller thread
+    // grows/shrinks the worker set within [min_threads, max_threads]
+    // based on queue depth and observed utilization (see
+    // controller_loop).
+    ThreadPool(size_t min_threads, size_t max_threads);
+
+    // NUMA-aware variant: worker slots are assigned CPUs node by node
+    // and each worker pins itself to its CPU (best-effort, Linux).
+    // Stealing then prefers same-node victims, so tasks and the lines
+    // of the deques they sit in mostly stay on one socket; memory
+    // follows from first touch, since a pinned worker's allocations
+    // fault in on its own node. On a single-node machine (or where /sys
+    // is unavailable) this behaves exactly like the flat constructor.
+    ThreadPool(size_t min_threads, size_t max_threads, bool numa_aware);
+
     ~ThreadPool();
 
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
     // Submit a task to the thread pool
     template<class F, class... Args>
-    auto submit(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type>;
+    auto submit(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type> {
+        using return_type = typename std::result_of<F(Args...)>::type;
+
+        // unique_function is move-only, so the packaged_task can be
+        // captured directly instead of through a shared_ptr.
+        std::packaged_task<return_type()> task(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+        );
+
+        std::future<return_type> res = task.get_future();
+        enqueue([t = std::move(task)]() mutable { t(); });
+        return res;
+    }
+
+    // Fire-and-forget submission; the hot path for the scheduler.
+    void enqueue(unique_function<void()> task);
+
+    // Signal workers to stop and join them. Remaining queued tasks are
+    // discarded.
+    void shutdown();
+
+    // Currently active workers (the adaptive target, not the configured
+    // maximum).
+    size_t get_thread_count() const;
+
+    // Approximate number of queued tasks (injection queue + local deques).
+    size_t get_queue_size() const;
+
+    // True when the calling thread is one of this pool's workers. The
+    // parallel algorithms use this to decide between blocking on a
+    // condition variable (external caller) and helping (see below).
+    bool is_worker_thread() const { return current_pool_ == this; }
+
+    // Help-first joining for nested parallelism: runs ONE pending task
+    // on the calling worker thread - own deque first, then steal, then
+    // injection queue, exactly as the worker loop would. Returns false
+    // when the caller is not a worker of this pool or no task was found.
+    //
+    // A task that blocks waiting for subtasks it enqueued on its own
+    // pool would otherwise deadlock once every worker is such a waiter
+    // (guaranteed on a one-worker pool); looping on this instead turns
+    // each waiting worker back into an executor.
+    bool run_pending_task();
+
+    // The calling thread's counter line: its own worker line on a pool
+    // thread, the shared external line otherwise. Callers do relaxed
+    // increments only.
+    WorkerStats& local_stats();
+
+    // Copies every worker line (plus the external line) with relaxed
+    // loads - workers are never stopped or synchronized against.
+    std::vector<WorkerStatsSnapshot> stats_snapshot() const;
 
 private:
-    // Need to keep track of threads so we can join them
+    void worker_loop(size_t worker_index);
+
+    // Periodically re-targets the worker count from queue depth and
+    // executed-task deltas. Only runs when min_threads < max_threads.
+    void controller_loop();
+
+    // Retargets to new_target and (re)spawns worker slots as needed.
+    // Caller must hold queue_mutex_.
+    void resize_workers_locked(size_t new_target);
+
+    // Local pop, then steal, then injection queue. Returns false if no
+    // work was found anywhere.
+    bool try_get_task(size_t worker_index, unique_function<void()>& task);
+
+    // Eventcount-style wakeup: notifies one worker only if one is parked.
+    // Call after publishing work to pending_tasks_ (seq_cst on both sides
+    // makes the announce/park handshake race-free).
+    void wake_one_worker();
+
+    // One slot per potential worker (max_threads_ of them). A slot's
+    // thread object may be joined and respawned across shrink/grow
+    // cycles; slot_active_[i] says whether slot i currently has a live
+    // worker.
     std::vector<std::thread> workers_;
-    // The task queue
-    std::queue<std::function<void()>> tasks_;
+    std::unique_ptr<std::atomic<bool>[]> slot_active_;
+
+    // One lock-free deque per worker slot, only pushed/popped by its
+    // owner and stolen from by the others. Sized to max_threads_ up
+    // front so stealers can scan without any resize race; a retired
+    // slot's deque stays stealable.
+    std::vector<std::unique_ptr<WorkStealingDeque<unique_function<void()>>>> local_queues_;
+
+    // Fallback path for external submitters and for local-deque overflow.
+    std::queue<unique_function<void()>> injection_queue_;
+
+    // Synchronization for the injection queue and for sleeping workers
+    mutable HierarchicalMutex<> queue_mutex_{lock_level::kPoolQueue};
+    std::condition_variable_any condition_;  // waits on the wrapped mutex
+
+    // Total tasks sitting in any queue; lets sleeping workers wake without
+    // scanning every deque under the mutex.
+    std::atomic<size_t> pending_tasks_;
+
+    // Workers currently parked on condition_ (incremented under
+    // queue_mutex_ just before waiting). Submitters consult it through
+    // wake_one_worker so a busy pool pays no futex syscall per enqueue -
+    // at high submission rates every worker is awake and notifies were
+    // pure waste.
+    std::atomic<size_t> sleeping_workers_{0};
+
+    std::atomic<bool> stop_; // Flag to signal threads to stop
+
+    // Sizing bounds and the current target. Workers whose index is at or
+    // beyond the target retire themselves (the decision is made under
+    // queue_mutex_ so a concurrent grow can't race a retiring worker).
+    size_t min_threads_;
+    size_t max_threads_;
+    std::atomic<size_t> target_threads_;
+
+    std::thread controller_;
+
+    // NUMA placement (empty when not numa_aware). worker_cpu_[i] is the
+    // CPU slot i pins to; steal_order_[i] is slot i's precomputed victim
+    // scan - same-node slots first, remote ones after - replacing the
+    // flat (i + k) % max rotation in try_get_task.
+    std::vector<int> worker_cpu_;
+    std::vector<std::vector<size_t>> steal_order_;
+
+    // max_threads_ + 1 cache-line-padded counter blocks; the extra one
+    // absorbs activity from threads outside the pool. Raw array because
+    // atomics aren't movable.
+    std::unique_ptr<WorkerStats[]> stats_;
 
-    // Synchronization primitives
-    std::mutex queue_mutex_;
-    std::condition_variable condition_;
-    bool stop_; // Flag to signal threads to stop
+    // Identifies the current thread as a worker of a particular pool so
+    // enqueue() can take the lock-free local path.
+    static thread_local ThreadPool* current_pool_;
+    static thread_local size_t current_worker_index_;
 };
 
 } // namespace scheduler
 
-#endif // SCHEDULER_THREAD_POOL_HPP
\ No newline at end of file
+#endif // SCHEDULER_THREAD_POOL_HPP
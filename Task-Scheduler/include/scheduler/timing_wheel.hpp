@@ -0,0 +1,102 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "unique_function.hpp"
+
+namespace scheduler {
+
+using TimerId = std::size_t;
+
+// Hierarchical timing wheel.
+//
+// Four levels of 256 slots each, so a timer is placed by bit-slicing its
+// expiry tick - O(1) insertion, no comparisons, no sorted structure. Each
+// advance() step touches exactly one level-0 slot; timers parked on a
+// higher level cascade down only when their level-0 window comes around.
+// With a 1ms tick the wheel spans ~2^32 ms (~49 days), far beyond any
+// retry/timeout horizon we schedule.
+//
+// The wheel is passive: it never spawns a thread or reads the clock. The
+// owner converts wall time to a tick count and calls advance(), which
+// hands back the expired callbacks to run outside the wheel's lock.
+// Periodic timers are reinserted internally before their callback is
+// handed out.
+class TimingWheel {
+public:
+    explicit TimingWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(1));
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    // One-shot timer firing 'delay' from now (rounded up to a whole tick).
+    TimerId schedule(std::chrono::milliseconds delay, unique_function<void()> callback);
+
+    // Recurring timer firing every 'interval' until cancelled. The
+    // callback is shared across firings, so it must be re-invocable.
+    TimerId schedule_periodic(std::chrono::milliseconds interval,
+                              unique_function<void()> callback);
+
+    // Lazy cancellation: the entry is dropped when its slot is next
+    // touched. Returns false if the timer is unknown or already fired.
+    bool cancel(TimerId id);
+
+    // Advances the wheel to now_tick, appending every expired callback to
+    // 'fired'. The caller invokes them after releasing its own locks.
+    void advance(std::uint64_t now_tick, std::vector<unique_function<void()>>& fired);
+
+    std::chrono::milliseconds tick_duration() const { return tick_; }
+
+    // Converts a duration to whole ticks, rounding up so nothing fires
+    // early.
+    std::uint64_t to_ticks(std::chrono::milliseconds duration) const;
+
+private:
+    static constexpr std::size_t kSlotBits = 8;
+    static constexpr std::size_t kSlotsPerLevel = 1u << kSlotBits;  // 256
+    static constexpr std::size_t kNumLevels = 4;
+    static constexpr std::size_t kSlotMask = kSlotsPerLevel - 1;
+
+    struct Entry {
+        TimerId id;
+        std::uint64_t expiry_tick;
+        std::uint64_t interval_ticks;  // 0 for one-shot
+
+        // One-shot timers own their callback; periodic timers share it
+        // across firings (unique_function is move-only, so each firing
+        // hands out a thin lambda over the shared callable instead).
+        unique_function<void()> callback;
+        std::shared_ptr<unique_function<void()>> shared_callback;
+    };
+
+    using Slot = std::vector<Entry>;
+
+    // Places the entry by the distance to its expiry: level l holds
+    // timers due within (2^(8l), 2^(8(l+1))] ticks, indexed by bits
+    // [8l, 8(l+1)) of the expiry tick.
+    void insert_locked(Entry entry);
+
+    // Moves every live entry of a higher-level slot down one level (or
+    // into 'fired' if it is already due).
+    void cascade_locked(std::size_t level, std::size_t slot_index,
+                        std::vector<unique_function<void()>>& fired);
+
+    // Expires or reinserts a single entry.
+    void fire_locked(Entry& entry, std::vector<unique_function<void()>>& fired);
+
+    const std::chrono::milliseconds tick_;
+
+    std::mutex mutex_;
+    Slot wheel_[kNumLevels][kSlotsPerLevel];
+    std::uint64_t current_tick_ = 0;
+    TimerId next_timer_id_ = 1;
+    std::unordered_set<TimerId> cancelled_;
+    std::size_t live_timers_ = 0;
+};
+
+}  // namespace scheduler
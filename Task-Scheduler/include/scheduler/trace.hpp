@@ -0,0 +1,97 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "task.hpp"
+
+namespace scheduler {
+
+// Lifecycle phases recorded per task. START/END become Chrome "B"/"E"
+// duration events; the rest are instant events on the recording thread's
+// track.
+enum class TracePhase : std::uint8_t {
+    SUBMITTED,
+    READY,
+    START,
+    END,
+    CANCELLED
+};
+
+// Opt-in lifecycle tracer dumping Chrome trace-event JSON
+// (chrome://tracing / Perfetto).
+//
+// Recording is designed to stay on in production: when disabled, record()
+// is one relaxed load and a branch; when enabled, it is a store into the
+// calling thread's own fixed-size ring plus a relaxed index bump - no
+// locks, no allocation, no shared cache line. Each ring overwrites its
+// oldest events when full, so tracing bounds memory and keeps the most
+// recent window, which is the one that matters when a DAG runs slow.
+//
+// The only mutex guards thread registration (first event from a thread)
+// and dump_json(), both cold paths.
+class TaskTracer {
+public:
+    TaskTracer() = default;
+    TaskTracer(const TaskTracer&) = delete;
+    TaskTracer& operator=(const TaskTracer&) = delete;
+
+    void enable() { enabled_.store(true, std::memory_order_release); }
+    void disable() { enabled_.store(false, std::memory_order_release); }
+    bool is_enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // Hot path: no-op unless enabled.
+    void record(TaskId task_id, TracePhase phase) {
+        if (!is_enabled()) {
+            return;
+        }
+        record_slow(task_id, phase);
+    }
+
+    // Serializes every buffered event as a Chrome trace-event JSON
+    // document. Recording may continue concurrently; events written while
+    // dumping may or may not appear.
+    std::string dump_json();
+
+private:
+    struct TraceEvent {
+        std::uint64_t timestamp_ns;
+        TaskId task_id;
+        TracePhase phase;
+    };
+
+    struct ThreadBuffer {
+        // 64k events * 24 bytes = 1.5 MiB per recording thread.
+        static constexpr std::size_t kCapacity = 1u << 16;
+
+        std::array<TraceEvent, kCapacity> events;
+        // Monotonic write index; slot = next % kCapacity. Only the owning
+        // thread writes, so relaxed ordering suffices for the events and
+        // a release on the index publishes them to the dumper.
+        std::atomic<std::uint64_t> next{0};
+        std::uint32_t thread_track = 0;
+    };
+
+    // Registers (once per thread) and appends to the thread's own ring.
+    void record_slow(TaskId task_id, TracePhase phase);
+
+    ThreadBuffer* local_buffer();
+
+    std::atomic<bool> enabled_{false};
+
+    std::mutex registry_mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::uint32_t next_track_ = 1;
+
+    // Same pattern as ThreadPool's worker identification: the pair tags
+    // which tracer the cached buffer belongs to, so multiple schedulers
+    // coexist.
+    static thread_local TaskTracer* current_tracer_;
+    static thread_local ThreadBuffer* current_buffer_;
+};
+
+}  // namespace scheduler
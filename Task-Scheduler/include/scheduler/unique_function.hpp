@@ -0,0 +1,172 @@
+#ifndef SCHEDULER_UNIQUE_FUNCTION_HPP
+#define SCHEDULER_UNIQUE_FUNCTION_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace scheduler {
+
+// Move-only callable wrapper with inline small-buffer storage.
+//
+// std::function heap-allocates for any capture beyond a couple of pointers
+// and requires the target to be copyable. Task lambdas here typically
+// capture a few pointers/ids, so the default 56-byte inline buffer
+// absorbs nearly all of them - zero allocations on the submit path. Larger callables
+// (and move-only ones like a captured std::packaged_task) fall back to a
+// single heap cell.
+//
+// InlineBytes is tunable per use site for callables known to carry fatter
+// captures; functions with different buffer sizes are distinct types and
+// do not convert into each other.
+inline constexpr std::size_t kUniqueFunctionInlineBytes = 56;
+
+template<typename Signature,
+         std::size_t InlineBytes = kUniqueFunctionInlineBytes>
+class unique_function;
+
+template<typename R, typename... Args, std::size_t InlineBytes>
+class unique_function<R(Args...), InlineBytes> {
+private:
+    // Default: 56 bytes of storage + 8 bytes of vtable pointer = one
+    // cache line. Must at least fit the heap fallback's pointer.
+    static constexpr std::size_t kBufferSize =
+        InlineBytes < sizeof(void*) ? sizeof(void*) : InlineBytes;
+    static constexpr std::size_t kBufferAlign = alignof(std::max_align_t);
+
+    // Hand-rolled vtable: one static instance per erased type.
+    struct VTable {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*move_to)(void* from, void* to);  // Move-construct into 'to', destroy 'from'
+        void (*destroy)(void* storage);
+    };
+
+    template<typename F>
+    static constexpr bool stored_inline() {
+        return sizeof(F) <= kBufferSize &&
+               alignof(F) <= kBufferAlign &&
+               std::is_nothrow_move_constructible<F>::value;
+    }
+
+    // --- Inline storage handlers ---
+    template<typename F>
+    struct InlineHandler {
+        static F* get(void* storage) {
+            return static_cast<F*>(storage);
+        }
+        static R invoke(void* storage, Args&&... args) {
+            return (*get(storage))(std::forward<Args>(args)...);
+        }
+        static void move_to(void* from, void* to) {
+            ::new (to) F(std::move(*get(from)));
+            get(from)->~F();
+        }
+        static void destroy(void* storage) {
+            get(storage)->~F();
+        }
+        static const VTable* vtable() {
+            static const VTable table = {&invoke, &move_to, &destroy};
+            return &table;
+        }
+    };
+
+    // --- Heap fallback handlers (the buffer holds just an F*) ---
+    template<typename F>
+    struct HeapHandler {
+        static F*& get(void* storage) {
+            return *static_cast<F**>(storage);
+        }
+        static R invoke(void* storage, Args&&... args) {
+            return (*get(storage))(std::forward<Args>(args)...);
+        }
+        static void move_to(void* from, void* to) {
+            *static_cast<F**>(to) = get(from);  // Just move the pointer
+            get(from) = nullptr;
+        }
+        static void destroy(void* storage) {
+            delete get(storage);
+        }
+        static const VTable* vtable() {
+            static const VTable table = {&invoke, &move_to, &destroy};
+            return &table;
+        }
+    };
+
+    alignas(kBufferAlign) unsigned char storage_[kBufferSize];
+    const VTable* vtable_ = nullptr;
+
+public:
+    unique_function() noexcept = default;
+    unique_function(std::nullptr_t) noexcept {}
+
+    // Constructs from any callable invocable as R(Args...).
+    template<typename F,
+             typename DF = typename std::decay<F>::type,
+             typename = typename std::enable_if<
+                 !std::is_same<DF, unique_function>::value &&
+                 std::is_invocable_r<R, DF&, Args...>::value>::type>
+    unique_function(F&& f) {
+        if constexpr (stored_inline<DF>()) {
+            ::new (static_cast<void*>(storage_)) DF(std::forward<F>(f));
+            vtable_ = InlineHandler<DF>::vtable();
+        } else {
+            *reinterpret_cast<DF**>(storage_) = new DF(std::forward<F>(f));
+            vtable_ = HeapHandler<DF>::vtable();
+        }
+    }
+
+    unique_function(unique_function&& other) noexcept {
+        if (other.vtable_) {
+            other.vtable_->move_to(other.storage_, storage_);
+            vtable_ = other.vtable_;
+            other.vtable_ = nullptr;
+        }
+    }
+
+    unique_function& operator=(unique_function&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.vtable_) {
+                other.vtable_->move_to(other.storage_, storage_);
+                vtable_ = other.vtable_;
+                other.vtable_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    // Move-only, like the tasks it carries.
+    unique_function(const unique_function&) = delete;
+    unique_function& operator=(const unique_function&) = delete;
+
+    ~unique_function() {
+        reset();
+    }
+
+    R operator()(Args... args) {
+        return vtable_->invoke(storage_, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept {
+        return vtable_ != nullptr;
+    }
+
+    void reset() noexcept {
+        if (vtable_) {
+            vtable_->destroy(storage_);
+            vtable_ = nullptr;
+        }
+    }
+
+    void swap(unique_function& other) noexcept {
+        unique_function tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+};
+
+} // namespace scheduler
+
+#endif // SCHEDULER_UNIQUE_FUNCTION_HPP
@@ -0,0 +1,170 @@
+#ifndef SCHEDULER_WORK_STEALING_DEQUE_HPP
+#define SCHEDULER_WORK_STEALING_DEQUE_HPP
+
+#include "../../../Concurrent-Data-Structures/sync/padded.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace scheduler {
+
+// Chase-Lev work-stealing deque.
+//
+// One thread (the owner) pushes and pops at the bottom in LIFO order, which
+// keeps recently submitted tasks hot in the owner's cache. Any other thread
+// may steal from the top in FIFO order, which takes the oldest (and therefore
+// coldest) task and minimizes contention with the owner.
+//
+// The deque has a fixed power-of-two capacity. push() reports failure when
+// the ring is full so the caller can fall back to a shared overflow queue
+// instead of blocking or resizing under contention.
+//
+// Elements are stored as heap-allocated T* so that slots can be published
+// with a single atomic pointer store; moving a whole T in and out of the
+// ring atomically is not possible for non-trivial T (e.g. std::function).
+template<typename T>
+class WorkStealingDeque {
+private:
+    const std::int64_t capacity_;
+    const std::int64_t mask_;
+    std::vector<std::atomic<T*>> buffer_;
+
+    // top_ is the steal end, bottom_ the owner end. Both only grow;
+    // the ring index is (value & mask_). Padded apart: thieves hammer
+    // top_ with CAS while the owner bumps bottom_ on every push/pop -
+    // on one line, every steal attempt would stall the owner.
+    cds::padded<std::atomic<std::int64_t>> top_;
+    cds::padded<std::atomic<std::int64_t>> bottom_;
+
+public:
+    explicit WorkStealingDeque(std::size_t capacity = 8192)
+        : capacity_(static_cast<std::int64_t>(round_up_pow2(capacity)))
+        , mask_(capacity_ - 1)
+        , buffer_(static_cast<std::size_t>(capacity_))
+        , top_(0)
+        , bottom_(0)
+    {
+        for (auto& slot : buffer_) {
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~WorkStealingDeque() {
+        // Drain anything left so we don't leak tasks on shutdown.
+        T item;
+        while (pop(item)) {
+        }
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only. Returns false if the ring is full, in which case the
+    // item is left untouched so the caller can route it elsewhere.
+    bool push(T&& item) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+
+        if (b - t >= capacity_) {
+            return false;  // Full - caller should use the overflow path
+        }
+
+        buffer_[static_cast<std::size_t>(b & mask_)]
+            .store(new T(std::move(item)), std::memory_order_relaxed);
+
+        // Publish the new element to thieves.
+        bottom_.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Owner only. Pops the most recently pushed element (LIFO).
+    bool pop(T& item) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+
+        // The fence orders the bottom_ store before the top_ load so that
+        // the owner and a concurrent thief cannot both take the last element.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Deque was already empty - restore bottom.
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        T* ptr = buffer_[static_cast<std::size_t>(b & mask_)]
+                     .load(std::memory_order_relaxed);
+
+        if (t == b) {
+            // Exactly one element left: race the thieves for it via CAS on top_.
+            if (!top_.compare_exchange_strong(t, t + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                // A thief won - the deque is now empty.
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+
+        item = std::move(*ptr);
+        delete ptr;
+        return true;
+    }
+
+    // Any thread. Steals the oldest element (FIFO).
+    bool steal(T& item) {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return false;  // Empty
+        }
+
+        T* ptr = buffer_[static_cast<std::size_t>(t & mask_)]
+                     .load(std::memory_order_relaxed);
+
+        // Claim the slot. If another thief (or the owner taking the last
+        // element) got there first, just report failure and let the caller
+        // try another victim.
+        if (!top_.compare_exchange_strong(t, t + 1,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return false;
+        }
+
+        item = std::move(*ptr);
+        delete ptr;
+        return true;
+    }
+
+    // Approximate - only meaningful for monitoring.
+    std::size_t size() const {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+private:
+    static std::size_t round_up_pow2(std::size_t n) {
+        std::size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+};
+
+} // namespace scheduler
+
+#endif // SCHEDULER_WORK_STEALING_DEQUE_HPP
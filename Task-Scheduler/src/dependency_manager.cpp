@@ -1,155 +1,417 @@
 #include "scheduler/dependency_manager.hpp"
+#include "../../Concurrent-Data-Structures/memory/monotonic_arena.hpp"
 #include <algorithm>
+#include <stdexcept>
 
 void DependencyManager::add_dependency(TaskId dependent, TaskId dependency) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    
-    // Add to dependents map
-    dependents_[dependency].insert(dependent);
-    
-    // Increment dependency count for the dependent task
-    dependency_count_[dependent]++;
-}
-
-std::vector<TaskId> DependencyManager::mark_completed(TaskId task_id) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    std::vector<TaskId> ready_tasks;
-    
+    std::unique_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
+    add_edge_locked(dependent, dependency);
+}
+
+void DependencyManager::add_dependencies(TaskId dependent,
+                                         std::span<const TaskId> dependencies)
+{
+    if (dependencies.empty()) {
+        return;
+    }
+    std::unique_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
+
+    // Fresh-dependent fast path (every normal submission): nothing can
+    // reach a node the graph has never seen, so no edge in this set can
+    // close a cycle - one check for the whole set. Order the
+    // dependencies first and the dependent after all of them, and the
+    // per-edge order test below can never trip, let alone DFS.
+    if (topo_order_.find(dependent) == topo_order_.end()) {
+        for (TaskId dependency : dependencies) {
+            ensure_node(dependency);
+        }
+        topo_order_[dependent] = next_order_++;
+    }
+    for (TaskId dependency : dependencies) {
+        add_edge_locked(dependent, dependency);
+    }
+}
+
+void DependencyManager::add_dependency_batch(
+    std::span<const std::pair<TaskId, TaskId>> edges)
+{
+    std::unique_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
+
+    // Same bookkeeping as add_dependency, but one lock acquisition for the
+    // whole edge list - the win that matters for 10k+ node DAG submissions.
+    for (const auto& [dependent, dependency] : edges) {
+        add_edge_locked(dependent, dependency);
+    }
+}
+
+void DependencyManager::ensure_node(TaskId id) {
+    // New nodes get a maximal order, which is always consistent: nothing
+    // can depend on a task that doesn't exist yet.
+    if (topo_order_.find(id) == topo_order_.end()) {
+        topo_order_[id] = next_order_++;
+    }
+}
+
+void DependencyManager::add_edge_locked(TaskId dependent, TaskId dependency) {
+    ensure_node(dependency);
+    ensure_node(dependent);
+
+    // Check/restore the order invariant before publishing the edge, so a
+    // rejected edge leaves no trace.
+    if (topo_order_[dependency] > topo_order_[dependent]) {
+        if (!try_reorder(dependency, dependent)) {
+            throw std::runtime_error("Circular dependency detected");
+        }
+    }
+
+    // Add to dependents map; only a genuinely new edge bumps the count,
+    // so adding the same dependency twice can't strand the dependent.
+    if (dependents_.insert(dependency).first->insert(dependent).second) {
+        dependencies_of_[dependent].insert(dependency);
+        auto [count, inserted] = dependency_count_.insert(dependent);
+        ++*count;
+        if (inserted) {
+            pending_count_.increment();  // First dependency: task now pending
+        }
+    }
+}
+
+bool DependencyManager::try_reorder(TaskId dependency, TaskId dependent) {
+    const std::int64_t lower = topo_order_[dependent];
+    const std::int64_t upper = topo_order_[dependency];
+
+    // Forward discovery: everything reachable from the dependent whose
+    // order lies inside [lower, upper]. Reaching the dependency means the
+    // new edge would close a cycle.
+    delta_forward_.clear();
+    delta_backward_.clear();
+    visited_scratch_.clear();
+    dfs_stack_.clear();
+
+    dfs_stack_.push_back(dependent);
+    visited_scratch_.insert(dependent);
+    while (!dfs_stack_.empty()) {
+        TaskId current = dfs_stack_.back();
+        dfs_stack_.pop_back();
+
+        if (current == dependency) {
+            return false;  // Cycle
+        }
+        delta_forward_.push_back(current);
+
+        const auto* adjacent = dependents_.find(current);
+        if (adjacent == nullptr) {
+            continue;
+        }
+        for (TaskId next : *adjacent) {
+            if (topo_order_[next] <= upper &&
+                visited_scratch_.insert(next).second) {
+                dfs_stack_.push_back(next);
+            }
+        }
+    }
+
+    // Backward discovery: everything that reaches the dependency within
+    // the same window.
+    dfs_stack_.push_back(dependency);
+    visited_scratch_.insert(dependency);
+    while (!dfs_stack_.empty()) {
+        TaskId current = dfs_stack_.back();
+        dfs_stack_.pop_back();
+        delta_backward_.push_back(current);
+
+        auto it = dependencies_of_.find(current);
+        if (it == dependencies_of_.end()) {
+            continue;
+        }
+        for (TaskId prev : it->second) {
+            if (topo_order_[prev] >= lower &&
+                visited_scratch_.insert(prev).second) {
+                dfs_stack_.push_back(prev);
+            }
+        }
+    }
+
+    // Reorder: the backward set must end up entirely before the forward
+    // set. Sort both by current order, pool their order slots, and deal
+    // the slots back out - backward nodes first.
+    auto by_order = [this](TaskId a, TaskId b) {
+        return topo_order_[a] < topo_order_[b];
+    };
+    std::sort(delta_backward_.begin(), delta_backward_.end(), by_order);
+    std::sort(delta_forward_.begin(), delta_forward_.end(), by_order);
+
+    std::vector<std::int64_t> slots;
+    slots.reserve(delta_backward_.size() + delta_forward_.size());
+    for (TaskId id : delta_backward_) {
+        slots.push_back(topo_order_[id]);
+    }
+    for (TaskId id : delta_forward_) {
+        slots.push_back(topo_order_[id]);
+    }
+    std::sort(slots.begin(), slots.end());
+
+    size_t slot = 0;
+    for (TaskId id : delta_backward_) {
+        topo_order_[id] = slots[slot++];
+    }
+    for (TaskId id : delta_forward_) {
+        topo_order_[id] = slots[slot++];
+    }
+
+    return true;
+}
+
+void DependencyManager::register_pending(TaskId task_id, std::shared_ptr<Task> task) {
+    std::unique_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
+    pending_tasks_[task_id] = std::move(task);
+}
+
+cds::small_vector<std::shared_ptr<Task>, 4>
+DependencyManager::mark_completed(TaskId task_id) {
+    std::unique_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
+    cds::small_vector<std::shared_ptr<Task>, 4> ready_tasks;
+
     // Find all tasks that depend on this completed task
-    auto it = dependents_.find(task_id);
-    if (it != dependents_.end()) {
-        for (TaskId dependent_id : it->second) {
+    if (auto* dependent_ids = dependents_.find(task_id)) {
+        for (TaskId dependent_id : *dependent_ids) {
+            // The completed task is no longer a live dependency edge.
+            auto rev_it = dependencies_of_.find(dependent_id);
+            if (rev_it != dependencies_of_.end()) {
+                rev_it->second.erase(task_id);
+                if (rev_it->second.empty()) {
+                    dependencies_of_.erase(rev_it);
+                }
+            }
+
             // Decrement dependency count
-            auto count_it = dependency_count_.find(dependent_id);
-            if (count_it != dependency_count_.end()) {
-                int remaining = --count_it->second;
-                
-                // If no more dependencies, task is ready
+            if (auto* count = dependency_count_.find(dependent_id)) {
+                int remaining = --*count;
+
+                // If no more dependencies, task is ready - hand its
+                // handle straight back.
                 if (remaining == 0) {
-                    ready_tasks.push_back(dependent_id);
-                    dependency_count_.erase(count_it);
+                    auto handle_it = pending_tasks_.find(dependent_id);
+                    if (handle_it != pending_tasks_.end()) {
+                        ready_tasks.push_back(std::move(handle_it->second));
+                        pending_tasks_.erase(handle_it);
+                    }
+                    dependency_count_.erase(dependent_id);
+                    pending_count_.decrement();
                 }
             }
         }
-        
+
         // Clean up completed task from dependents map
-        dependents_.erase(it);
+        dependents_.erase(task_id);
     }
-    
+
+    topo_order_.erase(task_id);
+
     return ready_tasks;
 }
 
+std::vector<std::shared_ptr<Task>> DependencyManager::cancel_dependents(TaskId root) {
+    std::unique_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
+    std::vector<std::shared_ptr<Task>> cancelled;
+
+    // Downstream discovery over the dependents adjacency. Reuses the
+    // reorder scratch - we hold the exclusive lock.
+    dfs_stack_.clear();
+    visited_scratch_.clear();
+    std::vector<TaskId> downstream;
+
+    dfs_stack_.push_back(root);
+    visited_scratch_.insert(root);
+    while (!dfs_stack_.empty()) {
+        TaskId current = dfs_stack_.back();
+        dfs_stack_.pop_back();
+        if (current != root) {
+            downstream.push_back(current);
+        }
+
+        const auto* adjacent = dependents_.find(current);
+        if (adjacent == nullptr) {
+            continue;
+        }
+        for (TaskId next : *adjacent) {
+            if (visited_scratch_.insert(next).second) {
+                dfs_stack_.push_back(next);
+            }
+        }
+    }
+
+    // Reclaim every reached task's bookkeeping. Edges from live upstream
+    // tasks into the cancelled set are unlinked too, so their dependents
+    // sets don't keep dead ids alive.
+    for (TaskId id : downstream) {
+        auto handle_it = pending_tasks_.find(id);
+        if (handle_it != pending_tasks_.end()) {
+            cancelled.push_back(std::move(handle_it->second));
+            pending_tasks_.erase(handle_it);
+        }
+
+        auto rev_it = dependencies_of_.find(id);
+        if (rev_it != dependencies_of_.end()) {
+            for (TaskId dep : rev_it->second) {
+                if (visited_scratch_.count(dep) == 0) {
+                    if (auto* dep_set = dependents_.find(dep)) {
+                        dep_set->erase(id);
+                    }
+                }
+            }
+            dependencies_of_.erase(rev_it);
+        }
+
+        if (dependency_count_.erase(id) != 0) {
+            pending_count_.decrement();
+        }
+        dependents_.erase(id);
+        topo_order_.erase(id);
+    }
+
+    // The root's own downstream edges are dead as well.
+    dependents_.erase(root);
+
+    return cancelled;
+}
+
 bool DependencyManager::has_dependencies(TaskId task_id) const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    
-    auto it = dependency_count_.find(task_id);
-    return it != dependency_count_.end() && it->second.load() > 0;
+    std::shared_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
+
+    const auto* count = dependency_count_.find(task_id);
+    return count != nullptr && count->load() > 0;
 }
 
 int DependencyManager::get_dependency_count(TaskId task_id) const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    
-    auto it = dependency_count_.find(task_id);
-    return (it != dependency_count_.end()) ? it->second.load() : 0;
+    std::shared_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
+
+    const auto* count = dependency_count_.find(task_id);
+    return (count != nullptr) ? count->load() : 0;
 }
 
 std::vector<TaskId> DependencyManager::get_dependents(TaskId task_id) const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    
-    auto it = dependents_.find(task_id);
-    if (it != dependents_.end()) {
-        return std::vector<TaskId>(it->second.begin(), it->second.end());
+    std::shared_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
+
+    if (const auto* dependent_ids = dependents_.find(task_id)) {
+        return std::vector<TaskId>(dependent_ids->begin(),
+                                   dependent_ids->end());
     }
-    
+
     return {};
 }
 
 bool DependencyManager::has_circular_dependency(
-    TaskId task_id, 
-    const std::vector<TaskId>& new_dependencies) const 
+    TaskId task_id,
+    const std::vector<TaskId>& new_dependencies) const
 {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    
-    // For each new dependency, check if it would create a cycle
+    std::shared_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
+
+    // Fast path: a task the graph has never seen cannot be on any existing
+    // path, so no new edge to it can close a cycle. This is every normal
+    // submission (fresh id), and it is O(1) with no allocation.
+    auto task_it = topo_order_.find(task_id);
+    if (task_it == topo_order_.end()) {
+        return false;
+    }
+
     for (TaskId dep : new_dependencies) {
-        if (creates_cycle(task_id, dep)) {
-            return true;
+        auto dep_it = topo_order_.find(dep);
+        if (dep_it == topo_order_.end()) {
+            continue;  // Unknown dependency - cannot be reachable
+        }
+
+        // Order fast path: paths only run from lower to higher order, so
+        // a dependency already ordered before the task cannot be reached
+        // from it.
+        if (dep_it->second < task_it->second) {
+            continue;
+        }
+
+        // Slow path (rare): bounded DFS from the task towards the
+        // dependency, confined to the affected order window. Arena-backed
+        // buffers, not the shared scratch - we only hold the shared lock,
+        // and the thread-local arena makes repeat checks allocation-free
+        // (one rewind per dependency instead of a free per node).
+        thread_local cds::monotonic_arena dfs_arena;
+        dfs_arena.reset();
+        std::vector<TaskId, cds::arena_allocator<TaskId>> stack{
+            cds::arena_allocator<TaskId>(dfs_arena)};
+        std::unordered_set<TaskId, std::hash<TaskId>, std::equal_to<TaskId>,
+                           cds::arena_allocator<TaskId>>
+            visited(16, std::hash<TaskId>(), std::equal_to<TaskId>(),
+                    cds::arena_allocator<TaskId>(dfs_arena));
+        stack.push_back(task_id);
+        visited.insert(task_id);
+        while (!stack.empty()) {
+            TaskId current = stack.back();
+            stack.pop_back();
+            if (current == dep) {
+                return true;
+            }
+            const auto* adj = dependents_.find(current);
+            if (adj == nullptr) {
+                continue;
+            }
+            for (TaskId next : *adj) {
+                auto next_it = topo_order_.find(next);
+                if (next_it != topo_order_.end() &&
+                    next_it->second <= dep_it->second &&
+                    visited.insert(next).second) {
+                    stack.push_back(next);
+                }
+            }
         }
     }
-    
+
     return false;
 }
 
 void DependencyManager::remove_task(TaskId task_id) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    
+    std::unique_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
+
     // Remove from dependency count
-    dependency_count_.erase(task_id);
-    
+    if (dependency_count_.erase(task_id) != 0) {
+        pending_count_.decrement();
+    }
+    pending_tasks_.erase(task_id);
+
     // Remove from dependents map
     dependents_.erase(task_id);
-    
+
     // Remove this task from other tasks' dependent lists
-    for (auto& pair : dependents_) {
+    dependents_.for_each(
+        [task_id](std::unordered_set<TaskId>& set) { set.erase(task_id); });
+
+    forget_node_locked(task_id);
+}
+
+void DependencyManager::forget_node_locked(TaskId task_id) {
+    topo_order_.erase(task_id);
+
+    auto rev_it = dependencies_of_.find(task_id);
+    if (rev_it != dependencies_of_.end()) {
+        dependencies_of_.erase(rev_it);
+    }
+    for (auto& pair : dependencies_of_) {
         pair.second.erase(task_id);
     }
 }
 
+// Lock-free: reads the striped mirror of dependency_count_.size(), so a
+// monitor polling pending counts never serializes against submissions or
+// completions. A moment stale while the scheduler runs.
 size_t DependencyManager::get_pending_task_count() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    return dependency_count_.size();
+    return pending_count_.load_size();
 }
 
 void DependencyManager::clear() {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
+    std::unique_lock<scheduler::HierarchicalMutex<std::shared_mutex>> lock(mutex_);
     dependents_.clear();
+    dependencies_of_.clear();
     dependency_count_.clear();
+    pending_count_.reset();
+    pending_tasks_.clear();
+    topo_order_.clear();
+    next_order_ = 0;
 }
-
-bool DependencyManager::creates_cycle(TaskId start, TaskId target) const {
-    // Use DFS to detect if adding target as dependency of start creates cycle
-    std::unordered_set<TaskId> visited;
-    std::unordered_set<TaskId> rec_stack;
-    
-    return dfs_cycle_detection(start, target, visited, rec_stack);
-}
-
-bool DependencyManager::dfs_cycle_detection(
-    TaskId start, 
-    TaskId current, 
-    std::unordered_set<TaskId>& visited,
-    std::unordered_set<TaskId>& rec_stack) const 
-{
-    // If we've reached the start node again, we have a cycle
-    if (current == start && !rec_stack.empty()) {
-        return true;
-    }
-    
-    // If already visited in this path, no cycle through this branch
-    if (rec_stack.find(current) != rec_stack.end()) {
-        return false;
-    }
-    
-    // If already fully explored, no cycle
-    if (visited.find(current) != visited.end()) {
-        return false;
-    }
-    
-    // Mark as visited and in recursion stack
-    visited.insert(current);
-    rec_stack.insert(current);
-    
-    // Check all dependents of current task
-    auto it = dependents_.find(current);
-    if (it != dependents_.end()) {
-        for (TaskId dependent : it->second) {
-            if (dfs_cycle_detection(start, dependent, visited, rec_stack)) {
-                return true;
-            }
-        }
-    }
-    
-    // Remove from recursion stack
-    rec_stack.erase(current);
-    return false;
-}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "scheduler/numa_topology.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace scheduler {
+
+namespace {
+
+// Parses the kernel's cpulist format: comma-separated entries, each a
+// single CPU ("3") or an inclusive range ("0-7"). Returns empty on any
+// malformed input - treated as "node absent".
+std::vector<int> parse_cpulist(const std::string& list) {
+    std::vector<int> cpus;
+    std::istringstream stream(list);
+    std::string entry;
+    while (std::getline(stream, entry, ',')) {
+        const std::size_t dash = entry.find('-');
+        try {
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(entry));
+            } else {
+                const int first = std::stoi(entry.substr(0, dash));
+                const int last = std::stoi(entry.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+        } catch (...) {
+            return {};
+        }
+    }
+    return cpus;
+}
+
+} // namespace
+
+std::size_t NumaTopology::node_of(int cpu) const {
+    for (std::size_t n = 0; n < node_cpus.size(); ++n) {
+        for (int c : node_cpus[n]) {
+            if (c == cpu) {
+                return n;
+            }
+        }
+    }
+    return 0;
+}
+
+std::size_t NumaTopology::cpu_count() const {
+    std::size_t total = 0;
+    for (const auto& cpus : node_cpus) {
+        total += cpus.size();
+    }
+    return total;
+}
+
+NumaTopology NumaTopology::detect() {
+    NumaTopology topology;
+
+    // Node ids are dense in practice but not guaranteed; stop at the
+    // first gap, which matches how the kernel populates possible nodes.
+    for (int node = 0;; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" +
+                           std::to_string(node) + "/cpulist");
+        if (!file) {
+            break;
+        }
+        std::string list;
+        std::getline(file, list);
+        std::vector<int> cpus = parse_cpulist(list);
+        if (!cpus.empty()) {
+            topology.node_cpus.push_back(std::move(cpus));
+        }
+    }
+
+    if (topology.node_cpus.empty()) {
+        // Non-Linux, or /sys unavailable: one flat node, so NUMA-aware
+        // callers transparently behave like the non-aware ones.
+        unsigned count = std::thread::hardware_concurrency();
+        if (count == 0) {
+            count = 1;
+        }
+        std::vector<int> cpus;
+        cpus.reserve(count);
+        for (unsigned cpu = 0; cpu < count; ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+        topology.node_cpus.push_back(std::move(cpus));
+    }
+
+    return topology;
+}
+
+} // namespace scheduler
@@ -0,0 +1,7 @@
+#include "scheduler/priority_queue.hpp"
+
+// The queue is a template over its wait-recording policy, so the
+// implementation lives in the header. Instantiating both policies here
+// keeps them compile-checked even in builds that use only one.
+template class ThreadSafePriorityQueue<cds::no_queue_waits>;
+template class ThreadSafePriorityQueue<cds::record_queue_waits>;
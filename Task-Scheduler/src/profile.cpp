@@ -0,0 +1,155 @@
+#include "scheduler/profile.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <thread>
+
+namespace scheduler {
+
+thread_local Profiler::ThreadBuffer* Profiler::current_buffer_ = nullptr;
+
+Profiler& Profiler::instance() {
+    // Leaked on purpose: probes may fire from detached threads during
+    // static destruction, and a process-lifetime singleton sidesteps the
+    // shutdown ordering problem entirely.
+    static Profiler* profiler = new Profiler();
+    return *profiler;
+}
+
+Profiler::ThreadBuffer* Profiler::local_buffer() {
+    if (current_buffer_ != nullptr) {
+        return current_buffer_;
+    }
+
+    // First sample from this thread: register a fresh ring. The process
+    // has exactly one Profiler, so no tracer-style ownership tag is
+    // needed.
+    auto buffer = std::make_unique<ThreadBuffer>();
+    ThreadBuffer* raw = buffer.get();
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        buffers_.push_back(std::move(buffer));
+    }
+    current_buffer_ = raw;
+    return raw;
+}
+
+void Profiler::record_slow(const char* name, std::uint64_t ticks) {
+    ThreadBuffer* buffer = local_buffer();
+
+    const std::uint64_t index =
+        buffer->next.load(std::memory_order_relaxed);
+    Sample& slot = buffer->samples[index % ThreadBuffer::kCapacity];
+    slot.name = name;
+    slot.ticks = ticks;
+    // Release publishes the slot write to a concurrent aggregate().
+    buffer->next.store(index + 1, std::memory_order_release);
+}
+
+double Profiler::ns_per_tick() {
+#if defined(__x86_64__) || defined(_M_X64)
+    // Calibrated once against steady_clock over a short window; modern
+    // x86 TSCs are constant-rate, so one measurement holds for the
+    // process lifetime. Only aggregation pays for it.
+    static const double ratio = [] {
+        const auto wall_begin = std::chrono::steady_clock::now();
+        const std::uint64_t tsc_begin = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const std::uint64_t tsc_end = now();
+        const auto wall_end = std::chrono::steady_clock::now();
+
+        const double ns =
+            static_cast<double>(std::chrono::duration_cast<
+                                    std::chrono::nanoseconds>(wall_end -
+                                                              wall_begin)
+                                    .count());
+        const double ticks = static_cast<double>(tsc_end - tsc_begin);
+        return ticks > 0.0 ? ns / ticks : 1.0;
+    }();
+    return ratio;
+#else
+    return 1.0;  // now() already returns nanoseconds.
+#endif
+}
+
+std::vector<ScopeStats> Profiler::aggregate() {
+    const double scale = ns_per_tick();
+
+    // Bucket by name text, not pointer: the same literal can have a
+    // different address in each translation unit that uses it.
+    struct StrLess {
+        bool operator()(const char* a, const char* b) const {
+            return std::strcmp(a, b) < 0;
+        }
+    };
+    std::map<const char*, std::vector<std::uint64_t>, StrLess> buckets;
+
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        for (const auto& buffer : buffers_) {
+            const std::uint64_t written =
+                buffer->next.load(std::memory_order_acquire);
+            const std::uint64_t count =
+                std::min<std::uint64_t>(written, ThreadBuffer::kCapacity);
+            for (std::uint64_t i = written - count; i < written; ++i) {
+                const Sample& sample =
+                    buffer->samples[i % ThreadBuffer::kCapacity];
+                buckets[sample.name].push_back(sample.ticks);
+            }
+        }
+    }
+
+    std::vector<ScopeStats> stats;
+    stats.reserve(buckets.size());
+    for (auto& [name, ticks] : buckets) {
+        std::sort(ticks.begin(), ticks.end());
+        const auto percentile = [&](std::size_t p) {
+            const std::size_t index = (ticks.size() - 1) * p / 100;
+            return static_cast<std::uint64_t>(
+                static_cast<double>(ticks[index]) * scale);
+        };
+        ScopeStats entry;
+        entry.name = name;
+        entry.count = ticks.size();
+        entry.p50_ns = percentile(50);
+        entry.p95_ns = percentile(95);
+        entry.p99_ns = percentile(99);
+        entry.max_ns = static_cast<std::uint64_t>(
+            static_cast<double>(ticks.back()) * scale);
+        stats.push_back(std::move(entry));
+    }
+    return stats;
+}
+
+std::string Profiler::report() {
+    const std::vector<ScopeStats> stats = aggregate();
+
+    std::size_t name_width = std::strlen("scope");
+    for (const ScopeStats& entry : stats) {
+        name_width = std::max(name_width, entry.name.size());
+    }
+
+    char line[256];
+    std::string out;
+    std::snprintf(line, sizeof(line),
+                  "%-*s %10s %12s %12s %12s %12s\n",
+                  static_cast<int>(name_width), "scope", "count",
+                  "p50(ns)", "p95(ns)", "p99(ns)", "max(ns)");
+    out += line;
+    for (const ScopeStats& entry : stats) {
+        std::snprintf(line, sizeof(line),
+                      "%-*s %10llu %12llu %12llu %12llu %12llu\n",
+                      static_cast<int>(name_width), entry.name.c_str(),
+                      static_cast<unsigned long long>(entry.count),
+                      static_cast<unsigned long long>(entry.p50_ns),
+                      static_cast<unsigned long long>(entry.p95_ns),
+                      static_cast<unsigned long long>(entry.p99_ns),
+                      static_cast<unsigned long long>(entry.max_ns));
+        out += line;
+    }
+    return out;
+}
+
+}  // namespace scheduler
@@ -1,69 +1,232 @@
-#include "scheduler/thread_pool.hpp"
-#include <iostream> // For debugging, remove in production
+#include "scheduler/task.hpp"
 
-namespace scheduler {
+Task::Task(TaskId id, scheduler::unique_function<void()> work, Priority priority)
+    : id_(id)
+    , work_(std::move(work))
+    , priority_(priority)
+    , word_(static_cast<std::uint32_t>(TaskState::PENDING))
+{
+}
+
+Task::Task(TaskId id, scheduler::unique_function<void(TaskContext&)> work,
+           Priority priority)
+    : id_(id)
+    , priority_(priority)
+    , word_(static_cast<std::uint32_t>(TaskState::PENDING))
+{
+    // Binding 'this' is safe: tasks live in pool cells behind shared_ptr
+    // and are never moved. The wrapper overflows the unique_function
+    // inline buffer (it carries another unique_function), costing one
+    // heap allocation - acceptable for the long-running tasks this
+    // overload exists for.
+    work_ = [this, f = std::move(work)]() mutable {
+        TaskContext context(*this);
+        f(context);
+    };
+}
+
+TaskId Task::get_id() const {
+    return id_;
+}
+
+Priority Task::get_priority() const {
+    return priority_.load(std::memory_order_relaxed);
+}
+
+TaskState Task::get_state() const {
+    return static_cast<TaskState>(word_.load() & kStateMask);
+}
+
+const cds::small_vector<TaskId, 4>& Task::get_dependencies() const {
+    return dependencies_;
+}
+
+void Task::set_state(TaskState new_state) {
+    // CAS loop: the flag bits may be set concurrently and must survive.
+    std::uint32_t expected = word_.load(std::memory_order_relaxed);
+    std::uint32_t desired;
+    do {
+        desired = (expected & ~kStateMask) | static_cast<std::uint32_t>(new_state);
+    } while (!word_.compare_exchange_weak(expected, desired,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_relaxed));
+    // Wake any futex-parked waiter (wait_until_terminal).
+    word_.notify_all();
+}
+
+bool Task::is_ready() const {
+    return get_state() == TaskState::READY;
+}
+
+bool Task::is_completed() const {
+    return get_state() == TaskState::COMPLETED;
+}
 
-ThreadPool::ThreadPool(size_t num_threads) : stop_(false) {
-    if (num_threads == 0) {
-        throw std::invalid_argument("Number of threads must be greater than 0.");
+void Task::wait_until_terminal() const {
+    std::uint32_t word = word_.load();
+    for (;;) {
+        const auto state = static_cast<TaskState>(word & kStateMask);
+        if (state == TaskState::COMPLETED || state == TaskState::CANCELLED) {
+            return;
+        }
+        word_.wait(word);  // Futex on Linux - no polling
+        word = word_.load();
     }
-    for (size_t i = 0; i < num_threads; ++i) {
-        workers_.emplace_back([this] {
-            for (;;) {
-                std::function<void()> task;
-                {
-                    std::unique_lock<std::mutex> lock(this->queue_mutex_);
-                    this->condition_.wait(lock, [this] {
-                        return this->stop_ || !this->tasks_.empty();
-                    });
-                    if (this->stop_ && this->tasks_.empty()) {
-                        return;
-                    }
-                    task = std::move(this->tasks_.front());
-                    this->tasks_.pop();
-                }
-                task();
-            }
-        });
+}
+
+bool Task::mark_finished_once() {
+    return (word_.fetch_or(kFinishedBit, std::memory_order_acq_rel) &
+            kFinishedBit) == 0;
+}
+
+bool Task::raise_priority(Priority floor) {
+    Priority current = priority_.load(std::memory_order_relaxed);
+    while (current < floor) {
+        if (priority_.compare_exchange_weak(current, floor,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+            return true;
+        }
     }
+    return false;
+}
+
+bool Task::claim_run_once() {
+    return (word_.fetch_or(kClaimBit, std::memory_order_acq_rel) &
+            kClaimBit) == 0;
+}
+
+void Task::rearm_run() {
+    word_.fetch_and(~kClaimBit, std::memory_order_acq_rel);
 }
 
-ThreadPool::~ThreadPool() {
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        stop_ = true;
+void Task::add_dependency(TaskId dependency) {
+    dependencies_.push_back(dependency);
+}
+
+void Task::execute() {
+    // One RMW reads the cancel flag and moves the state: a cancelled task
+    // transitions straight to CANCELLED (its promise is still satisfied so
+    // waiters don't block forever), everything else to RUNNING.
+    std::uint32_t expected = word_.load(std::memory_order_relaxed);
+    for (;;) {
+        const std::uint32_t target = (expected & kCancelBit)
+            ? static_cast<std::uint32_t>(TaskState::CANCELLED)
+            : static_cast<std::uint32_t>(TaskState::RUNNING);
+        const std::uint32_t desired = (expected & ~kStateMask) | target;
+        if (word_.compare_exchange_weak(expected, desired,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_relaxed)) {
+            expected = desired;
+            break;
+        }
     }
-    condition_.notify_all();
-    for (std::thread& worker : workers_) {
-        worker.join();
+    word_.notify_all();
+
+    if ((expected & kStateMask) ==
+        static_cast<std::uint32_t>(TaskState::CANCELLED)) {
+        deliver_completion(nullptr);
+        return;
+    }
+
+    try {
+        if (work_) {
+            work_();
+        }
+        if (consume_yield_request()) {
+            // The work checkpointed itself and asked to be resumed later:
+            // park the task back in READY without delivering completion.
+            // The scheduler requeues it (see execute_task) and this method
+            // runs the same work again from the top.
+            set_state(TaskState::READY);
+            return;
+        }
+        set_state(TaskState::COMPLETED);
+        deliver_completion(nullptr);
+    } catch (...) {
+        // Propagate the exception to anyone holding the task's future. A
+        // yield request followed by a throw is moot - the task is done.
+        consume_yield_request();
+        set_state(TaskState::COMPLETED);
+        deliver_completion(std::current_exception());
     }
 }
 
-template<class F, class... Args>
-auto ThreadPool::submit(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type> {
-    using return_type = typename std::result_of<F(Args...)>::type;
+void Task::deliver_completion(std::exception_ptr error) {
+    // Fast path: a successful task nobody waits on (the overwhelmingly
+    // common case) records its outcome with one CAS and never touches the
+    // spinlock. The CAS can only succeed while kWaiterBit is clear, so it
+    // serializes against get_future's fetch_or on the same word.
+    if (!error) {
+        std::uint32_t expected = word_.load(std::memory_order_acquire);
+        while ((expected & kWaiterBit) == 0) {
+            if (word_.compare_exchange_weak(expected, expected | kDeliveredBit,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+                return;
+            }
+        }
+    }
 
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-    );
+    // Slow path: a waiter exists (or an exception must be recorded for a
+    // future waiter). error_ is only ever written here, under the lock.
+    while (promise_lock_.test_and_set(std::memory_order_acquire)) {
+    }
 
-    std::future<return_type> res = task->get_future();
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        if (stop_) {
-            throw std::runtime_error("submit on stopped ThreadPool");
+    error_ = error;
+    if (completion_promise_) {
+        if (error_) {
+            completion_promise_->set_exception(error_);
+        } else {
+            completion_promise_->set_value();
         }
-        tasks_.emplace([task]() { (*task)(); });
     }
-    condition_.notify_one();
-    return res;
+    word_.fetch_or(kDeliveredBit, std::memory_order_release);
+
+    promise_lock_.clear(std::memory_order_release);
+}
+
+void Task::request_cancel() {
+    word_.fetch_or(kCancelBit, std::memory_order_acq_rel);
+}
+
+bool Task::is_cancel_requested() const {
+    return (word_.load() & kCancelBit) != 0;
+}
+
+void Task::request_yield() {
+    word_.fetch_or(kYieldBit, std::memory_order_acq_rel);
+}
+
+bool Task::consume_yield_request() {
+    return (word_.fetch_and(~kYieldBit, std::memory_order_acq_rel) &
+            kYieldBit) != 0;
 }
 
-// Explicit instantiation of common types to avoid linkage errors for template in .cpp
-// If you plan to use a variety of function signatures, you might need to
-// consider a different approach (e.g., compile-time task submission or type erasure).
-// For a task scheduler, typically you'll be submitting `std::function<void()>` tasks.
-// So, we'll specialize for that.
-template std::future<void> ThreadPool::submit<std::function<void()>>(std::function<void()>&&);
+std::future<void> Task::get_future() {
+    while (promise_lock_.test_and_set(std::memory_order_acquire)) {
+    }
+
+    if (!completion_promise_) {
+        completion_promise_ = std::make_unique<std::promise<void>>();
 
-} // namespace scheduler
\ No newline at end of file
+        // Announce the waiter, then re-check: either our fetch_or beat
+        // the completer's CAS (it will take the slow path and settle the
+        // promise under the lock we hold), or the delivered bit is
+        // already visible and we settle immediately from the recorded
+        // outcome.
+        const std::uint32_t word =
+            word_.fetch_or(kWaiterBit, std::memory_order_acq_rel);
+        if (word & kDeliveredBit) {
+            if (error_) {
+                completion_promise_->set_exception(error_);
+            } else {
+                completion_promise_->set_value();
+            }
+        }
+    }
+    auto future = completion_promise_->get_future();
+
+    promise_lock_.clear(std::memory_order_release);
+    return future;
+}
@@ -0,0 +1,86 @@
+#include "scheduler/task_graph.hpp"
+
+#include <string>
+
+namespace scheduler {
+
+std::size_t TaskGraph::add_node(unique_function<void()> work,
+                                std::vector<std::size_t> dependencies) {
+    if (finalized_) {
+        throw std::runtime_error("Cannot add nodes to a finalized TaskGraph");
+    }
+
+    const std::size_t index = works_.size();
+    for (std::size_t dep : dependencies) {
+        if (dep >= index) {
+            throw std::runtime_error("TaskGraph node " + std::to_string(index) +
+                                     " depends on invalid node " +
+                                     std::to_string(dep));
+        }
+    }
+
+    works_.push_back(std::move(work));
+    dependencies_.push_back(std::move(dependencies));
+    return index;
+}
+
+void TaskGraph::finalize() {
+    if (finalized_) {
+        return;
+    }
+
+    const std::size_t n = works_.size();
+
+    indegree_.assign(n, 0);
+    edge_offsets_.assign(n + 1, 0);
+
+    // CSR counting pass: how many dependents each node has.
+    for (std::size_t i = 0; i < n; ++i) {
+        indegree_[i] = static_cast<int>(dependencies_[i].size());
+        for (std::size_t dep : dependencies_[i]) {
+            ++edge_offsets_[dep + 1];
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        edge_offsets_[i + 1] += edge_offsets_[i];
+    }
+
+    // Fill pass.
+    edges_.resize(edge_offsets_[n]);
+    std::vector<std::size_t> cursor(edge_offsets_.begin(),
+                                    edge_offsets_.end() - 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t dep : dependencies_[i]) {
+            edges_[cursor[dep]++] = i;
+        }
+    }
+
+    // Kahn's algorithm over the flat arrays: every node must drain.
+    // (add_node already restricts edges to earlier indices, which makes a
+    // cycle impossible by construction - this validates the invariant
+    // holds and will catch any future relaxation of it.)
+    std::vector<int> remaining(indegree_);
+    std::vector<std::size_t> queue;
+    queue.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (remaining[i] == 0) {
+            queue.push_back(i);
+        }
+    }
+    std::size_t processed = 0;
+    while (processed < queue.size()) {
+        const std::size_t node = queue[processed++];
+        for (std::size_t e = edge_offsets_[node]; e < edge_offsets_[node + 1]; ++e) {
+            if (--remaining[edges_[e]] == 0) {
+                queue.push_back(edges_[e]);
+            }
+        }
+    }
+    if (processed != n) {
+        throw std::runtime_error("Circular dependency detected");
+    }
+
+    finalized_ = true;
+}
+
+}  // namespace scheduler
@@ -0,0 +1,91 @@
+#include "scheduler/task_pool.hpp"
+#include <new>
+
+namespace {
+// x86-64/AArch64 user-space pointers fit in 48 bits; the top 16 carry a
+// generation counter bumped on every push and pop.
+constexpr std::uintptr_t kPtrMask = (std::uintptr_t(1) << 48) - 1;
+
+std::uintptr_t pack(void* ptr, std::uintptr_t tag) {
+    return (reinterpret_cast<std::uintptr_t>(ptr) & kPtrMask) | (tag << 48);
+}
+} // namespace
+
+TaskPool::TaskPool()
+    : free_head_(pack(nullptr, 0))
+{
+}
+
+std::shared_ptr<Task> TaskPool::acquire(TaskId id,
+                                        scheduler::unique_function<void()> work,
+                                        Priority priority)
+{
+    // allocate_shared folds the control block and the Task into a single
+    // node drawn from the free list, so once the slabs have warmed up a
+    // submission performs no heap allocation at all.
+    return std::allocate_shared<Task>(CellAllocator<Task>(this), id,
+                                      std::move(work), priority);
+}
+
+std::shared_ptr<Task> TaskPool::acquire(
+    TaskId id, scheduler::unique_function<void(TaskContext&)> work,
+    Priority priority)
+{
+    return std::allocate_shared<Task>(CellAllocator<Task>(this), id,
+                                      std::move(work), priority);
+}
+
+size_t TaskPool::slab_count() const {
+    std::lock_guard<std::mutex> lock(slabs_mutex_);
+    return slabs_.size();
+}
+
+TaskPool::Cell* TaskPool::take_cell() {
+    Cell* cell = pop_cell();
+    if (!cell) {
+        add_slab();
+        cell = pop_cell();
+    }
+    return cell;
+}
+
+TaskPool::Cell* TaskPool::pop_cell() {
+    std::uintptr_t head = free_head_.load(std::memory_order_acquire);
+    for (;;) {
+        Cell* cell = reinterpret_cast<Cell*>(head & kPtrMask);
+        if (!cell) {
+            return nullptr;
+        }
+        const std::uintptr_t tag = head >> 48;
+        if (free_head_.compare_exchange_weak(head, pack(cell->next, tag + 1),
+                                             std::memory_order_acquire,
+                                             std::memory_order_acquire)) {
+            return cell;
+        }
+    }
+}
+
+void TaskPool::push_cell(Cell* cell) {
+    std::uintptr_t head = free_head_.load(std::memory_order_relaxed);
+    for (;;) {
+        cell->next = reinterpret_cast<Cell*>(head & kPtrMask);
+        const std::uintptr_t tag = head >> 48;
+        if (free_head_.compare_exchange_weak(head, pack(cell, tag + 1),
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+void TaskPool::add_slab() {
+    std::lock_guard<std::mutex> lock(slabs_mutex_);
+
+    // Another thread may have added a slab while we waited for the lock;
+    // adding one more anyway is harmless, so keep it simple.
+    auto slab = std::make_unique<Cell[]>(kTasksPerSlab);
+    for (size_t i = 0; i < kTasksPerSlab; ++i) {
+        push_cell(&slab[i]);
+    }
+    slabs_.push_back(std::move(slab));
+}
@@ -1,12 +1,22 @@
 #include "scheduler/task_scheduler.hpp"
+#include "scheduler/profile.hpp"
 #include <algorithm>
 #include <iostream>
 
+namespace {
+// Process-wide TaskId namespace allocator (see instance_id()).
+std::atomic<std::uint32_t> next_instance_id{0};
+}
+
 TaskScheduler::TaskScheduler(size_t num_threads)
-    : thread_pool_(std::make_unique<ThreadPool>(num_threads))
-    , next_task_id_(1)
+    : thread_pool_(std::make_unique<scheduler::ThreadPool>(num_threads))
+    , instance_id_(next_instance_id.fetch_add(1, std::memory_order_relaxed) &
+                   ((1u << kInstanceBits) - 1))
+    , next_task_id_((static_cast<TaskId>(instance_id_) << kInstanceShift) + 1)
     , shutdown_requested_(false)
+    , unfinished_count_(0)
 {
+    timer_thread_ = std::thread(&TaskScheduler::timer_loop, this);
 }
 
 TaskScheduler::~TaskScheduler() {
@@ -14,7 +24,7 @@ TaskScheduler::~TaskScheduler() {
 }
 
 TaskId TaskScheduler::submit_task(
-    std::function<void()> work, 
+    scheduler::unique_function<void()> work, 
     Priority priority,
     const std::vector<TaskId>& dependencies) 
 {
@@ -32,31 +42,86 @@ TaskId TaskScheduler::submit_task(
     }
     
     // Create the task
-    auto task = std::make_shared<Task>(task_id, std::move(work), priority);
-    
-    {
-        std::lock_guard<std::mutex> lock(tasks_mutex_);
-        all_tasks_[task_id] = task;
+    return publish_task(task_id,
+                        task_pool_.acquire(task_id, std::move(work), priority),
+                        dependencies);
+}
+
+TaskId TaskScheduler::submit_task(
+    scheduler::unique_function<void(TaskContext&)> work,
+    Priority priority,
+    const std::vector<TaskId>& dependencies)
+{
+    if (shutdown_requested_.load()) {
+        throw std::runtime_error("Cannot submit task: scheduler is shutting down");
     }
-    
-    // Add dependencies
+
+    TaskId task_id = generate_task_id();
+
+    if (!dependencies.empty()) {
+        if (dependency_manager_.has_circular_dependency(task_id, dependencies)) {
+            throw std::runtime_error("Circular dependency detected");
+        }
+    }
+
+    return publish_task(task_id,
+                        task_pool_.acquire(task_id, std::move(work), priority),
+                        dependencies);
+}
+
+TaskId TaskScheduler::publish_task(TaskId task_id, std::shared_ptr<Task> task,
+                                   const std::vector<TaskId>& dependencies)
+{
+    tracer_.record(task_id, scheduler::TracePhase::SUBMITTED);
+    unfinished_count_.fetch_add(1, std::memory_order_relaxed);
+    all_tasks_.insert(task_id, task);
+
+    // Register the handle before wiring any edge so a dependency that
+    // completes mid-wiring can still resolve it.
+    if (!dependencies.empty()) {
+        dependency_manager_.register_pending(task_id, task);
+    }
+
+    // Add dependencies: per-dependency bookkeeping first, then every
+    // graph edge in one dependency-manager lock acquisition instead of
+    // one exclusive acquire per dependency.
     for (TaskId dep : dependencies) {
         // Verify dependency task exists
-        {
-            std::lock_guard<std::mutex> lock(tasks_mutex_);
-            if (all_tasks_.find(dep) == all_tasks_.end()) {
-                throw std::runtime_error("Dependency task does not exist: " + std::to_string(dep));
-            }
+        auto dep_task = all_tasks_.find(dep);
+        if (!dep_task) {
+            throw std::runtime_error("Dependency task does not exist: " + std::to_string(dep));
         }
-        
+
         task->add_dependency(dep);
-        dependency_manager_.add_dependency(task_id, dep);
+
+        // This dependency now gates a task of our priority - lift it (and
+        // its own incomplete dependencies) to at least that level.
+        inherit_priority(dep_task, task->get_priority());
     }
-    
+    if (!dependencies.empty()) {
+        dependency_manager_.add_dependencies(task_id, dependencies);
+    }
+
     // If no dependencies, task is ready to run
     if (dependencies.empty()) {
         task->set_state(TaskState::READY);
+        tracer_.record(task_id, scheduler::TracePhase::READY);
         ready_queue_.push(task);
+    } else {
+        // A dependency may already have completed - its mark_completed ran
+        // before our edge existed, so replay it to settle the counts (same
+        // race submit_batch handles for external dependencies).
+        for (TaskId dep : dependencies) {
+            auto dep_task = all_tasks_.find(dep);
+            if (dep_task && dep_task->is_completed()) {
+                for (auto& ready_task : dependency_manager_.mark_completed(dep)) {
+                    ready_task->set_state(TaskState::READY);
+                    tracer_.record(ready_task->get_id(), scheduler::TracePhase::READY);
+                    ready_queue_.push(std::move(ready_task));
+                    schedule_ready_tasks();
+                }
+            }
+        }
     }
     
     // Start processing ready tasks
@@ -65,57 +130,358 @@ TaskId TaskScheduler::submit_task(
     return task_id;
 }
 
+std::vector<TaskId> TaskScheduler::submit_batch(std::vector<TaskSpec> specs) {
+    if (shutdown_requested_.load()) {
+        throw std::runtime_error("Cannot submit task: scheduler is shutting down");
+    }
+
+    std::vector<TaskId> ids;
+    ids.reserve(specs.size());
+    for (size_t i = 0; i < specs.size(); ++i) {
+        ids.push_back(generate_task_id());
+    }
+
+    std::vector<std::shared_ptr<Task>> tasks;
+    tasks.reserve(specs.size());
+    std::vector<std::pair<TaskId, TaskId>> edges;  // (dependent, dependency)
+    std::vector<std::shared_ptr<Task>> initially_ready;
+
+    // Validate the batch before registering anything.
+    for (size_t i = 0; i < specs.size(); ++i) {
+        for (size_t dep_index : specs[i].batch_dependencies) {
+            if (dep_index >= i) {
+                throw std::runtime_error(
+                    "Batch entry " + std::to_string(i) +
+                    " may only depend on earlier batch entries");
+            }
+        }
+        for (TaskId dep : specs[i].external_dependencies) {
+            if (!all_tasks_.contains(dep)) {
+                throw std::runtime_error("Dependency task does not exist: " +
+                                         std::to_string(dep));
+            }
+        }
+    }
+
+    // Priority inheritance inside the batch is settled up front: edges
+    // only point at earlier entries, so one reverse pass propagates every
+    // transitive floor before any task exists - no re-bucketing needed.
+    std::vector<Priority> effective(specs.size());
+    for (size_t i = 0; i < specs.size(); ++i) {
+        effective[i] = specs[i].priority;
+    }
+    for (size_t i = specs.size(); i-- > 0;) {
+        for (size_t dep_index : specs[i].batch_dependencies) {
+            if (effective[dep_index] < effective[i]) {
+                effective[dep_index] = effective[i];
+            }
+        }
+    }
+
+    std::vector<std::pair<TaskId, std::shared_ptr<Task>>> entries;
+    entries.reserve(specs.size());
+
+    for (size_t i = 0; i < specs.size(); ++i) {
+        auto task = task_pool_.acquire(ids[i], std::move(specs[i].work),
+                                       effective[i]);
+
+        for (size_t dep_index : specs[i].batch_dependencies) {
+            task->add_dependency(ids[dep_index]);
+            edges.emplace_back(ids[i], ids[dep_index]);
+        }
+        for (TaskId dep : specs[i].external_dependencies) {
+            task->add_dependency(dep);
+            edges.emplace_back(ids[i], dep);
+        }
+
+        tracer_.record(ids[i], scheduler::TracePhase::SUBMITTED);
+        if (task->get_dependencies().empty()) {
+            task->set_state(TaskState::READY);
+            tracer_.record(ids[i], scheduler::TracePhase::READY);
+            initially_ready.push_back(task);
+        }
+
+        entries.emplace_back(ids[i], task);
+        if (!task->get_dependencies().empty()) {
+            dependency_manager_.register_pending(ids[i], task);
+        }
+        tasks.push_back(std::move(task));
+    }
+
+    unfinished_count_.fetch_add(specs.size(), std::memory_order_relaxed);
+
+    // One lock acquisition per involved registry shard for the whole batch.
+    all_tasks_.insert_batch(entries);
+
+    // One dependency-manager lock acquisition for every edge. Intra-batch
+    // edges point at earlier entries and external edges point at existing
+    // tasks, so the batch cannot introduce a cycle and no DFS is needed.
+    if (!edges.empty()) {
+        dependency_manager_.add_dependency_batch(edges);
+    }
+
+    // External dependencies get the same treatment as in submit_task:
+    // incomplete ones are lifted to each dependent's effective priority.
+    for (size_t i = 0; i < specs.size(); ++i) {
+        for (TaskId dep : specs[i].external_dependencies) {
+            if (auto dep_task = all_tasks_.find(dep)) {
+                inherit_priority(dep_task, effective[i]);
+            }
+        }
+    }
+
+    // An external dependency may have completed between validation and edge
+    // registration; replaying mark_completed for it settles the counts so
+    // its dependents in this batch aren't stranded.
+    std::unordered_set<TaskId> settled;
+    for (size_t i = 0; i < specs.size(); ++i) {
+        for (TaskId dep : specs[i].external_dependencies) {
+            if (!settled.insert(dep).second) {
+                continue;
+            }
+            auto dep_task = all_tasks_.find(dep);
+            if (dep_task && dep_task->is_completed()) {
+                for (auto& ready_task : dependency_manager_.mark_completed(dep)) {
+                    ready_task->set_state(TaskState::READY);
+                    tracer_.record(ready_task->get_id(), scheduler::TracePhase::READY);
+                    initially_ready.push_back(std::move(ready_task));
+                }
+            }
+        }
+    }
+
+    // Publish every initially-ready task with a single notification.
+    const size_t ready_count = initially_ready.size();
+    ready_queue_.push_batch(std::move(initially_ready));
+    for (size_t i = 0; i < ready_count; ++i) {
+        schedule_ready_tasks();
+    }
+
+    return ids;
+}
+
+scheduler::TimerId TaskScheduler::submit_after(
+    std::chrono::milliseconds delay,
+    scheduler::unique_function<void()> work,
+    Priority priority)
+{
+    if (shutdown_requested_.load()) {
+        throw std::runtime_error("Cannot submit task: scheduler is shutting down");
+    }
+
+    return timing_wheel_.schedule(
+        delay,
+        [this, priority, work = std::move(work)]() mutable {
+            submit_task(std::move(work), priority);
+        });
+}
+
+scheduler::TimerId TaskScheduler::submit_periodic(
+    std::chrono::milliseconds interval,
+    scheduler::unique_function<void()> work,
+    Priority priority)
+{
+    if (shutdown_requested_.load()) {
+        throw std::runtime_error("Cannot submit task: scheduler is shutting down");
+    }
+
+    // The wheel shares the periodic callback across firings, and each
+    // firing needs a submittable copy - so the work lives behind a
+    // shared_ptr and every submission is a thin call-through.
+    auto shared_work = std::make_shared<scheduler::unique_function<void()>>(
+        std::move(work));
+
+    return timing_wheel_.schedule_periodic(
+        interval,
+        [this, priority, shared_work] {
+            submit_task([shared_work] { (*shared_work)(); }, priority);
+        });
+}
+
+bool TaskScheduler::cancel_timer(scheduler::TimerId timer_id) {
+    return timing_wheel_.cancel(timer_id);
+}
+
+void TaskScheduler::timer_loop() {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<scheduler::unique_function<void()>> fired;
+
+    std::unique_lock<scheduler::HierarchicalMutex<>> lock(timer_mutex_);
+    while (!shutdown_requested_.load()) {
+        timer_cv_.wait_for(lock, timing_wheel_.tick_duration());
+        if (shutdown_requested_.load()) {
+            break;
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        const std::uint64_t now_tick =
+            static_cast<std::uint64_t>(elapsed / timing_wheel_.tick_duration());
+
+        fired.clear();
+        timing_wheel_.advance(now_tick, fired);
+
+        // Submit outside the timer mutex - submit_task may run the
+        // schedule machinery, and a firing must never block the tick.
+        lock.unlock();
+        publish_stats();
+        for (auto& callback : fired) {
+            if (shutdown_requested_.load()) {
+                break;
+            }
+            callback();
+        }
+        lock.lock();
+    }
+}
+
+// Per-replay state: a private indegree array (the graph itself stays
+// immutable, so replays can overlap) and a futex-waited completion count.
+struct TaskScheduler::GraphRun {
+    scheduler::TaskGraph* graph;
+    std::unique_ptr<std::atomic<int>[]> remaining;
+    std::atomic<size_t> nodes_left;
+    std::atomic<bool> failed{false};
+    std::exception_ptr first_error;
+};
+
+void TaskScheduler::run(scheduler::TaskGraph& graph) {
+    if (shutdown_requested_.load()) {
+        throw std::runtime_error("Cannot submit task: scheduler is shutting down");
+    }
+    if (!graph.is_finalized()) {
+        throw std::runtime_error("TaskGraph must be finalized before run()");
+    }
+
+    const size_t n = graph.node_count();
+    if (n == 0) {
+        return;
+    }
+
+    auto run_state = std::make_shared<GraphRun>();
+    run_state->graph = &graph;
+    run_state->remaining.reset(new std::atomic<int>[n]);
+    run_state->nodes_left.store(n, std::memory_order_relaxed);
+    for (size_t i = 0; i < n; ++i) {
+        run_state->remaining[i].store(graph.indegree_[i],
+                                      std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (graph.indegree_[i] == 0) {
+            thread_pool_->enqueue([this, run_state, i] {
+                run_graph_node(run_state, i);
+            });
+        }
+    }
+
+    // Futex-wait until the last node counts down.
+    size_t left = run_state->nodes_left.load(std::memory_order_acquire);
+    while (left > 0) {
+        run_state->nodes_left.wait(left, std::memory_order_acquire);
+        left = run_state->nodes_left.load(std::memory_order_acquire);
+    }
+
+    if (run_state->first_error) {
+        std::rethrow_exception(run_state->first_error);
+    }
+}
+
+void TaskScheduler::run_graph_node(const std::shared_ptr<GraphRun>& run_state,
+                                   size_t index) {
+    scheduler::TaskGraph& graph = *run_state->graph;
+
+    try {
+        graph.works_[index]();
+    } catch (...) {
+        // Keep the first failure; dependents still run so the replay
+        // always terminates and the counter always drains.
+        if (!run_state->failed.exchange(true)) {
+            run_state->first_error = std::current_exception();
+        }
+    }
+
+    // Release dependents: one relaxed-failure CAS-free decrement per edge.
+    for (size_t e = graph.edge_offsets_[index];
+         e < graph.edge_offsets_[index + 1]; ++e) {
+        const size_t dependent = graph.edges_[e];
+        if (run_state->remaining[dependent].fetch_sub(
+                1, std::memory_order_acq_rel) == 1) {
+            thread_pool_->enqueue([this, run_state, dependent] {
+                run_graph_node(run_state, dependent);
+            });
+        }
+    }
+
+    if (run_state->nodes_left.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        run_state->nodes_left.notify_all();
+    }
+}
+
 std::future<void> TaskScheduler::get_task_future(TaskId task_id) {
-    std::lock_guard<std::mutex> lock(tasks_mutex_);
-    
-    auto it = all_tasks_.find(task_id);
-    if (it == all_tasks_.end()) {
+    auto task = all_tasks_.find(task_id);
+    if (!task) {
         throw std::runtime_error("Task not found: " + std::to_string(task_id));
     }
-    
-    return it->second->get_future();
+
+    return task->get_future();
 }
 
-bool TaskScheduler::cancel_task(TaskId task_id) {
-    std::lock_guard<std::mutex> lock(tasks_mutex_);
-    
-    auto it = all_tasks_.find(task_id);
-    if (it == all_tasks_.end()) {
+bool TaskScheduler::cancel_task(TaskId task_id, bool propagate) {
+    auto task = all_tasks_.find(task_id);
+    if (!task) {
         return false;  // Task doesn't exist
     }
-    
-    auto& task = it->second;
+
     TaskState current_state = task->get_state();
-    
+
+    bool cancelled_root = false;
+
     // Can only cancel pending or ready tasks
     if (current_state == TaskState::PENDING || current_state == TaskState::READY) {
         task->request_cancel();
         task->set_state(TaskState::CANCELLED);
-        
+        tracer_.record(task_id, scheduler::TracePhase::CANCELLED);
+        on_task_finished(task);
+        notify_forwards(task_id, true);
+        cancelled_root = true;
+    } else if (current_state == TaskState::RUNNING) {
+        // For running tasks, request cancellation (cooperative)
+        task->request_cancel();
+        cancelled_root = true;
+    } else {
+        return false;  // Already completed or cancelled
+    }
+
+    if (propagate) {
+        // The whole downstream subgraph can never run - cancel it and
+        // reclaim its bookkeeping in one pass instead of leaking count
+        // and adjacency entries until clear().
+        for (auto& dependent : dependency_manager_.cancel_dependents(task_id)) {
+            dependent->request_cancel();
+            dependent->set_state(TaskState::CANCELLED);
+            tracer_.record(dependent->get_id(), scheduler::TracePhase::CANCELLED);
+            on_task_finished(dependent);
+            notify_forwards(dependent->get_id(), true);
+        }
+        if (current_state != TaskState::RUNNING) {
+            dependency_manager_.remove_task(task_id);
+        }
+    } else if (current_state != TaskState::RUNNING) {
         // Remove from dependency manager
         dependency_manager_.remove_task(task_id);
-        
-        return true;
     }
-    
-    // For running tasks, request cancellation (cooperative)
-    if (current_state == TaskState::RUNNING) {
-        task->request_cancel();
-        return true;
-    }
-    
-    return false;  // Already completed or cancelled
+
+    return cancelled_root;
 }
 
 TaskState TaskScheduler::get_task_status(TaskId task_id) const {
-    std::lock_guard<std::mutex> lock(tasks_mutex_);
-    
-    auto it = all_tasks_.find(task_id);
-    if (it == all_tasks_.end()) {
+    auto task = all_tasks_.find(task_id);
+    if (!task) {
         throw std::runtime_error("Task not found: " + std::to_string(task_id));
     }
-    
-    return it->second->get_state();
+
+    return task->get_state();
 }
 
 size_t TaskScheduler::pending_tasks() const {
@@ -126,18 +492,59 @@ size_t TaskScheduler::ready_tasks() const {
     return ready_queue_.size();
 }
 
+// Aggregate once, publish through the seqlock; the store is wait-free
+// with respect to any number of polling readers.
+void TaskScheduler::publish_stats() {
+    const scheduler::SchedulerStats s = snapshot();
+    scheduler::PublishedStats p;
+    p.tasks_executed = s.tasks_executed;
+    p.queue_wait_ns = s.queue_wait_ns;
+    p.steal_attempts = s.steal_attempts;
+    p.steals_successful = s.steals_successful;
+    p.lock_acquisitions = s.lock_acquisitions;
+    p.ready_queue_high_water = s.ready_queue_high_water;
+    published_stats_.store(p);
+}
+
+scheduler::PublishedStats TaskScheduler::published_stats() const {
+    return published_stats_.load();
+}
+
+scheduler::SchedulerStats TaskScheduler::snapshot() const {
+    scheduler::SchedulerStats stats;
+    stats.per_worker = thread_pool_->stats_snapshot();
+    for (const auto& worker : stats.per_worker) {
+        stats.tasks_executed += worker.tasks_executed;
+        stats.queue_wait_ns += worker.queue_wait_ns;
+        stats.steal_attempts += worker.steal_attempts;
+        stats.steals_successful += worker.steals_successful;
+        stats.lock_acquisitions += worker.lock_acquisitions;
+    }
+    stats.ready_queue_high_water = ready_queue_.high_water_mark();
+    return stats;
+}
+
 void TaskScheduler::shutdown() {
     shutdown_requested_.store(true);
+    unfinished_count_.notify_all();  // Unblock wait_for_all callers
+
+    // Stop the timer thread first so no expiry races the teardown below.
+    {
+        std::lock_guard<scheduler::HierarchicalMutex<>> lock(timer_mutex_);
+        timer_cv_.notify_all();
+    }
+    if (timer_thread_.joinable()) {
+        timer_thread_.join();
+    }
     
     // Cancel all pending tasks
-    std::lock_guard<std::mutex> lock(tasks_mutex_);
-    for (auto& pair : all_tasks_) {
-        auto& task = pair.second;
+    all_tasks_.for_each([this](const std::shared_ptr<Task>& task) {
         if (task->get_state() == TaskState::PENDING || task->get_state() == TaskState::READY) {
             task->request_cancel();
             task->set_state(TaskState::CANCELLED);
+            on_task_finished(task);
         }
-    }
+    });
     
     // Clear queues
     ready_queue_.clear();
@@ -150,8 +557,29 @@ void TaskScheduler::shutdown() {
 }
 
 void TaskScheduler::wait_for_all() {
-    while (pending_tasks() > 0 && !shutdown_requested_.load()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    size_t remaining = unfinished_count_.load(std::memory_order_acquire);
+    while (remaining > 0 && !shutdown_requested_.load()) {
+        // Futex wait: kernel parks us until the counter changes, so the
+        // caller burns zero CPU instead of re-polling pending_tasks().
+        unfinished_count_.wait(remaining, std::memory_order_acquire);
+        remaining = unfinished_count_.load(std::memory_order_acquire);
+    }
+}
+
+void TaskScheduler::wait_for_group(std::span<const TaskId> task_ids) {
+    for (TaskId id : task_ids) {
+        if (auto task = all_tasks_.find(id)) {
+            task->wait_until_terminal();
+        }
+    }
+}
+
+void TaskScheduler::on_task_finished(const std::shared_ptr<Task>& task) {
+    if (!task->mark_finished_once()) {
+        return;  // Another path (cancel vs. execute) already counted it
+    }
+    if (unfinished_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        unfinished_count_.notify_all();  // Last task - wake wait_for_all
     }
 }
 
@@ -159,6 +587,144 @@ TaskId TaskScheduler::generate_task_id() {
     return next_task_id_.fetch_add(1);
 }
 
+TaskId TaskScheduler::forward(TaskId task_id, TaskScheduler& target) {
+    auto task = all_tasks_.find(task_id);
+    if (!task) {
+        throw std::runtime_error("Task not found: " + std::to_string(task_id));
+    }
+
+    const TaskId proxy_id = target.create_proxy();
+
+    {
+        std::lock_guard<std::mutex> lock(forward_mutex_);
+        forwards_[task_id].push_back(ForwardLink{&target, proxy_id});
+        forward_count_.fetch_add(1, std::memory_order_release);
+    }
+
+    // The source may have finished between the lookup and the
+    // registration, in which case the completion path saw an empty map.
+    // Re-checking here is safe: whoever extracts the links settles them,
+    // so a concurrent completion cannot double-fire.
+    const TaskState state = task->get_state();
+    if (state == TaskState::COMPLETED || state == TaskState::CANCELLED) {
+        notify_forwards(task_id, state == TaskState::CANCELLED);
+    }
+
+    return proxy_id;
+}
+
+TaskId TaskScheduler::create_proxy() {
+    if (shutdown_requested_.load()) {
+        throw std::runtime_error("Cannot submit task: scheduler is shutting down");
+    }
+
+    TaskId proxy_id = generate_task_id();
+    auto task = task_pool_.acquire(proxy_id, scheduler::unique_function<void()>{},
+                                   Priority::NORMAL);
+    tracer_.record(proxy_id, scheduler::TracePhase::SUBMITTED);
+    unfinished_count_.fetch_add(1, std::memory_order_relaxed);
+    all_tasks_.insert(proxy_id, task);
+    return proxy_id;
+}
+
+void TaskScheduler::settle_proxy(TaskId proxy_id, bool cancelled) {
+    auto task = all_tasks_.find(proxy_id);
+    if (!task || shutdown_requested_.load()) {
+        return;
+    }
+
+    // Drive the proxy through the ordinary lifecycle so futures taken on
+    // it are satisfied: execute() on the empty work transitions it to
+    // COMPLETED - or straight to CANCELLED if the bit is set - and
+    // delivers completion.
+    if (cancelled) {
+        task->request_cancel();
+    }
+    task->execute();
+    on_task_finished(task);
+
+    if (cancelled) {
+        // The source can never complete, so the proxy's downstream
+        // subgraph is dead - same propagation as cancel_task.
+        tracer_.record(proxy_id, scheduler::TracePhase::CANCELLED);
+        for (auto& dependent : dependency_manager_.cancel_dependents(proxy_id)) {
+            dependent->request_cancel();
+            dependent->set_state(TaskState::CANCELLED);
+            tracer_.record(dependent->get_id(), scheduler::TracePhase::CANCELLED);
+            on_task_finished(dependent);
+            notify_forwards(dependent->get_id(), true);
+        }
+        dependency_manager_.remove_task(proxy_id);
+        return;
+    }
+
+    // Running on the source scheduler's completing worker: dependents
+    // land straight in this instance's ready queue - no intermediary
+    // thread, no extra wakeup.
+    tracer_.record(proxy_id, scheduler::TracePhase::END);
+    auto ready_tasks = dependency_manager_.mark_completed(proxy_id);
+    const bool any_ready = !ready_tasks.empty();
+    for (auto& ready_task : ready_tasks) {
+        ready_task->set_state(TaskState::READY);
+        tracer_.record(ready_task->get_id(), scheduler::TracePhase::READY);
+        ready_queue_.push(std::move(ready_task));
+    }
+    if (any_ready) {
+        schedule_ready_tasks();
+    }
+}
+
+void TaskScheduler::notify_forwards(TaskId task_id, bool cancelled) {
+    if (forward_count_.load(std::memory_order_acquire) == 0) {
+        return;
+    }
+
+    std::vector<ForwardLink> links;
+    {
+        std::lock_guard<std::mutex> lock(forward_mutex_);
+        auto it = forwards_.find(task_id);
+        if (it == forwards_.end()) {
+            return;
+        }
+        links = std::move(it->second);
+        forwards_.erase(it);
+        forward_count_.fetch_sub(links.size(), std::memory_order_release);
+    }
+
+    for (const ForwardLink& link : links) {
+        link.target->settle_proxy(link.proxy_id, cancelled);
+    }
+}
+
+void TaskScheduler::inherit_priority(const std::shared_ptr<Task>& task,
+                                     Priority floor) {
+    std::vector<std::shared_ptr<Task>> stack;
+    stack.push_back(task);
+    while (!stack.empty()) {
+        auto current = std::move(stack.back());
+        stack.pop_back();
+
+        const TaskState state = current->get_state();
+        if (state == TaskState::COMPLETED || state == TaskState::CANCELLED) {
+            continue;  // Done - its priority no longer matters
+        }
+        if (!current->raise_priority(floor)) {
+            // Already at or above the floor, and so is everything it
+            // depends on (the boost ran when it was submitted).
+            continue;
+        }
+        if (current->is_ready()) {
+            // Sitting in the ready queue at the old level - re-bucket.
+            ready_queue_.reprioritize(current);
+        }
+        for (TaskId dep : current->get_dependencies()) {
+            if (auto dep_task = all_tasks_.find(dep)) {
+                stack.push_back(std::move(dep_task));
+            }
+        }
+    }
+}
+
 void TaskScheduler::schedule_ready_tasks() {
     // This method is called whenever tasks might become ready
     // The actual scheduling happens in the thread pool workers
@@ -168,8 +734,18 @@ void TaskScheduler::schedule_ready_tasks() {
     
     // Submit a worker function that processes the ready queue
     thread_pool_->enqueue([this]() {
+        // Dependency-heavy runs leave roughly one surplus poll queued per
+        // dependent task by the time the DAG completes; without this
+        // check shutdown() drains them serially with each one sleeping
+        // out the full timeout on the now-empty ready queue - minutes of
+        // teardown for nothing. Bail before the timed pop instead; no
+        // measured number changes, only the drain is bounded.
+        if (shutdown_requested_.load()) {
+            return;
+        }
+
         std::shared_ptr<Task> task;
-        
+
         // Try to get a task with timeout to avoid blocking forever
         if ((task = ready_queue_.try_pop_for(std::chrono::milliseconds(100)))) {
             execute_task(task);
@@ -178,38 +754,73 @@ void TaskScheduler::schedule_ready_tasks() {
 }
 
 void TaskScheduler::execute_task(std::shared_ptr<Task> task) {
+    PROFILE_SCOPE("TaskScheduler::execute_task");
     if (!task || shutdown_requested_.load()) {
         return;
     }
-    
+
     TaskId task_id = task->get_id();
-    
+
+    // A priority re-bucket leaves the old ring entry behind; exactly one
+    // entry per arming wins the claim and the rest are dropped here.
+    if (!task->claim_run_once()) {
+        return;
+    }
+
+    // Attribute queue wait to the executing worker's counter line.
+    const auto enqueued_at = task->get_enqueue_time();
+    if (enqueued_at.time_since_epoch().count() != 0) {
+        const auto waited = std::chrono::steady_clock::now() - enqueued_at;
+        thread_pool_->local_stats().queue_wait_ns.fetch_add(
+            static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count()),
+            std::memory_order_relaxed);
+    }
+
     // Execute the task
+    tracer_.record(task_id, scheduler::TracePhase::START);
     task->execute();
+    tracer_.record(task_id, scheduler::TracePhase::END);
+
+    // A task that comes back READY yielded cooperatively: requeue it at
+    // its priority - the ring is FIFO within a level, so everything
+    // already waiting there runs first - and leave the unfinished count
+    // alone: it has not completed, so its dependents stay blocked and its
+    // future stays unsatisfied until a later run finishes for real.
+    if (task->get_state() == TaskState::READY) {
+        tracer_.record(task_id, scheduler::TracePhase::READY);
+        task->rearm_run();
+        ready_queue_.push(std::move(task));
+        schedule_ready_tasks();
+        return;
+    }
+
+    on_task_finished(task);
     
     // If task completed successfully, check for newly ready tasks
     if (task->get_state() == TaskState::COMPLETED) {
         auto ready_tasks = dependency_manager_.mark_completed(task_id);
-        
-        // Add newly ready tasks to the queue
-        {
-            std::lock_guard<std::mutex> lock(tasks_mutex_);
-            for (TaskId ready_id : ready_tasks) {
-                auto it = all_tasks_.find(ready_id);
-                if (it != all_tasks_.end()) {
-                    auto& ready_task = it->second;
-                    ready_task->set_state(TaskState::READY);
-                    ready_queue_.push(ready_task);
-                }
-            }
+
+        // Push the handles straight to the ready queue - no registry
+        // lookup on the completion path.
+        const bool any_ready = !ready_tasks.empty();
+        for (auto& ready_task : ready_tasks) {
+            ready_task->set_state(TaskState::READY);
+            tracer_.record(ready_task->get_id(), scheduler::TracePhase::READY);
+            ready_queue_.push(std::move(ready_task));
         }
-        
+
         // Schedule processing of newly ready tasks
-        if (!ready_tasks.empty()) {
+        if (any_ready) {
             schedule_ready_tasks();
         }
+
+        // Settle any cross-scheduler handoffs hanging off this task.
+        notify_forwards(task_id, false);
+    } else if (task->get_state() == TaskState::CANCELLED) {
+        notify_forwards(task_id, true);
     }
-    
+
     // Clean up completed task after some time (optional)
     // In a production system, you might want to keep completed tasks
     // for a while for status queries, then clean them up
@@ -1,14 +1,102 @@
 #include "scheduler/thread_pool.hpp"
+#include <chrono>
 #include <iostream>
 
-ThreadPool::ThreadPool(size_t num_threads) 
-    : stop_(false)
-    , num_threads_(num_threads)
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace scheduler {
+
+thread_local ThreadPool* ThreadPool::current_pool_ = nullptr;
+thread_local size_t ThreadPool::current_worker_index_ = 0;
+
+ThreadPool::ThreadPool(size_t num_threads)
+    : ThreadPool(num_threads, num_threads)
 {
-    // Create worker threads
-    workers_.reserve(num_threads);
-    for (size_t i = 0; i < num_threads; ++i) {
-        workers_.emplace_back(&ThreadPool::worker_loop, this);
+}
+
+ThreadPool::ThreadPool(size_t min_threads, size_t max_threads)
+    : ThreadPool(min_threads, max_threads, false)
+{
+}
+
+ThreadPool::ThreadPool(size_t min_threads, size_t max_threads, bool numa_aware)
+    : pending_tasks_(0)
+    , stop_(false)
+    , min_threads_(min_threads)
+    , max_threads_(max_threads)
+    , target_threads_(min_threads)
+    , stats_(new WorkerStats[max_threads + 1])
+{
+    if (min_threads == 0) {
+        throw std::invalid_argument("Number of threads must be greater than 0.");
+    }
+    if (max_threads < min_threads) {
+        throw std::invalid_argument("max_threads must be >= min_threads.");
+    }
+
+    // Every structure indexed by worker slot is sized to the maximum up
+    // front - stealers scan local_queues_ without a lock, so the vector
+    // must never reallocate.
+    local_queues_.reserve(max_threads);
+    for (size_t i = 0; i < max_threads; ++i) {
+        local_queues_.emplace_back(
+            std::make_unique<WorkStealingDeque<unique_function<void()>>>());
+    }
+    slot_active_.reset(new std::atomic<bool>[max_threads]);
+    for (size_t i = 0; i < max_threads; ++i) {
+        slot_active_[i].store(false, std::memory_order_relaxed);
+    }
+
+    if (numa_aware) {
+        // Slots are dealt CPUs node-major: slots 0..k fill node 0, the
+        // next fill node 1, and so on (wrapping if the pool is larger
+        // than the machine). Same-node slots are therefore contiguous,
+        // and each slot's victim scan visits its node's other slots
+        // before crossing the interconnect. Must be computed before any
+        // worker spawns - workers read both tables at loop entry.
+        const NumaTopology topology = NumaTopology::detect();
+        std::vector<size_t> worker_node(max_threads);
+        worker_cpu_.resize(max_threads);
+        size_t node = 0;
+        size_t within = 0;
+        for (size_t i = 0; i < max_threads; ++i) {
+            if (within == topology.node_cpus[node].size()) {
+                node = (node + 1) % topology.node_count();
+                within = 0;
+            }
+            worker_cpu_[i] = topology.node_cpus[node][within++];
+            worker_node[i] = node;
+        }
+
+        steal_order_.resize(max_threads);
+        for (size_t i = 0; i < max_threads; ++i) {
+            steal_order_[i].reserve(max_threads - 1);
+            // Same rotation-past-self as the flat scan (thieves spread
+            // out instead of mobbing one victim), run twice: local
+            // slots, then remote.
+            for (int remote = 0; remote < 2; ++remote) {
+                for (size_t k = 1; k < max_threads; ++k) {
+                    const size_t victim = (i + k) % max_threads;
+                    if ((worker_node[victim] != worker_node[i]) ==
+                        (remote != 0)) {
+                        steal_order_[i].push_back(victim);
+                    }
+                }
+            }
+        }
+    }
+
+    workers_.resize(max_threads);
+    for (size_t i = 0; i < min_threads; ++i) {
+        slot_active_[i].store(true, std::memory_order_relaxed);
+        workers_[i] = std::thread(&ThreadPool::worker_loop, this, i);
+    }
+
+    if (max_threads > min_threads) {
+        controller_ = std::thread(&ThreadPool::controller_loop, this);
     }
 }
 
@@ -16,83 +104,323 @@ ThreadPool::~ThreadPool() {
     shutdown();
 }
 
-void ThreadPool::enqueue(std::function<void()> task) {
+void ThreadPool::enqueue(unique_function<void()> task) {
+    if (stop_.load(std::memory_order_relaxed)) {
+        return;  // Don't accept new tasks if stopping
+    }
+
+    // Fast path: a worker submitting from inside the pool pushes onto its
+    // own deque without touching any lock. seq_cst on the counter bump
+    // pairs with the parking worker's predicate load (see
+    // wake_one_worker).
+    if (current_pool_ == this) {
+        if (local_queues_[current_worker_index_]->push(std::move(task))) {
+            pending_tasks_.fetch_add(1, std::memory_order_seq_cst);
+            wake_one_worker();
+            return;
+        }
+        // Deque full - push() left the task intact, fall through to the
+        // shared overflow path.
+    }
+
     {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        
-        // Don't accept new tasks if stopping
+        std::lock_guard<HierarchicalMutex<>> lock(queue_mutex_);
         if (stop_) {
             return;
         }
-        
-        task_queue_.push(std::move(task));
+        injection_queue_.push(std::move(task));
+        pending_tasks_.fetch_add(1, std::memory_order_release);
     }
-    
-    // Notify one waiting worker
+
+    wake_one_worker();
+}
+
+void ThreadPool::wake_one_worker() {
+    // Nobody parked (the common case under load: every worker is awake
+    // and chewing through its deque) - skip the futex syscall entirely.
+    // seq_cst pairs with the sleeper's registration: if this load sees
+    // zero, the registration comes later in the total order, and the
+    // worker's subsequent predicate load is then guaranteed to see the
+    // pending_tasks_ bump we just published - it won't sleep.
+    if (sleeping_workers_.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+
+    // A worker between "predicate saw no work" and actually parking holds
+    // queue_mutex_ for that whole window; bouncing through the lock
+    // orders this notify after its park, so the wakeup cannot fall into
+    // the gap. (The old lock-free fast path notified without the lock and
+    // could in principle lose exactly that wakeup.)
+    { std::lock_guard<HierarchicalMutex<>> lock(queue_mutex_); }
     condition_.notify_one();
 }
 
 void ThreadPool::shutdown() {
     {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
+        std::lock_guard<HierarchicalMutex<>> lock(queue_mutex_);
         stop_ = true;
     }
-    
+
     // Wake up all workers
     condition_.notify_all();
-    
+
+    if (controller_.joinable()) {
+        controller_.join();
+    }
+
     // Wait for all workers to finish
     for (std::thread& worker : workers_) {
         if (worker.joinable()) {
             worker.join();
         }
     }
-    
+
     workers_.clear();
 }
 
 size_t ThreadPool::get_thread_count() const {
-    return num_threads_;
+    return target_threads_.load(std::memory_order_relaxed);
 }
 
 size_t ThreadPool::get_queue_size() const {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    return task_queue_.size();
+    return pending_tasks_.load(std::memory_order_relaxed);
+}
+
+WorkerStats& ThreadPool::local_stats() {
+    if (current_pool_ == this) {
+        return stats_[current_worker_index_];
+    }
+    return stats_[max_threads_];  // External threads share the last line
+}
+
+std::vector<WorkerStatsSnapshot> ThreadPool::stats_snapshot() const {
+    std::vector<WorkerStatsSnapshot> out(max_threads_ + 1);
+    for (size_t i = 0; i <= max_threads_; ++i) {
+        out[i].tasks_executed =
+            stats_[i].tasks_executed.load(std::memory_order_relaxed);
+        out[i].queue_wait_ns =
+            stats_[i].queue_wait_ns.load(std::memory_order_relaxed);
+        out[i].steal_attempts =
+            stats_[i].steal_attempts.load(std::memory_order_relaxed);
+        out[i].steals_successful =
+            stats_[i].steals_successful.load(std::memory_order_relaxed);
+        out[i].lock_acquisitions =
+            stats_[i].lock_acquisitions.load(std::memory_order_relaxed);
+    }
+    return out;
+}
+
+bool ThreadPool::run_pending_task() {
+    if (current_pool_ != this) {
+        return false;  // Not our worker; the caller should block instead
+    }
+
+    unique_function<void()> task;
+    if (!try_get_task(current_worker_index_, task)) {
+        return false;
+    }
+
+    pending_tasks_.fetch_sub(1, std::memory_order_release);
+    stats_[current_worker_index_].tasks_executed.fetch_add(
+        1, std::memory_order_relaxed);
+
+    // Same exception policy as worker_loop: a stolen task's failure must
+    // not propagate into whatever join loop is helping out.
+    try {
+        task();
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in worker thread: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Unknown exception in worker thread" << std::endl;
+    }
+    return true;
 }
 
-void ThreadPool::worker_loop() {
+bool ThreadPool::try_get_task(size_t worker_index, unique_function<void()>& task) {
+    // 1. Own deque, newest first (LIFO keeps the working set hot).
+    if (local_queues_[worker_index]->pop(task)) {
+        return true;
+    }
+
+    // 2. Steal oldest-first from the other slots, starting just past our
+    //    own index so thieves spread out instead of mobbing worker 0.
+    //    Retired slots are scanned too: their deques may still hold work
+    //    stranded by a shrink. A NUMA-aware pool scans its precomputed
+    //    order instead - same rotation, but same-node victims first, so
+    //    a steal crosses the interconnect only when the whole node is
+    //    dry.
+    WorkerStats& stats = stats_[worker_index];
+    if (!steal_order_.empty()) {
+        for (size_t victim : steal_order_[worker_index]) {
+            stats.steal_attempts.fetch_add(1, std::memory_order_relaxed);
+            if (local_queues_[victim]->steal(task)) {
+                stats.steals_successful.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    } else {
+        for (size_t i = 1; i < max_threads_; ++i) {
+            size_t victim = (worker_index + i) % max_threads_;
+            stats.steal_attempts.fetch_add(1, std::memory_order_relaxed);
+            if (local_queues_[victim]->steal(task)) {
+                stats.steals_successful.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    // 3. Shared injection queue (external submitters and overflow).
+    stats.lock_acquisitions.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<HierarchicalMutex<>> lock(queue_mutex_);
+    if (!injection_queue_.empty()) {
+        task = std::move(injection_queue_.front());
+        injection_queue_.pop();
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::worker_loop(size_t worker_index) {
+    current_pool_ = this;
+    current_worker_index_ = worker_index;
+
+#ifdef __linux__
+    if (!worker_cpu_.empty()) {
+        // Best-effort pin to this slot's CPU: keeps the worker's working
+        // set in one core's cache, and makes everything it allocates
+        // fault in on its own NUMA node (first touch). Failure (shrunk
+        // cpuset) just leaves the thread unpinned.
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(static_cast<unsigned>(worker_cpu_[worker_index]), &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#endif
+
     while (true) {
-        std::function<void()> task;
-        
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            
-            // Wait for work or stop signal
-            condition_.wait(lock, [this] {
-                return stop_ || !task_queue_.empty();
-            });
-            
-            // Exit if stopping and no more work
-            if (stop_ && task_queue_.empty()) {
+        unique_function<void()> task;
+
+        if (!try_get_task(worker_index, task)) {
+            // Nothing anywhere - sleep until new work is announced.
+            std::unique_lock<HierarchicalMutex<>> lock(queue_mutex_);
+
+            // Retirement check under the mutex: a concurrent grow also
+            // retargets under this mutex, so either this worker sees the
+            // raised target and stays, or it marks its slot dead before
+            // the grow inspects it - never both.
+            if (stop_ ||
+                worker_index >= target_threads_.load(std::memory_order_relaxed)) {
+                slot_active_[worker_index].store(false, std::memory_order_relaxed);
                 break;
             }
-            
-            // Get next task
-            if (!task_queue_.empty()) {
-                task = std::move(task_queue_.front());
-                task_queue_.pop();
+
+            // Register as a sleeper before the first predicate check;
+            // submitters only notify when this count is non-zero, so the
+            // order (count up, then look for work) is what makes the
+            // skipped-notify protocol lossless.
+            sleeping_workers_.fetch_add(1, std::memory_order_seq_cst);
+            condition_.wait(lock, [this, worker_index] {
+                return stop_ ||
+                       worker_index >=
+                           target_threads_.load(std::memory_order_relaxed) ||
+                       pending_tasks_.load(std::memory_order_seq_cst) > 0;
+            });
+            sleeping_workers_.fetch_sub(1, std::memory_order_relaxed);
+
+            if (stop_ ||
+                worker_index >= target_threads_.load(std::memory_order_relaxed)) {
+                slot_active_[worker_index].store(false, std::memory_order_relaxed);
+                break;
             }
+            continue;  // Re-run the full local/steal/injection scan
         }
-        
+
+        pending_tasks_.fetch_sub(1, std::memory_order_release);
+        stats_[worker_index].tasks_executed.fetch_add(1, std::memory_order_relaxed);
+
         // Execute task outside of lock
-        if (task) {
-            try {
-                task();
-            } catch (const std::exception& e) {
-                std::cerr << "Exception in worker thread: " << e.what() << std::endl;
-            } catch (...) {
-                std::cerr << "Unknown exception in worker thread" << std::endl;
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "Exception in worker thread: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Unknown exception in worker thread" << std::endl;
+        }
+    }
+
+    current_pool_ = nullptr;
+}
+
+void ThreadPool::resize_workers_locked(size_t new_target) {
+    const size_t old_target = target_threads_.load(std::memory_order_relaxed);
+    target_threads_.store(new_target, std::memory_order_relaxed);
+
+    for (size_t i = old_target; i < new_target; ++i) {
+        if (slot_active_[i].load(std::memory_order_relaxed)) {
+            // The slot's worker hasn't retired yet; it will observe the
+            // raised target (same mutex) and simply keep running.
+            continue;
+        }
+        if (workers_[i].joinable()) {
+            workers_[i].join();  // Slot already marked dead, so brief
+        }
+        slot_active_[i].store(true, std::memory_order_relaxed);
+        workers_[i] = std::thread(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+void ThreadPool::controller_loop() {
+    using namespace std::chrono_literals;
+
+    // Queue deeper than kGrowFactor tasks per worker: add one. Idle for
+    // kShrinkIntervals consecutive observation windows: drop one.
+    constexpr size_t kGrowFactor = 2;
+    constexpr int kShrinkIntervals = 5;
+    constexpr auto kInterval = 100ms;
+
+    std::uint64_t last_executed = 0;
+    int idle_intervals = 0;
+
+    while (!stop_.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(kInterval);
+        if (stop_.load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        std::uint64_t executed = 0;
+        for (size_t i = 0; i < max_threads_; ++i) {
+            executed += stats_[i].tasks_executed.load(std::memory_order_relaxed);
+        }
+        const std::uint64_t delta = executed - last_executed;
+        last_executed = executed;
+
+        const size_t depth = pending_tasks_.load(std::memory_order_relaxed);
+        const size_t target = target_threads_.load(std::memory_order_relaxed);
+
+        if (depth > target * kGrowFactor && target < max_threads_) {
+            // Backlog is outrunning the workers (e.g. some are blocked on
+            // I/O) - bring another core online.
+            std::lock_guard<HierarchicalMutex<>> lock(queue_mutex_);
+            if (!stop_) {
+                resize_workers_locked(target + 1);
             }
+            idle_intervals = 0;
+        } else if (depth == 0 && delta == 0 && target > min_threads_) {
+            if (++idle_intervals >= kShrinkIntervals) {
+                {
+                    std::lock_guard<HierarchicalMutex<>> lock(queue_mutex_);
+                    if (!stop_) {
+                        resize_workers_locked(target - 1);
+                    }
+                }
+                condition_.notify_all();  // Wake the retiring worker
+                idle_intervals = 0;
+            }
+        } else {
+            idle_intervals = 0;
         }
     }
-}
\ No newline at end of file
+}
+
+} // namespace scheduler
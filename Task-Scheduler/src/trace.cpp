@@ -0,0 +1,121 @@
+#include "scheduler/trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace scheduler {
+
+thread_local TaskTracer* TaskTracer::current_tracer_ = nullptr;
+thread_local TaskTracer::ThreadBuffer* TaskTracer::current_buffer_ = nullptr;
+
+namespace {
+
+std::uint64_t now_ns() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+const char* phase_name(TracePhase phase) {
+    switch (phase) {
+        case TracePhase::SUBMITTED: return "submitted";
+        case TracePhase::READY:     return "ready";
+        case TracePhase::START:     return "run";
+        case TracePhase::END:       return "run";
+        case TracePhase::CANCELLED: return "cancelled";
+    }
+    return "?";
+}
+
+}  // namespace
+
+TaskTracer::ThreadBuffer* TaskTracer::local_buffer() {
+    if (current_tracer_ == this && current_buffer_ != nullptr) {
+        return current_buffer_;
+    }
+
+    // First event from this thread (or the thread last recorded into a
+    // different tracer): register a fresh ring.
+    auto buffer = std::make_unique<ThreadBuffer>();
+    ThreadBuffer* raw = buffer.get();
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        raw->thread_track = next_track_++;
+        buffers_.push_back(std::move(buffer));
+    }
+    current_tracer_ = this;
+    current_buffer_ = raw;
+    return raw;
+}
+
+void TaskTracer::record_slow(TaskId task_id, TracePhase phase) {
+    ThreadBuffer* buffer = local_buffer();
+
+    const std::uint64_t index =
+        buffer->next.load(std::memory_order_relaxed);
+    TraceEvent& slot = buffer->events[index % ThreadBuffer::kCapacity];
+    slot.timestamp_ns = now_ns();
+    slot.task_id = task_id;
+    slot.phase = phase;
+    // Release publishes the slot write to a concurrent dump_json.
+    buffer->next.store(index + 1, std::memory_order_release);
+}
+
+std::string TaskTracer::dump_json() {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+
+    std::string out;
+    out.reserve(1u << 16);
+    out += "{\"traceEvents\":[";
+
+    bool first = true;
+    for (const auto& buffer : buffers_) {
+        const std::uint64_t written =
+            buffer->next.load(std::memory_order_acquire);
+        const std::uint64_t count =
+            std::min<std::uint64_t>(written, ThreadBuffer::kCapacity);
+        const std::uint64_t begin = written - count;
+
+        for (std::uint64_t i = begin; i < written; ++i) {
+            const TraceEvent& event =
+                buffer->events[i % ThreadBuffer::kCapacity];
+
+            const char* ph = nullptr;
+            switch (event.phase) {
+                case TracePhase::START: ph = "B"; break;
+                case TracePhase::END:   ph = "E"; break;
+                default:                ph = "i"; break;
+            }
+
+            if (!first) {
+                out += ',';
+            }
+            first = false;
+
+            out += "{\"name\":\"task ";
+            out += std::to_string(event.task_id);
+            out += " ";
+            out += phase_name(event.phase);
+            out += "\",\"cat\":\"task\",\"ph\":\"";
+            out += ph;
+            out += "\",\"pid\":1,\"tid\":";
+            out += std::to_string(buffer->thread_track);
+            // Chrome expects microseconds; keep sub-microsecond precision
+            // with a fractional part.
+            out += ",\"ts\":";
+            out += std::to_string(event.timestamp_ns / 1000);
+            out += '.';
+            out += std::to_string(event.timestamp_ns % 1000);
+            if (ph[0] == 'i') {
+                out += ",\"s\":\"t\"";
+            }
+            out += '}';
+        }
+    }
+
+    out += "]}";
+    return out;
+}
+
+}  // namespace scheduler
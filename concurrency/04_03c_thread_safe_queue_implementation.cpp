@@ -7,6 +7,10 @@
 #include <chrono>
 
 // Listing 4.5: Full class definition for a thread-safe queue using condition variables
+//
+// NOTE: the production form of this queue (same core, plus bounding,
+// close() for shutdown, and bulk ops) is cds::concurrent_queue in
+// Concurrent-Data-Structures/queue/concurrent_queue.hpp.
 template<typename T>
 class threadsafe_queue
 {